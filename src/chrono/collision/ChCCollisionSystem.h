@@ -15,6 +15,8 @@
 #ifndef CHC_COLLISIONSYSTEM_H
 #define CHC_COLLISIONSYSTEM_H
 
+#include <vector>
+
 #include "chrono/collision/ChCCollisionInfo.h"
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChFrame.h"
@@ -70,6 +72,19 @@ class ChApi ChCollisionSystem {
     /// Reset any timers associated with collision detection.
     virtual void ResetTimers() {}
 
+    /// Write the persistent contact data (e.g., contact manifolds and their cached reactions) to the given buffer.
+    /// Used for system snapshots (see ChSystem::WriteSnapshot). By default, there is no such data.
+    virtual void WriteContactCache(std::vector<char>& buffer) const { buffer.clear(); }
+
+    /// Check, without modifying the collision system, that a buffer created with WriteContactCache can be restored
+    /// with ReadContactCache. Return false if the data does not match this collision system.
+    virtual bool CheckContactCache(const char* data, size_t size) const { return size == 0; }
+
+    /// Restore the persistent contact data from a buffer created with WriteContactCache.
+    /// Must be called after Run(), with the collision models at the configuration of the snapshot.
+    /// Return false if the data does not match this collision system.
+    virtual bool ReadContactCache(const char* data, size_t size) { return size == 0; }
+
     /// After the Run() has completed, you can call this function to
     /// fill a 'contact container', that is an object inherited from class
     /// ChContactContainer. For instance ChSystem, after each Run()
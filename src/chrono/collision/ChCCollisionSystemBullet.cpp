@@ -12,6 +12,13 @@
 // Authors: Alessandro Tasora
 // =============================================================================
 
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/collision/gimpact/GIMPACT/Bullet/btGImpactCollisionAlgorithm.h"
@@ -25,6 +32,7 @@
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/bt2DShape.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/btCEtriangleShape.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionDispatch/btEmptyCollisionAlgorithm.h"
+#include "chrono/collision/bullet/BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
 
 extern btScalar gContactBreakingThreshold;
 
@@ -1167,7 +1175,7 @@ private:
 ////////////////////////////////////
 
 
-ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, double scene_size) {
+ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, double scene_size) : num_threads(1) {
     // btDefaultCollisionConstructionInfo conf_info(...); ***TODO***
     bt_collision_configuration = new btDefaultCollisionConfiguration();
 
@@ -1283,73 +1291,105 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontain
     // This should remove all old contacts (or at least rewind the index)
     mcontactcontainer->BeginAddContact();
 
+    int numManifolds = bt_collision_world->getDispatcher()->getNumManifolds();
+
+    // User callbacks are not required to be thread-safe: use the parallel path only if there are none.
+    int nthreads = (this->broad_callback || this->narrow_callback) ? 1 : std::min(num_threads, numManifolds);
+
+    if (nthreads > 1) {
+        // Each thread processes a contiguous range of manifolds into its own batch; batches are then
+        // passed to the container in thread order, so that contacts are reported in the serial order.
+        batches.resize(nthreads);
+
+#pragma omp parallel for num_threads(nthreads) schedule(static, 1)
+        for (int t = 0; t < nthreads; t++) {
+            batches[t].clear();
+            int i_start = (int)(((long long)numManifolds * t) / nthreads);
+            int i_end = (int)(((long long)numManifolds * (t + 1)) / nthreads);
+            for (int i = i_start; i < i_end; i++) {
+                ProcessManifold(bt_collision_world->getDispatcher()->getManifoldByIndexInternal(i), batches[t]);
+            }
+        }
+
+        for (int t = 0; t < nthreads; t++)
+            mcontactcontainer->AddContacts(batches[t]);
+    } else {
+        if (batches.empty())
+            batches.resize(1);
+        for (int i = 0; i < numManifolds; i++) {
+            batches[0].clear();
+            ProcessManifold(bt_collision_world->getDispatcher()->getManifoldByIndexInternal(i), batches[0]);
+            for (const auto& icontact : batches[0])
+                mcontactcontainer->AddContact(icontact);
+        }
+    }
+
+    mcontactcontainer->EndAddContact();
+}
+
+void ChCollisionSystemBullet::ProcessManifold(btPersistentManifold* contactManifold,
+                                              std::vector<ChCollisionInfo>& batch) {
     // NOTE: Bullet does not provide information on radius of curvature at a contact point.
-    // As such, for all Bullet-identified contacts, the default value will be used (SMC only). 
+    // As such, for all Bullet-identified contacts, the default value will be used (SMC only).
     ChCollisionInfo icontact;
 
-    int numManifolds = bt_collision_world->getDispatcher()->getNumManifolds();
-    for (int i = 0; i < numManifolds; i++) {
-        btPersistentManifold* contactManifold = bt_collision_world->getDispatcher()->getManifoldByIndexInternal(i);
-        btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
-        btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
-        contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
+    btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
+    btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
+    contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
 
-        icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
-        icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
+    icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
+    icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
 
-        double envelopeA = icontact.modelA->GetEnvelope();
-        double envelopeB = icontact.modelB->GetEnvelope();
+    double envelopeA = icontact.modelA->GetEnvelope();
+    double envelopeB = icontact.modelB->GetEnvelope();
 
-        double marginA = icontact.modelA->GetSafeMargin();
-        double marginB = icontact.modelB->GetSafeMargin();
+    double marginA = icontact.modelA->GetSafeMargin();
+    double marginB = icontact.modelB->GetSafeMargin();
 
-        // Execute custom broadphase callback, if any
-        bool do_narrow_contactgeneration = true;
-        if (this->broad_callback)
-            do_narrow_contactgeneration = this->broad_callback->OnBroadphase(icontact.modelA, icontact.modelB);
+    // Execute custom broadphase callback, if any
+    bool do_narrow_contactgeneration = true;
+    if (this->broad_callback)
+        do_narrow_contactgeneration = this->broad_callback->OnBroadphase(icontact.modelA, icontact.modelB);
 
-        if (do_narrow_contactgeneration) {
-            int numContacts = contactManifold->getNumContacts();
-            //GetLog() << "numContacts=" << numContacts << "\n";
-            for (int j = 0; j < numContacts; j++) {
-                btManifoldPoint& pt = contactManifold->getContactPoint(j);
+    if (!do_narrow_contactgeneration)
+        return;
 
-                // Discard "too far" constraints (the Bullet engine also has its threshold)
-                if (pt.getDistance() < marginA + marginB) {
-                    btVector3 ptA = pt.getPositionWorldOnA();
-                    btVector3 ptB = pt.getPositionWorldOnB();
+    int numContacts = contactManifold->getNumContacts();
+    for (int j = 0; j < numContacts; j++) {
+        btManifoldPoint& pt = contactManifold->getContactPoint(j);
 
-                    icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
-                    icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
+        // Discard "too far" constraints (the Bullet engine also has its threshold)
+        if (pt.getDistance() < marginA + marginB) {
+            btVector3 ptA = pt.getPositionWorldOnA();
+            btVector3 ptB = pt.getPositionWorldOnB();
 
-                    icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(),
-                                    -pt.m_normalWorldOnB.getZ());
-                    icontact.vN.Normalize();
+            icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
+            icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
 
-                    double ptdist = pt.getDistance();
+            icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(), -pt.m_normalWorldOnB.getZ());
+            icontact.vN.Normalize();
 
-                    icontact.vpA = icontact.vpA - icontact.vN * envelopeA;
-                    icontact.vpB = icontact.vpB + icontact.vN * envelopeB;
-                    icontact.distance = ptdist + envelopeA + envelopeB;
+            double ptdist = pt.getDistance();
 
-                    icontact.reaction_cache = pt.reactions_cache;
+            icontact.vpA = icontact.vpA - icontact.vN * envelopeA;
+            icontact.vpB = icontact.vpB + icontact.vN * envelopeB;
+            icontact.distance = ptdist + envelopeA + envelopeB;
 
-                    // Execute some user custom callback, if any
-                    bool add_contact = true;
-                    if (this->narrow_callback)
-                        add_contact = this->narrow_callback->OnNarrowphase(icontact);
+            icontact.reaction_cache = pt.reactions_cache;
 
-                    // Add to contact container
-                    if (add_contact)
-                        mcontactcontainer->AddContact(icontact);
-                }
-            }
-        }
+            // Execute some user custom callback, if any
+            bool add_contact = true;
+            if (this->narrow_callback)
+                add_contact = this->narrow_callback->OnNarrowphase(icontact);
 
-        // you can un-comment out this line, and then all points are removed
-        // contactManifold->clearManifold();
+            // Add to contact batch
+            if (add_contact)
+                batch.push_back(icontact);
+        }
     }
-    mcontactcontainer->EndAddContact();
+
+    // you can un-comment out this line, and then all points are removed
+    // contactManifold->clearManifold();
 }
 
 void ChCollisionSystemBullet::ReportProximities(ChProximityContainer* mproximitycontainer) {
@@ -1385,6 +1425,16 @@ void ChCollisionSystemBullet::ReportProximities(ChProximityContainer* mproximity
     mproximitycontainer->EndAddProximities();
 }
 
+bool ChCollisionSystemBullet::HasConcaveMeshes() const {
+    const btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++) {
+        ChModelBullet* model = (ChModelBullet*)objects[i]->getUserPointer();
+        if (model && model->HasConcaveMeshes())
+            return true;
+    }
+    return false;
+}
+
 bool ChCollisionSystemBullet::RayHit(const ChVector<>& from, const ChVector<>& to, ChRayhitResult& mresult) const {
     return RayHit(from, to, mresult, btBroadphaseProxy::DefaultFilter, btBroadphaseProxy::AllFilter);
 }
@@ -1473,6 +1523,493 @@ bool ChCollisionSystemBullet::RayHit(const ChVector<>& from,
     return true;
 }
 
+// -----------------------------------------------------------------------------
+// Contact cache.
+// Besides the contact points stored in the persistent manifolds (with the cached
+// reactions used for warm starting), the Bullet collision world carries state
+// that depends on the history of the simulation and that determines the order in
+// which contacts are reported: the structure of the broadphase trees, the order
+// of the broadphase pairs, and the order of the manifolds in the dispatcher.
+// All of these are saved, with collision objects identified by their index in
+// the collision world.
+// -----------------------------------------------------------------------------
+
+namespace {
+
+struct ContactCacheHeader {
+    int32_t point_size;  // sizeof(btManifoldPoint), to detect incompatible builds
+    int32_t num_objects;
+    int32_t broadphase;  // 1 if the DBVT broadphase state is included
+    int32_t num_pairs;
+};
+
+struct BroadphaseState {
+    int32_t stage_current;
+    int32_t fupdates;
+    int32_t dupdates;
+    int32_t cupdates;
+    int32_t newpairs;
+    int32_t fixedleft;
+    int32_t pid;
+    int32_t cid;
+    int32_t gid;
+    int32_t needcleanup;
+    uint32_t updates_call;
+    uint32_t updates_done;
+    btScalar updates_ratio;
+    int32_t lkhd[2];
+    int32_t leaves[2];
+    uint32_t opath[2];
+    int32_t num_nodes[2];
+};
+
+struct ProxyState {
+    btVector3 aabb_min;
+    btVector3 aabb_max;
+};
+
+// Tree node, in depth-first order (object index for leaves, -1 for internal nodes).
+struct TreeNode {
+    btDbvtVolume volume;
+    int32_t object;
+};
+
+struct PairEntry {
+    int32_t object0;
+    int32_t object1;
+    int32_t num_manifolds;
+};
+
+struct ManifoldEntry {
+    int32_t index;  // index in the dispatcher
+    int32_t num_points;
+};
+
+struct SavedPair {
+    PairEntry entry;
+    std::vector<ManifoldEntry> manifolds;
+    std::vector<const char*> points;
+};
+
+template <typename T>
+void Append(std::vector<char>& buffer, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+// Sequential reader with bounds checking.
+class CacheReader {
+  public:
+    CacheReader(const char* data, size_t size) : m_data(data), m_size(size), m_offset(0) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        if (m_size - m_offset < sizeof(T))
+            return false;
+        std::memcpy(&value, m_data + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    const char* Skip(size_t bytes) {
+        if (m_size - m_offset < bytes)
+            return nullptr;
+        const char* ptr = m_data + m_offset;
+        m_offset += bytes;
+        return ptr;
+    }
+
+    bool AtEnd() const { return m_offset == m_size; }
+
+  private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_offset;
+};
+
+typedef std::pair<btBroadphaseProxy*, btBroadphaseProxy*> ProxyPair;
+
+ProxyPair MakeProxyPair(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1) {
+    return proxy0->getUid() < proxy1->getUid() ? ProxyPair(proxy0, proxy1) : ProxyPair(proxy1, proxy0);
+}
+
+void WriteTree(std::vector<char>& buffer,
+               const btDbvtNode* node,
+               const std::unordered_map<const void*, int>& object_index) {
+    TreeNode entry;
+    entry.volume = node->volume;
+    entry.object =
+        node->isleaf() ? object_index.at(static_cast<const btDbvtProxy*>(node->data)->m_clientObject) : -1;
+    Append(buffer, entry);
+    if (node->isinternal()) {
+        WriteTree(buffer, node->childs[0], object_index);
+        WriteTree(buffer, node->childs[1], object_index);
+    }
+}
+
+// Check that the nodes starting at position i form a complete tree; on return, i is past the tree.
+bool CheckTree(const std::vector<TreeNode>& nodes, size_t& i, std::vector<int>& leaf_count) {
+    if (i >= nodes.size())
+        return false;
+    const TreeNode& entry = nodes[i++];
+    if (entry.object >= (int)leaf_count.size())
+        return false;
+    if (entry.object >= 0)
+        return ++leaf_count[entry.object] == 1;
+    return CheckTree(nodes, i, leaf_count) && CheckTree(nodes, i, leaf_count);
+}
+
+// Build the tree from the nodes starting at position i (allocated as in btDbvt).
+btDbvtNode* BuildTree(const std::vector<TreeNode>& nodes,
+                      size_t& i,
+                      btDbvtNode* parent,
+                      const std::vector<btDbvtProxy*>& proxies) {
+    const TreeNode& entry = nodes[i++];
+    btDbvtNode* node = new (btAlignedAlloc(sizeof(btDbvtNode), 16)) btDbvtNode();
+    node->parent = parent;
+    node->volume = entry.volume;
+    if (entry.object >= 0) {
+        node->data = proxies[entry.object];
+        node->childs[1] = 0;
+        proxies[entry.object]->leaf = node;
+    } else {
+        node->childs[0] = BuildTree(nodes, i, node, proxies);
+        node->childs[1] = BuildTree(nodes, i, node, proxies);
+    }
+    return node;
+}
+
+// Contents of a contact cache (see ChCollisionSystemBullet::WriteContactCache).
+struct ContactCache {
+    ContactCacheHeader header;
+    BroadphaseState state;
+    std::vector<ProxyState> proxy_states;
+    std::vector<std::vector<int32_t>> stages;
+    std::vector<TreeNode> trees[2];
+    std::vector<SavedPair> saved_pairs;
+};
+
+// Parse and validate a contact cache for a collision world with num_objects collision objects and, if dbvt is true,
+// a DBVT broadphase. Contact points are not copied: the saved pairs point to them in the data buffer.
+bool ParseContactCache(const char* data, size_t size, int num_objects, bool dbvt, ContactCache& cache) {
+    CacheReader reader(data, size);
+
+    ContactCacheHeader& header = cache.header;
+    if (!reader.Read(header) || header.point_size != (int32_t)sizeof(btManifoldPoint) ||
+        header.num_objects != num_objects || header.broadphase != (dbvt ? 1 : 0) || header.num_pairs < 0)
+        return false;
+
+    BroadphaseState& state = cache.state;
+    std::vector<ProxyState>& proxy_states = cache.proxy_states;
+    std::vector<std::vector<int32_t>>& stages = cache.stages;
+    std::vector<TreeNode>* trees = cache.trees;
+    proxy_states.resize(num_objects);
+    stages.resize(btDbvtBroadphase::STAGECOUNT + 1);
+    if (dbvt) {
+        if (!reader.Read(state))
+            return false;
+        for (int i = 0; i < num_objects; i++) {
+            if (!reader.Read(proxy_states[i]))
+                return false;
+        }
+        std::vector<int> stage_count(num_objects, 0);
+        for (auto& stage : stages) {
+            int32_t count;
+            if (!reader.Read(count) || count < 0 || count > num_objects)
+                return false;
+            stage.resize(count);
+            for (auto& object : stage) {
+                if (!reader.Read(object) || object < 0 || object >= num_objects || ++stage_count[object] > 1)
+                    return false;
+            }
+        }
+        std::vector<int> leaf_count(num_objects, 0);
+        for (int s = 0; s < 2; s++) {
+            if (state.num_nodes[s] < 0)
+                return false;
+            trees[s].resize(state.num_nodes[s]);
+            for (auto& node : trees[s]) {
+                if (!reader.Read(node))
+                    return false;
+            }
+            size_t i = 0;
+            if (!trees[s].empty() && (!CheckTree(trees[s], i, leaf_count) || i != trees[s].size()))
+                return false;
+        }
+        for (int i = 0; i < num_objects; i++) {
+            if (stage_count[i] != 1 || leaf_count[i] != 1)
+                return false;
+        }
+    }
+
+    std::vector<SavedPair>& saved_pairs = cache.saved_pairs;
+    saved_pairs.resize(header.num_pairs);
+    for (auto& pair : saved_pairs) {
+        if (!reader.Read(pair.entry) || pair.entry.object0 < 0 || pair.entry.object0 >= num_objects ||
+            pair.entry.object1 < 0 || pair.entry.object1 >= num_objects || pair.entry.num_manifolds < 0)
+            return false;
+        pair.manifolds.resize(pair.entry.num_manifolds);
+        pair.points.resize(pair.entry.num_manifolds);
+        for (int j = 0; j < pair.entry.num_manifolds; j++) {
+            ManifoldEntry& entry = pair.manifolds[j];
+            if (!reader.Read(entry) || entry.num_points < 0 || entry.num_points > MANIFOLD_CACHE_SIZE)
+                return false;
+            pair.points[j] = reader.Skip(entry.num_points * sizeof(btManifoldPoint));
+            if (!pair.points[j])
+                return false;
+        }
+    }
+    return reader.AtEnd();
+}
+
+}  // end anonymous namespace
+
+void ChCollisionSystemBullet::WriteContactCache(std::vector<char>& buffer) const {
+    const btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    std::unordered_map<const void*, int> object_index;
+    for (int i = 0; i < objects.size(); i++)
+        object_index[objects[i]] = i;
+
+    btDbvtBroadphase* dbvt = dynamic_cast<btDbvtBroadphase*>(bt_broadphase);
+    btOverlappingPairCache* pair_cache = bt_broadphase->getOverlappingPairCache();
+    btBroadphasePairArray& pairs = pair_cache->getOverlappingPairArray();
+
+    ContactCacheHeader header = {(int32_t)sizeof(btManifoldPoint), (int32_t)objects.size(), dbvt ? 1 : 0,
+                                 (int32_t)pair_cache->getNumOverlappingPairs()};
+    buffer.clear();
+    Append(buffer, header);
+
+    // Broadphase: counters, proxy bounding boxes, stage lists, and trees
+    if (dbvt) {
+        BroadphaseState state;
+        state.stage_current = dbvt->m_stageCurrent;
+        state.fupdates = dbvt->m_fupdates;
+        state.dupdates = dbvt->m_dupdates;
+        state.cupdates = dbvt->m_cupdates;
+        state.newpairs = dbvt->m_newpairs;
+        state.fixedleft = dbvt->m_fixedleft;
+        state.pid = dbvt->m_pid;
+        state.cid = dbvt->m_cid;
+        state.gid = dbvt->m_gid;
+        state.needcleanup = dbvt->m_needcleanup ? 1 : 0;
+        state.updates_call = dbvt->m_updates_call;
+        state.updates_done = dbvt->m_updates_done;
+        state.updates_ratio = dbvt->m_updates_ratio;
+        for (int s = 0; s < 2; s++) {
+            state.lkhd[s] = dbvt->m_sets[s].m_lkhd;
+            state.leaves[s] = dbvt->m_sets[s].m_leaves;
+            state.opath[s] = dbvt->m_sets[s].m_opath;
+            state.num_nodes[s] = 0;
+        }
+        std::vector<char> trees[2];
+        for (int s = 0; s < 2; s++) {
+            if (dbvt->m_sets[s].m_root)
+                WriteTree(trees[s], dbvt->m_sets[s].m_root, object_index);
+            state.num_nodes[s] = (int32_t)(trees[s].size() / sizeof(TreeNode));
+        }
+        Append(buffer, state);
+
+        for (int i = 0; i < objects.size(); i++) {
+            const btBroadphaseProxy* proxy = objects[i]->getBroadphaseHandle();
+            ProxyState proxy_state = {proxy->m_aabbMin, proxy->m_aabbMax};
+            Append(buffer, proxy_state);
+        }
+
+        for (int s = 0; s <= btDbvtBroadphase::STAGECOUNT; s++) {
+            int32_t count = 0;
+            for (const btDbvtProxy* proxy = dbvt->m_stageRoots[s]; proxy; proxy = proxy->links[1])
+                count++;
+            Append(buffer, count);
+            for (const btDbvtProxy* proxy = dbvt->m_stageRoots[s]; proxy; proxy = proxy->links[1])
+                Append(buffer, (int32_t)object_index.at(proxy->m_clientObject));
+        }
+
+        for (int s = 0; s < 2; s++)
+            buffer.insert(buffer.end(), trees[s].begin(), trees[s].end());
+    }
+
+    // Pairs, in pair cache order, each with the manifolds of its collision algorithm
+    btManifoldArray manifolds;
+    for (int i = 0; i < pairs.size(); i++) {
+        manifolds.resize(0);
+        if (pairs[i].m_algorithm)
+            pairs[i].m_algorithm->getAllContactManifolds(manifolds);
+
+        PairEntry entry;
+        entry.object0 = object_index.at(pairs[i].m_pProxy0->m_clientObject);
+        entry.object1 = object_index.at(pairs[i].m_pProxy1->m_clientObject);
+        entry.num_manifolds = manifolds.size();
+        Append(buffer, entry);
+
+        for (int j = 0; j < manifolds.size(); j++) {
+            ManifoldEntry manifold_entry = {manifolds[j]->m_index1a, manifolds[j]->getNumContacts()};
+            Append(buffer, manifold_entry);
+            for (int k = 0; k < manifold_entry.num_points; k++)
+                Append(buffer, manifolds[j]->getContactPoint(k));
+        }
+    }
+}
+
+bool ChCollisionSystemBullet::CheckContactCache(const char* data, size_t size) const {
+    const btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    ContactCache cache;
+    return ParseContactCache(data, size, objects.size(), dynamic_cast<btDbvtBroadphase*>(bt_broadphase) != nullptr,
+                             cache);
+}
+
+bool ChCollisionSystemBullet::ReadContactCache(const char* data, size_t size) {
+    const btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    int num_objects = objects.size();
+    btDbvtBroadphase* dbvt = dynamic_cast<btDbvtBroadphase*>(bt_broadphase);
+
+    // Parse and validate the cache before modifying the collision world
+    ContactCache cache;
+    if (!ParseContactCache(data, size, num_objects, dbvt != nullptr, cache))
+        return false;
+    const BroadphaseState& state = cache.state;
+    const std::vector<ProxyState>& proxy_states = cache.proxy_states;
+    const std::vector<std::vector<int32_t>>& stages = cache.stages;
+    const std::vector<TreeNode>* trees = cache.trees;
+    const std::vector<SavedPair>& saved_pairs = cache.saved_pairs;
+
+    // Broadphase trees, stage lists, and counters
+    if (dbvt) {
+        std::vector<btDbvtProxy*> proxies(num_objects);
+        for (int i = 0; i < num_objects; i++) {
+            proxies[i] = static_cast<btDbvtProxy*>(objects[i]->getBroadphaseHandle());
+            proxies[i]->m_aabbMin = proxy_states[i].aabb_min;
+            proxies[i]->m_aabbMax = proxy_states[i].aabb_max;
+        }
+
+        for (int s = 0; s < 2; s++) {
+            btDbvt& tree = dbvt->m_sets[s];
+            tree.clear();
+            size_t i = 0;
+            tree.m_root = trees[s].empty() ? 0 : BuildTree(trees[s], i, 0, proxies);
+            tree.m_lkhd = state.lkhd[s];
+            tree.m_leaves = state.leaves[s];
+            tree.m_opath = state.opath[s];
+        }
+
+        for (int s = 0; s <= btDbvtBroadphase::STAGECOUNT; s++) {
+            dbvt->m_stageRoots[s] = stages[s].empty() ? 0 : proxies[stages[s].front()];
+            for (size_t k = 0; k < stages[s].size(); k++) {
+                btDbvtProxy* proxy = proxies[stages[s][k]];
+                proxy->stage = s;
+                proxy->links[0] = k > 0 ? proxies[stages[s][k - 1]] : 0;
+                proxy->links[1] = k + 1 < stages[s].size() ? proxies[stages[s][k + 1]] : 0;
+            }
+        }
+
+        dbvt->m_stageCurrent = state.stage_current;
+        dbvt->m_fupdates = state.fupdates;
+        dbvt->m_dupdates = state.dupdates;
+        dbvt->m_cupdates = state.cupdates;
+        dbvt->m_newpairs = state.newpairs;
+        dbvt->m_fixedleft = state.fixedleft;
+        dbvt->m_pid = state.pid;
+        dbvt->m_cid = state.cid;
+        dbvt->m_gid = state.gid;
+        dbvt->m_needcleanup = state.needcleanup != 0;
+        dbvt->m_updates_call = state.updates_call;
+        dbvt->m_updates_done = state.updates_done;
+        dbvt->m_updates_ratio = state.updates_ratio;
+    }
+
+    // Pairs: remove all current pairs, keeping the collision algorithms of those also in the cache,
+    // and add the saved pairs in their original order.
+    btOverlappingPairCache* pair_cache = bt_broadphase->getOverlappingPairCache();
+    btBroadphasePairArray& pairs = pair_cache->getOverlappingPairArray();
+
+    std::vector<ProxyPair> saved_proxy_pairs(saved_pairs.size());
+    std::set<ProxyPair> saved_set;
+    for (size_t k = 0; k < saved_pairs.size(); k++) {
+        saved_proxy_pairs[k] = MakeProxyPair(objects[saved_pairs[k].entry.object0]->getBroadphaseHandle(),
+                                             objects[saved_pairs[k].entry.object1]->getBroadphaseHandle());
+        saved_set.insert(saved_proxy_pairs[k]);
+    }
+
+    std::map<ProxyPair, btCollisionAlgorithm*> algorithms;
+    for (int i = 0; i < pairs.size(); i++) {
+        ProxyPair key = MakeProxyPair(pairs[i].m_pProxy0, pairs[i].m_pProxy1);
+        if (pairs[i].m_algorithm && saved_set.count(key)) {
+            algorithms[key] = pairs[i].m_algorithm;
+            pairs[i].m_algorithm = 0;
+        }
+    }
+    while (pair_cache->getNumOverlappingPairs() > 0) {
+        btBroadphasePair& pair = pairs[pair_cache->getNumOverlappingPairs() - 1];
+        pair_cache->removeOverlappingPair(pair.m_pProxy0, pair.m_pProxy1, bt_dispatcher);
+    }
+
+    for (const auto& key : saved_proxy_pairs) {
+        btBroadphasePair* pair = pair_cache->addOverlappingPair(key.first, key.second);
+        auto it = algorithms.find(key);
+        if (pair && it != algorithms.end()) {
+            pair->m_algorithm = it->second;
+            algorithms.erase(it);
+        }
+    }
+    for (auto& entry : algorithms) {
+        entry.second->~btCollisionAlgorithm();
+        bt_dispatcher->freeCollisionAlgorithm(entry.second);
+    }
+
+    // Create the collision algorithms (and their manifolds) of pairs that had none
+    bt_dispatcher->dispatchAllCollisionPairs(pair_cache, bt_collision_world->getDispatchInfo(), bt_dispatcher);
+
+    // Manifolds: restore the contact points and the order in the dispatcher. Manifolds without a saved
+    // counterpart are emptied and fill the remaining positions.
+    int num_manifolds = bt_dispatcher->getNumManifolds();
+    btPersistentManifold** dispatcher_manifolds = bt_dispatcher->getInternalManifoldPointer();
+    std::vector<btPersistentManifold*> ordered(num_manifolds, nullptr);
+    std::unordered_set<btPersistentManifold*> restored;
+    std::unordered_set<btPersistentManifold*> placed;
+
+    btManifoldArray manifolds;
+    for (size_t k = 0; k < saved_pairs.size(); k++) {
+        manifolds.resize(0);
+        btBroadphasePair* pair = pair_cache->findPair(saved_proxy_pairs[k].first, saved_proxy_pairs[k].second);
+        if (pair && pair->m_algorithm)
+            pair->m_algorithm->getAllContactManifolds(manifolds);
+
+        for (int j = 0; j < manifolds.size() && j < saved_pairs[k].entry.num_manifolds; j++) {
+            btPersistentManifold* manifold = manifolds[j];
+            const ManifoldEntry& entry = saved_pairs[k].manifolds[j];
+            manifold->clearManifold();
+            for (int i = 0; i < entry.num_points; i++) {
+                btManifoldPoint pt;
+                std::memcpy(&pt, saved_pairs[k].points[j] + i * sizeof(btManifoldPoint), sizeof(btManifoldPoint));
+                pt.m_userPersistentData = 0;
+                manifold->addManifoldPoint(pt);
+            }
+            restored.insert(manifold);
+            if (entry.index >= 0 && entry.index < num_manifolds && !ordered[entry.index]) {
+                ordered[entry.index] = manifold;
+                placed.insert(manifold);
+            }
+        }
+    }
+
+    int slot = 0;
+    for (int k = 0; k < num_manifolds; k++) {
+        btPersistentManifold* manifold = dispatcher_manifolds[k];
+        if (placed.count(manifold))
+            continue;
+        if (!restored.count(manifold))
+            manifold->clearManifold();
+        while (ordered[slot])
+            slot++;
+        ordered[slot] = manifold;
+    }
+    for (int k = 0; k < num_manifolds; k++) {
+        dispatcher_manifolds[k] = ordered[k];
+        dispatcher_manifolds[k]->m_index1a = k;
+    }
+
+    return true;
+}
+
 void ChCollisionSystemBullet::SetContactBreakingThreshold(double threshold) {
     gContactBreakingThreshold = (btScalar)threshold;
 }
@@ -15,6 +15,8 @@
 #ifndef CHC_COLLISIONSYSTEMBULLET_H
 #define CHC_COLLISIONSYSTEMBULLET_H
 
+#include <vector>
+
 #include "chrono/collision/ChCCollisionSystem.h"
 #include "chrono/collision/bullet/btBulletCollisionCommon.h"
 #include "chrono/core/ChApiCE.h"
@@ -62,6 +64,19 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// Return the time (in seconds) for narrowphase collision detection.
     virtual double GetTimerCollisionNarrow() const override;
 
+    /// Write the contact manifolds (contact points and cached reactions) and the state of the collision
+    /// world that determines the order of the contacts: broadphase trees (DBVT broadphase only), broadphase
+    /// pairs, and manifold order in the dispatcher.
+    virtual void WriteContactCache(std::vector<char>& buffer) const override;
+
+    /// Check that the data saved with WriteContactCache matches this collision system.
+    virtual bool CheckContactCache(const char* data, size_t size) const override;
+
+    /// Restore the data saved with WriteContactCache. Collision objects are identified by their index in the
+    /// collision world, so the collision models must have been added in the same order as in the saved system.
+    /// Manifolds with no saved counterpart are emptied.
+    virtual bool ReadContactCache(const char* data, size_t size) override;
+
     /// After the Run() has completed, you can call this function to
     /// fill a 'contact container', that is an object inherited from class
     /// ChContactContainer. For instance ChSystem, after each Run()
@@ -69,8 +84,19 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// The basic behavior of the implementation is the following: collision system
     /// will call in sequence the functions BeginAddContact(), AddContact() (x n times),
     /// EndAddContact() of the contact container.
+    /// If more than one thread was set with SetNumThreads() and no broadphase or narrowphase user callbacks are
+    /// registered, the contact manifolds are processed in parallel and the resulting contacts are passed to the
+    /// container in batches with AddContacts(). The order of the contacts is the same as in the serial case.
     virtual void ReportContacts(ChContactContainer* mcontactcontainer) override;
 
+    /// Set the number of OpenMP threads used in ReportContacts() (default: 1, i.e. serial).
+    /// Parallel reporting is disabled when user callbacks are registered, since these are not required to be
+    /// thread-safe.
+    void SetNumThreads(int nthreads) { num_threads = nthreads; }
+
+    /// Get the number of threads used in ReportContacts().
+    int GetNumThreads() const { return num_threads; }
+
     /// After the Run() has completed, you can call this function to
     /// fill a 'proximity container' (container of narrow phase pairs), that is
     /// an object inherited from class ChProximityContainer. For instance ChSystem, after each Run()
@@ -106,6 +132,10 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
                 short int filter_group,
                 short int filter_mask) const;
 
+    /// Return true if any of the collision models in this system contains concave triangle meshes
+    /// (see ChModelBullet::HasConcaveMeshes). Ray-hit tests must not be performed concurrently in this case.
+    bool HasConcaveMeshes() const;
+
     // For Bullet related stuff
     btCollisionWorld* GetBulletCollisionWorld() { return bt_collision_world; }
 
@@ -115,10 +145,16 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     static void SetContactBreakingThreshold(double threshold);
 
   private:
+    /// Process the contact points of a manifold, appending the resulting contacts to the given batch.
+    void ProcessManifold(btPersistentManifold* contactManifold, std::vector<ChCollisionInfo>& batch);
+
     btCollisionConfiguration* bt_collision_configuration;
     btCollisionDispatcher* bt_dispatcher;
     btBroadphaseInterface* bt_broadphase;
     btCollisionWorld* bt_collision_world;
+
+    int num_threads;                                    ///< number of threads for contact reporting
+    std::vector<std::vector<ChCollisionInfo>> batches;  ///< per-thread contact batches
 };
 
 }  // end namespace collision
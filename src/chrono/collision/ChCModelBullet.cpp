@@ -678,6 +678,14 @@ bool ChModelBullet::AddTriangleMeshConcave(std::shared_ptr<geometry::ChTriangleM
     return true;
 }
 
+bool ChModelBullet::HasConcaveMeshes() const {
+    for (const auto& shape : shapes) {
+        if (shape->getShapeType() == GIMPACT_SHAPE_PROXYTYPE)
+            return true;
+    }
+    return false;
+}
+
 bool ChModelBullet::AddTriangleMeshConcaveDecomposed(std::shared_ptr<ChConvexDecomposition> mydecomposition,
                                                      const ChVector<>& pos,
                                                      const ChMatrix33<>& rot) {
@@ -276,6 +276,10 @@ class ChApi ChModelBullet : public ChCollisionModel {
     /// Return the pointer to the Bullet model
     btCollisionObject* GetBulletModel() { return this->bt_collision_object; }
 
+    /// Return true if the model contains concave triangle meshes (see AddTriangleMeshConcave).
+    /// Note that Bullet ray casts against such meshes modify them, so they must not be performed concurrently.
+    bool HasConcaveMeshes() const;
+
   private:
     void _injectShape(const ChVector<>& pos, const ChMatrix33<>& rot, btCollisionShape* mshape);
 
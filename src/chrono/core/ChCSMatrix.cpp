@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cstdint>
 #include <iomanip>
 
 #include "chrono/core/ChCSMatrix.h"
@@ -129,7 +130,7 @@ void ChCSMatrix::Reset(int nrows, int ncols, int nonzeros_hint) {
 
     if (nonzeros_hint == 0 && lead_dim_new == *leading_dimension && trail_dim_new == *trailing_dimension && m_lock &&
         lead_dim_new != 0 && trail_dim_new != 0) {
-        std::fill(values.begin(), values.begin() + leadIndex[*leading_dimension] - 1, 0);
+        std::fill(values.begin(), values.begin() + leadIndex[*leading_dimension], 0);
     } else {
         if (nonzeros_hint == 0)
             nonzeros_hint = GetTrailingIndexLength();
@@ -181,6 +182,30 @@ bool ChCSMatrix::Compress() {
     return trail_i_dest != trail_i;
 }
 
+size_t ChCSMatrix::GetSparsityPatternHash() {
+    if (!isCompressed)
+        Compress();
+
+    // 64-bit FNV-1a hash of the index arrays
+    uint64_t hash = 14695981039346656037ULL;
+    auto hash_int = [&hash](int val) {
+        for (int k = 0; k < 4; ++k) {
+            hash ^= static_cast<uint64_t>((val >> (8 * k)) & 0xff);
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    hash_int(m_num_rows);
+    hash_int(m_num_cols);
+    hash_int(row_major_format ? 1 : 0);
+    for (auto lead_i = 0; lead_i <= *leading_dimension; ++lead_i)
+        hash_int(leadIndex[lead_i]);
+    for (auto trail_i = 0; trail_i < leadIndex[*leading_dimension]; ++trail_i)
+        hash_int(trailIndex[trail_i]);
+
+    return static_cast<size_t>(hash);
+}
+
 int ChCSMatrix::Inflate(int storage_augm, int lead_sel, int trail_sel) {
     assert(lead_sel >= 0 && lead_sel < *leading_dimension && "Cannot inflate a row(CSR)|column(CSC) that does not exist");
     if (trail_sel == -1)
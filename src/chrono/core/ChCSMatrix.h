@@ -224,6 +224,11 @@ class ChApi ChCSMatrix : public ChSparseMatrix {
     /// Compress the internal arrays and purge all uninitialized elements.
     bool Compress() override;
 
+    /// Return a hash of the sparsity pattern (dimensions, storage order and index arrays), compressing the matrix if
+    /// needed. Matrices with the same sparsity pattern have the same hash, whatever their values; direct solvers use
+    /// this to detect whether the symbolic analysis of a previous factorization can be reused.
+    size_t GetSparsityPatternHash();
+
     /// Add not-initialized element to the matrix. If many new element should be inserted
     /// it can improve the speed.
     int Inflate(int storage_augm, int lead_sel = 0, int trail_sel = -1);
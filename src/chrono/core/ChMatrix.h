@@ -365,7 +365,8 @@ class ChMatrix {
             int tot_elements = GetRows() * GetColumns();
             ChValueSpecific<Real*> specVal(this->address, "data", 0);
             marchive.out_array_pre(specVal, tot_elements);
-            for (int i = 0; i < tot_elements; i++) {
+            bool bulk = marchive.out_array_bulk(specVal, this->address, tot_elements);
+            for (int i = 0; !bulk && i < tot_elements; i++) {
                 marchive << CHNVP(ElementN(i), "");
                 marchive.out_array_between(specVal, tot_elements);
             }
@@ -388,7 +389,8 @@ class ChMatrix {
         // custom input of matrix data as array
         size_t tot_elements = GetRows() * GetColumns();
         marchive.in_array_pre("data", tot_elements);
-        for (int i = 0; i < tot_elements; i++) {
+        bool bulk = marchive.in_array_bulk("data", this->address, tot_elements);
+        for (int i = 0; !bulk && i < tot_elements; i++) {
             marchive >> CHNVP(ElementN(i));
             marchive.in_array_between("data");
         }
@@ -384,6 +384,17 @@ class ChQuaternion {
 
 CH_CLASS_VERSION(ChQuaternion<double>, 0)
 
+/// Arrays of ChQuaternion objects are transferred as blocks of numbers by archives that support it.
+template <class Real>
+struct ChArchiveBulkTraits<ChQuaternion<Real>> {
+    static_assert(sizeof(ChQuaternion<Real>) == 4 * sizeof(Real), "unexpected ChQuaternion layout");
+    static const bool value = ChArchiveBulkTraits<Real>::value;
+    typedef Real scalar;
+    static const size_t components = 4;
+    static const bool versioned = true;
+    typedef ChQuaternion<double> version_class;
+};
+
 // -----------------------------------------------------------------------------
 
 /// Shortcut for faster use of typical double-precision quaternion.
@@ -0,0 +1,687 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Sparse multifrontal LDL' factorization.
+//
+// References:
+// - P.R. Amestoy, T.A. Davis, I.S. Duff, "An approximate minimum degree ordering
+//   algorithm", SIAM J. Matrix Anal. Appl. 17(4), 1996.
+// - J.W.H. Liu, "The multifrontal method for sparse matrix solution: theory and
+//   practice", SIAM Review 34(1), 1992.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+#include "chrono/core/ChSparseLDL.h"
+#include "chrono/parallel/ChTaskScheduler.h"
+
+namespace chrono {
+
+// Minimum number of flops in the update of a front for it to be performed in parallel.
+static const double PARALLEL_UPDATE_FLOPS = 2e6;
+
+ChSparseLDL::ChSparseLDL()
+    : m_n(0),
+      m_nnz_A(0),
+      m_nnz_L(0),
+      m_flops(0),
+      m_pivot_eps(1e-10),
+      m_parallel(true),
+      m_analyzed(false),
+      m_num_perturbed(0) {}
+
+// -----------------------------------------------------------------------------
+// Ordering
+// -----------------------------------------------------------------------------
+
+// Minimum degree ordering on the quotient graph, with the approximate external degrees of AMD and aggressive
+// element absorption (no supervariable detection). Variables and elements share the index space: when variable
+// p is eliminated, it becomes element p, whose adjacency le[p] is the set of variables connected to p.
+// A delayed variable becomes eligible only when all its non-delayed neighbors have been eliminated: for a KKT
+// matrix with SPD stiffness block and independent constraints, all the pivots are then nonzero.
+void ChSparseLDL::OrderAMD(const std::vector<std::vector<int>>& adj,
+                           const std::vector<bool>& delay,
+                           std::vector<int>& order) {
+    enum Status { VARIABLE, ELEMENT, ABSORBED };
+
+    int n = (int)adj.size();
+    order.resize(n);
+
+    std::vector<std::vector<int>> vars(adj);  // adjacent variables
+    std::vector<std::vector<int>> elems(n);   // adjacent elements
+    std::vector<std::vector<int>> le(n);      // variables in each element
+    std::vector<char> status(n, VARIABLE);
+    std::vector<bool> delayed(delay);
+    std::vector<int> pending(n, 0);  // non-delayed neighbors of delayed variables, not yet eliminated
+    for (int i = 0; i < n; i++)
+        if (delayed[i])
+            for (int v : adj[i])
+                if (!delay[v])
+                    pending[i]++;
+    std::vector<int> degree(n);
+    std::vector<int> mark(n, -1);
+    std::vector<int> wtag(n, -1);
+    std::vector<int> w(n, 0);
+
+    typedef std::pair<int, int> Entry;  // (degree, variable)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for (int i = 0; i < n; i++) {
+        degree[i] = (int)vars[i].size();
+        queue.push(Entry(degree[i], i));
+    }
+
+    int k = 0;
+    while (k < n) {
+        if (queue.empty()) {
+            // Only delayed variables adjacent to other delayed variables are left
+            for (int i = 0; i < n; i++) {
+                if (status[i] == VARIABLE) {
+                    delayed[i] = false;
+                    queue.push(Entry(degree[i], i));
+                }
+            }
+        }
+
+        int p = queue.top().second;
+        int d = queue.top().first;
+        queue.pop();
+        if (status[p] != VARIABLE || d != degree[p])
+            continue;  // stale entry
+        if (delayed[p] && pending[p] > 0)
+            continue;  // re-inserted when a neighbor is eliminated
+
+        // Eliminate p and form the new element Lp
+        order[k++] = p;
+        status[p] = ELEMENT;
+        if (!delay[p])
+            for (int v : adj[p])
+                if (delayed[v])
+                    pending[v]--;
+
+        std::vector<int> lp;
+        mark[p] = p;
+        for (int v : vars[p]) {
+            if (status[v] == VARIABLE && mark[v] != p) {
+                mark[v] = p;
+                lp.push_back(v);
+            }
+        }
+        for (int e : elems[p]) {
+            if (status[e] != ELEMENT)
+                continue;
+            for (int v : le[e]) {
+                if (status[v] == VARIABLE && mark[v] != p) {
+                    mark[v] = p;
+                    lp.push_back(v);
+                }
+            }
+            status[e] = ABSORBED;
+            std::vector<int>().swap(le[e]);
+        }
+        std::vector<int>().swap(vars[p]);
+        std::vector<int>().swap(elems[p]);
+
+        // Update the adjacency of the variables in Lp: variables in Lp are now reached through element p
+        for (int i : lp) {
+            auto& vi = vars[i];
+            vi.erase(std::remove_if(vi.begin(), vi.end(),
+                                    [&](int v) { return v == p || status[v] != VARIABLE || mark[v] == p; }),
+                     vi.end());
+            auto& ei = elems[i];
+            ei.erase(std::remove_if(ei.begin(), ei.end(), [&](int e) { return status[e] != ELEMENT; }), ei.end());
+            ei.push_back(p);
+        }
+        le[p] = lp;
+
+        // Compute |Le \ Lp| for all elements adjacent to Lp
+        for (int i : lp) {
+            for (int e : elems[i]) {
+                if (e == p || status[e] != ELEMENT)
+                    continue;
+                if (wtag[e] != p) {
+                    wtag[e] = p;
+                    w[e] = (int)le[e].size();
+                }
+                w[e]--;
+            }
+        }
+
+        // Approximate external degrees, with aggressive absorption of the elements contained in Lp
+        int remaining = n - k;
+        int lp_size = (int)lp.size();
+        for (int i : lp) {
+            int deg = (int)vars[i].size() + lp_size - 1;
+            for (int e : elems[i]) {
+                if (e == p || status[e] != ELEMENT)
+                    continue;
+                if (w[e] > 0)
+                    deg += w[e];
+                else
+                    status[e] = ABSORBED;
+            }
+            degree[i] = std::min(deg, remaining - 1);
+            queue.push(Entry(degree[i], i));
+        }
+    }
+}
+
+// Elimination tree (Liu's algorithm, with path compression).
+void ChSparseLDL::EliminationTree(const std::vector<std::vector<int>>& adj, std::vector<int>& parent) {
+    int n = (int)adj.size();
+    parent.assign(n, -1);
+    std::vector<int> ancestor(n, -1);
+    for (int k = 0; k < n; k++) {
+        for (int i : adj[k]) {
+            while (i != -1 && i < k) {
+                int next = ancestor[i];
+                ancestor[i] = k;
+                if (next == -1)
+                    parent[i] = k;
+                i = next;
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Symbolic analysis
+// -----------------------------------------------------------------------------
+
+bool ChSparseLDL::Analyze(const ChCSMatrix& A) {
+    m_analyzed = false;
+    if (A.GetNumRows() != A.GetNumColumns())
+        return false;
+
+    int n = A.GetNumRows();
+    const int* lead = A.GetCS_LeadingIndexArray();
+    const int* trail = A.GetCS_TrailingIndexArray();
+    const double* values = A.GetCS_ValueArray();
+    bool row_major = A.IsRowMajor();
+    m_n = n;
+    m_nnz_A = lead[n];
+
+    // Symmetrized adjacency graph, and zero diagonal entries
+    std::vector<std::vector<int>> adj(n);
+    std::vector<bool> zero_diag(n, true);
+    for (int l = 0; l < n; l++) {
+        for (int e = lead[l]; e < lead[l + 1]; e++) {
+            int t = trail[e];
+            if (t == l) {
+                zero_diag[l] = (values[e] == 0);
+            } else {
+                adj[l].push_back(t);
+                adj[t].push_back(l);
+            }
+        }
+    }
+    for (auto& a : adj) {
+        std::sort(a.begin(), a.end());
+        a.erase(std::unique(a.begin(), a.end()), a.end());
+    }
+
+    // Fill-reducing ordering
+    std::vector<int> order;
+    OrderAMD(adj, zero_diag, order);
+
+    auto permute = [&](const std::vector<int>& perm, std::vector<std::vector<int>>& adjn) {
+        m_pinv.resize(n);
+        for (int k = 0; k < n; k++)
+            m_pinv[perm[k]] = k;
+        adjn.assign(n, std::vector<int>());
+        for (int k = 0; k < n; k++) {
+            adjn[k].reserve(adj[perm[k]].size());
+            for (int j : adj[perm[k]])
+                adjn[k].push_back(m_pinv[j]);
+        }
+    };
+
+    std::vector<std::vector<int>> adjn;
+    std::vector<int> parent;
+    permute(order, adjn);
+    EliminationTree(adjn, parent);
+
+    // Postorder the elimination tree, so that subtrees are contiguous
+    std::vector<int> head(n, -1);
+    std::vector<int> next(n, -1);
+    for (int j = n - 1; j >= 0; j--) {
+        if (parent[j] != -1) {
+            next[j] = head[parent[j]];
+            head[parent[j]] = j;
+        }
+    }
+    std::vector<int> post;
+    post.reserve(n);
+    std::vector<int> stack;
+    for (int r = 0; r < n; r++) {
+        if (parent[r] != -1)
+            continue;
+        stack.push_back(r);
+        while (!stack.empty()) {
+            int j = stack.back();
+            int c = head[j];
+            if (c == -1) {
+                post.push_back(j);
+                stack.pop_back();
+            } else {
+                head[j] = next[c];
+                stack.push_back(c);
+            }
+        }
+    }
+
+    m_perm.resize(n);
+    for (int k = 0; k < n; k++)
+        m_perm[k] = order[post[k]];
+    permute(m_perm, adjn);
+    EliminationTree(adjn, parent);
+
+    // Column counts of L (row subtrees)
+    std::vector<int> colcount(n, 1);
+    std::vector<int> mark(n, -1);
+    for (int k = 0; k < n; k++) {
+        mark[k] = k;
+        for (int i : adjn[k]) {
+            while (i < k && mark[i] != k) {
+                colcount[i]++;
+                mark[i] = k;
+                i = parent[i];
+            }
+        }
+    }
+    m_nnz_L = 0;
+    for (int j = 0; j < n; j++)
+        m_nnz_L += colcount[j];
+
+    // Fundamental supernodes
+    std::vector<int> nchild(n, 0);
+    for (int j = 0; j < n; j++)
+        if (parent[j] != -1)
+            nchild[parent[j]]++;
+    m_sn_first.clear();
+    for (int j = 0; j < n; j++) {
+        bool merge = j > 0 && parent[j - 1] == j && nchild[j] == 1 && colcount[j - 1] == colcount[j] + 1;
+        if (!merge)
+            m_sn_first.push_back(j);
+    }
+    int ns = (int)m_sn_first.size();
+    m_sn_first.push_back(n);
+
+    std::vector<int> snode(n);
+    for (int s = 0; s < ns; s++)
+        for (int j = m_sn_first[s]; j < m_sn_first[s + 1]; j++)
+            snode[j] = s;
+
+    m_sn_parent.resize(ns);
+    m_sn_child_ptr.assign(ns + 1, 0);
+    for (int s = 0; s < ns; s++) {
+        int p = parent[m_sn_first[s + 1] - 1];
+        m_sn_parent[s] = (p == -1) ? -1 : snode[p];
+        if (p != -1)
+            m_sn_child_ptr[m_sn_parent[s] + 1]++;
+    }
+    for (int s = 0; s < ns; s++)
+        m_sn_child_ptr[s + 1] += m_sn_child_ptr[s];
+    m_sn_child.resize(m_sn_child_ptr[ns]);
+    std::vector<int> fill(m_sn_child_ptr.begin(), m_sn_child_ptr.end() - 1);
+    for (int s = 0; s < ns; s++)
+        if (m_sn_parent[s] != -1)
+            m_sn_child[fill[m_sn_parent[s]]++] = s;
+
+    m_sn_first_desc.resize(ns);
+    for (int s = 0; s < ns; s++)
+        m_sn_first_desc[s] = s;
+    for (int s = 0; s < ns; s++)
+        if (m_sn_parent[s] != -1)
+            m_sn_first_desc[m_sn_parent[s]] = std::min(m_sn_first_desc[m_sn_parent[s]], m_sn_first_desc[s]);
+
+    // Row structure of the supernodes and relative positions of the update rows in the parent fronts
+    m_sn_rows.clear();
+    m_sn_rows.reserve(m_nnz_L);
+    m_sn_rows_ptr.assign(ns + 1, 0);
+    m_sn_L_ptr.assign(ns + 1, 0);
+    m_sn_cost.resize(ns);
+    m_flops = 0;
+    std::vector<int> local(n, -1);
+    std::fill(mark.begin(), mark.end(), -1);
+    for (int s = 0; s < ns; s++) {
+        int first = m_sn_first[s];
+        int last = m_sn_first[s + 1] - 1;
+        size_t start = m_sn_rows.size();
+        for (int j = first; j <= last; j++) {
+            m_sn_rows.push_back(j);
+            mark[j] = s;
+        }
+        for (int j = first; j <= last; j++) {
+            for (int i : adjn[j]) {
+                if (i > last && mark[i] != s) {
+                    mark[i] = s;
+                    m_sn_rows.push_back(i);
+                }
+            }
+        }
+        for (int ic = m_sn_child_ptr[s]; ic < m_sn_child_ptr[s + 1]; ic++) {
+            int c = m_sn_child[ic];
+            int wc = m_sn_first[c + 1] - m_sn_first[c];
+            for (size_t r = m_sn_rows_ptr[c] + wc; r < m_sn_rows_ptr[c + 1]; r++) {
+                int i = m_sn_rows[r];
+                if (i > last && mark[i] != s) {
+                    mark[i] = s;
+                    m_sn_rows.push_back(i);
+                }
+            }
+        }
+        std::sort(m_sn_rows.begin() + start + (last - first + 1), m_sn_rows.end());
+        m_sn_rows_ptr[s + 1] = m_sn_rows.size();
+
+        size_t m = m_sn_rows_ptr[s + 1] - m_sn_rows_ptr[s];
+        size_t w = last - first + 1;
+        m_sn_L_ptr[s + 1] = m_sn_L_ptr[s] + m * w;
+
+        double cost = 0;
+        for (size_t j = 0; j < w; j++)
+            cost += (double)(m - j) * (m - j);
+        m_sn_cost[s] = cost;
+        m_flops += cost;
+    }
+
+    m_sn_rel.assign(m_sn_rows.size(), -1);
+    for (int s = 0; s < ns; s++) {
+        for (size_t r = m_sn_rows_ptr[s]; r < m_sn_rows_ptr[s + 1]; r++)
+            local[m_sn_rows[r]] = (int)(r - m_sn_rows_ptr[s]);
+        for (int ic = m_sn_child_ptr[s]; ic < m_sn_child_ptr[s + 1]; ic++) {
+            int c = m_sn_child[ic];
+            int wc = m_sn_first[c + 1] - m_sn_first[c];
+            for (size_t r = m_sn_rows_ptr[c] + wc; r < m_sn_rows_ptr[c + 1]; r++)
+                m_sn_rel[r] = local[m_sn_rows[r]];
+        }
+    }
+
+    // Scatter map of the entries in the lower triangle (in the new ordering), grouped by column
+    std::vector<int> entry_row(m_nnz_A, -1);
+    m_a_ptr.assign(n + 1, 0);
+    for (int l = 0; l < n; l++) {
+        for (int e = lead[l]; e < lead[l + 1]; e++) {
+            int r = row_major ? l : trail[e];
+            int c = row_major ? trail[e] : l;
+            int ni = m_pinv[r];
+            int nj = m_pinv[c];
+            if (ni >= nj) {
+                entry_row[e] = ni;
+                m_a_ptr[nj + 1]++;
+            }
+        }
+    }
+    for (int j = 0; j < n; j++)
+        m_a_ptr[j + 1] += m_a_ptr[j];
+    m_a_entry.resize(m_a_ptr[n]);
+    m_a_pos.resize(m_a_ptr[n]);
+    fill.assign(m_a_ptr.begin(), m_a_ptr.end() - 1);
+    for (int l = 0; l < n; l++) {
+        for (int e = lead[l]; e < lead[l + 1]; e++) {
+            if (entry_row[e] == -1)
+                continue;
+            int c = row_major ? trail[e] : l;
+            m_a_entry[fill[m_pinv[c]]++] = e;
+        }
+    }
+    for (int s = 0; s < ns; s++) {
+        int first = m_sn_first[s];
+        size_t m = m_sn_rows_ptr[s + 1] - m_sn_rows_ptr[s];
+        for (size_t r = m_sn_rows_ptr[s]; r < m_sn_rows_ptr[s + 1]; r++)
+            local[m_sn_rows[r]] = (int)(r - m_sn_rows_ptr[s]);
+        for (int j = first; j < m_sn_first[s + 1]; j++)
+            for (int k = m_a_ptr[j]; k < m_a_ptr[j + 1]; k++)
+                m_a_pos[k] = m_sn_L_ptr[s] + (j - first) * m + local[entry_row[m_a_entry[k]]];
+    }
+
+    // Parallel schedule: split the tree from the roots down, until the subtrees are small enough to balance
+    // the load among the threads; the supernodes above the subtrees are processed last.
+    int nthreads = ChTaskScheduler::GetInstance().GetNumThreads();
+    std::vector<double> subtree_cost(m_sn_cost);
+    for (int s = 0; s < ns; s++)
+        if (m_sn_parent[s] != -1)
+            subtree_cost[m_sn_parent[s]] += subtree_cost[s];
+
+    m_subtrees.clear();
+    m_top.clear();
+    for (int s = 0; s < ns; s++)
+        if (m_sn_parent[s] == -1)
+            m_subtrees.push_back(s);
+    if (nthreads > 1) {
+        double max_cost = m_flops / (2 * nthreads);
+        while (!m_subtrees.empty() && (int)m_subtrees.size() < 8 * nthreads) {
+            auto largest = std::max_element(m_subtrees.begin(), m_subtrees.end(), [&](int a, int b) {
+                return subtree_cost[a] < subtree_cost[b];
+            });
+            if (subtree_cost[*largest] <= max_cost)
+                break;
+            int s = *largest;
+            m_subtrees.erase(largest);
+            m_top.push_back(s);
+            for (int ic = m_sn_child_ptr[s]; ic < m_sn_child_ptr[s + 1]; ic++)
+                m_subtrees.push_back(m_sn_child[ic]);
+        }
+        std::sort(m_top.begin(), m_top.end());
+        std::sort(m_subtrees.begin(), m_subtrees.end(),
+                  [&](int a, int b) { return subtree_cost[a] > subtree_cost[b]; });
+    }
+
+    m_L.assign(m_sn_L_ptr[ns], 0.0);
+    m_D.assign(n, 0.0);
+    m_update.assign(ns, std::vector<double>());
+    m_analyzed = true;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// Numeric factorization
+// -----------------------------------------------------------------------------
+
+bool ChSparseLDL::Factorize(const ChCSMatrix& A) {
+    if (!m_analyzed || A.GetNumRows() != m_n || A.GetNumColumns() != m_n)
+        return false;
+    const double* Ax = A.GetCS_ValueArray();
+    if (A.GetCS_LeadingIndexArray()[m_n] != m_nnz_A)
+        return false;
+
+    double anorm = 0;
+    for (int e = 0; e < m_nnz_A; e++)
+        anorm = std::max(anorm, std::abs(Ax[e]));
+    double threshold = m_pivot_eps * (anorm > 0 ? anorm : 1);
+
+    auto& scheduler = ChTaskScheduler::GetInstance();
+    bool parallel = m_parallel && scheduler.GetNumThreads() > 1;
+
+    m_num_perturbed = 0;
+    if (!parallel || m_subtrees.size() < 2) {
+        FactorizeRange(0, GetNumSupernodes() - 1, Ax, threshold, m_num_perturbed);
+        return true;
+    }
+
+    std::vector<int> num_perturbed(m_subtrees.size(), 0);
+    {
+        ChTaskScheduler::TaskGroup group(scheduler);
+        for (size_t i = 0; i < m_subtrees.size(); i++) {
+            int root = m_subtrees[i];
+            group.Run([this, i, root, Ax, threshold, &num_perturbed]() {
+                FactorizeRange(m_sn_first_desc[root], root, Ax, threshold, num_perturbed[i]);
+            });
+        }
+        group.Wait();
+    }
+    for (int count : num_perturbed)
+        m_num_perturbed += count;
+
+    for (int s : m_top)
+        FactorizeSupernode(s, Ax, threshold, true, m_num_perturbed);
+
+    return true;
+}
+
+void ChSparseLDL::FactorizeRange(int first, int last, const double* Ax, double threshold, int& num_perturbed) {
+    for (int s = first; s <= last; s++)
+        FactorizeSupernode(s, Ax, threshold, false, num_perturbed);
+}
+
+void ChSparseLDL::FactorizeSupernode(int s,
+                                     const double* Ax,
+                                     double threshold,
+                                     bool parallel_update,
+                                     int& num_perturbed) {
+    int first = m_sn_first[s];
+    int w = m_sn_first[s + 1] - first;
+    int m = (int)(m_sn_rows_ptr[s + 1] - m_sn_rows_ptr[s]);
+    int mu = m - w;
+    double* L = m_L.data() + m_sn_L_ptr[s];
+    double* D = m_D.data() + first;
+
+    // Assemble the front: columns of the supernode (stored in place in L) and update matrix
+    std::fill(L, L + (size_t)m * w, 0.0);
+    std::vector<double>& U = m_update[s];
+    U.assign((size_t)mu * mu, 0.0);
+
+    for (int k = m_a_ptr[first]; k < m_a_ptr[first + w]; k++)
+        m_L[m_a_pos[k]] += Ax[m_a_entry[k]];
+
+    for (int ic = m_sn_child_ptr[s]; ic < m_sn_child_ptr[s + 1]; ic++) {
+        int c = m_sn_child[ic];
+        int wc = m_sn_first[c + 1] - m_sn_first[c];
+        int muc = (int)(m_sn_rows_ptr[c + 1] - m_sn_rows_ptr[c]) - wc;
+        const int* rel = m_sn_rel.data() + m_sn_rows_ptr[c] + wc;
+        const std::vector<double>& Uc = m_update[c];
+        for (int jj = 0; jj < muc; jj++) {
+            int pc = rel[jj];
+            const double* ucol = Uc.data() + (size_t)jj * muc;
+            if (pc < w) {
+                double* col = L + (size_t)pc * m;
+                for (int ii = jj; ii < muc; ii++)
+                    col[rel[ii]] += ucol[ii];
+            } else {
+                double* col = U.data() + (size_t)(pc - w) * mu - w;
+                for (int ii = jj; ii < muc; ii++)
+                    col[rel[ii]] += ucol[ii];
+            }
+        }
+        std::vector<double>().swap(m_update[c]);
+    }
+
+    // Partial LDL' factorization of the front (left-looking over the columns of the supernode)
+    for (int j = 0; j < w; j++) {
+        double* Lj = L + (size_t)j * m;
+        for (int k = 0; k < j; k++) {
+            const double* Lk = L + (size_t)k * m;
+            double f = Lk[j] * D[k];
+            if (f == 0)
+                continue;
+            for (int i = j; i < m; i++)
+                Lj[i] -= f * Lk[i];
+        }
+        double d = Lj[j];
+        if (std::abs(d) < threshold) {
+            d = (d < 0) ? -threshold : threshold;
+            num_perturbed++;
+        }
+        D[j] = d;
+        double inv = 1 / d;
+        for (int i = j + 1; i < m; i++)
+            Lj[i] *= inv;
+    }
+
+    // Update matrix: U -= L21 * D * L21'  (lower triangle)
+    if (mu == 0)
+        return;
+    auto update = [&](int from, int to) {
+        for (int jj = from; jj < to; jj++) {
+            double* Ucol = U.data() + (size_t)jj * mu;
+            for (int k = 0; k < w; k++) {
+                const double* Lk = L + (size_t)k * m + w;
+                double f = Lk[jj] * D[k];
+                if (f == 0)
+                    continue;
+                for (int ii = jj; ii < mu; ii++)
+                    Ucol[ii] -= f * Lk[ii];
+            }
+        }
+    };
+    if (parallel_update && (double)mu * mu * w > PARALLEL_UPDATE_FLOPS)
+        ChTaskScheduler::GetInstance().ParallelFor(0, mu, 0, update);
+    else
+        update(0, mu);
+}
+
+// -----------------------------------------------------------------------------
+// Solution
+// -----------------------------------------------------------------------------
+
+void ChSparseLDL::Solve(const ChMatrix<>& b, ChMatrix<>& x) const {
+    assert(b.GetRows() == m_n && x.GetRows() == m_n);
+    if (&x != &b)
+        for (int i = 0; i < m_n; i++)
+            x(i) = b(i);
+    Solve(x.GetAddress());
+}
+
+void ChSparseLDL::Solve(double* x) const {
+    int n = m_n;
+    int ns = GetNumSupernodes();
+    std::vector<double> y(n);
+    for (int k = 0; k < n; k++)
+        y[k] = x[m_perm[k]];
+
+    // Forward substitution: L y = b
+    for (int s = 0; s < ns; s++) {
+        int first = m_sn_first[s];
+        int w = m_sn_first[s + 1] - first;
+        int m = (int)(m_sn_rows_ptr[s + 1] - m_sn_rows_ptr[s]);
+        const int* rows = m_sn_rows.data() + m_sn_rows_ptr[s];
+        const double* L = m_L.data() + m_sn_L_ptr[s];
+        for (int j = 0; j < w; j++) {
+            double yj = y[first + j];
+            if (yj == 0)
+                continue;
+            const double* Lj = L + (size_t)j * m;
+            for (int i = j + 1; i < m; i++)
+                y[rows[i]] -= Lj[i] * yj;
+        }
+    }
+
+    // Diagonal: D z = y
+    for (int k = 0; k < n; k++)
+        y[k] /= m_D[k];
+
+    // Backward substitution: L' x = z
+    for (int s = ns - 1; s >= 0; s--) {
+        int first = m_sn_first[s];
+        int w = m_sn_first[s + 1] - first;
+        int m = (int)(m_sn_rows_ptr[s + 1] - m_sn_rows_ptr[s]);
+        const int* rows = m_sn_rows.data() + m_sn_rows_ptr[s];
+        const double* L = m_L.data() + m_sn_L_ptr[s];
+        for (int j = w - 1; j >= 0; j--) {
+            const double* Lj = L + (size_t)j * m;
+            double sum = y[first + j];
+            for (int i = j + 1; i < m; i++)
+                sum -= Lj[i] * y[rows[i]];
+            y[first + j] = sum;
+        }
+    }
+
+    for (int k = 0; k < n; k++)
+        x[m_perm[k]] = y[k];
+}
+
+}  // end namespace chrono
@@ -0,0 +1,148 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSPARSELDL_H
+#define CHSPARSELDL_H
+
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrix.h"
+
+namespace chrono {
+
+/// @addtogroup chrono
+/// @{
+
+/// Sparse direct LDL' factorization of symmetric (possibly indefinite) matrices, such as the KKT matrices
+/// assembled by ChSystemDescriptor::ConvertToMatrixForm.
+///
+/// The factorization is split in two phases:
+/// - Analyze() computes a fill-reducing ordering (approximate minimum degree), the elimination tree and the
+///   supernodal structure of the factor; it depends only on the sparsity pattern of the matrix;
+/// - Factorize() computes the numeric factorization with the multifrontal method, reusing the last analysis.
+///   Independent subtrees of the elimination tree, as well as the dense updates of the largest fronts, are
+///   processed in parallel on the process-wide ChTaskScheduler.
+///
+/// Only the lower triangle of the matrix (in the fill-reducing ordering) is used: the matrix is assumed to be
+/// symmetric. No dynamic pivoting is performed; instead, pivots that are too small in magnitude are replaced
+/// by a small value with the same sign (static pivoting), and the number of such perturbations is reported.
+/// The solution of a perturbed system should be improved by iterative refinement against the original matrix
+/// (as done in ChSolverSparseLDL). Zero diagonal entries (such as the ones of bilateral constraints in KKT
+/// matrices) are ordered after all their neighbors with nonzero diagonal, so that they are not used as pivots
+/// before they are filled.
+class ChApi ChSparseLDL {
+  public:
+    ChSparseLDL();
+    ~ChSparseLDL() {}
+
+    /// Perform the symbolic analysis of the given square matrix (ordering and structure of the factor).
+    /// The values of the matrix are used only to detect zero diagonal entries.
+    /// Return false if the matrix is not square.
+    bool Analyze(const ChCSMatrix& A);
+
+    /// Perform the numeric factorization of the given matrix, which must have the sparsity pattern of the
+    /// matrix passed to the last call to Analyze().
+    /// Return false if no analysis was performed or the matrix size does not match.
+    bool Factorize(const ChCSMatrix& A);
+
+    /// Solve the system A*x = b using the current factorization; x and b can be the same matrix.
+    void Solve(const ChMatrix<>& b, ChMatrix<>& x) const;
+
+    /// Solve in place, overwriting the right-hand side with the solution.
+    void Solve(double* x) const;
+
+    /// Set the relative threshold for static pivoting (default: 1e-10): pivots smaller in magnitude than
+    /// this value, times the largest entry of the matrix, are perturbed.
+    void SetPivotPerturbation(double eps) { m_pivot_eps = eps; }
+
+    /// Enable/disable the use of multiple threads in Factorize() (default: true).
+    void SetParallel(bool val) { m_parallel = val; }
+
+    /// Return the size of the analyzed matrix.
+    int GetSize() const { return m_n; }
+
+    /// Return the number of non-zeros in the factor L (including the unit diagonal).
+    size_t GetNNZ_L() const { return m_nnz_L; }
+
+    /// Return the number of supernodes.
+    int GetNumSupernodes() const { return (int)m_sn_first.size() - 1; }
+
+    /// Return the number of floating point operations for a numeric factorization.
+    double GetFactorizationFlops() const { return m_flops; }
+
+    /// Return the number of perturbed pivots in the last numeric factorization.
+    int GetNumPerturbedPivots() const { return m_num_perturbed; }
+
+    /// Return the fill-reducing permutation (new index -> original index).
+    const std::vector<int>& GetPermutation() const { return m_perm; }
+
+  private:
+    /// Approximate minimum degree ordering of the symmetric graph in 'adj' (no self loops).
+    /// Nodes flagged in 'delay' are eliminated only after all their neighbors that are not flagged.
+    static void OrderAMD(const std::vector<std::vector<int>>& adj,
+                         const std::vector<bool>& delay,
+                         std::vector<int>& order);
+
+    /// Compute the elimination tree of the graph 'adj' in the current numbering.
+    static void EliminationTree(const std::vector<std::vector<int>>& adj, std::vector<int>& parent);
+
+    /// Factorize supernode s: assemble the front, perform the partial LDL' and compute its update matrix.
+    void FactorizeSupernode(int s, const double* Ax, double threshold, bool parallel_update, int& num_perturbed);
+
+    /// Factorize the supernodes in [first, last] in sequence.
+    void FactorizeRange(int first, int last, const double* Ax, double threshold, int& num_perturbed);
+
+    int m_n;                    ///< matrix size
+    int m_nnz_A;                ///< number of stored entries in the analyzed matrix
+    size_t m_nnz_L;             ///< non-zeros in L
+    double m_flops;             ///< factorization flops
+    double m_pivot_eps;         ///< relative threshold for static pivoting
+    bool m_parallel;            ///< use multiple threads?
+    bool m_analyzed;            ///< is there a valid analysis?
+    int m_num_perturbed;        ///< number of perturbed pivots
+    std::vector<int> m_perm;    ///< permutation: new -> original
+    std::vector<int> m_pinv;    ///< inverse permutation: original -> new
+
+    // Supernodal structure (supernodes in postorder, i.e. children before parents)
+    std::vector<int> m_sn_first;       ///< first column of each supernode (plus end marker)
+    std::vector<int> m_sn_parent;      ///< parent supernode (-1 for roots)
+    std::vector<int> m_sn_child_ptr;   ///< children of each supernode: start in m_sn_child (plus end marker)
+    std::vector<int> m_sn_child;       ///< children of each supernode
+    std::vector<int> m_sn_first_desc;  ///< first supernode in the subtree of each supernode
+    std::vector<size_t> m_sn_rows_ptr; ///< row indices of each supernode: start in m_sn_rows (plus end marker)
+    std::vector<int> m_sn_rows;        ///< row indices of each supernode (its columns first, then sorted)
+    std::vector<int> m_sn_rel;         ///< for each supernode, local positions in the parent of its update rows
+    std::vector<size_t> m_sn_L_ptr;    ///< dense block of each supernode: start in m_L (plus end marker)
+    std::vector<double> m_sn_cost;     ///< factorization flops of each supernode
+
+    // Scatter map of the matrix entries in the lower triangle, grouped by (new) column
+    std::vector<int> m_a_ptr;     ///< start of each column (plus end marker)
+    std::vector<int> m_a_entry;   ///< index of the entry in the value array of the matrix
+    std::vector<size_t> m_a_pos;  ///< position of the entry in m_L
+
+    // Parallel schedule: subtrees processed concurrently, followed by the remaining (top) supernodes
+    std::vector<int> m_subtrees;  ///< roots of the independent subtrees
+    std::vector<int> m_top;       ///< supernodes above the subtrees, in postorder
+
+    // Numeric factor
+    std::vector<double> m_L;                    ///< dense column-major blocks of L (unit diagonal not used)
+    std::vector<double> m_D;                    ///< diagonal D (new numbering)
+    std::vector<std::vector<double>> m_update;  ///< pending update matrices of the fronts
+};
+
+/// @} chrono
+
+}  // end namespace chrono
+
+#endif
@@ -10,6 +10,7 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <cstdarg>
 #include <cerrno>
@@ -19,6 +20,10 @@
 #include "chrono/core/ChException.h"
 #include "chrono/core/ChLog.h"
 
+#ifdef CHRONO_HAS_ZLIB
+#include <zlib.h>
+#endif
+
 namespace chrono {
 
 // ChStreamOutAscii
@@ -503,6 +508,37 @@ void ChStreamOutBinary::VersionWrite(int mver) {
     *this << mver;
 }
 
+// On big-endian machines, values are byte-swapped through a buffer of limited size.
+template <typename T>
+void ChStreamOutBinary::WriteArrayImpl(const T* data, size_t n) {
+    if (!big_endian_machine) {
+        this->Output((const char*)data, n * sizeof(T));
+        return;
+    }
+    const size_t chunk = 1024;
+    T tmp[chunk];
+    for (size_t start = 0; start < n; start += chunk) {
+        size_t count = std::min(chunk, n - start);
+        for (size_t i = 0; i < count; i++) {
+            tmp[i] = data[start + i];
+            StreamSwapBytes<T>(&tmp[i]);
+        }
+        this->Output((const char*)tmp, count * sizeof(T));
+    }
+}
+
+void ChStreamOutBinary::WriteArray(const double* data, size_t n) {
+    WriteArrayImpl(data, n);
+}
+
+void ChStreamOutBinary::WriteArray(const float* data, size_t n) {
+    WriteArrayImpl(data, n);
+}
+
+void ChStreamOutBinary::WriteArray(const int* data, size_t n) {
+    WriteArrayImpl(data, n);
+}
+
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 //
@@ -641,6 +677,27 @@ int ChStreamInBinary::VersionRead() {
     return mres;
 }
 
+template <typename T>
+void ChStreamInBinary::ReadArrayImpl(T* data, size_t n) {
+    this->Input((char*)data, n * sizeof(T));
+    if (big_endian_machine) {
+        for (size_t i = 0; i < n; i++)
+            StreamSwapBytes<T>(&data[i]);
+    }
+}
+
+void ChStreamInBinary::ReadArray(double* data, size_t n) {
+    ReadArrayImpl(data, n);
+}
+
+void ChStreamInBinary::ReadArray(float* data, size_t n) {
+    ReadArrayImpl(data, n);
+}
+
+void ChStreamInBinary::ReadArray(int* data, size_t n) {
+    ReadArrayImpl(data, n);
+}
+
 ////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////
 //
@@ -728,16 +785,14 @@ ChStreamVectorWrapper::~ChStreamVectorWrapper() {
 }
 
 void ChStreamVectorWrapper::Write(const char* data, size_t n) {
-    std::copy(data, data + n, std::back_inserter(*vbuffer));
+    vbuffer->insert(vbuffer->end(), data, data + n);
 }
 void ChStreamVectorWrapper::Read(char* data, size_t n) {
     if (pos + n > vbuffer->size())
         n = vbuffer->size() - pos;
 
-    for (int i = 0; i < n; i++) {
-        data[i] = (*vbuffer)[pos];
-        pos++;
-    }
+    std::copy(vbuffer->begin() + pos, vbuffer->begin() + pos + n, data);
+    pos += (int)n;
 }
 bool ChStreamVectorWrapper::End_of_stream() {
     if (pos >= vbuffer->size())
@@ -812,4 +867,66 @@ ChStreamInAsciiFile::ChStreamInAsciiFile(const char* filename) : ChStreamFile(fi
 ChStreamInAsciiFile::~ChStreamInAsciiFile() {
 }
 
+#ifdef CHRONO_HAS_ZLIB
+
+////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////
+//
+// ChStreamOutBinaryGzipFile, ChStreamInBinaryGzipFile
+
+// Data is transferred in chunks, since zlib takes sizes as unsigned int.
+static const size_t gzip_chunk = 1 << 30;
+
+ChStreamOutBinaryGzipFile::ChStreamOutBinaryGzipFile(const char* filename, int level) {
+    std::string mode = "wb" + std::to_string(std::max(1, std::min(level, 9)));
+    file = gzopen(filename, mode.c_str());
+    if (!file)
+        throw ChException("Cannot open stream");
+}
+
+ChStreamOutBinaryGzipFile::~ChStreamOutBinaryGzipFile() {
+    gzclose((gzFile)file);
+}
+
+void ChStreamOutBinaryGzipFile::Output(const char* data, size_t n) {
+    while (n > 0) {
+        unsigned int count = (unsigned int)std::min(n, gzip_chunk);
+        if (gzwrite((gzFile)file, data, count) != (int)count)
+            throw ChException("Cannot write to stream");
+        data += count;
+        n -= count;
+    }
+}
+
+ChStreamInBinaryGzipFile::ChStreamInBinaryGzipFile(const char* filename) {
+    file = gzopen(filename, "rb");
+    if (!file)
+        throw ChException("Cannot open stream");
+}
+
+ChStreamInBinaryGzipFile::~ChStreamInBinaryGzipFile() {
+    gzclose((gzFile)file);
+}
+
+bool ChStreamInBinaryGzipFile::End_of_stream() {
+    // gzeof() is set only after a read past the end: peek the next char instead
+    int c = gzgetc((gzFile)file);
+    if (c == -1)
+        return true;
+    gzungetc(c, (gzFile)file);
+    return false;
+}
+
+void ChStreamInBinaryGzipFile::Input(char* data, size_t n) {
+    while (n > 0) {
+        unsigned int count = (unsigned int)std::min(n, gzip_chunk);
+        if (gzread((gzFile)file, data, count) != (int)count)
+            throw ChException("Cannot read from stream");
+        data += count;
+        n -= count;
+    }
+}
+
+#endif
+
 }  // end namespace chrono
@@ -22,6 +22,7 @@
 #include <vector>
 #include <ios>
 
+#include "chrono/ChConfig.h"
 #include "chrono/core/ChException.h"
 #include "chrono/core/ChApiCE.h"
 
@@ -331,6 +332,12 @@ class ChApi ChStreamOutBinary : public ChStreamOut, public ChBinaryArchive {
     ChStreamOutBinary& operator<<(const char* str);
     ChStreamOutBinary& operator<<(char* str);
 
+    /// Write an array of numbers as a single block.
+    /// The result is the same as writing the numbers one at a time with the << operator.
+    void WriteArray(const double* data, size_t n);
+    void WriteArray(const float* data, size_t n);
+    void WriteArray(const int* data, size_t n);
+
     /// Generic operator for binary streaming of generic objects.
     /// WARNING!!! raw byte streaming! If class 'T' contains double,
     /// int, long, etc, these may give problems when loading on another
@@ -400,6 +407,10 @@ class ChApi ChStreamOutBinary : public ChStreamOut, public ChBinaryArchive {
     /// Some objects may write class version at the beginning
     /// of the streamed data, using this function.
     void VersionWrite(int mver);
+
+  private:
+    template <typename T>
+    void WriteArrayImpl(const T* data, size_t n);
 };
 
 ///
@@ -447,6 +458,12 @@ class ChApi ChStreamInBinary : public ChStreamIn, public ChBinaryArchive {
     /// Specialized operator for C strings
     ChStreamInBinary& operator>>(char* str);
 
+    /// Read an array of numbers written with ChStreamOutBinary::WriteArray (or one at a time
+    /// with the << operator) as a single block.
+    void ReadArray(double* data, size_t n);
+    void ReadArray(float* data, size_t n);
+    void ReadArray(int* data, size_t n);
+
     /// Generic operator for raw binary streaming of generic objects
     /// WARNING!!! raw byte streaming! If class 'T' contains double,
     /// int, long, etc, these may give problems when loading on another
@@ -539,6 +556,10 @@ class ChApi ChStreamInBinary : public ChStreamIn, public ChBinaryArchive {
     /// Some objects may write class version at the beginning
     /// of the streamed data, they can use this function to read class from stream.
     int VersionRead();
+
+  private:
+    template <typename T>
+    void ReadArrayImpl(T* data, size_t n);
 };
 
 ///
@@ -825,6 +846,47 @@ class ChApi ChStreamInAsciiFile : public ChStreamFile, public ChStreamInAscii {
     virtual void Input(char* data, size_t n) { ChStreamFile::Read(data, n); }
 };
 
+#ifdef CHRONO_HAS_ZLIB
+
+///
+/// This is a specialized class for BINARY output on a compressed file (gzip format).
+/// Available only if Chrono was built with zlib support (ENABLE_ZLIB).
+///
+
+class ChApi ChStreamOutBinaryGzipFile : public ChStreamOutBinary {
+  public:
+    /// Open the file for writing, with the given compression level
+    /// (from 1, fastest, to 9, best compression).
+    ChStreamOutBinaryGzipFile(const char* filename, int level = 6);
+    virtual ~ChStreamOutBinaryGzipFile();
+
+  private:
+    virtual void Output(const char* data, size_t n);
+
+    void* file;  ///< zlib file handle (gzFile)
+};
+
+///
+/// This is a specialized class for BINARY input from a compressed file (gzip format).
+/// Uncompressed files are also read transparently.
+/// Available only if Chrono was built with zlib support (ENABLE_ZLIB).
+///
+
+class ChApi ChStreamInBinaryGzipFile : public ChStreamInBinary {
+  public:
+    ChStreamInBinaryGzipFile(const char* filename);
+    virtual ~ChStreamInBinaryGzipFile();
+
+    virtual bool End_of_stream();
+
+  private:
+    virtual void Input(char* data, size_t n);
+
+    void* file;  ///< zlib file handle (gzFile)
+};
+
+#endif
+
 }  // end namespace chrono
 
 #endif
@@ -216,6 +216,17 @@ class ChVector {
 
 CH_CLASS_VERSION(ChVector<double>, 0)
 
+/// Arrays of ChVector objects are transferred as blocks of numbers by archives that support it.
+template <class Real>
+struct ChArchiveBulkTraits<ChVector<Real>> {
+    static_assert(sizeof(ChVector<Real>) == 3 * sizeof(Real), "unexpected ChVector layout");
+    static const bool value = ChArchiveBulkTraits<Real>::value;
+    typedef Real scalar;
+    static const size_t components = 3;
+    static const bool versioned = true;
+    typedef ChVector<double> version_class;
+};
+
 // -----------------------------------------------------------------------------
 
 /// Shortcut for faster use of typical double-precision vectors.
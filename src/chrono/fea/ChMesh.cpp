@@ -18,8 +18,10 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/core/ChMath.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/physics/ChLoad.h"
 #include "chrono/physics/ChObject.h"
 #include "chrono/physics/ChSystem.h"
@@ -46,6 +48,8 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
     automatic_gravity_load = other.automatic_gravity_load;
     num_points_gravity = other.num_points_gravity;
 
+    coloring_valid = false;
+
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
 }
@@ -66,6 +70,8 @@ void ChMesh::SetupInitial() {
         //    - precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
     }
+
+    coloring_valid = false;
 }
 
 void ChMesh::Relax() {
@@ -85,21 +91,98 @@ void ChMesh::SetNoSpeedNoAcceleration() {
 void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> m_node) {
     m_node->SetIndex(static_cast<unsigned int>(vnodes.size()) + 1);
     vnodes.push_back(m_node);
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     velements.push_back(m_elem);
+    coloring_valid = false;
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChMesh::ClearElements() {
     velements.clear();
     vcontactsurfaces.clear();
+    coloring_valid = false;
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChMesh::ClearNodes() {
     velements.clear();
     vnodes.clear();
     vcontactsurfaces.clear();
+    coloring_valid = false;
+    if (system)
+        system->InvalidateDescriptor();
+}
+
+void ChMesh::UpdateColoring() {
+    if (coloring_valid)
+        return;
+
+    int nelements = (int)velements.size();
+
+    // Greedy coloring: each element gets the lowest color not used yet by any of its nodes.
+    std::unordered_map<ChNodeFEAbase*, std::vector<int>> node_colors;
+    std::vector<int> element_color(nelements);
+    std::vector<int> used;
+    int ncolors = 0;
+    for (int ie = 0; ie < nelements; ie++) {
+        used.clear();
+        for (int in = 0; in < velements[ie]->GetNnodes(); in++) {
+            auto& colors = node_colors[velements[ie]->GetNodeN(in).get()];
+            used.insert(used.end(), colors.begin(), colors.end());
+        }
+        std::sort(used.begin(), used.end());
+        int color = 0;
+        for (auto c : used) {
+            if (c == color)
+                color++;
+            else if (c > color)
+                break;
+        }
+        for (int in = 0; in < velements[ie]->GetNnodes(); in++)
+            node_colors[velements[ie]->GetNodeN(in).get()].push_back(color);
+        element_color[ie] = color;
+        ncolors = std::max(ncolors, color + 1);
+    }
+
+    // Sort element indices by color (stable, so elements keep their order within a color).
+    color_start.assign(ncolors + 1, 0);
+    for (auto color : element_color)
+        color_start[color + 1]++;
+    for (int color = 0; color < ncolors; color++)
+        color_start[color + 1] += color_start[color];
+    color_elements.resize(nelements);
+    std::vector<int> fill(color_start.begin(), color_start.end() - 1);
+    for (int ie = 0; ie < nelements; ie++)
+        color_elements[fill[element_color[ie]]++] = ie;
+
+    // Cache the elements that can receive the automatic gravity load.
+    gravity_loadables.resize(nelements);
+    for (int ie = 0; ie < nelements; ie++)
+        gravity_loadables[ie] = std::dynamic_pointer_cast<ChLoadableUVW>(velements[ie]);
+
+    coloring_valid = true;
+}
+
+int ChMesh::GetNumThreads() const {
+    return system ? system->GetParallelThreadNumber() : 0;
+}
+
+void ChMesh::ForEachElementColored(const std::function<void(int)>& func) {
+    UpdateColoring();
+    for (int color = 0; color + 1 < (int)color_start.size(); color++) {
+        ChTaskScheduler::GetInstance().ParallelFor(color_start[color], color_start[color + 1], 0,
+                                                   [&](int from, int to) {
+                                                       for (int k = from; k < to; k++)
+                                                           func(color_elements[k]);
+                                                   },
+                                                   GetNumThreads());
+    }
 }
 
 void ChMesh::AddContactSurface(std::shared_ptr<ChContactSurface> m_surf) {
@@ -241,9 +324,12 @@ void ChMesh::IntStateIncrement(const unsigned int off_x,
             local_off_v += vnodes[j]->Get_ndof_w();
         }
     }
-	for (unsigned int ie = 0; ie < velements.size(); ie++) {
-		velements[ie]->EleDoIntegration();
-	}
+    ChTaskScheduler::GetInstance().ParallelFor(0, (int)velements.size(), 0,
+                                               [&](int from, int to) {
+                                                   for (int ie = from; ie < to; ie++)
+                                                       velements[ie]->EleDoIntegration();
+                                               },
+                                               GetNumThreads());
 }
 
 void ChMesh::IntLoadResidual_F(const unsigned int off, 
@@ -261,31 +347,36 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,
 
     // internal forces
     timer_internal_forces.start();
-#pragma omp parallel for schedule(dynamic, 4)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
-    }
+    ForEachElementColored([&](int ie) { velements[ie]->EleIntLoadResidual_F(R, c); });
     timer_internal_forces.stop();
     ncalls_internal_forces++;
 
     // Apply gravity loads without the need of adding
     // a ChLoad object to each element: just instance here a single ChLoad and reuse
-    // it for all 'volume' objects.
+    // it for all 'volume' objects (one ChLoad per chunk of elements, as ComputeQ() stores the
+    // generalized forces in the ChLoad).
     if (automatic_gravity_load) {
-        std::shared_ptr<ChLoadableUVW> mloadable;  // still null
-        auto common_gravity_loader = std::make_shared<ChLoad<ChLoaderGravity>>(mloadable);
-        common_gravity_loader->loader.Set_G_acc(GetSystem()->Get_G_acc());
-        common_gravity_loader->loader.SetNumIntPoints(num_points_gravity);
-
-        for (unsigned int ie = 0; ie < velements.size(); ie++) {
-            if ((mloadable = std::dynamic_pointer_cast<ChLoadableUVW>(velements[ie]))) {
-                if (mloadable->GetDensity()) {
-                    // temporary set loader target and compute generalized forces term
-                    common_gravity_loader->loader.loadable = mloadable;
-                    common_gravity_loader->ComputeQ(0, 0);
-                    common_gravity_loader->LoadIntLoadResidual_F(R, c);
-                }
-            }
+        UpdateColoring();
+        ChVector<> G_acc = GetSystem()->Get_G_acc();
+        for (int color = 0; color + 1 < (int)color_start.size(); color++) {
+            ChTaskScheduler::GetInstance().ParallelFor(
+                color_start[color], color_start[color + 1], 0,
+                [&](int from, int to) {
+                    std::shared_ptr<ChLoadableUVW> mloadable;  // still null
+                    ChLoad<ChLoaderGravity> gravity_loader(mloadable);
+                    gravity_loader.loader.Set_G_acc(G_acc);
+                    gravity_loader.loader.SetNumIntPoints(num_points_gravity);
+                    for (int k = from; k < to; k++) {
+                        mloadable = gravity_loadables[color_elements[k]];
+                        if (mloadable && mloadable->GetDensity()) {
+                            // temporary set loader target and compute generalized forces term
+                            gravity_loader.loader.loadable = mloadable;
+                            gravity_loader.ComputeQ(0, 0);
+                            gravity_loader.LoadIntLoadResidual_F(R, c);
+                        }
+                    }
+                },
+                GetNumThreads());
         }
     }
 }
@@ -303,9 +394,7 @@ void ChMesh::ComputeMassProperties(double& mass,           // ChMesh object mass
         vnodes[j]->m_TotalMass = 0.0;
     }
     // Loop over all elements and calculate contribution to nodal mass
-    for (unsigned int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->ComputeNodalMass();
-    }
+    ForEachElementColored([&](int ie) { velements[ie]->ComputeNodalMass(); });
     // Loop over all the nodes of the mesh to obtain total object mass
     for (unsigned int j = 0; j < vnodes.size(); j++) {
         mass += vnodes[j]->m_TotalMass;
@@ -326,9 +415,7 @@ void ChMesh::IntLoadResidual_Mv(const unsigned int off,      ///< offset in R re
     }
 
     // internal masses
-    for (unsigned int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_Mv(R, w, c);
-    }
+    ForEachElementColored([&](int ie) { velements[ie]->EleIntLoadResidual_Mv(R, w, c); });
 }
 
 void ChMesh::IntToDescriptor(const unsigned int off_v,
@@ -368,9 +455,12 @@ void ChMesh::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 
 void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
     timer_KRMload.start();
-#pragma omp parallel for
-    for (int ie = 0; ie < velements.size(); ie++)
-        velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+    ChTaskScheduler::GetInstance().ParallelFor(0, (int)velements.size(), 0,
+                                               [&](int from, int to) {
+                                                   for (int ie = from; ie < to; ie++)
+                                                       velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+                                               },
+                                               GetNumThreads());
     timer_KRMload.stop();
     ncalls_KRMload++;
 }
@@ -382,12 +472,15 @@ void ChMesh::VariablesFbReset() {
 
 void ChMesh::VariablesFbLoadForces(double factor) {
     // applied nodal forces
-    for (unsigned int in = 0; in < vnodes.size(); in++)
-        vnodes[in]->VariablesFbLoadForces(factor);
+    ChTaskScheduler::GetInstance().ParallelFor(0, (int)vnodes.size(), 0,
+                                               [&](int from, int to) {
+                                                   for (int in = from; in < to; in++)
+                                                       vnodes[in]->VariablesFbLoadForces(factor);
+                                               },
+                                               GetNumThreads());
 
     // internal forces
-    for (unsigned int ie = 0; ie < velements.size(); ie++)
-        velements[ie]->VariablesFbLoadInternalForces(factor);
+    ForEachElementColored([&](int ie) { velements[ie]->VariablesFbLoadInternalForces(factor); });
 }
 
 void ChMesh::VariablesQbLoadSpeed() {
@@ -397,12 +490,15 @@ void ChMesh::VariablesQbLoadSpeed() {
 
 void ChMesh::VariablesFbIncrementMq() {
     // nodal masses
-    for (unsigned int ie = 0; ie < vnodes.size(); ie++)
-        vnodes[ie]->VariablesFbIncrementMq();
+    ChTaskScheduler::GetInstance().ParallelFor(0, (int)vnodes.size(), 0,
+                                               [&](int from, int to) {
+                                                   for (int in = from; in < to; in++)
+                                                       vnodes[in]->VariablesFbIncrementMq();
+                                               },
+                                               GetNumThreads());
 
     // internal masses
-    for (unsigned int ie = 0; ie < velements.size(); ie++)
-        velements[ie]->VariablesFbIncrementMq();
+    ForEachElementColored([&](int ie) { velements[ie]->VariablesFbIncrementMq(); });
 }
 
 void ChMesh::VariablesQbSetSpeed(double step) {
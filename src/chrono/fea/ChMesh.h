@@ -17,10 +17,12 @@
 
 #include <cstdlib>
 #include <cmath>
+#include <functional>
 
 #include "chrono/core/ChTimer.h"
 #include "chrono/physics/ChContinuumMaterial.h"
 #include "chrono/physics/ChIndexedNodes.h"
+#include "chrono/physics/ChLoadable.h"
 #include "chrono/physics/ChMaterialSurfaceNSC.h"
 #include "chrono/fea/ChContactSurface.h"
 #include "chrono/fea/ChElementBase.h"
@@ -51,6 +53,11 @@ class ChApi ChMesh : public ChIndexedNodes {
     bool automatic_gravity_load;
     int num_points_gravity;
 
+    std::vector<int> color_start;     ///< start of each color in color_elements (plus end marker)
+    std::vector<int> color_elements;  ///< element indices, sorted by color
+    std::vector<std::shared_ptr<ChLoadableUVW>> gravity_loadables;  ///< elements as ChLoadableUVW (or null)
+    bool coloring_valid;
+
     ChTimer<> timer_internal_forces;
     ChTimer<> timer_KRMload;
     int ncalls_internal_forces;
@@ -62,6 +69,7 @@ class ChApi ChMesh : public ChIndexedNodes {
           n_dofs_w(0),
           automatic_gravity_load(true),
           num_points_gravity(1),
+          coloring_valid(false),
           ncalls_internal_forces(0),
           ncalls_KRMload(0) {}
     ChMesh(const ChMesh& other);
@@ -93,6 +101,16 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// Get the number of elements in the mesh.
     unsigned int GetNelements() { return (unsigned int)velements.size(); }
 
+    /// Get the number of element colors.
+    /// Elements are partitioned in colors such that elements of the same color do not share nodes; the loops
+    /// that add element terms into nodal quantities process one color after the other, with the elements of
+    /// each color in parallel, so the results do not depend on the number of threads.
+    /// The coloring is recomputed when elements are added or removed.
+    int GetNelementColors() {
+        UpdateColoring();
+        return (int)color_start.size() - 1;
+    }
+
     virtual int GetDOF() override { return n_dofs; }
     virtual int GetDOF_w() override { return n_dofs_w; }
 
@@ -269,6 +287,15 @@ class ChApi ChMesh : public ChIndexedNodes {
     virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
 
   private:
+    /// Recompute the element coloring and the list of gravity loadables, if out of date.
+    void UpdateColoring();
+
+    /// Call func(ie) for all elements, one color after the other, with the elements of a color in parallel.
+    void ForEachElementColored(const std::function<void(int)>& func);
+
+    /// Maximum number of threads for the parallel loops on nodes and elements (as set on the owner ChSystem).
+    int GetNumThreads() const;
+
     /// Initial setup (before analysis).
     /// This function is called from ChSystem::SetupInitial, marking a point where system
     /// construction is completed.
@@ -39,11 +39,28 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <map>
 #include <unordered_map>
 
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "chrono/core/ChLinearAlgebra.h"
 #include "chrono/geometry/ChTriangleMeshConnected.h"
 
@@ -1074,6 +1091,220 @@ void ChTriangleMeshConnected::WriteWavefront(const std::string& filename,
     mf.close();
 }
 
+// -----------------------------------------------------------------------------
+// Chrono binary mesh format.
+// The file starts with a fixed-size header, followed by the data arrays in the
+// order of the header counts, each padded to a multiple of 8 bytes. Arrays are
+// the raw memory images of the corresponding std::vector<ChVector<>> members, so
+// loading amounts to mapping the file and copying each section in bulk.
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const char binary_mesh_magic[8] = {'C', 'H', 'M', 'E', 'S', 'H', 'B', '\0'};
+const uint32_t binary_mesh_version = 1;
+const uint32_t binary_mesh_byte_order = 0x01020304;
+
+enum BinaryMeshSection {
+    VERTICES,
+    NORMALS,
+    UVS,
+    COLORS,
+    FACE_V_INDICES,
+    FACE_N_INDICES,
+    FACE_UV_INDICES,
+    FACE_COL_INDICES,
+    TRI_MAP,
+    NUM_SECTIONS
+};
+
+struct BinaryMeshHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t counts[NUM_SECTIONS];
+};
+
+static_assert(sizeof(ChVector<double>) == 3 * sizeof(double), "unexpected ChVector layout");
+static_assert(sizeof(ChVector<float>) == 3 * sizeof(float), "unexpected ChVector layout");
+static_assert(sizeof(ChVector<int>) == 3 * sizeof(int), "unexpected ChVector layout");
+static_assert(sizeof(BinaryMeshHeader) % 8 == 0, "unexpected header size");
+
+// Size in bytes of one entry of each section.
+const size_t binary_mesh_entry_size[NUM_SECTIONS] = {
+    sizeof(ChVector<double>), sizeof(ChVector<double>), sizeof(ChVector<double>),
+    sizeof(ChVector<float>),  sizeof(ChVector<int>),    sizeof(ChVector<int>),
+    sizeof(ChVector<int>),    sizeof(ChVector<int>),    sizeof(std::array<int, 4>)};
+
+size_t PaddedSize(size_t size) {
+    return (size + 7) & ~size_t(7);
+}
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+  public:
+    MappedFile(const std::string& filename) : m_data(nullptr), m_size(0) {
+#ifdef _WIN32
+        m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        m_mapping = NULL;
+        if (m_file == INVALID_HANDLE_VALUE)
+            return;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+            return;
+        m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m_mapping == NULL)
+            return;
+        m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_data)
+            m_size = (size_t)size.QuadPart;
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat buf;
+        if (fstat(fd, &buf) == 0 && buf.st_size > 0) {
+            void* data = mmap(nullptr, (size_t)buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                m_data = static_cast<const char*>(data);
+                m_size = (size_t)buf.st_size;
+            }
+        }
+        close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (m_data)
+            UnmapViewOfFile(m_data);
+        if (m_mapping != NULL)
+            CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE)
+            CloseHandle(m_file);
+#else
+        if (m_data)
+            munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+
+    const char* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+
+  private:
+    const char* m_data;
+    size_t m_size;
+#ifdef _WIN32
+    HANDLE m_file;
+    HANDLE m_mapping;
+#endif
+};
+
+template <typename T>
+void WriteSection(std::ofstream& mf, const std::vector<T>& v) {
+    size_t size = v.size() * sizeof(T);
+    if (size > 0)
+        mf.write(reinterpret_cast<const char*>(v.data()), size);
+    static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    mf.write(zeros, PaddedSize(size) - size);
+}
+
+template <typename T>
+void ReadSection(const char* data, uint64_t count, std::vector<T>& v) {
+    v.resize(count);
+    if (count > 0)
+        std::memcpy(v.data(), data, count * sizeof(T));
+}
+
+}  // end anonymous namespace
+
+bool ChTriangleMeshConnected::WriteBinaryMesh(const std::string& filename, bool write_tri_map) const {
+    std::vector<std::array<int, 4>> tri_map;
+    if (write_tri_map)
+        ComputeNeighbouringTriangleMap(tri_map);
+
+    BinaryMeshHeader header;
+    std::memcpy(header.magic, binary_mesh_magic, sizeof(header.magic));
+    header.version = binary_mesh_version;
+    header.byte_order = binary_mesh_byte_order;
+    header.counts[VERTICES] = m_vertices.size();
+    header.counts[NORMALS] = m_normals.size();
+    header.counts[UVS] = m_UV.size();
+    header.counts[COLORS] = m_colors.size();
+    header.counts[FACE_V_INDICES] = m_face_v_indices.size();
+    header.counts[FACE_N_INDICES] = m_face_n_indices.size();
+    header.counts[FACE_UV_INDICES] = m_face_uv_indices.size();
+    header.counts[FACE_COL_INDICES] = m_face_col_indices.size();
+    header.counts[TRI_MAP] = tri_map.size();
+
+    std::ofstream mf(filename, std::ios::binary);
+    if (!mf.good())
+        return false;
+    mf.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteSection(mf, m_vertices);
+    WriteSection(mf, m_normals);
+    WriteSection(mf, m_UV);
+    WriteSection(mf, m_colors);
+    WriteSection(mf, m_face_v_indices);
+    WriteSection(mf, m_face_n_indices);
+    WriteSection(mf, m_face_uv_indices);
+    WriteSection(mf, m_face_col_indices);
+    WriteSection(mf, tri_map);
+
+    return mf.good();
+}
+
+bool ChTriangleMeshConnected::LoadBinaryMesh(const std::string& filename,
+                                             bool load_normals,
+                                             bool load_uv,
+                                             std::vector<std::array<int, 4>>* tri_map) {
+    MappedFile file(filename);
+    if (!file.GetData() || file.GetSize() < sizeof(BinaryMeshHeader))
+        return false;
+
+    BinaryMeshHeader header;
+    std::memcpy(&header, file.GetData(), sizeof(header));
+    if (std::memcmp(header.magic, binary_mesh_magic, sizeof(header.magic)) != 0 ||
+        header.version != binary_mesh_version || header.byte_order != binary_mesh_byte_order)
+        return false;
+
+    // Locate the sections and check that the file is complete
+    const char* section[NUM_SECTIONS];
+    size_t offset = sizeof(header);
+    for (int i = 0; i < NUM_SECTIONS; i++) {
+        if (header.counts[i] > (file.GetSize() - offset) / binary_mesh_entry_size[i])
+            return false;
+        section[i] = file.GetData() + offset;
+        offset += PaddedSize(header.counts[i] * binary_mesh_entry_size[i]);
+        if (offset > file.GetSize())
+            return false;
+    }
+
+    m_filename = filename;
+
+    ReadSection(section[VERTICES], header.counts[VERTICES], m_vertices);
+    ReadSection(section[NORMALS], load_normals ? header.counts[NORMALS] : 0, m_normals);
+    ReadSection(section[UVS], load_uv ? header.counts[UVS] : 0, m_UV);
+    ReadSection(section[COLORS], header.counts[COLORS], m_colors);
+    ReadSection(section[FACE_V_INDICES], header.counts[FACE_V_INDICES], m_face_v_indices);
+    ReadSection(section[FACE_N_INDICES], load_normals ? header.counts[FACE_N_INDICES] : 0, m_face_n_indices);
+    ReadSection(section[FACE_UV_INDICES], load_uv ? header.counts[FACE_UV_INDICES] : 0, m_face_uv_indices);
+    ReadSection(section[FACE_COL_INDICES], header.counts[FACE_COL_INDICES], m_face_col_indices);
+    if (tri_map)
+        ReadSection(section[TRI_MAP], header.counts[TRI_MAP], *tri_map);
+
+    return true;
+}
+
+bool ChTriangleMeshConnected::IsBinaryMeshFile(const std::string& filename) {
+    std::ifstream mf(filename, std::ios::binary);
+    char magic[sizeof(binary_mesh_magic)];
+    if (!mf.read(magic, sizeof(magic)))
+        return false;
+    return std::memcmp(magic, binary_mesh_magic, sizeof(magic)) == 0;
+}
+
 /// Utility function for merging multiple meshes.
 ChTriangleMeshConnected ChTriangleMeshConnected::Merge(std::vector<ChTriangleMeshConnected>& meshes) {
     ChTriangleMeshConnected trimesh;
@@ -65,6 +65,24 @@ class ChApi ChTriangleMeshConnected : public ChTriangleMesh {
     /// Write the specified meshes in a Wavefront .obj file
     static void WriteWavefront(const std::string& filename, std::vector<ChTriangleMeshConnected>& meshes);
 
+    /// Write this mesh in the Chrono binary mesh format.
+    /// The file contains the raw vertex, normal, UV, and color arrays and the face index arrays, in the byte order
+    /// of the host. Optionally, the map of neighboring triangles (see ComputeNeighbouringTriangleMap) is computed
+    /// and stored as well. Return false if the file cannot be written.
+    bool WriteBinaryMesh(const std::string& filename, bool write_tri_map = false) const;
+
+    /// Load a triangle mesh saved in the Chrono binary mesh format (see WriteBinaryMesh).
+    /// The file is memory-mapped and its arrays are copied in bulk, without any parsing. If requested and present
+    /// in the file, the map of neighboring triangles is also returned (otherwise tri_map is left empty).
+    /// Return false if the file cannot be read or is not a valid binary mesh file.
+    bool LoadBinaryMesh(const std::string& filename,
+                        bool load_normals = true,
+                        bool load_uv = true,
+                        std::vector<std::array<int, 4>>* tri_map = nullptr);
+
+    /// Return true if the specified file is in the Chrono binary mesh format.
+    static bool IsBinaryMeshFile(const std::string& filename);
+
     /// Utility function for merging multiple meshes.
     static ChTriangleMeshConnected Merge(std::vector<ChTriangleMeshConnected>& meshes);
 
@@ -0,0 +1,230 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "chrono/parallel/ChTaskScheduler.h"
+
+namespace chrono {
+
+// Scheduler and queue index of the worker running on the current thread (if any).
+static thread_local const ChTaskScheduler* tls_scheduler = nullptr;
+static thread_local int tls_queue_index = -1;
+
+// -----------------------------------------------------------------------------
+
+void ChTaskScheduler::TaskGroup::Run(std::function<void()> task) {
+    m_pending++;
+    m_scheduler.Push(Task{std::move(task), this});
+}
+
+void ChTaskScheduler::TaskGroup::WaitNoThrow() {
+    int queue_index = m_scheduler.CurrentQueueIndex();
+    while (m_pending > 0) {
+        if (!m_scheduler.TryRunTask(queue_index))
+            std::this_thread::yield();
+    }
+}
+
+void ChTaskScheduler::TaskGroup::Wait() {
+    WaitNoThrow();
+    if (m_exception) {
+        std::exception_ptr exception = m_exception;
+        m_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ChTaskScheduler::ChTaskScheduler(int num_threads, bool pin_threads) : m_num_threads(1), m_num_queued(0), m_stop(false) {
+    Start(num_threads, pin_threads);
+}
+
+ChTaskScheduler::~ChTaskScheduler() {
+    Stop();
+}
+
+ChTaskScheduler& ChTaskScheduler::GetInstance() {
+    static ChTaskScheduler instance;
+    return instance;
+}
+
+void ChTaskScheduler::SetNumThreads(int num_threads, bool pin_threads) {
+    Stop();
+    Start(num_threads, pin_threads);
+}
+
+void ChTaskScheduler::Start(int num_threads, bool pin_threads) {
+    if (num_threads <= 0)
+        num_threads = std::max(1, (int)std::thread::hardware_concurrency());
+    m_num_threads = num_threads;
+    m_stop = false;
+    m_num_queued = 0;
+
+    // Queues 0..n-2 belong to the worker threads, the last one receives tasks from external threads.
+    int num_workers = num_threads - 1;
+    m_queues.clear();
+    for (int i = 0; i <= num_workers; i++)
+        m_queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue));
+
+    for (int i = 0; i < num_workers; i++) {
+        m_workers.push_back(std::thread(&ChTaskScheduler::WorkerLoop, this, i));
+#if defined(__linux__)
+        if (pin_threads) {
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET((i + 1) % std::max(1, (int)std::thread::hardware_concurrency()), &cpuset);
+            pthread_setaffinity_np(m_workers.back().native_handle(), sizeof(cpu_set_t), &cpuset);
+        }
+#endif
+    }
+}
+
+void ChTaskScheduler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_sleep_cv.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+}
+
+int ChTaskScheduler::CurrentQueueIndex() const {
+    return (tls_scheduler == this) ? tls_queue_index : (int)m_queues.size() - 1;
+}
+
+int ChTaskScheduler::EffectiveThreads(int max_threads) const {
+    return (max_threads > 0) ? std::min(max_threads, m_num_threads) : m_num_threads;
+}
+
+int ChTaskScheduler::DefaultGrain(int n, int max_threads) const {
+    return std::max(1, n / (8 * EffectiveThreads(max_threads)));
+}
+
+void ChTaskScheduler::Push(Task&& task) {
+    TaskQueue& queue = *m_queues[CurrentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_num_queued++;
+    }
+    m_sleep_cv.notify_one();
+}
+
+bool ChTaskScheduler::TryRunTask(int queue_index) {
+    Task task;
+    bool found = false;
+    int num_queues = (int)m_queues.size();
+
+    // First look in the own queue (most recently pushed task), then steal from the others (oldest task).
+    for (int k = 0; k < num_queues && !found; k++) {
+        TaskQueue& queue = *m_queues[(queue_index + k) % num_queues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+        if (k == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        found = true;
+    }
+
+    if (!found)
+        return false;
+
+    m_num_queued--;
+
+    try {
+        task.func();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(task.group->m_exception_mutex);
+        if (!task.group->m_exception)
+            task.group->m_exception = std::current_exception();
+    }
+    task.group->m_pending--;
+
+    return true;
+}
+
+void ChTaskScheduler::WorkerLoop(int index) {
+    tls_scheduler = this;
+    tls_queue_index = index;
+
+    while (true) {
+        if (TryRunTask(index))
+            continue;
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_sleep_cv.wait(lock, [this]() { return m_stop || m_num_queued > 0; });
+        if (m_stop)
+            break;
+    }
+
+    tls_scheduler = nullptr;
+    tls_queue_index = -1;
+}
+
+void ChTaskScheduler::ParallelFor(int begin,
+                                  int end,
+                                  int grain,
+                                  const std::function<void(int, int)>& body,
+                                  int max_threads) {
+    if (end <= begin)
+        return;
+    int nthreads = EffectiveThreads(max_threads);
+    if (grain <= 0)
+        grain = DefaultGrain(end - begin, max_threads);
+
+    if (nthreads == 1 || end - begin <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    TaskGroup group(*this);
+
+    if (nthreads == m_num_threads) {
+        // One task per sub-range
+        for (int from = begin; from < end; from += grain) {
+            int to = std::min(from + grain, end);
+            group.Run([&body, from, to]() { body(from, to); });
+        }
+    } else {
+        // Limited concurrency: nthreads tasks take the sub-ranges in turn
+        int nchunks = (end - begin + grain - 1) / grain;
+        std::atomic<int> next_chunk(0);
+        for (int k = 0; k < std::min(nthreads, nchunks); k++) {
+            group.Run([&]() {
+                for (int c = next_chunk++; c < nchunks; c = next_chunk++) {
+                    int from = begin + c * grain;
+                    body(from, std::min(from + grain, end));
+                }
+            });
+        }
+    }
+
+    group.Wait();
+}
+
+}  // end namespace chrono
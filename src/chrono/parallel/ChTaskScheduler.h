@@ -0,0 +1,157 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHTASKSCHEDULER_H
+#define CHTASKSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+
+/// Work-stealing task scheduler.
+/// The scheduler owns a pool of worker threads, each with its own task queue. Workers execute the tasks of their
+/// own queue in LIFO order and, when this is empty, steal tasks from the other queues in FIFO order, so that
+/// workloads with uneven task costs are balanced automatically. A thread waiting for a group of tasks does not
+/// block, but helps executing pending tasks; this makes nested parallel loops safe.
+/// A process-wide instance is available through GetInstance(); this is the one used by the Chrono modules.
+class ChApi ChTaskScheduler {
+  public:
+    /// Group of tasks that can be waited for as a whole.
+    class ChApi TaskGroup {
+      public:
+        TaskGroup(ChTaskScheduler& scheduler) : m_scheduler(scheduler), m_pending(0) {}
+        ~TaskGroup() { WaitNoThrow(); }
+
+        /// Schedule a task for execution.
+        void Run(std::function<void()> task);
+
+        /// Wait for all tasks scheduled in this group, helping with their execution.
+        /// If any of the tasks threw an exception, the first one is re-thrown here.
+        void Wait();
+
+      private:
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void WaitNoThrow();
+
+        ChTaskScheduler& m_scheduler;
+        std::atomic<int> m_pending;
+        std::mutex m_exception_mutex;
+        std::exception_ptr m_exception;
+
+        friend class ChTaskScheduler;
+    };
+
+    /// Create a scheduler using the specified number of threads (including the calling thread).
+    /// If num_threads is not positive, the number of hardware threads is used.
+    /// If pin_threads is true, worker threads are bound to cores (currently supported on Linux only).
+    ChTaskScheduler(int num_threads = 0, bool pin_threads = false);
+
+    ~ChTaskScheduler();
+
+    /// Return the process-wide scheduler instance.
+    static ChTaskScheduler& GetInstance();
+
+    /// Return the number of threads used by this scheduler (including the calling thread).
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Change the number of threads used by this scheduler; the worker threads are restarted.
+    /// Must not be called while tasks are being executed.
+    void SetNumThreads(int num_threads, bool pin_threads = false);
+
+    /// Execute body(from, to) on sub-ranges of [begin, end) in parallel and wait for completion.
+    /// Sub-ranges contain 'grain' indices (except possibly the last one); if grain is not positive, it is
+    /// chosen so that each thread gets several sub-ranges to balance the load.
+    /// If max_threads is positive, at most max_threads sub-ranges are processed at the same time (for example,
+    /// to honor the number of threads set on a ChSystem); sub-ranges are still handed out dynamically.
+    void ParallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body, int max_threads = 0);
+
+    /// Parallel reduction over [begin, end): body(from, to, identity) returns the partial result over a
+    /// sub-range, and reduce(a, b) combines two partial results. Partial results are combined in the order
+    /// of the sub-ranges, so the result does not depend on the number of threads or on the scheduling.
+    /// The grain and max_threads arguments are as in ParallelFor.
+    template <typename T, typename Body, typename Reduce>
+    T ParallelReduce(int begin,
+                     int end,
+                     int grain,
+                     const T& identity,
+                     const Body& body,
+                     const Reduce& reduce,
+                     int max_threads = 0) {
+        if (end <= begin)
+            return identity;
+        if (grain <= 0)
+            grain = DefaultGrain(end - begin, max_threads);
+        int nchunks = (end - begin + grain - 1) / grain;
+        std::vector<T> partial(nchunks, identity);
+        ParallelFor(0, nchunks, 1,
+                    [&](int c_from, int c_to) {
+                        for (int c = c_from; c < c_to; c++) {
+                            int from = begin + c * grain;
+                            int to = (from + grain < end) ? from + grain : end;
+                            partial[c] = body(from, to, identity);
+                        }
+                    },
+                    max_threads);
+        T result = identity;
+        for (int c = 0; c < nchunks; c++)
+            result = reduce(result, partial[c]);
+        return result;
+    }
+
+  private:
+    struct Task {
+        std::function<void()> func;
+        TaskGroup* group;
+    };
+
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    ChTaskScheduler(const ChTaskScheduler&) = delete;
+    ChTaskScheduler& operator=(const ChTaskScheduler&) = delete;
+
+    void Start(int num_threads, bool pin_threads);
+    void Stop();
+    void Push(Task&& task);
+    bool TryRunTask(int queue_index);
+    int CurrentQueueIndex() const;
+    int EffectiveThreads(int max_threads) const;
+    int DefaultGrain(int n, int max_threads) const;
+    void WorkerLoop(int index);
+
+    int m_num_threads;
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<TaskQueue>> m_queues;  ///< one per worker, plus one for external threads
+
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_cv;
+    std::atomic<int> m_num_queued;
+    bool m_stop;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -30,6 +30,31 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChAssembly)
 
+// Apply the given operation to all items in the list. If more than one thread is requested, the list
+// is split in contiguous per-thread chunks; items that declare shared state are processed afterwards,
+// serially, in their original order.
+template <class T, class Op>
+static void ForEachItem(const std::vector<std::shared_ptr<T>>& list, int nthreads, Op op) {
+    int nitems = (int)list.size();
+
+    if (nthreads < 2 || nitems < 2 * nthreads) {
+        for (int ip = 0; ip < nitems; ++ip)
+            op(list[ip].get());
+        return;
+    }
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+    for (int ip = 0; ip < nitems; ++ip) {
+        if (!list[ip]->SharesState())
+            op(list[ip].get());
+    }
+
+    for (int ip = 0; ip < nitems; ++ip) {
+        if (list[ip]->SharesState())
+            op(list[ip].get());
+    }
+}
+
 ChAssembly::ChAssembly()
     : nbodies(0),
       nlinks(0),
@@ -45,7 +70,8 @@ ChAssembly::ChAssembly()
       nsysvars(0),
       nsysvars_w(0),
       nbodies_sleep(0),
-      nbodies_fixed(0) {}
+      nbodies_fixed(0),
+      parallel_update(false) {}
 
 ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     nbodies = other.nbodies;
@@ -63,6 +89,7 @@ ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     nsysvars_w = other.nsysvars_w;
     nbodies_sleep = other.nbodies_sleep;
     nbodies_fixed = other.nbodies_fixed;
+    parallel_update = other.parallel_update;
 
     //// RADU
     //// TODO:  deep copy of the object lists (bodylist, linklist, meshlist,  otherphysicslist)
@@ -108,6 +135,8 @@ void ChAssembly::AddBody(std::shared_ptr<ChBody> body) {
     // set system and also add collision models to system
     body->SetSystem(system);
     bodylist.push_back(body);
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::RemoveBody(std::shared_ptr<ChBody> body) {
@@ -116,6 +145,8 @@ void ChAssembly::RemoveBody(std::shared_ptr<ChBody> body) {
 
     bodylist.erase(itr);
     body->SetSystem(nullptr);
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::AddLink(std::shared_ptr<ChLinkBase> link) {
@@ -123,6 +154,8 @@ void ChAssembly::AddLink(std::shared_ptr<ChLinkBase> link) {
 
     link->SetSystem(system);
     linklist.push_back(link);
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::RemoveLink(std::shared_ptr<ChLinkBase> link) {
@@ -131,6 +164,8 @@ void ChAssembly::RemoveLink(std::shared_ptr<ChLinkBase> link) {
 
     linklist.erase(itr);
     link->SetSystem(nullptr);
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::AddMesh(std::shared_ptr<fea::ChMesh> mesh) {
@@ -138,6 +173,8 @@ void ChAssembly::AddMesh(std::shared_ptr<fea::ChMesh> mesh) {
 
     mesh->SetSystem(system);
     meshlist.push_back(mesh);
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::RemoveMesh(std::shared_ptr<fea::ChMesh> mesh) {
@@ -146,6 +183,8 @@ void ChAssembly::RemoveMesh(std::shared_ptr<fea::ChMesh> mesh) {
 
     meshlist.erase(itr);
     mesh->SetSystem(nullptr);
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::AddOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> item) {
@@ -158,6 +197,8 @@ void ChAssembly::AddOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> item) {
     // set system and also add collision models to system
     item->SetSystem(system);
     otherphysicslist.push_back(item);
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::RemoveOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> item) {
@@ -166,6 +207,8 @@ void ChAssembly::RemoveOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> item) {
 
     otherphysicslist.erase(itr);
     item->SetSystem(nullptr);
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::Add(std::shared_ptr<ChPhysicsItem> item) {
@@ -222,6 +265,8 @@ void ChAssembly::RemoveAllBodies() {
         body->SetSystem(nullptr);
     }
     bodylist.clear();
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::RemoveAllLinks() {
@@ -229,6 +274,8 @@ void ChAssembly::RemoveAllLinks() {
         link->SetSystem(nullptr);
     }
     linklist.clear();
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::RemoveAllMeshes() {
@@ -236,6 +283,8 @@ void ChAssembly::RemoveAllMeshes() {
         mesh->SetSystem(nullptr);
     }
     meshlist.clear();
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChAssembly::RemoveAllOtherPhysicsItems() {
@@ -243,6 +292,8 @@ void ChAssembly::RemoveAllOtherPhysicsItems() {
         item->SetSystem(nullptr);
     }
     otherphysicslist.clear();
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 std::shared_ptr<ChBody> ChAssembly::SearchBody(const char* name) {
@@ -450,22 +501,49 @@ void ChAssembly::Update(double mytime, bool update_assets) {
 // Update all physical items (bodies, links, meshes, etc), including their auxiliary variables.
 // Updates all forces (automatic, as children of bodies)
 // Updates all markers (automatic, as children of bodies).
+// In parallel update mode, the items are updated concurrently and their assets refreshed afterwards, serially.
 void ChAssembly::Update(bool update_assets) {
-    //// NOTE: do not switch these to range for loops (may want to use OMP for)
-    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
-        bodylist[ip]->Update(ChTime, update_assets);
-    }
-    for (int ip = 0; ip < (int)otherphysicslist.size(); ++ip) {
-        otherphysicslist[ip]->Update(ChTime, update_assets);
-    }
-    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
-        linklist[ip]->Update(ChTime, update_assets);
-    }
-    for (int ip = 0; ip < (int)meshlist.size(); ++ip) {
-        meshlist[ip]->Update(ChTime, update_assets);
+    int nthreads = GetUpdateThreads();
+    bool item_assets = update_assets && nthreads < 2;
+    double mytime = ChTime;
+
+    auto update = [mytime, item_assets](ChPhysicsItem* item) { item->Update(mytime, item_assets); };
+    ForEachItem(bodylist, nthreads, update);
+    ForEachItem(otherphysicslist, nthreads, update);
+    ForEachItem(linklist, nthreads, update);
+    ForEachItem(meshlist, nthreads, update);
+
+    if (update_assets && !item_assets) {
+        for (auto& body : bodylist)
+            body->UpdateAssets();
+        for (auto& item : otherphysicslist)
+            item->UpdateAssets();
+        for (auto& link : linklist)
+            link->UpdateAssets();
+        for (auto& mesh : meshlist)
+            mesh->UpdateAssets();
     }
 }
 
+void ChAssembly::UpdateAssets() {
+    ChPhysicsItem::UpdateAssets();
+
+    for (auto& body : bodylist)
+        body->UpdateAssets();
+    for (auto& item : otherphysicslist)
+        item->UpdateAssets();
+    for (auto& link : linklist)
+        link->UpdateAssets();
+    for (auto& mesh : meshlist)
+        mesh->UpdateAssets();
+}
+
+int ChAssembly::GetUpdateThreads() const {
+    if (!parallel_update || !system)
+        return 1;
+    return system->GetParallelThreadNumber();
+}
+
 void ChAssembly::SetNoSpeedNoAcceleration() {
     for (auto& body : bodylist) {
         body->SetNoSpeedNoAcceleration();
@@ -488,21 +566,23 @@ void ChAssembly::IntStateGather(const unsigned int off_x,
                                 double& T) {
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
-
-    for (auto& body : bodylist) {
+    int nthreads = GetUpdateThreads();
+
+    // Note: each item gathers the time in a local variable, to avoid concurrent writes to T.
+    auto gather = [&](ChPhysicsItem* item) {
+        double item_T;
+        item->IntStateGather(displ_x + item->GetOffset_x(), x, displ_v + item->GetOffset_w(), v, item_T);
+    };
+    ForEachItem(bodylist, nthreads, [&](ChBody* body) {
         if (body->IsActive())
-            body->IntStateGather(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T);
-    }
-    for (auto& link : linklist) {
+            gather(body);
+    });
+    ForEachItem(linklist, nthreads, [&](ChLinkBase* link) {
         if (link->IsActive())
-            link->IntStateGather(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T);
-    }
-    for (auto& mesh : meshlist) {
-        mesh->IntStateGather(displ_x + mesh->GetOffset_x(), x, displ_v + mesh->GetOffset_w(), v, T);
-    }
-    for (auto& item : otherphysicslist) {
-        item->IntStateGather(displ_x + item->GetOffset_x(), x, displ_v + item->GetOffset_w(), v, T);
-    }
+            gather(link);
+    });
+    ForEachItem(meshlist, nthreads, gather);
+    ForEachItem(otherphysicslist, nthreads, gather);
     T = GetChTime();
 }
 
@@ -513,21 +593,21 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
                                  const double T) {
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
+    int nthreads = GetUpdateThreads();
 
-    for (auto& body : bodylist) {
+    auto scatter = [&](ChPhysicsItem* item) {
+        item->IntStateScatter(displ_x + item->GetOffset_x(), x, displ_v + item->GetOffset_w(), v, T);
+    };
+    ForEachItem(bodylist, nthreads, [&](ChBody* body) {
         if (body->IsActive())
-            body->IntStateScatter(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T);
-    }
-    for (auto& link : linklist) {
+            scatter(body);
+    });
+    ForEachItem(linklist, nthreads, [&](ChLinkBase* link) {
         if (link->IsActive())
-            link->IntStateScatter(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T);
-    }
-    for (auto& mesh : meshlist) {
-        mesh->IntStateScatter(displ_x + mesh->GetOffset_x(), x, displ_v + mesh->GetOffset_w(), v, T);
-    }
-    for (auto& item : otherphysicslist) {
-        item->IntStateScatter(displ_x + item->GetOffset_x(), x, displ_v + item->GetOffset_w(), v, T);
-    }
+            scatter(link);
+    });
+    ForEachItem(meshlist, nthreads, scatter);
+    ForEachItem(otherphysicslist, nthreads, scatter);
     SetChTime(T);
 
     // Note: all those IntStateScatter() above should call Update() automatically
@@ -540,80 +620,76 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
 void ChAssembly::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (auto& body : bodylist) {
+    int nthreads = GetUpdateThreads();
+
+    auto op = [&](ChPhysicsItem* item) { item->IntStateGatherAcceleration(displ_a + item->GetOffset_w(), a); };
+    ForEachItem(bodylist, nthreads, [&](ChBody* body) {
         if (body->IsActive())
-            body->IntStateGatherAcceleration(displ_a + body->GetOffset_w(), a);
-    }
-    for (auto& link : linklist) {
+            op(body);
+    });
+    ForEachItem(linklist, nthreads, [&](ChLinkBase* link) {
         if (link->IsActive())
-            link->IntStateGatherAcceleration(displ_a + link->GetOffset_w(), a);
-    }
-    for (auto& mesh : meshlist) {
-        mesh->IntStateGatherAcceleration(displ_a + mesh->GetOffset_w(), a);
-    }
-    for (auto& item : otherphysicslist) {
-        item->IntStateGatherAcceleration(displ_a + item->GetOffset_w(), a);
-    }
+            op(link);
+    });
+    ForEachItem(meshlist, nthreads, op);
+    ForEachItem(otherphysicslist, nthreads, op);
 }
 
 // From state derivative (acceleration) to system, sometimes might be needed
 void ChAssembly::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (auto& body : bodylist) {
+    int nthreads = GetUpdateThreads();
+
+    auto op = [&](ChPhysicsItem* item) { item->IntStateScatterAcceleration(displ_a + item->GetOffset_w(), a); };
+    ForEachItem(bodylist, nthreads, [&](ChBody* body) {
         if (body->IsActive())
-            body->IntStateScatterAcceleration(displ_a + body->GetOffset_w(), a);
-    }
-    for (auto& link : linklist) {
+            op(body);
+    });
+    ForEachItem(linklist, nthreads, [&](ChLinkBase* link) {
         if (link->IsActive())
-            link->IntStateScatterAcceleration(displ_a + link->GetOffset_w(), a);
-    }
-    for (auto& mesh : meshlist) {
-        mesh->IntStateScatterAcceleration(displ_a + mesh->GetOffset_w(), a);
-    }
-    for (auto& item : otherphysicslist) {
-        item->IntStateScatterAcceleration(displ_a + item->GetOffset_w(), a);
-    }
+            op(link);
+    });
+    ForEachItem(meshlist, nthreads, op);
+    ForEachItem(otherphysicslist, nthreads, op);
 }
 
 // From system to reaction forces (last computed) - some timestepper might need this
 void ChAssembly::IntStateGatherReactions(const unsigned int off_L, ChVectorDynamic<>& L) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+    int nthreads = GetUpdateThreads();
+
+    auto op = [&](ChPhysicsItem* item) { item->IntStateGatherReactions(displ_L + item->GetOffset_L(), L); };
+    ForEachItem(bodylist, nthreads, [&](ChBody* body) {
         if (body->IsActive())
-            body->IntStateGatherReactions(displ_L + body->GetOffset_L(), L);
-    }
-    for (auto& link : linklist) {
+            op(body);
+    });
+    ForEachItem(linklist, nthreads, [&](ChLinkBase* link) {
         if (link->IsActive())
-            link->IntStateGatherReactions(displ_L + link->GetOffset_L(), L);
-    }
-    for (auto& mesh : meshlist) {
-        mesh->IntStateGatherReactions(displ_L + mesh->GetOffset_L(), L);
-    }
-    for (auto& item : otherphysicslist) {
-        item->IntStateGatherReactions(displ_L + item->GetOffset_L(), L);
-    }
+            op(link);
+    });
+    ForEachItem(meshlist, nthreads, op);
+    ForEachItem(otherphysicslist, nthreads, op);
 }
 
 // From reaction forces to system, ex. store last computed reactions in ChLinkBase objects for plotting etc.
 void ChAssembly::IntStateScatterReactions(const unsigned int off_L, const ChVectorDynamic<>& L) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+    int nthreads = GetUpdateThreads();
+
+    auto op = [&](ChPhysicsItem* item) { item->IntStateScatterReactions(displ_L + item->GetOffset_L(), L); };
+    ForEachItem(bodylist, nthreads, [&](ChBody* body) {
         if (body->IsActive())
-            body->IntStateScatterReactions(displ_L + body->GetOffset_L(), L);
-    }
-    for (auto& link : linklist) {
+            op(body);
+    });
+    ForEachItem(linklist, nthreads, [&](ChLinkBase* link) {
         if (link->IsActive())
-            link->IntStateScatterReactions(displ_L + link->GetOffset_L(), L);
-    }
-    for (auto& mesh : meshlist) {
-        mesh->IntStateScatterReactions(displ_L + mesh->GetOffset_L(), L);
-    }
-    for (auto& item : otherphysicslist) {
-        item->IntStateScatterReactions(displ_L + item->GetOffset_L(), L);
-    }
+            op(link);
+    });
+    ForEachItem(meshlist, nthreads, op);
+    ForEachItem(otherphysicslist, nthreads, op);
 }
 
 void ChAssembly::IntStateIncrement(const unsigned int off_x,
@@ -624,23 +700,21 @@ void ChAssembly::IntStateIncrement(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
-        if (body->IsActive())
-            body->IntStateIncrement(displ_x + body->GetOffset_x(), x_new, x, displ_v + body->GetOffset_w(), Dv);
-    }
+    int nthreads = GetUpdateThreads();
 
-    for (auto& link : linklist) {
-        if (link->IsActive())
-            link->IntStateIncrement(displ_x + link->GetOffset_x(), x_new, x, displ_v + link->GetOffset_w(), Dv);
-    }
-
-    for (auto& mesh : meshlist) {
-        mesh->IntStateIncrement(displ_x + mesh->GetOffset_x(), x_new, x, displ_v + mesh->GetOffset_w(), Dv);
-    }
-
-    for (auto& item : otherphysicslist) {
+    auto increment = [&](ChPhysicsItem* item) {
         item->IntStateIncrement(displ_x + item->GetOffset_x(), x_new, x, displ_v + item->GetOffset_w(), Dv);
-    }
+    };
+    ForEachItem(bodylist, nthreads, [&](ChBody* body) {
+        if (body->IsActive())
+            increment(body);
+    });
+    ForEachItem(linklist, nthreads, [&](ChLinkBase* link) {
+        if (link->IsActive())
+            increment(link);
+    });
+    ForEachItem(meshlist, nthreads, increment);
+    ForEachItem(otherphysicslist, nthreads, increment);
 }
 
 void ChAssembly::IntLoadResidual_F(const unsigned int off,  ///< offset in R residual
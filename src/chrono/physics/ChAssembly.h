@@ -185,6 +185,20 @@ class ChApi ChAssembly : public ChPhysicsItem {
     /// bodies, forces, links, given their current state.
     virtual void Update(bool update_assets = true) override;
 
+    /// Refresh the assets of this assembly and of all contained items.
+    virtual void UpdateAssets() override;
+
+    /// Enable/disable the parallel update mode (default: false).
+    /// If enabled, Update() and the state gather/scatter functions split each list of items
+    /// (bodies, links, meshes, other physics items) in per-thread chunks, using as many
+    /// threads as set with ChSystem::SetParallelThreadNumber(). Items that declare shared
+    /// state (see ChPhysicsItem::SharesState) are still processed serially, after the others.
+    /// Assets are always refreshed serially. Has no effect if Chrono was built without OpenMP.
+    void SetParallelUpdate(bool val) { parallel_update = val; }
+
+    /// Tell if the parallel update mode is enabled.
+    bool GetParallelUpdate() const { return parallel_update; }
+
     /// Set zero speed (and zero accelerations) in state, without changing the position.
     virtual void SetNoSpeedNoAcceleration() override;
 
@@ -282,6 +296,9 @@ class ChApi ChAssembly : public ChPhysicsItem {
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
 
   protected:
+    /// Number of threads used by the parallel update (1 if the parallel update mode is disabled).
+    int GetUpdateThreads() const;
+
     std::vector<std::shared_ptr<ChBody>> bodylist;                 ///< list of rigid bodies
     std::vector<std::shared_ptr<ChLinkBase>> linklist;             ///< list of joints (links)
     std::vector<std::shared_ptr<fea::ChMesh>> meshlist;            ///< list of meshes
@@ -304,6 +321,8 @@ class ChApi ChAssembly : public ChPhysicsItem {
     int ndoc_w_D;       ///< number of scalar constraints D, when using 3 rot. dof. per body (only unilaterals)
     int nbodies_sleep;  ///< number of bodies that are sleeping
     int nbodies_fixed;  ///< number of bodies that are fixed
+
+    bool parallel_update;  ///< process items in parallel in Update() and state gather/scatter
 };
 
 CH_CLASS_VERSION(ChAssembly, 0)
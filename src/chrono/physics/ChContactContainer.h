@@ -17,10 +17,12 @@
 
 #include <list>
 #include <unordered_map>
+#include <vector>
 
 #include "chrono/collision/ChCCollisionInfo.h"
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChContactable.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChMaterialSurface.h"
 
 namespace chrono {
@@ -46,6 +48,14 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     /// Add a contact between two models, storing it into this container.
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) = 0;
 
+    /// Add a batch of contacts, storing them into this container in the order in which they appear in the batch.
+    /// The collision system may use this to merge contacts that were generated in parallel. By default, it simply
+    /// calls AddContact() for each entry.
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& mcontacts) {
+        for (const auto& mcontact : mcontacts)
+            AddContact(mcontact);
+    }
+
     /// The collision system will call EndAddContact() after adding all contacts (for example with AddContact() or
     /// similar).
     virtual void EndAddContact() {}
@@ -135,48 +145,63 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     void SumAllContactForces(std::list<Tcont*>& contactlist,
                              std::unordered_map<ChContactable*, ForceTorque>& contactforces) {
         for (auto contact = contactlist.begin(); contact != contactlist.end(); ++contact) {
-            // Extract information for current contact (expressed in global frame)
-            ChMatrix33<> A = (*contact)->GetContactPlane();
-            ChVector<> force_loc = (*contact)->GetContactForce();
-            ChVector<> force = A.Matr_x_Vect(force_loc);
-            ChVector<> p1 = (*contact)->GetContactP1();
-            ChVector<> p2 = (*contact)->GetContactP2();
-
-            // Calculate contact torque for first object (expressed in global frame).
-            // Recall that -force is applied to the first object.
-            ChVector<> torque1(0);
-            if (ChBody* body = dynamic_cast<ChBody*>((*contact)->GetObjA())) {
-                torque1 = Vcross(p1 - body->GetPos(), -force);
-            }
-
-            // If there is already an entry for the first object, accumulate.
-            // Otherwise, insert a new entry.
-            auto entry1 = contactforces.find((*contact)->GetObjA());
-            if (entry1 != contactforces.end()) {
-                entry1->second.force -= force;
-                entry1->second.torque += torque1;
-            } else {
-                ForceTorque ft{-force, torque1};
-                contactforces.insert(std::make_pair((*contact)->GetObjA(), ft));
-            }
-
-            // Calculate contact torque for second object (expressed in global frame).
-            // Recall that +force is applied to the second object.
-            ChVector<> torque2(0);
-            if (ChBody* body = dynamic_cast<ChBody*>((*contact)->GetObjB())) {
-                torque2 = Vcross(p2 - body->GetPos(), force);
-            }
-
-            // If there is already an entry for the first object, accumulate.
-            // Otherwise, insert a new entry.
-            auto entry2 = contactforces.find((*contact)->GetObjB());
-            if (entry2 != contactforces.end()) {
-                entry2->second.force += force;
-                entry2->second.torque += torque2;
-            } else {
-                ForceTorque ft{force, torque2};
-                contactforces.insert(std::make_pair((*contact)->GetObjB(), ft));
-            }
+            AccumulateContactForce(**contact, contactforces);
+        }
+    }
+
+    /// Same as above, for contacts stored in a ChContactPool.
+    template <class Tcont>
+    void SumAllContactForces(ChContactPool<Tcont>& contactpool,
+                             std::unordered_map<ChContactable*, ForceTorque>& contactforces) {
+        for (size_t i = 0; i < contactpool.size(); ++i) {
+            AccumulateContactForce(contactpool[i], contactforces);
+        }
+    }
+
+    /// Accumulate the force of the given contact (and its torque on the two contactable objects).
+    template <class Tcont>
+    void AccumulateContactForce(Tcont& contact, std::unordered_map<ChContactable*, ForceTorque>& contactforces) {
+        // Extract information for current contact (expressed in global frame)
+        ChMatrix33<> A = contact.GetContactPlane();
+        ChVector<> force_loc = contact.GetContactForce();
+        ChVector<> force = A.Matr_x_Vect(force_loc);
+        ChVector<> p1 = contact.GetContactP1();
+        ChVector<> p2 = contact.GetContactP2();
+
+        // Calculate contact torque for first object (expressed in global frame).
+        // Recall that -force is applied to the first object.
+        ChVector<> torque1(0);
+        if (ChBody* body = dynamic_cast<ChBody*>(contact.GetObjA())) {
+            torque1 = Vcross(p1 - body->GetPos(), -force);
+        }
+
+        // If there is already an entry for the first object, accumulate.
+        // Otherwise, insert a new entry.
+        auto entry1 = contactforces.find(contact.GetObjA());
+        if (entry1 != contactforces.end()) {
+            entry1->second.force -= force;
+            entry1->second.torque += torque1;
+        } else {
+            ForceTorque ft{-force, torque1};
+            contactforces.insert(std::make_pair(contact.GetObjA(), ft));
+        }
+
+        // Calculate contact torque for second object (expressed in global frame).
+        // Recall that +force is applied to the second object.
+        ChVector<> torque2(0);
+        if (ChBody* body = dynamic_cast<ChBody*>(contact.GetObjB())) {
+            torque2 = Vcross(p2 - body->GetPos(), force);
+        }
+
+        // If there is already an entry for the first object, accumulate.
+        // Otherwise, insert a new entry.
+        auto entry2 = contactforces.find(contact.GetObjB());
+        if (entry2 != contactforces.end()) {
+            entry2->second.force += force;
+            entry2->second.torque += torque2;
+        } else {
+            ForceTorque ft{force, torque2};
+            contactforces.insert(std::make_pair(contact.GetObjB(), ft));
         }
     }
 };
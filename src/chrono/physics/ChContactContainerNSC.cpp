@@ -24,32 +24,9 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChContactContainerNSC)
 
-ChContactContainerNSC::ChContactContainerNSC()
-    : n_added_6_6(0),
-      n_added_6_3(0),
-      n_added_3_3(0),
-      n_added_333_3(0),
-      n_added_333_6(0),
-      n_added_333_333(0),
-      n_added_666_3(0),
-      n_added_666_6(0),
-      n_added_666_333(0),
-      n_added_666_666(0),
-      n_added_6_6_rolling(0) {}
-
-ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other) : ChContactContainer(other) {
-    n_added_6_6 = 0;
-    n_added_6_3 = 0;
-    n_added_3_3 = 0;
-    n_added_333_3 = 0;
-    n_added_333_6 = 0;
-    n_added_333_333 = 0;
-    n_added_666_3 = 0;
-    n_added_666_6 = 0;
-    n_added_666_333 = 0;
-    n_added_666_666 = 0;
-    n_added_6_6_rolling = 0;
-}
+ChContactContainerNSC::ChContactContainerNSC() {}
+
+ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other) : ChContactContainer(other) {}
 
 ChContactContainerNSC::~ChContactContainerNSC() {
     RemoveAllContacts();
@@ -60,138 +37,36 @@ void ChContactContainerNSC::Update(double mytime, bool update_assets) {
     ChContactContainer::Update(mytime, update_assets);
 }
 
-template <class Tcont, class Titer>
-void _RemoveAllContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, int& n_added) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        delete (*itercontact);
-        (*itercontact) = 0;
-        ++itercontact;
-    }
-    contactlist.clear();
-    lastcontact = contactlist.begin();
-    n_added = 0;
-}
-
 void ChContactContainerNSC::RemoveAllContacts() {
-    _RemoveAllContacts(contactlist_6_6, lastcontact_6_6, n_added_6_6);
-    _RemoveAllContacts(contactlist_6_3, lastcontact_6_3, n_added_6_3);
-    _RemoveAllContacts(contactlist_3_3, lastcontact_3_3, n_added_3_3);
-    _RemoveAllContacts(contactlist_333_3, lastcontact_333_3, n_added_333_3);
-    _RemoveAllContacts(contactlist_333_6, lastcontact_333_6, n_added_333_6);
-    _RemoveAllContacts(contactlist_333_333, lastcontact_333_333, n_added_333_333);
-    _RemoveAllContacts(contactlist_666_3, lastcontact_666_3, n_added_666_3);
-    _RemoveAllContacts(contactlist_666_6, lastcontact_666_6, n_added_666_6);
-    _RemoveAllContacts(contactlist_666_333, lastcontact_666_333, n_added_666_333);
-    _RemoveAllContacts(contactlist_666_666, lastcontact_666_666, n_added_666_666);
-    _RemoveAllContacts(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling);
+    contactlist_6_6.Clear();
+    contactlist_6_3.Clear();
+    contactlist_3_3.Clear();
+    contactlist_333_3.Clear();
+    contactlist_333_6.Clear();
+    contactlist_333_333.Clear();
+    contactlist_666_3.Clear();
+    contactlist_666_6.Clear();
+    contactlist_666_333.Clear();
+    contactlist_666_666.Clear();
+    contactlist_6_6_rolling.Clear();
 }
 
 void ChContactContainerNSC::BeginAddContact() {
-    lastcontact_6_6 = contactlist_6_6.begin();
-    n_added_6_6 = 0;
-
-    lastcontact_6_3 = contactlist_6_3.begin();
-    n_added_6_3 = 0;
-
-    lastcontact_3_3 = contactlist_3_3.begin();
-    n_added_3_3 = 0;
-
-    lastcontact_333_3 = contactlist_333_3.begin();
-    n_added_333_3 = 0;
-
-    lastcontact_333_6 = contactlist_333_6.begin();
-    n_added_333_6 = 0;
-
-    lastcontact_333_333 = contactlist_333_333.begin();
-    n_added_333_333 = 0;
-
-    lastcontact_666_3 = contactlist_666_3.begin();
-    n_added_666_3 = 0;
-
-    lastcontact_666_6 = contactlist_666_6.begin();
-    n_added_666_6 = 0;
-
-    lastcontact_666_333 = contactlist_666_333.begin();
-    n_added_666_333 = 0;
-
-    lastcontact_666_666 = contactlist_666_666.begin();
-    n_added_666_666 = 0;
-
-    lastcontact_6_6_rolling = contactlist_6_6_rolling.begin();
-    n_added_6_6_rolling = 0;
+    contactlist_6_6.Rewind();
+    contactlist_6_3.Rewind();
+    contactlist_3_3.Rewind();
+    contactlist_333_3.Rewind();
+    contactlist_333_6.Rewind();
+    contactlist_333_333.Rewind();
+    contactlist_666_3.Rewind();
+    contactlist_666_6.Rewind();
+    contactlist_666_333.Rewind();
+    contactlist_666_666.Rewind();
+    contactlist_6_6_rolling.Rewind();
 }
 
 void ChContactContainerNSC::EndAddContact() {
-    // remove contacts that are beyond last contact
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-    while (lastcontact_333_3 != contactlist_333_3.end()) {
-        delete (*lastcontact_333_3);
-        lastcontact_333_3 = contactlist_333_3.erase(lastcontact_333_3);
-    }
-    while (lastcontact_333_6 != contactlist_333_6.end()) {
-        delete (*lastcontact_333_6);
-        lastcontact_333_6 = contactlist_333_6.erase(lastcontact_333_6);
-    }
-    while (lastcontact_333_333 != contactlist_333_333.end()) {
-        delete (*lastcontact_333_333);
-        lastcontact_333_333 = contactlist_333_333.erase(lastcontact_333_333);
-    }
-    while (lastcontact_666_3 != contactlist_666_3.end()) {
-        delete (*lastcontact_666_3);
-        lastcontact_666_3 = contactlist_666_3.erase(lastcontact_666_3);
-    }
-    while (lastcontact_666_6 != contactlist_666_6.end()) {
-        delete (*lastcontact_666_6);
-        lastcontact_666_6 = contactlist_666_6.erase(lastcontact_666_6);
-    }
-    while (lastcontact_666_333 != contactlist_666_333.end()) {
-        delete (*lastcontact_666_333);
-        lastcontact_666_333 = contactlist_666_333.erase(lastcontact_666_333);
-    }
-    while (lastcontact_666_666 != contactlist_666_666.end()) {
-        delete (*lastcontact_666_666);
-        lastcontact_666_666 = contactlist_666_666.erase(lastcontact_666_666);
-    }
-
-    while (lastcontact_6_6_rolling != contactlist_6_6_rolling.end()) {
-        delete (*lastcontact_6_6_rolling);
-        lastcontact_6_6_rolling = contactlist_6_6_rolling.erase(lastcontact_6_6_rolling);
-    }
-}
-
-template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,          ///< contact list
-                           Titer& lastcontact,                      ///< last contact acquired
-                           int& n_added,                            ///< number of contact inserted
-                           ChContactContainer* mcontainer,          ///< contact container
-                           Ta* objA,                                ///< collidable object A
-                           Tb* objB,                                ///< collidable object B
-                           const collision::ChCollisionInfo& cinfo  ///< collision informations
-) {
-    if (lastcontact != contactlist.end()) {
-        // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo);
-        lastcontact++;
-
-    } else {
-        // add new contact
-        Tcont* mc = new Tcont(mcontainer, objA, objB, cinfo);
-        contactlist.push_back(mc);
-        lastcontact = contactlist.end();
-    }
-    n_added++;
+    // Nothing to do: contact objects beyond the last added contact are kept in the pools, to be reused.
 }
 
 void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontact) {
@@ -233,22 +108,22 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 3_3
-                _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
+                contactlist_3_3.Add(this, mmboA, mmboB, mcontact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 3_6 -> 6_3
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
+                contactlist_6_3.Add(this, mmboB, mmboA, swapped_contact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 3_333 -> 333_3
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboB, mmboA, swapped_contact);
+                contactlist_333_3.Add(this, mmboB, mmboA, swapped_contact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 3_666 -> 666_3
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboB, mmboA, swapped_contact);
+                contactlist_666_3.Add(this, mmboB, mmboA, swapped_contact);
             }
         } break;
 
@@ -257,26 +132,26 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 6_3
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
+                contactlist_6_3.Add(this, mmboA, mmboB, mcontact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 6_6    ***NOTE: for body-body one could have rolling friction: ***
                 if ((mmatA->rolling_friction && mmatB->rolling_friction) ||
                     (mmatA->spinning_friction && mmatB->spinning_friction)) {
-                    _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this, mmboA, mmboB, mcontact);
+                    contactlist_6_6_rolling.Add(this, mmboA, mmboB, mcontact);
                 } else {
-                    _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
+                    contactlist_6_6.Add(this, mmboA, mmboB, mcontact);
                 }
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 6_333 -> 333_6
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboB, mmboA, swapped_contact);
+                contactlist_333_6.Add(this, mmboB, mmboA, swapped_contact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 6_666 -> 666_6
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboB, mmboA, swapped_contact);
+                contactlist_666_6.Add(this, mmboB, mmboA, swapped_contact);
             }
         } break;
 
@@ -285,20 +160,20 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 333_3
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboA, mmboB, mcontact);
+                contactlist_333_3.Add(this, mmboA, mmboB, mcontact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 333_6
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboA, mmboB, mcontact);
+                contactlist_333_6.Add(this, mmboA, mmboB, mcontact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 333_333
-                _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, mmboA, mmboB, mcontact);
+                contactlist_333_333.Add(this, mmboA, mmboB, mcontact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 333_666 -> 666_333
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboB, mmboA, swapped_contact);
+                contactlist_666_333.Add(this, mmboB, mmboA, swapped_contact);
             }
         } break;
 
@@ -307,19 +182,19 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 666_3
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboA, mmboB, mcontact);
+                contactlist_666_3.Add(this, mmboA, mmboB, mcontact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 666_6
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboA, mmboB, mcontact);
+                contactlist_666_6.Add(this, mmboA, mmboB, mcontact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 666_333
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboA, mmboB, mcontact);
+                contactlist_666_333.Add(this, mmboA, mmboB, mcontact);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 666_666
-                _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, mmboA, mmboB, mcontact);
+                contactlist_666_666.Add(this, mmboA, mmboB, mcontact);
             }
         } break;
 
@@ -360,31 +235,29 @@ ChVector<> ChContactContainerNSC::GetContactableTorque(ChContactable* contactabl
 }
 
 template <class Tcont>
-void _ReportAllContacts(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
+void _ReportAllContacts(ChContactPool<Tcont>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        Tcont& contact = contactlist[i];
         bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), VNULL, (*itercontact)->GetObjA(), (*itercontact)->GetObjB());
+            contact.GetContactP1(), contact.GetContactP2(), contact.GetContactPlane(),
+            contact.GetContactDistance(), contact.GetEffectiveCurvatureRadius(),
+            contact.GetContactForce(), VNULL, contact.GetObjA(), contact.GetObjB());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
 template <class Tcont>
-void _ReportAllContactsRolling(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
+void _ReportAllContactsRolling(ChContactPool<Tcont>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        Tcont& contact = contactlist[i];
         bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), (*itercontact)->GetContactTorque(), (*itercontact)->GetObjA(),
-            (*itercontact)->GetObjB());
+            contact.GetContactP1(), contact.GetContactP2(), contact.GetContactPlane(),
+            contact.GetContactDistance(), contact.GetEffectiveCurvatureRadius(),
+            contact.GetContactForce(), contact.GetContactTorque(), contact.GetObjA(),
+            contact.GetObjB());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
@@ -406,15 +279,13 @@ void ChContactContainerNSC::ReportAllContacts(ReportContactCallback* mcallback)
 
 template <class Tcont>
 void _IntStateGatherReactions(unsigned int& coffset,
-                              std::list<Tcont*>& contactlist,
+                              ChContactPool<Tcont>& contactlist,
                               const unsigned int off_L,
                               ChVectorDynamic<>& L,
                               const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntStateGatherReactions(off_L + coffset, L);
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].ContIntStateGatherReactions(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -435,15 +306,13 @@ void ChContactContainerNSC::IntStateGatherReactions(const unsigned int off_L, Ch
 
 template <class Tcont>
 void _IntStateScatterReactions(unsigned int& coffset,
-                               std::list<Tcont*>& contactlist,
+                               ChContactPool<Tcont>& contactlist,
                                const unsigned int off_L,
                                const ChVectorDynamic<>& L,
                                const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntStateScatterReactions(off_L + coffset, L);
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].ContIntStateScatterReactions(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -464,18 +333,16 @@ void ChContactContainerNSC::IntStateScatterReactions(const unsigned int off_L, c
 
 template <class Tcont>
 void _IntLoadResidual_CqL(unsigned int& coffset,           ///< offset of the contacts
-                          std::list<Tcont*>& contactlist,  ///< list of contacts
+                          ChContactPool<Tcont>& contactlist,  ///< list of contacts
                           const unsigned int off_L,        ///< offset in L multipliers
                           ChVectorDynamic<>& R,            ///< result: the R residual, R += c*Cq'*L
                           const ChVectorDynamic<>& L,      ///< the L vector
                           const double c,                  ///< a scaling factor
                           const int stride                 ///< stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -499,7 +366,7 @@ void ChContactContainerNSC::IntLoadResidual_CqL(const unsigned int off_L,
 
 template <class Tcont>
 void _IntLoadConstraint_C(unsigned int& coffset,           ///< contact offset
-                          std::list<Tcont*>& contactlist,  ///< contact list
+                          ChContactPool<Tcont>& contactlist,  ///< contact list
                           const unsigned int off,          ///< offset in Qc residual
                           ChVectorDynamic<>& Qc,           ///< result: the Qc residual, Qc += c*C
                           const double c,                  ///< a scaling factor
@@ -507,11 +374,9 @@ void _IntLoadConstraint_C(unsigned int& coffset,           ///< contact offset
                           double recovery_clamp,           ///< value for min/max clamping of c*C
                           const int stride                 ///< stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -536,7 +401,7 @@ void ChContactContainerNSC::IntLoadConstraint_C(const unsigned int off,
 
 template <class Tcont>
 void _IntToDescriptor(unsigned int& coffset,
-                      std::list<Tcont*>& contactlist,
+                      ChContactPool<Tcont>& contactlist,
                       const unsigned int off_v,
                       const ChStateDelta& v,
                       const ChVectorDynamic<>& R,
@@ -544,11 +409,9 @@ void _IntToDescriptor(unsigned int& coffset,
                       const ChVectorDynamic<>& L,
                       const ChVectorDynamic<>& Qc,
                       const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntToDescriptor(off_L + coffset, L, Qc);
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].ContIntToDescriptor(off_L + coffset, L, Qc);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -574,17 +437,15 @@ void ChContactContainerNSC::IntToDescriptor(const unsigned int off_v,
 
 template <class Tcont>
 void _IntFromDescriptor(unsigned int& coffset,
-                        std::list<Tcont*>& contactlist,
+                        ChContactPool<Tcont>& contactlist,
                         const unsigned int off_v,
                         ChStateDelta& v,
                         const unsigned int off_L,
                         ChVectorDynamic<>& L,
                         const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntFromDescriptor(off_L + coffset, L);
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].ContIntFromDescriptor(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -609,11 +470,9 @@ void ChContactContainerNSC::IntFromDescriptor(const unsigned int off_v,
 // SOLVER INTERFACES
 
 template <class Tcont>
-void _InjectConstraints(std::list<Tcont*>& contactlist, ChSystemDescriptor& mdescriptor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->InjectConstraints(mdescriptor);
-        ++itercontact;
+void _InjectConstraints(ChContactPool<Tcont>& contactlist, ChSystemDescriptor& mdescriptor) {
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].InjectConstraints(mdescriptor);
     }
 }
 
@@ -632,11 +491,9 @@ void ChContactContainerNSC::InjectConstraints(ChSystemDescriptor& mdescriptor) {
 }
 
 template <class Tcont>
-void _ConstraintsBiReset(std::list<Tcont*>& contactlist) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsBiReset();
-        ++itercontact;
+void _ConstraintsBiReset(ChContactPool<Tcont>& contactlist) {
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].ConstraintsBiReset();
     }
 }
 
@@ -655,11 +512,9 @@ void ChContactContainerNSC::ConstraintsBiReset() {
 }
 
 template <class Tcont>
-void _ConstraintsBiLoad_C(std::list<Tcont*>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
-        ++itercontact;
+void _ConstraintsBiLoad_C(ChContactPool<Tcont>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
     }
 }
 
@@ -682,12 +537,10 @@ void ChContactContainerNSC::ConstraintsLoadJacobians() {
 }
 
 template <class Tcont>
-void _ConstraintsFetch_react(std::list<Tcont*>& contactlist, double factor) {
+void _ConstraintsFetch_react(ChContactPool<Tcont>& contactlist, double factor) {
     // From constraints to react vector:
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsFetch_react(factor);
-        ++itercontact;
+    for (size_t i = 0; i < contactlist.size(); ++i) {
+        contactlist[i].ConstraintsFetch_react(factor);
     }
 }
 
@@ -0,0 +1,96 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_CONTACT_POOL_H
+#define CH_CONTACT_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "chrono/collision/ChCCollisionInfo.h"
+
+namespace chrono {
+
+// Forward references
+class ChContactContainer;
+
+/// Pool of contact objects of a given type, stored by value in contiguous chunks.
+/// A slot is constructed in place the first time it is used; at the following collision detection
+/// passes it is recycled through the Reset() function of the contact, so that no allocation takes
+/// place once the pool has reached its peak size. Slots are never moved (growing the pool only adds
+/// new chunks), so that pointers to the contact constraints, as stored in the system descriptor,
+/// remain valid.
+/// Tcont is assumed to be derived from ChContactTuple.
+template <class Tcont>
+class ChContactPool {
+  public:
+    ChContactPool() : n_active(0), n_constructed(0) {}
+    ~ChContactPool() { Clear(); }
+
+    /// Number of contacts added since the last call to Rewind().
+    size_t size() const { return n_active; }
+
+    /// Number of contact objects constructed so far (including those not currently in use).
+    size_t capacity() const { return n_constructed; }
+
+    /// Access the i-th active contact.
+    Tcont& operator[](size_t i) { return chunks[i >> chunk_bits][i & chunk_mask]; }
+    const Tcont& operator[](size_t i) const { return chunks[i >> chunk_bits][i & chunk_mask]; }
+
+    /// Mark all contacts as unused. Contact objects are kept, to be recycled by the following calls to Add().
+    void Rewind() { n_active = 0; }
+
+    /// Add a contact, reusing the first unused contact object if any.
+    template <class Ta, class Tb>
+    void Add(ChContactContainer* container,             ///< contact container
+             Ta* objA,                                  ///< collidable object A
+             Tb* objB,                                  ///< collidable object B
+             const collision::ChCollisionInfo& cinfo    ///< collision information
+             ) {
+        if (n_active < n_constructed) {
+            (*this)[n_active].Reset(objA, objB, cinfo);
+        } else {
+            if (n_constructed == (chunks.size() << chunk_bits))
+                chunks.push_back(static_cast<Tcont*>(::operator new(sizeof(Tcont) << chunk_bits)));
+            new (&(*this)[n_constructed]) Tcont(container, objA, objB, cinfo);
+            n_constructed++;
+        }
+        n_active++;
+    }
+
+    /// Destroy all contact objects and release the memory.
+    void Clear() {
+        for (size_t i = 0; i < n_constructed; ++i)
+            (*this)[i].~Tcont();
+        for (auto chunk : chunks)
+            ::operator delete(chunk);
+        chunks.clear();
+        n_active = 0;
+        n_constructed = 0;
+    }
+
+  private:
+    ChContactPool(const ChContactPool&) = delete;
+    ChContactPool& operator=(const ChContactPool&) = delete;
+
+    static const size_t chunk_bits = 8;                            ///< 256 contacts per chunk
+    static const size_t chunk_mask = (size_t(1) << chunk_bits) - 1;
+
+    std::vector<Tcont*> chunks;  ///< storage, in chunks of 2^chunk_bits contacts
+    size_t n_active;             ///< number of contacts in use
+    size_t n_constructed;        ///< number of constructed contact objects
+};
+
+}  // end namespace chrono
+
+#endif
@@ -17,6 +17,7 @@
 ////    out until support for unique_ptr is implemented in ChArchive.
 
 #include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystem.h"
 
 namespace chrono {
 
@@ -329,6 +330,10 @@ void ChLinkLock::BuildLink() {
         Cqw1 = nullptr;
         Cqw2 = nullptr;
     }
+
+    // the constraints injected in the system descriptor may have changed
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChLinkLock::BuildLink(ChLinkMask* new_mask) {
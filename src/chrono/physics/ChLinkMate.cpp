@@ -110,6 +110,10 @@ void ChLinkMateGeneric::ChangedLinkMask() {
     ndoc = mask->GetMaskDoc();
     ndoc_c = mask->GetMaskDoc_c();
     ndoc_d = mask->GetMaskDoc_d();
+
+    // the constraints injected in the system descriptor may have changed
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChLinkMateGeneric::SetDisabled(bool mdis) {
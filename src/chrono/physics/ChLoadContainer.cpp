@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/physics/ChLoadContainer.h"
+#include "chrono/physics/ChSystem.h"
 
 namespace chrono {
 
@@ -30,6 +31,10 @@ void ChLoadContainer::Add(std::shared_ptr<ChLoadBase> newload) {
     //assert(std::find<std::vector<std::shared_ptr<ChLoadBase>>::iterator>(loadlist.begin(), loadlist.end(), newload)
     ///== loadlist.end());
     loadlist.push_back(newload);
+
+    // the stiffness blocks injected in the system descriptor may have changed
+    if (system)
+        system->InvalidateDescriptor();
 }
 
 void ChLoadContainer::Update(double mytime, bool update_assets) {
@@ -41,12 +41,16 @@ class ChApi ChLoadContainer : public ChPhysicsItem {
     void Add(std::shared_ptr<ChLoadBase> newload);
 
     /// Direct access to the load vector, for iterating etc.
+    /// If loads are added or removed through this vector, ChSystem::InvalidateDescriptor() must be called.
     std::vector<std::shared_ptr<ChLoadBase> >& GetLoadList() { return loadlist; }
 
     virtual void Setup() override {}
 
     virtual void Update(double mytime, bool update_assets = true) override;
 
+    /// Loads are evaluated on loadables owned by other items, so the container is always updated serially.
+    virtual bool SharesState() const override { return true; }
+
     virtual void IntLoadResidual_F(const unsigned int off,  ///< offset in R residual
                                    ChVectorDynamic<>& R,    ///< result: the R residual, R += c*F
                                    const double c           ///< a scaling factor
@@ -67,10 +67,13 @@ void ChPhysicsItem::GetCenter(ChVector<>& mcenter) {
 void ChPhysicsItem::Update(double mytime, bool update_assets) {
     ChTime = mytime;
 
-    if (update_assets) {
-        for (unsigned int ia = 0; ia < assets.size(); ++ia)
-            assets[ia]->Update(this, GetAssetsFrame().GetCoord());
-    }
+    if (update_assets)
+        UpdateAssets();
+}
+
+void ChPhysicsItem::UpdateAssets() {
+    for (unsigned int ia = 0; ia < assets.size(); ++ia)
+        assets[ia]->Update(this, GetAssetsFrame().GetCoord());
 }
 
 void ChPhysicsItem::ArchiveOUT(ChArchiveOut& marchive) {
@@ -152,6 +152,19 @@ class ChApi ChPhysicsItem : public ChObj {
     /// data. By default, calls Update(mytime) using item's current time.
     virtual void Update(bool update_assets = true) { Update(ChTime, update_assets); }
 
+    /// Update the asset tree of this item, if any, using the current assets frame.
+    /// This is called by the base Update() when update_assets is true; it is also
+    /// used by ChAssembly to refresh assets serially after a parallel update pass.
+    virtual void UpdateAssets();
+
+    /// Tell if Update() and the state gather/scatter functions of this item modify data
+    /// owned by other items (for example bodies or markers that it does not own, or the
+    /// lists of the parent assembly), or read the state of other items of the same list
+    /// (for example the shafts connected by a shaft couple). Such items are always processed
+    /// serially, after the others, even when the parent assembly runs in parallel update mode
+    /// (see ChAssembly::SetParallelUpdate). By default, items are assumed to be independent.
+    virtual bool SharesState() const { return false; }
+
     /// Set zero speed (and zero accelerations) in state, without changing the position.
     /// Child classes should implement this function if GetDOF() > 0.
     /// It is used by owner ChSystem for some static analysis.
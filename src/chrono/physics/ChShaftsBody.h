@@ -124,6 +124,9 @@ class ChApi ChShaftsBody : public ChPhysicsItem {
     /// Update all auxiliary data of the gear transmission at given time
     virtual void Update(double mytime, bool update_assets = true) override;
 
+    /// Reads the state of the connected shaft and body, hence it is never updated concurrently with them.
+    virtual bool SharesState() const override { return true; }
+
     //
     // SERIALIZATION
     //
@@ -247,6 +250,9 @@ class ChApi ChShaftsBodyTranslation : public ChPhysicsItem {
     /// Update all auxiliary data of the gear transmission at given time
     virtual void Update(double mytime, bool update_assets = true) override;
 
+    /// Reads the state of the connected shaft and body, hence it is never updated concurrently with them.
+    virtual bool SharesState() const override { return true; }
+
     //
     // SERIALIZATION
     //
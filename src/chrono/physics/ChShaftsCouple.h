@@ -39,6 +39,9 @@ class ChApi ChShaftsCouple : public ChPhysicsItem {
     /// Get the number of scalar variables affected by constraints in this link
     virtual int GetNumCoords() { return 2; }
 
+    /// The couple reads the state of the two shafts, so it is always updated serially, after them.
+    virtual bool SharesState() const override { return true; }
+
     /// Use this function after gear creation, to initialize it, given two shafts to join.
     /// Each shaft must belong to the same ChSystem.
     /// Derived classes might overload this (here, basically it only sets the two pointers)
@@ -167,6 +167,9 @@ class ChApi ChShaftsGearboxAngled : public ChPhysicsItem {
     /// Update all auxiliary data of the gear transmission at given time
     virtual void Update(double mytime, bool update_assets = true) override;
 
+    /// Reads the state of the connected shafts and body, hence it is never updated concurrently with them.
+    virtual bool SharesState() const override { return true; }
+
     //
     // SERIALIZATION
     //
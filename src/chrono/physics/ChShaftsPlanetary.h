@@ -201,6 +201,9 @@ class ChApi ChShaftsPlanetary : public ChPhysicsItem {
     /// Update all auxiliary data of the gear transmission at given time
     virtual void Update(double mytime, bool update_assets = true) override;
 
+    /// Reads the state of the three connected shafts, hence it is never updated concurrently with them.
+    virtual bool SharesState() const override { return true; }
+
     //
     // SERIALIZATION
     //
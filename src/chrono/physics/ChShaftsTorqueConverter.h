@@ -124,6 +124,9 @@ class ChApi ChShaftsTorqueConverter : public ChPhysicsItem {
     /// Update all auxiliary data of the gear transmission at given time
     virtual void Update(double mytime, bool update_assets = true) override;
 
+    /// Reads the state of the connected shafts, hence it is never updated concurrently with them.
+    virtual bool SharesState() const override { return true; }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) override;
 
@@ -13,6 +13,8 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 #include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
@@ -26,7 +28,9 @@
 #include "chrono/solver/ChSolverPCG.h"
 #include "chrono/solver/ChSolverPMINRES.h"
 #include "chrono/solver/ChSolverSOR.h"
+#include "chrono/solver/ChSolverSORcolored.h"
 #include "chrono/solver/ChSolverSORmultithread.h"
+#include "chrono/solver/ChSolverSparseLDL.h"
 #include "chrono/solver/ChSolverSymmSOR.h"
 #include "chrono/timestepper/ChStaticAnalysis.h"
 #include "chrono/core/ChLinkedListMatrix.h"
@@ -46,9 +50,13 @@ ChSystem::ChSystem()
       step(0.04),
       step_min(0.002),
       step_max(0.04),
+      step_min_set(false),
+      step_max_set(false),
       tol(2e-4),
       tol_force(1e-3),
       maxiter(6),
+      incremental_descriptor(true),
+      descriptor_valid(false),
       max_iter_solver_speed(30),
       max_iter_solver_stab(10),
       ncontacts(0),
@@ -65,6 +73,9 @@ ChSystem::ChSystem()
     // Required by ChAssembly
     system = this;
 
+    assembly_signature.fill(0);
+    descriptor_signature.fill(0);
+
     // Set default number of threads to be equal to number of available cores
     parallel_thread_number = CHOMPfunctions::GetNumProcs();
 
@@ -80,11 +91,16 @@ ChSystem::ChSystem(const ChSystem& other) : ChAssembly(other) {
     // Required by ChAssembly
     system = this;
 
+    assembly_signature.fill(0);
+    descriptor_signature.fill(0);
+
     G_acc = other.G_acc;
     end_time = other.end_time;
     step = other.step;
     step_min = other.step_min;
     step_max = other.step_max;
+    step_min_set = other.step_min_set;
+    step_max_set = other.step_max_set;
     stepcount = other.stepcount;
     solvecount = other.solvecount;
     setupcount = other.setupcount;
@@ -101,6 +117,8 @@ ChSystem::ChSystem(const ChSystem& other) : ChAssembly(other) {
     SetSolverType(GetSolverType());
     parallel_thread_number = other.parallel_thread_number;
     use_sleeping = other.use_sleeping;
+    incremental_descriptor = other.incremental_descriptor;
+    descriptor_valid = false;
 
     ncontacts = other.ncontacts;
 
@@ -121,6 +139,9 @@ ChSystem::~ChSystem() {
 
     RemoveAllProbes();
     RemoveAllControls();
+
+    // The base ChAssembly destructor must not notify this system anymore
+    system = nullptr;
 }
 
 void ChSystem::Clear() {
@@ -164,6 +185,10 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
             solver_speed = std::make_shared<ChSolverSORmultithread>("speedSolver", parallel_thread_number);
             solver_stab = std::make_shared<ChSolverSORmultithread>("posSolver", parallel_thread_number);
             break;
+        case ChSolver::Type::SOR_COLORED:
+            solver_speed = std::make_shared<ChSolverSORcolored>();
+            solver_stab = std::make_shared<ChSolverSORcolored>();
+            break;
         case ChSolver::Type::PMINRES:
             solver_speed = std::make_shared<ChSolverPMINRES>();
             solver_stab = std::make_shared<ChSolverPMINRES>();
@@ -184,6 +209,10 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
             solver_speed = std::make_shared<ChSolverMINRES>();
             solver_stab = std::make_shared<ChSolverMINRES>();
             break;
+        case ChSolver::Type::SPARSE_LDL:
+            solver_speed = std::make_shared<ChSolverSparseLDL>();
+            solver_stab = std::make_shared<ChSolverSparseLDL>();
+            break;
         default:
             solver_speed = std::make_shared<ChSolverSymmSOR>();
             solver_stab = std::make_shared<ChSolverSymmSOR>();
@@ -282,6 +311,7 @@ void ChSystem::SetParallelThreadNumber(int mthreads) {
 void ChSystem::SetSystemDescriptor(std::shared_ptr<ChSystemDescriptor> newdescriptor) {
     assert(newdescriptor);
     descriptor = newdescriptor;
+    descriptor_valid = false;
 }
 void ChSystem::SetSolver(std::shared_ptr<ChSolver> newsolver) {
     assert(newsolver);
@@ -619,13 +649,42 @@ bool ChSystem::ManageSleepingBodies() {
 // -----------------------------------------------------------------------------
 
 void ChSystem::DescriptorPrepareInject(ChSystemDescriptor& mdescriptor) {
-    mdescriptor.BeginInsertion();  // This resets the vectors of constr. and var. pointers.
+    auto& vconstraints = mdescriptor.GetConstraintsList();
+    auto& vvariables = mdescriptor.GetVariablesList();
+    auto& vstiffness = mdescriptor.GetKblocksList();
+
+    // The items of bodies, links, meshes, etc. can be kept if the model did not change since they were injected in
+    // this descriptor, and if the descriptor was not modified elsewhere in the meantime.
+    bool incremental = incremental_descriptor && descriptor_valid && &mdescriptor == descriptor.get() &&
+                       assembly_signature == descriptor_signature && vconstraints.size() == descriptor_sizes[0] &&
+                       vvariables.size() == descriptor_sizes[1] && vstiffness.size() == descriptor_sizes[2];
+
+    if (incremental) {
+        // Only the contact container is injected again.
+        mdescriptor.ResumeInsertion(descriptor_nconstraints, descriptor_nvariables, descriptor_nkblocks);
+    } else {
+        mdescriptor.BeginInsertion();  // This resets the vectors of constr. and var. pointers.
+
+        ChAssembly::InjectConstraints(mdescriptor);
+        ChAssembly::InjectVariables(mdescriptor);
+        ChAssembly::InjectKRMmatrices(mdescriptor);
+
+        descriptor_nconstraints = vconstraints.size();
+        descriptor_nvariables = vvariables.size();
+        descriptor_nkblocks = vstiffness.size();
+        descriptor_signature = assembly_signature;
+        descriptor_valid = (&mdescriptor == descriptor.get());
+    }
 
-    InjectConstraints(mdescriptor);
-    InjectVariables(mdescriptor);
-    InjectKRMmatrices(mdescriptor);
+    contact_container->InjectConstraints(mdescriptor);
+    contact_container->InjectVariables(mdescriptor);
+    contact_container->InjectKRMmatrices(mdescriptor);
 
     mdescriptor.EndInsertion();
+
+    descriptor_sizes[0] = vconstraints.size();
+    descriptor_sizes[1] = vvariables.size();
+    descriptor_sizes[2] = vstiffness.size();
 }
 
 // -----------------------------------------------------------------------------
@@ -643,6 +702,9 @@ void ChSystem::Setup() {
     // inherit the parent class (compute offsets of bodies, links, etc.)
     ChAssembly::Setup();
 
+    // a change of these counts requires a full rebuild of the system descriptor
+    assembly_signature = {{nbodies, nlinks, nmeshes, nphysicsitems, ncoords_w, ndoc_w}};
+
     // also compute offsets for contact container
     {
         contact_container->SetOffset_L(offset_L + ndoc_w);
@@ -1116,6 +1178,15 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
         // For ChVariable objects without a ChKblock, just use the 'a' coefficient
         descriptor->SetMassFactor(c_a);
 
+        // Jacobians may have changed: repack them if the descriptor uses assembled products
+        descriptor->InvalidateAssembledShurProduct();
+
+        timer_jacobian.stop();
+    } else {
+        // The constraint Jacobians are also used when loading the Cq'*L term of the residual: keep them current
+        // even if the factorized matrix is reused (modified Newton).
+        timer_jacobian.start();
+        ConstraintsLoadJacobians();
         timer_jacobian.stop();
     }
 
@@ -1256,6 +1327,15 @@ double ChSystem::ComputeCollisions() {
     // Perform the collision detection ( broadphase and narrowphase )
     collision_system->Run();
 
+    // Report contacts and proximities
+    ReportCollisions();
+
+    timer_collision.stop();
+
+    return mretC;
+}
+
+void ChSystem::ReportCollisions() {
     // Report and store contacts and/or proximities, if there are some
     // containers in the physic system. The default contact container
     // for ChBody and ChParticles is used always.
@@ -1283,10 +1363,6 @@ double ChSystem::ComputeCollisions() {
 
     // Count the contacts of body-body type.
     ncontacts = contact_container->GetNcontacts();
-
-    timer_collision.stop();
-
-    return mretC;
 }
 
 // =============================================================================
@@ -1430,9 +1506,8 @@ bool ChSystem::Integrate_Y() {
     // some body that is not in sleep state.
     ManageSleepingBodies();
 
-    // Prepare lists of variables and constraints.
+    // Prepare lists of variables and constraints (this also updates counts and offsets).
     DescriptorPrepareInject(*descriptor);
-    descriptor->UpdateCountsAndOffsets();
 
     // Set some settings in timestepper object
     timestepper->SetQcDoClamp(true);
@@ -1440,6 +1515,10 @@ bool ChSystem::Integrate_Y() {
     if (std::dynamic_pointer_cast<ChTimestepperHHT>(timestepper) ||
         std::dynamic_pointer_cast<ChTimestepperNewmark>(timestepper))
         timestepper->SetQcDoClamp(false);
+    auto implicit = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(timestepper);
+    if (implicit && implicit->GetErrorControl() && (step_min_set || step_max_set))
+        implicit->SetStepSizeLimits(step_min_set ? step_min : implicit->GetStepSizeMin(),
+                                    step_max_set ? step_max : implicit->GetStepSizeMax());
 
     // PERFORM TIME STEP HERE!
     {
@@ -1680,6 +1759,7 @@ bool ChSystem::DoEntireDynamics() {
     // automatically by Integrate()
 
     while (ChTime < end_time) {
+        AdaptStepSize();
         if (!Integrate_Y())
             break;  // >>> 1- single integration step,
                     //        updating Y, from t to t+dt.
@@ -1721,6 +1801,8 @@ bool ChSystem::DoFrameDynamics(double m_endtime) {
         if (left_time < 1e-12)
             break;  // - no integration if backward or null frame step.
 
+        AdaptStepSize();
+
         if (left_time < (1.3 * step))  // - step changed if too little frame step
         {
             old_step = step;
@@ -1746,6 +1828,17 @@ bool ChSystem::DoFrameDynamics(double m_endtime) {
     return true;
 }
 
+// If the timestepper controls the local error, take the step size it proposes
+// (within the step_min and step_max limits) for the next integration step.
+void ChSystem::AdaptStepSize() {
+    auto implicit = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(timestepper);
+    if (!implicit || !implicit->GetErrorControl())
+        return;
+    double h = implicit->GetStepSize();
+    if (h > 0)
+        step = ChClamp(h, step_min, step_max);
+}
+
 // Performs the dynamical simulation, but using "frame integration"
 // iteratively. The results are provided only at each frame (evenly
 // spaced by "frame_step") rather than at each "step" (steps can be much
@@ -1834,6 +1927,163 @@ bool ChSystem::DoFullAssembly() {
     return last_err;
 }
 
+// -----------------------------------------------------------------------------
+//  SNAPSHOTS
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const char snapshot_magic[8] = {'C', 'H', 'S', 'N', 'A', 'P', '\0', '\0'};
+const uint32_t snapshot_version = 1;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t num_coords_x;   // size of the position state
+    uint64_t num_coords_v;   // size of the velocity and acceleration states
+    uint64_t num_constr;     // number of reactions (including contacts)
+    uint64_t num_stepper;    // number of internal timestepper values
+    uint64_t num_collision;  // size in bytes of the collision system data
+    uint64_t stepcount;
+    double time;
+};
+
+template <typename T>
+void AppendData(std::vector<char>& buffer, const T* data, size_t count) {
+    const char* bytes = reinterpret_cast<const char*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+}
+
+template <typename T>
+const char* ExtractData(const char* src, T* data, size_t count) {
+    if (count > 0)
+        std::memcpy(data, src, count * sizeof(T));
+    return src + count * sizeof(T);
+}
+
+}  // end anonymous namespace
+
+void ChSystem::WriteSnapshot(std::vector<char>& buffer) {
+    Setup();
+
+    ChState x(GetNcoords_x(), this);
+    ChStateDelta v(GetNcoords_v(), this);
+    ChStateDelta a(GetNcoords_v(), this);
+    ChVectorDynamic<> L(GetNconstr());
+    double T;
+    StateGather(x, v, T);
+    StateGatherAcceleration(a);
+    StateGatherReactions(L);
+
+    // The state vectors do not capture bit for bit the internal representation of all quantities
+    // (e.g., body angular velocities are stored as quaternion derivatives). Re-apply the gathered
+    // state, so that this system and any system restored from the snapshot continue from identical data.
+    // For the same reason, reload the constraint Jacobians at this configuration (some timesteppers
+    // use the Jacobians left over from the previous step).
+    StateScatter(x, v, T);
+    StateScatterAcceleration(a);
+    StateScatterReactions(L);
+    ConstraintsLoadJacobians();
+
+    std::vector<double> stepper_state;
+    timestepper->GetInternalState(stepper_state);
+
+    std::vector<char> collision_data;
+    collision_system->WriteContactCache(collision_data);
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+    header.version = snapshot_version;
+    header.reserved = 0;
+    header.num_coords_x = x.GetRows();
+    header.num_coords_v = v.GetRows();
+    header.num_constr = L.GetRows();
+    header.num_stepper = stepper_state.size();
+    header.num_collision = collision_data.size();
+    header.stepcount = stepcount;
+    header.time = T;
+
+    buffer.clear();
+    buffer.reserve(sizeof(header) +
+                   sizeof(double) * (header.num_coords_x + 2 * header.num_coords_v + header.num_constr +
+                                     header.num_stepper) +
+                   header.num_collision);
+    AppendData(buffer, &header, 1);
+    AppendData(buffer, x.GetAddress(), x.GetRows());
+    AppendData(buffer, v.GetAddress(), v.GetRows());
+    AppendData(buffer, a.GetAddress(), a.GetRows());
+    AppendData(buffer, L.GetAddress(), L.GetRows());
+    AppendData(buffer, stepper_state.data(), stepper_state.size());
+    AppendData(buffer, collision_data.data(), collision_data.size());
+}
+
+// The collision detection is run at the restored configuration to recreate the
+// broadphase pairs and the contact manifolds, which are then overwritten with the
+// saved ones. Contacts are reported from the restored manifolds, after which the
+// manifolds are restored once more, to undo the point refresh done while reporting.
+bool ChSystem::ReadSnapshot(const std::vector<char>& buffer) {
+    SnapshotHeader header;
+    if (buffer.size() < sizeof(header))
+        return false;
+    const char* src = ExtractData(buffer.data(), &header, 1);
+
+    if (std::memcmp(header.magic, snapshot_magic, sizeof(header.magic)) != 0 || header.version != snapshot_version)
+        return false;
+    if (buffer.size() != sizeof(header) +
+                             sizeof(double) * (header.num_coords_x + 2 * header.num_coords_v + header.num_constr +
+                                               header.num_stepper) +
+                             header.num_collision)
+        return false;
+
+    Setup();
+    if (header.num_coords_x != (uint64_t)GetNcoords_x() || header.num_coords_v != (uint64_t)GetNcoords_v())
+        return false;
+
+    ChState x((int)header.num_coords_x, this);
+    ChStateDelta v((int)header.num_coords_v, this);
+    ChStateDelta a((int)header.num_coords_v, this);
+    ChVectorDynamic<> L((int)header.num_constr);
+    std::vector<double> stepper_state(header.num_stepper);
+    src = ExtractData(src, x.GetAddress(), x.GetRows());
+    src = ExtractData(src, v.GetAddress(), v.GetRows());
+    src = ExtractData(src, a.GetAddress(), a.GetRows());
+    src = ExtractData(src, L.GetAddress(), L.GetRows());
+    src = ExtractData(src, stepper_state.data(), stepper_state.size());
+    const char* collision_data = src;
+    size_t collision_size = (size_t)header.num_collision;
+
+    // Validate the contact cache before modifying the system
+    if (!collision_system->CheckContactCache(collision_data, collision_size))
+        return false;
+
+    // Integrable state
+    StateScatter(x, v, header.time);
+    StateScatterAcceleration(a);
+    stepcount = (size_t)header.stepcount;
+    timestepper->SetInternalState(stepper_state);
+
+    // Collision state and contacts
+    SyncCollisionModels();
+    collision_system->Run();
+    collision_system->ReadContactCache(collision_data, collision_size);
+    ReportCollisions();
+
+    // Reactions. If the restored contacts do not match the saved ones, the contact
+    // reactions are those cached in the contact manifolds.
+    Setup();
+    if (GetNconstr() == L.GetRows())
+        StateScatterReactions(L);
+    else
+        ChAssembly::IntStateScatterReactions(0, L);
+    ConstraintsLoadJacobians();
+    contact_container->ComputeContactForces();
+
+    collision_system->ReadContactCache(collision_data, collision_size);
+
+    return true;
+}
+
 // -----------------------------------------------------------------------------
 //  STREAMING - FILE HANDLING
 
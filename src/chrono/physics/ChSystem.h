@@ -15,6 +15,7 @@
 #ifndef CHSYSTEM_H
 #define CHSYSTEM_H
 
+#include <array>
 #include <cfloat>
 #include <memory>
 #include <cstdlib>
@@ -100,18 +101,27 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
 
     /// Sets the lower limit for time step (only needed if using
     /// integration methods which support time step adaption).
+    /// With a timestepper using local error control (see ChImplicitIterativeTimestepper::SetErrorControl),
+    /// a value set here is also the smallest step size taken by the timestepper; otherwise the timestepper
+    /// keeps its own limit.
     void SetStepMin(double m_step_min) {
-        if (m_step_min > 0.)
+        if (m_step_min > 0.) {
             step_min = m_step_min;
+            step_min_set = true;
+        }
     }
     /// Gets the lower limit for time step
     double GetStepMin() const { return step_min; }
 
     /// Sets the upper limit for time step (only needed if using
     /// integration methods which support time step adaption).
+    /// With a timestepper using local error control, this is the largest step size taken by DoFrameDynamics
+    /// and DoEntireDynamics; a value set here is also the largest step size taken by the timestepper.
     void SetStepMax(double m_step_max) {
-        if (m_step_max > step_min)
+        if (m_step_max > step_min) {
             step_max = m_step_max;
+            step_max_set = true;
+        }
     }
     /// Gets the upper limit for time step
     double GetStepMax() const { return step_max; }
@@ -255,9 +265,26 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// Access directly the 'system descriptor'.
     std::shared_ptr<ChSystemDescriptor> GetSystemDescriptor() { return descriptor; }
 
+    /// Enable/disable the incremental update of the system descriptor (default: enabled).
+    /// If enabled, the variables, constraints, and stiffness blocks of bodies, links, meshes, and other physics items
+    /// are injected in the system descriptor only when the model changes (items added or removed, link masks changed,
+    /// number of active bodies or constraints changed); at the other steps, only those of the contact container are
+    /// injected again. If disabled, the system descriptor is rebuilt from scratch at each step.
+    void SetIncrementalDescriptor(bool val) { incremental_descriptor = val; }
+
+    /// Return true if the incremental update of the system descriptor is enabled.
+    bool GetIncrementalDescriptor() const { return incremental_descriptor; }
+
+    /// Force a full rebuild of the system descriptor at the next step.
+    /// Items added to or removed from the system (and from its meshes and sub-assemblies) do this automatically;
+    /// this function is needed only by custom physics items which change the ChVariables, ChConstraint, or ChKblock
+    /// objects they inject without changing their number of DOFs or constraints.
+    void InvalidateDescriptor() { descriptor_valid = false; }
+
     /// Changes the number of parallel threads (by default is n.of cores).
     /// Note that not all solvers use parallel computation.
     /// If you have a N-core processor, this should be set at least =N for maximum performance.
+    /// This is also the number of threads used by the parallel update mode, see ChAssembly::SetParallelUpdate().
     void SetParallelThreadNumber(int mthreads = 2);
     /// Get the number of parallel threads.
     /// Note that not all solvers use parallel computation.
@@ -360,6 +387,8 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
   protected:
     /// Pushes all ChConstraints and ChVariables contained in links, bodies, etc.
     /// into the system descriptor.
+    /// With incremental updates (see SetIncrementalDescriptor), if the model did not change since the last call, only
+    /// the items of the contact container are pushed again.
     virtual void DescriptorPrepareInject(ChSystemDescriptor& mdescriptor);
 
   public:
@@ -627,6 +656,14 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// Depending on the integration type, it switches to one of the following:
     virtual bool Integrate_Y();
 
+    /// If the timestepper uses local error control, set the current step to the
+    /// step size it proposes, limited to [step_min, step_max].
+    void AdaptStepSize();
+
+    /// Report the contacts and proximities found by the last collision detection to the
+    /// contact and proximity containers, and invoke the custom collision callbacks.
+    void ReportCollisions();
+
   public:
     // ---- DYNAMICS
 
@@ -652,6 +689,8 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// time is reached, repeating many steps (maybe the step size
     /// will be automatically changed if the integrator method supports
     /// step size adaption).
+    /// If the timestepper uses local error control, each step has the size proposed by the timestepper
+    /// (see AdaptStepSize); collision detection is performed once per step.
     bool DoEntireDynamics();
 
     /// Like "DoEntireDynamics", but results are provided at uniform
@@ -772,6 +811,28 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// before coming to the precise static solution.
     bool DoStaticRelaxing(int nsteps = 10);
 
+    // ---- SNAPSHOTS
+
+    /// Write a binary snapshot of the current system state to the given buffer.
+    /// The snapshot contains the time, the state vectors (positions, velocities, accelerations), the
+    /// reactions, the internal state of the timestepper (if any), and the contact cache of the
+    /// collision system (persistent contact manifolds, with the reactions used for warm starting).
+    /// Model data (bodies, links, materials, solver settings, etc.) is not included: a snapshot can only
+    /// be restored into an identically built system. Internal states not exposed through the state
+    /// vectors (e.g., plasticity data of FEA elements) are also not included.
+    /// Note that this is not a read-only operation: the gathered state is scattered back into the system
+    /// and the constraint Jacobians are reloaded at the current configuration, so that the writer and any
+    /// system restored from the snapshot continue from identical data. As a consequence, writing a snapshot
+    /// can perturb (at round-off level) the trajectory of this system with respect to a run without snapshots.
+    void WriteSnapshot(std::vector<char>& buffer);
+
+    /// Restore the system state from a snapshot created with WriteSnapshot.
+    /// The system must have been built identically to the one that produced the snapshot (same items,
+    /// added in the same order). Simulation then continues exactly as it would have from the saved
+    /// state. Return false (leaving the system state unchanged) if the snapshot is invalid or does not match
+    /// this system.
+    bool ReadSnapshot(const std::vector<char>& buffer);
+
     //
     // SERIALIZATION
     //
@@ -799,10 +860,12 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
 
     ChVector<> G_acc;  ///< gravitational acceleration
 
-    double end_time;  ///< end of simulation
-    double step;      ///< time step
-    double step_min;  ///< min time step
-    double step_max;  ///< max time step
+    double end_time;    ///< end of simulation
+    double step;        ///< time step
+    double step_min;    ///< min time step
+    double step_max;    ///< max time step
+    bool step_min_set;  ///< was step_min set explicitly? (then it is forwarded to the timestepper)
+    bool step_max_set;  ///< was step_max set explicitly? (then it is forwarded to the timestepper)
 
     double tol;        ///< tolerance
     double tol_force;  ///< tolerance for forces (used to obtain a tolerance for impulses)
@@ -812,6 +875,14 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     bool use_sleeping;  ///< if true, put to sleep objects that come to rest
 
     std::shared_ptr<ChSystemDescriptor> descriptor;  ///< the system descriptor
+    bool incremental_descriptor;                     ///< update the system descriptor incrementally?
+    bool descriptor_valid;                           ///< are the assembly items in the descriptor up to date?
+    std::array<int, 6> assembly_signature;           ///< counts of the assembly items, at the last Setup()
+    std::array<int, 6> descriptor_signature;         ///< counts of the assembly items, at the last full injection
+    size_t descriptor_nconstraints;                  ///< number of ChConstraint objects of the assembly items
+    size_t descriptor_nvariables;                    ///< number of ChVariables objects of the assembly items
+    size_t descriptor_nkblocks;                      ///< number of ChKblock objects of the assembly items
+    size_t descriptor_sizes[3];                      ///< total sizes of the descriptor lists, at the last injection
     std::shared_ptr<ChSolver> solver_speed;          ///< the solver for speed problem
     std::shared_ptr<ChSolver> solver_stab;           ///< the solver for position (stabilization) problem, if any
 
@@ -18,6 +18,7 @@
 #include <vector>
 #include <list>
 #include <typeinfo>
+#include <type_traits>
 #include <unordered_set>
 #include <memory>
 #include <algorithm>
@@ -746,6 +747,47 @@ private:
 };
 
 
+//
+// Traits for the bulk transfer of arrays
+//
+
+/// Traits of the types whose arrays can be transferred as contiguous blocks of numbers, by archives that
+/// support it (see ChArchiveOut::out_array_bulk). Specialized for the numeric types double, float, and int,
+/// and for fixed-size aggregates of numbers (e.g. ChVector), stored as 'components' consecutive numbers
+/// of type 'scalar'. Aggregates whose ArchiveOUT writes a class version set 'versioned' and give the class
+/// used for the version in 'version_class': the bulk transfer then writes (reads) that version before the
+/// block, exactly where the element-by-element transfer would, so that the byte layout of the two paths is
+/// the same.
+template <class T>
+struct ChArchiveBulkTraits {
+    static const bool value = false;
+};
+
+template <>
+struct ChArchiveBulkTraits<double> {
+    static const bool value = true;
+    typedef double scalar;
+    static const size_t components = 1;
+    static const bool versioned = false;
+};
+
+template <>
+struct ChArchiveBulkTraits<float> {
+    static const bool value = true;
+    typedef float scalar;
+    static const size_t components = 1;
+    static const bool versioned = false;
+};
+
+template <>
+struct ChArchiveBulkTraits<int> {
+    static const bool value = true;
+    typedef int scalar;
+    static const size_t components = 1;
+    static const bool versioned = false;
+};
+
+
 ///
 /// This is a base class for archives with pointers to shared objects 
 ///
@@ -893,6 +935,56 @@ class  ChArchiveOut : public ChArchive {
       virtual void out_array_between (ChValue& bVal, size_t msize) = 0;
       virtual void out_array_end (ChValue& bVal, size_t msize) = 0;
 
+        // for arrays of numbers: write all 'msize' numbers at once, between out_array_pre and out_array_end.
+        // Return false if not supported by the archive (default), in which case the caller must write
+        // the elements one by one.
+      virtual bool out_array_bulk (ChValue& bVal, const double* data, size_t msize) { return false; }
+      virtual bool out_array_bulk (ChValue& bVal, const float* data, size_t msize) { return false; }
+      virtual bool out_array_bulk (ChValue& bVal, const int* data, size_t msize) { return false; }
+
+        // return true if the out_array_bulk functions above are implemented by the archive
+      virtual bool has_array_bulk () const { return false; }
+
+        // for arrays of other types: bulk transfer if the type has ChArchiveBulkTraits, otherwise return false.
+        // Here 'msize' is the number of array elements.
+      template<class T>
+      bool out_array_bulk (ChValue& bVal, const T* data, size_t msize) {
+          return this->out_array_bulk_impl(bVal, data, msize, std::integral_constant<bool, ChArchiveBulkTraits<T>::value>());
+      }
+
+  private:
+      template<class T>
+      bool out_array_bulk_impl (ChValue& bVal, const T* data, size_t msize, std::true_type) {
+          return this->out_array_bulk_versioned(bVal, data, msize, std::integral_constant<bool, ChArchiveBulkTraits<T>::versioned>());
+      }
+      template<class T>
+      bool out_array_bulk_impl (ChValue& bVal, const T* data, size_t msize, std::false_type) {
+          return false;
+      }
+      template<class T>
+      bool out_array_bulk_versioned (ChValue& bVal, const T* data, size_t msize, std::false_type) {
+          typedef typename ChArchiveBulkTraits<T>::scalar scalar_type;
+          return this->out_array_bulk(bVal, reinterpret_cast<const scalar_type*>(data),
+                                      msize * ChArchiveBulkTraits<T>::components);
+      }
+      template<class T>
+      bool out_array_bulk_versioned (ChValue& bVal, const T* data, size_t msize, std::true_type) {
+          // the element-by-element path writes the class version in the first element only if versions are
+          // clustered: otherwise there is one version per element and the array cannot be sent as a block
+          if (!this->has_array_bulk() || (use_versions && !cluster_class_versions))
+              return false;
+          if (msize > 0)
+              this->VersionWrite<typename ChArchiveBulkTraits<T>::version_class>();
+          return this->out_array_bulk_versioned(bVal, data, msize, std::false_type());
+      }
+
+      // vector<bool> has no contiguous storage (and no bulk traits)
+      template<class T>
+      static const T* vector_data(const std::vector<T>& vec) { return vec.data(); }
+      static const bool* vector_data(const std::vector<bool>& vec) { return nullptr; }
+
+  public:
+
 
       //---------------------------------------------------
 
@@ -909,7 +1001,8 @@ class  ChArchiveOut : public ChArchive {
           size_t arraysize = sizeof(bVal.value())/sizeof(T);
           ChValueSpecific<T[N]> specVal(bVal.value(), bVal.name(), bVal.flags());
           this->out_array_pre( specVal, arraysize);
-          for (size_t i = 0; i<arraysize; ++i)
+          bool bulk = this->out_array_bulk(specVal, bVal.value(), arraysize);
+          for (size_t i = 0; !bulk && i<arraysize; ++i)
           {
               char buffer[20];
               sprintf(buffer, "%lu", (unsigned long)i);
@@ -925,7 +1018,8 @@ class  ChArchiveOut : public ChArchive {
       void out     (ChNameValue< std::vector<T> > bVal) {
           ChValueSpecific< std::vector<T> > specVal(bVal.value(), bVal.name(), bVal.flags());
           this->out_array_pre( specVal, bVal.value().size());
-          for (size_t i = 0; i<bVal.value().size(); ++i)
+          bool bulk = this->out_array_bulk(specVal, vector_data(bVal.value()), bVal.value().size());
+          for (size_t i = 0; !bulk && i<bVal.value().size(); ++i)
           {
               char buffer[20];
               sprintf(buffer, "%lu", (unsigned long)i);
@@ -1204,6 +1298,55 @@ class  ChArchiveIn : public ChArchive {
       virtual void in_array_between (const char* name) = 0;
       virtual void in_array_end (const char* name) = 0;
 
+        // for arrays of numbers: read all 'msize' numbers at once, between in_array_pre and in_array_end.
+        // Return false if not supported by the archive (default), in which case the caller must read
+        // the elements one by one.
+      virtual bool in_array_bulk (const char* name, double* data, size_t msize) { return false; }
+      virtual bool in_array_bulk (const char* name, float* data, size_t msize) { return false; }
+      virtual bool in_array_bulk (const char* name, int* data, size_t msize) { return false; }
+
+        // return true if the in_array_bulk functions above are implemented by the archive
+      virtual bool has_array_bulk () const { return false; }
+
+        // for arrays of other types: bulk transfer if the type has ChArchiveBulkTraits, otherwise return false.
+        // Here 'msize' is the number of array elements.
+      template<class T>
+      bool in_array_bulk (const char* name, T* data, size_t msize) {
+          return this->in_array_bulk_impl(name, data, msize, std::integral_constant<bool, ChArchiveBulkTraits<T>::value>());
+      }
+
+  private:
+      template<class T>
+      bool in_array_bulk_impl (const char* name, T* data, size_t msize, std::true_type) {
+          return this->in_array_bulk_versioned(name, data, msize, std::integral_constant<bool, ChArchiveBulkTraits<T>::versioned>());
+      }
+      template<class T>
+      bool in_array_bulk_impl (const char* name, T* data, size_t msize, std::false_type) {
+          return false;
+      }
+      template<class T>
+      bool in_array_bulk_versioned (const char* name, T* data, size_t msize, std::false_type) {
+          typedef typename ChArchiveBulkTraits<T>::scalar scalar_type;
+          return this->in_array_bulk(name, reinterpret_cast<scalar_type*>(data),
+                                     msize * ChArchiveBulkTraits<T>::components);
+      }
+      template<class T>
+      bool in_array_bulk_versioned (const char* name, T* data, size_t msize, std::true_type) {
+          // same conditions as in ChArchiveOut::out_array_bulk
+          if (!this->has_array_bulk() || (use_versions && !cluster_class_versions))
+              return false;
+          if (msize > 0)
+              this->VersionRead<typename ChArchiveBulkTraits<T>::version_class>();
+          return this->in_array_bulk_versioned(name, data, msize, std::false_type());
+      }
+
+      // vector<bool> has no contiguous storage (and no bulk traits)
+      template<class T>
+      static T* vector_data(std::vector<T>& vec) { return vec.data(); }
+      static bool* vector_data(std::vector<bool>& vec) { return nullptr; }
+
+  public:
+
       //---------------------------------------------------
 
            // trick to wrap enum mappers:
@@ -1219,7 +1362,8 @@ class  ChArchiveIn : public ChArchive {
           size_t arraysize;
           this->in_array_pre(bVal.name(), arraysize);
           if (arraysize != sizeof(bVal.value())/sizeof(T) ) {throw (ChExceptionArchive( "Size of [] saved array does not match size of receiver array " + std::string(bVal.name()) + "."));}
-          for (size_t i = 0; i<arraysize; ++i)
+          bool bulk = this->in_array_bulk(bVal.name(), bVal.value(), arraysize);
+          for (size_t i = 0; !bulk && i<arraysize; ++i)
           {
               char idname[20];
               sprintf(idname, "%lu", (unsigned long)i);
@@ -1239,7 +1383,8 @@ class  ChArchiveIn : public ChArchive {
           size_t arraysize;
           this->in_array_pre(bVal.name(), arraysize);
           bVal.value().resize(arraysize);
-          for (size_t i = 0; i<arraysize; ++i)
+          bool bulk = this->in_array_bulk(bVal.name(), vector_data(bVal.value()), arraysize);
+          for (size_t i = 0; !bulk && i<arraysize; ++i)
           {
               char idname[20];
               sprintf(idname, "%lu", (unsigned long)i);
@@ -71,6 +71,24 @@ class  ChArchiveOutBinary : public ChArchiveOut {
       virtual void out_array_between (ChValue& bVal, size_t msize) {}
       virtual void out_array_end (ChValue& bVal, size_t msize) {}
 
+        // arrays of numbers (and of ChVector, ChQuaternion) are written as single blocks. The byte layout is
+        // the same as element by element, class versions included, so archives written with or without the
+        // bulk transfer can be read by both.
+      virtual bool has_array_bulk () const { return true; }
+      virtual bool out_array_bulk (ChValue& bVal, const double* data, size_t msize) {
+            ostream->WriteArray(data, msize);
+            return true;
+      }
+      virtual bool out_array_bulk (ChValue& bVal, const float* data, size_t msize) {
+            ostream->WriteArray(data, msize);
+            return true;
+      }
+      virtual bool out_array_bulk (ChValue& bVal, const int* data, size_t msize) {
+            ostream->WriteArray(data, msize);
+            return true;
+      }
+      using ChArchiveOut::out_array_bulk;
+
 
         // for custom c++ objects:
       virtual void out     (ChValue& bVal, bool tracked, size_t obj_ID) {
@@ -163,6 +181,22 @@ class  ChArchiveInBinary : public ChArchiveIn {
       virtual void in_array_between (const char* name) {}
       virtual void in_array_end (const char* name) {}
 
+        // arrays of numbers (and of ChVector, ChQuaternion) are read as single blocks
+      virtual bool has_array_bulk () const { return true; }
+      virtual bool in_array_bulk (const char* name, double* data, size_t msize) {
+            istream->ReadArray(data, msize);
+            return true;
+      }
+      virtual bool in_array_bulk (const char* name, float* data, size_t msize) {
+            istream->ReadArray(data, msize);
+            return true;
+      }
+      virtual bool in_array_bulk (const char* name, int* data, size_t msize) {
+            istream->ReadArray(data, msize);
+            return true;
+      }
+      using ChArchiveIn::in_array_bulk;
+
         //  for custom c++ objects:
       virtual void in     (ChNameValue<ChFunctorArchiveIn> bVal) {
           if (bVal.flags() & NVP_TRACK_OBJECT){
@@ -22,6 +22,9 @@
 
 namespace chrono {
 
+// Forward references
+class ChVariables;
+
 /// Modes for constraint
 enum eChConstraintMode {
     CONSTRAINT_FREE = 0,        ///< the constraint does not enforce anything
@@ -298,6 +301,11 @@ class ChApi ChConstraint {
     /// Same as Build_Cq, but puts the _transposed_ jacobian row as a column.
     virtual void Build_CqT(ChSparseMatrix& storage, int inscol) = 0;
 
+    /// Append to 'vars' the variables objects referenced by this constraint.
+    /// Used by solvers that need to know which constraints share variables (e.g. for graph coloring).
+    /// Return false if the constraint does not provide this information (default).
+    virtual bool GetConstrainedVariables(std::vector<ChVariables*>& vars) const { return false; }
+
     /// Set offset in global q vector (set automatically by ChSystemDescriptor)
     void SetOffset(int moff) { offset = moff; }
 
@@ -65,6 +65,12 @@ class ChApi ChConstraintNgeneric : public ChConstraint {
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(std::vector<ChVariables*> mvars);
 
+    /// Append all the constrained variables objects to 'vars'.
+    virtual bool GetConstrainedVariables(std::vector<ChVariables*>& vars) const override {
+        vars.insert(vars.end(), variables.begin(), variables.end());
+        return true;
+    }
+
 	/// This function updates the following auxiliary data:
 	///  - the Eq  matrices
 	///  - the g_i product
@@ -123,6 +123,13 @@ class ChConstraintTwoTuples : public ChConstraint {
         tuple_a.Build_CqT(storage, inscol);
         tuple_b.Build_CqT(storage, inscol);
     }
+
+    /// Append the variables objects of both tuples to 'vars'.
+    virtual bool GetConstrainedVariables(std::vector<ChVariables*>& vars) const override {
+        tuple_a.GetConstrainedVariables(vars);
+        tuple_b.GetConstrainedVariables(vars);
+        return true;
+    }
 };
 
 }  // end namespace chrono
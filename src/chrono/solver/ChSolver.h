@@ -47,6 +47,8 @@ class ChApi ChSolver {
           APGD,
           MINRES,
           SOLVER_SMC,
+          SOR_COLORED,
+          SPARSE_LDL,
           CUSTOM,
       };
 
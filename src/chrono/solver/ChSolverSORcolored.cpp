@@ -0,0 +1,340 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/solver/ChSolverSORcolored.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChSolverSORcolored)
+
+// Maximum number of colors (one bit per color in the per-variable masks)
+static const int max_colors = 64;
+
+bool ChSolverSORcolored::CollectBlocks(std::vector<ChConstraint*>& mconstraints) {
+    constraints = mconstraints;
+
+    std::vector<int> new_block_start;
+    std::vector<int> new_block_vars_start;
+    std::vector<ChVariables*> new_block_vars;
+    new_block_start.reserve(block_start.size());
+    new_block_vars_start.reserve(block_vars_start.size());
+    new_block_vars.reserve(block_vars.size());
+
+    std::vector<ChVariables*> cvars;
+    int nconstr = (int)constraints.size();
+    int ic = 0;
+    while (ic < nconstr) {
+        // The three multipliers of a frictional contact (n,u,v) are kept in the same block
+        int size = 1;
+        if (constraints[ic]->GetMode() == CONSTRAINT_FRIC && ic + 2 < nconstr &&
+            constraints[ic + 1]->GetMode() == CONSTRAINT_FRIC && constraints[ic + 2]->GetMode() == CONSTRAINT_FRIC)
+            size = 3;
+
+        new_block_start.push_back(ic);
+        new_block_vars_start.push_back((int)new_block_vars.size());
+
+        bool known = true;
+        cvars.clear();
+        for (int k = 0; k < size; k++)
+            known = known && constraints[ic + k]->GetConstrainedVariables(cvars);
+
+        if (known) {
+            // Only active variables are modified by Increment_q(), the others do not create dependencies
+            for (auto var : cvars) {
+                if (var && var->IsActive() &&
+                    std::find(new_block_vars.begin() + new_block_vars_start.back(), new_block_vars.end(), var) ==
+                        new_block_vars.end())
+                    new_block_vars.push_back(var);
+            }
+        } else {
+            new_block_vars.push_back(nullptr);
+        }
+
+        ic += size;
+    }
+    new_block_start.push_back(nconstr);
+    new_block_vars_start.push_back((int)new_block_vars.size());
+
+    bool unchanged = (new_block_start == block_start && new_block_vars_start == block_vars_start &&
+                      new_block_vars == block_vars);
+
+    block_start.swap(new_block_start);
+    block_vars_start.swap(new_block_vars_start);
+    block_vars.swap(new_block_vars);
+
+    return unchanged;
+}
+
+void ChSolverSORcolored::ColorBlocks() {
+    int nblocks = (int)block_start.size() - 1;
+
+    std::unordered_map<ChVariables*, uint64_t> var_colors;
+    std::vector<int> block_color(nblocks, -1);
+    std::vector<int> color_count(max_colors, 0);
+    serial_blocks.clear();
+
+    for (int ib = 0; ib < nblocks; ib++) {
+        int from = block_vars_start[ib];
+        int to = block_vars_start[ib + 1];
+
+        if (from < to && block_vars[from] == nullptr) {
+            serial_blocks.push_back(ib);
+            continue;
+        }
+
+        // Colors already used by blocks sharing a variable with this one
+        uint64_t used = 0;
+        for (int iv = from; iv < to; iv++)
+            used |= var_colors[block_vars[iv]];
+
+        if (used == ~uint64_t(0)) {
+            serial_blocks.push_back(ib);
+            continue;
+        }
+
+        int color = 0;
+        while (used & (uint64_t(1) << color))
+            color++;
+
+        for (int iv = from; iv < to; iv++)
+            var_colors[block_vars[iv]] |= (uint64_t(1) << color);
+
+        block_color[ib] = color;
+        color_count[color]++;
+    }
+
+    int num_colors = 0;
+    for (int c = 0; c < max_colors; c++)
+        if (color_count[c] > 0)
+            num_colors = c + 1;
+
+    // Sort blocks by color, preserving their original order within each color
+    color_start.assign(num_colors + 1, 0);
+    for (int c = 0; c < num_colors; c++)
+        color_start[c + 1] = color_start[c] + color_count[c];
+
+    color_blocks.resize(color_start[num_colors]);
+    std::vector<int> fill(color_start.begin(), color_start.end() - 1);
+    for (int ib = 0; ib < nblocks; ib++) {
+        if (block_color[ib] >= 0)
+            color_blocks[fill[block_color[ib]]++] = ib;
+    }
+
+    num_colorings++;
+}
+
+void ChSolverSORcolored::ProcessBlock(int block, double& maxviolation, double& maxdeltalambda) {
+    int ic = block_start[block];
+    int size = block_start[block + 1] - ic;
+    ChConstraint* constr = constraints[ic];
+
+    // skip computations if constraint not active.
+    if (!constr->IsActive())
+        return;
+
+    if (size == 3) {
+        // Frictional contact: the N normal component will take care of N,U,V
+        double old_lambda_friction[3];
+        double mresidual_n = 0;
+        for (int k = 0; k < 3; k++) {
+            ChConstraint* c = constraints[ic + k];
+            // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+            double mresidual = c->Compute_Cq_q() + c->Get_b_i() + c->Get_cfm_i() * c->Get_l_i();
+            if (k == 0)
+                mresidual_n = mresidual;
+
+            // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+            double deltal = (omega / c->Get_g_i()) * (-mresidual);
+
+            // update:   lambda += delta_lambda;
+            old_lambda_friction[k] = c->Get_l_i();
+            c->Set_l_i(old_lambda_friction[k] + deltal);
+        }
+
+        constraints[ic]->Project();
+        double new_lambda[3];
+        for (int k = 0; k < 3; k++)
+            new_lambda[k] = constraints[ic + k]->Get_l_i();
+
+        // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+        if (shlambda != 1.0) {
+            for (int k = 0; k < 3; k++) {
+                new_lambda[k] = shlambda * new_lambda[k] + (1.0 - shlambda) * old_lambda_friction[k];
+                constraints[ic + k]->Set_l_i(new_lambda[k]);
+            }
+        }
+
+        for (int k = 0; k < 3; k++) {
+            double true_delta = new_lambda[k] - old_lambda_friction[k];
+            constraints[ic + k]->Increment_q(true_delta);
+            maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta));
+        }
+
+        maxviolation = ChMax(maxviolation, fabs(ChMin(0.0, mresidual_n)));
+        return;
+    }
+
+    // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+    double mresidual = constr->Compute_Cq_q() + constr->Get_b_i() + constr->Get_cfm_i() * constr->Get_l_i();
+
+    // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+    double candidate_violation = fabs(constr->Violation(mresidual));
+
+    // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+    double deltal = (omega / constr->Get_g_i()) * (-mresidual);
+
+    // update:   lambda += delta_lambda;
+    double old_lambda = constr->Get_l_i();
+    constr->Set_l_i(old_lambda + deltal);
+
+    // If new lagrangian multiplier does not satisfy inequalities, project
+    // it into an admissible orthant (or, in general, onto an admissible set)
+    constr->Project();
+
+    // After projection, the lambda may have changed a bit..
+    double new_lambda = constr->Get_l_i();
+
+    // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+    if (shlambda != 1.0) {
+        new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda;
+        constr->Set_l_i(new_lambda);
+    }
+
+    double true_delta = new_lambda - old_lambda;
+
+    // For all items with variables, add the effect of incremented
+    // (and projected) lagrangian reactions:
+    constr->Increment_q(true_delta);
+
+    maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta));
+    maxviolation = ChMax(maxviolation, candidate_violation);
+}
+
+double ChSolverSORcolored::Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                                 ) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+
+    ChTaskScheduler& scheduler = ChTaskScheduler::GetInstance();
+
+    tot_iterations = 0;
+    double maxviolation = 0.;
+    double maxdeltalambda = 0.;
+
+    // 0)  Update the coloring of the constraint graph, if the topology changed
+    if (!CollectBlocks(mconstraints) || num_colorings == 0)
+        ColorBlocks();
+
+    int nblocks = (int)block_start.size() - 1;
+    int num_colors = GetNumColors();
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+    //     Average all g_i for the triplet of contact constraints n,u,v.
+    scheduler.ParallelFor(0, nblocks, 0, [&](int from, int to) {
+        for (int ib = from; ib < to; ib++) {
+            int ic = block_start[ib];
+            int size = block_start[ib + 1] - ic;
+            for (int k = 0; k < size; k++)
+                constraints[ic + k]->Update_auxiliary();
+            if (size == 3) {
+                double average_g_i =
+                    (constraints[ic]->Get_g_i() + constraints[ic + 1]->Get_g_i() + constraints[ic + 2]->Get_g_i()) /
+                    3.0;
+                for (int k = 0; k < 3; k++)
+                    constraints[ic + k]->Set_g_i(average_g_i);
+            }
+        }
+    });
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+    scheduler.ParallelFor(0, (int)mvariables.size(), 0, [&](int from, int to) {
+        for (int iv = from; iv < to; iv++) {
+            if (mvariables[iv]->IsActive())
+                mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
+        }
+    });
+
+    // 3)  For all items with variables, add the effect of initial (guessed)
+    //     lagrangian reactions of constraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    if (warm_start) {
+        auto warm_start_block = [&](int ib) {
+            for (int ic = block_start[ib]; ic < block_start[ib + 1]; ic++)
+                if (constraints[ic]->IsActive())
+                    constraints[ic]->Increment_q(constraints[ic]->Get_l_i());
+        };
+        for (int c = 0; c < num_colors; c++) {
+            scheduler.ParallelFor(color_start[c], color_start[c + 1], 0, [&](int from, int to) {
+                for (int k = from; k < to; k++)
+                    warm_start_block(color_blocks[k]);
+            });
+        }
+        for (auto ib : serial_blocks)
+            warm_start_block(ib);
+    } else {
+        scheduler.ParallelFor(0, (int)constraints.size(), 0, [&](int from, int to) {
+            for (int ic = from; ic < to; ic++)
+                constraints[ic]->Set_l_i(0.);
+        });
+    }
+
+    // 4)  Perform the iteration loops, sweeping one color at a time
+    //
+    typedef std::pair<double, double> Maxima;  // max violation, max delta lambda
+    auto max_reduce = [](const Maxima& a, const Maxima& b) {
+        return Maxima(ChMax(a.first, b.first), ChMax(a.second, b.second));
+    };
+
+    for (int iter = 0; iter < max_iterations; iter++) {
+        Maxima maxima(0, 0);
+
+        for (int c = 0; c < num_colors; c++) {
+            Maxima color_maxima = scheduler.ParallelReduce(color_start[c], color_start[c + 1], 0, Maxima(0, 0),
+                                                           [&](int from, int to, Maxima m) {
+                                                               for (int k = from; k < to; k++)
+                                                                   ProcessBlock(color_blocks[k], m.first, m.second);
+                                                               return m;
+                                                           },
+                                                           max_reduce);
+            maxima = max_reduce(maxima, color_maxima);
+        }
+
+        for (auto ib : serial_blocks)
+            ProcessBlock(ib, maxima.first, maxima.second);
+
+        maxviolation = maxima.first;
+        maxdeltalambda = maxima.second;
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        tot_iterations++;
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < tolerance)
+            break;
+    }
+
+    return maxviolation;
+}
+
+}  // end namespace chrono
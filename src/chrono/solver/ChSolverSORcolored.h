@@ -0,0 +1,84 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSOLVERSORCOLORED_H
+#define CHSOLVERSORCOLORED_H
+
+#include <vector>
+
+#include "chrono/solver/ChIterativeSolver.h"
+
+namespace chrono {
+
+/// An iterative solver based on projective fixed point method, with overrelaxation
+/// and immediate variable update as in SOR methods. Multi-threaded, lock-free.\n
+/// The constraints are partitioned in colors, such that constraints with the same color do not share any
+/// (active) variables object. At each iteration, colors are processed one after the other, and the constraints
+/// of a color are processed in parallel on the process-wide ChTaskScheduler. This is a Gauss-Seidel sweep
+/// as in ChSolverSOR, with the constraints reordered by color; the result does not depend on the number of
+/// threads.\n
+/// The coloring is cached and recomputed only when the variables referenced by the constraints change.
+/// Constraints that do not implement ChConstraint::GetConstrainedVariables(), as well as the few that cannot
+/// be assigned one of the first 64 colors, are processed serially after all colors.\n
+/// See ChSystemDescriptor for more information about the problem formulation and the data structures
+/// passed to the solver.
+
+class ChApi ChSolverSORcolored : public ChIterativeSolver {
+  public:
+    ChSolverSORcolored(int mmax_iters = 50,       ///< max.number of iterations
+                       bool mwarm_start = false,  ///< uses warm start?
+                       double mtolerance = 0.0,   ///< tolerance for termination criterion
+                       double momega = 1.0        ///< overrelaxation criterion
+                       )
+        : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega), num_colorings(0) {}
+
+    virtual ~ChSolverSORcolored() {}
+
+    virtual Type GetType() const override { return Type::SOR_COLORED; }
+
+    /// Performs the solution of the problem.
+    /// \return  the maximum constraint violation after termination.
+    virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                         ) override;
+
+    /// Return the number of colors in the current coloring (not counting the serial group).
+    int GetNumColors() const { return color_start.empty() ? 0 : (int)color_start.size() - 1; }
+
+    /// Return the number of times the coloring was (re)computed.
+    int GetNumColorings() const { return num_colorings; }
+
+  private:
+    /// Collect the blocks of constraints (single constraints or contact triplets) and their active variables.
+    /// Return true if these are the same as at the previous call.
+    bool CollectBlocks(std::vector<ChConstraint*>& mconstraints);
+
+    /// Greedy coloring of the blocks.
+    void ColorBlocks();
+
+    /// Perform one SOR update for the given block of constraints; update the max violation and max delta lambda.
+    void ProcessBlock(int block, double& maxviolation, double& maxdeltalambda);
+
+    std::vector<ChConstraint*> constraints;  ///< constraints, as in the system descriptor
+    std::vector<int> block_start;            ///< first constraint of each block (plus end marker)
+    std::vector<int> block_vars_start;       ///< first entry in block_vars for each block (plus end marker)
+    std::vector<ChVariables*> block_vars;    ///< active variables of each block (nullptr: unknown)
+
+    std::vector<int> color_start;    ///< start of each color in color_blocks (plus end marker)
+    std::vector<int> color_blocks;   ///< block indices, sorted by color
+    std::vector<int> serial_blocks;  ///< blocks processed serially after all colors
+
+    int num_colorings;
+};
+
+}  // end namespace chrono
+
+#endif
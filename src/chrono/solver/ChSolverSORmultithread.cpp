@@ -12,9 +12,11 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
-#include <cstdio>
+#include <algorithm>
+#include <mutex>
+#include <utility>
 
-#include "chrono/parallel/ChThreadsSync.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
 #include "chrono/solver/ChConstraintTwoTuplesRollingN.h"
 #include "chrono/solver/ChConstraintTwoTuplesRollingT.h"
@@ -25,257 +27,145 @@ namespace chrono {
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChSolverSORmultithread)
 
-// Each thread will own an instance of the following data:
-
-struct thread_data {
-    ChSolverSORmultithread* solver;  // reference to solver
-    ChMutexSpinlock* mutex;          // this will be used to avoid race condition when writing to shared memory.
-
-    enum solver_stage { STAGE1_PREPARE = 0, STAGE2_ADDFORCES, STAGE3_LOOPCONSTRAINTS };
-
-    solver_stage stage;
-
-    // the range of scanned multipliers (for loops on multipliers)
-    unsigned int constr_from;
-    unsigned int constr_to;
-
-    // the range of scanned 'variables' objects (for loops on variables, aka rigid bodies)
-    unsigned int var_from;
-    unsigned int var_to;
-
-    std::vector<ChConstraint*>* mconstraints;
-    std::vector<ChVariables*>* mvariables;
-};
-
-// Don't create local store memory, just return 0
-
-void* SolverMemoryFunc() {
-    return 0;
+// Split the constraints in contiguous blocks of about 'size' multipliers, without separating
+// the multipliers of a contact (three, or six in case of rolling friction).
+static void SplitConstraints(std::vector<ChConstraint*>& mconstraints,
+                             unsigned int size,
+                             std::vector<unsigned int>& block_start) {
+    unsigned int nconstr = (unsigned int)mconstraints.size();
+    block_start.clear();
+    for (unsigned int ic = 0; ic < nconstr;) {
+        block_start.push_back(ic);
+        unsigned int to = std::min(ic + size, nconstr);
+        if (to < nconstr && dynamic_cast<ChConstraintTwoTuplesFrictionTall*>(mconstraints[to]))
+            to++;
+        if (to < nconstr && dynamic_cast<ChConstraintTwoTuplesFrictionTall*>(mconstraints[to]))
+            to++;
+        if (to < nconstr && dynamic_cast<ChConstraintTwoTuplesRollingNall*>(mconstraints[to]))
+            to++;
+        if (to < nconstr && dynamic_cast<ChConstraintTwoTuplesRollingTall*>(mconstraints[to]))
+            to++;
+        if (to < nconstr && dynamic_cast<ChConstraintTwoTuplesRollingTall*>(mconstraints[to]))
+            to++;
+        ic = to;
+    }
+    block_start.push_back(nconstr);
 }
 
-// The following is the function which will be executed by
-// each thread, when threads are launched at each Solve()
-
-void SolverThreadFunc(void* userPtr, void* lsMemory) {
-    double maxviolation = 0.;
-    double maxdeltalambda = 0.;
+ChSolverSORmultithread::ChSolverSORmultithread(const char* uniquename,
+                                               int nthreads,
+                                               int mmax_iters,
+                                               bool mwarm_start,
+                                               double mtolerance,
+                                               double momega)
+    : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega), num_threads(ChMax(nthreads, 1)) {}
+
+ChSolverSORmultithread::~ChSolverSORmultithread() {}
+
+// Process one block of constraints in a SOR sweep, updating the maxima of the constraint
+// violation and of the multiplier increments.
+void ChSolverSORmultithread::ProcessBlock(std::vector<ChConstraint*>& mconstraints,
+                                          unsigned int constr_from,
+                                          unsigned int constr_to,
+                                          std::mutex& q_mutex,
+                                          double& maxviolation,
+                                          double& maxdeltalambda) {
     int i_friction_comp = 0;
     double old_lambda_friction[3];
 
-    thread_data* tdata = (thread_data*)userPtr;
-
-    std::vector<ChConstraint*>* mconstraints = tdata->mconstraints;
-    std::vector<ChVariables*>* mvariables = tdata->mvariables;
-
-    switch (tdata->stage) {
-        case thread_data::STAGE1_PREPARE: {
-            //    Update auxiliary data in all constraints before starting,
-            //    that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
-            //
-            for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++)
-                (*mconstraints)[ic]->Update_auxiliary();
-
-            //    Average all g_i for the triplet of contact constraints n,u,v.
-            //
-            int j_friction_comp = 0;
-            double gi_values[3];
-            for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++) {
-                if ((*mconstraints)[ic]->GetMode() == CONSTRAINT_FRIC) {
-                    gi_values[j_friction_comp] = (*mconstraints)[ic]->Get_g_i();
-                    j_friction_comp++;
-                    if (j_friction_comp == 3) {
-                        double average_g_i = (gi_values[0] + gi_values[1] + gi_values[2]) / 3.0;
-                        (*mconstraints)[ic - 2]->Set_g_i(average_g_i);
-                        (*mconstraints)[ic - 1]->Set_g_i(average_g_i);
-                        (*mconstraints)[ic - 0]->Set_g_i(average_g_i);
-                        j_friction_comp = 0;
+    for (unsigned int ic = constr_from; ic < constr_to; ic++) {
+        // skip computations if constraint not active.
+        if (mconstraints[ic]->IsActive()) {
+            // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+            double mresidual = mconstraints[ic]->Compute_Cq_q() + mconstraints[ic]->Get_b_i() +
+                               mconstraints[ic]->Get_cfm_i() * mconstraints[ic]->Get_l_i();
+
+            // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+            double candidate_violation = fabs(mconstraints[ic]->Violation(mresidual));
+
+            // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+            double deltal = (omega / mconstraints[ic]->Get_g_i()) * (-mresidual);
+
+            if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+                candidate_violation = 0;
+
+                // update:   lambda += delta_lambda;
+                old_lambda_friction[i_friction_comp] = mconstraints[ic]->Get_l_i();
+                mconstraints[ic]->Set_l_i(old_lambda_friction[i_friction_comp] + deltal);
+                i_friction_comp++;
+
+                if (i_friction_comp == 1)
+                    candidate_violation = fabs(ChMin(0.0, mresidual));
+
+                if (i_friction_comp == 3) {
+                    mconstraints[ic - 2]->Project();  // the N normal component will take care of N,U,V
+                    double new_lambda_0 = mconstraints[ic - 2]->Get_l_i();
+                    double new_lambda_1 = mconstraints[ic - 1]->Get_l_i();
+                    double new_lambda_2 = mconstraints[ic - 0]->Get_l_i();
+                    // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+                    if (shlambda != 1.0) {
+                        new_lambda_0 = shlambda * new_lambda_0 + (1.0 - shlambda) * old_lambda_friction[0];
+                        new_lambda_1 = shlambda * new_lambda_1 + (1.0 - shlambda) * old_lambda_friction[1];
+                        new_lambda_2 = shlambda * new_lambda_2 + (1.0 - shlambda) * old_lambda_friction[2];
+                        mconstraints[ic - 2]->Set_l_i(new_lambda_0);
+                        mconstraints[ic - 1]->Set_l_i(new_lambda_1);
+                        mconstraints[ic - 0]->Set_l_i(new_lambda_2);
                     }
+                    double true_delta_0 = new_lambda_0 - old_lambda_friction[0];
+                    double true_delta_1 = new_lambda_1 - old_lambda_friction[1];
+                    double true_delta_2 = new_lambda_2 - old_lambda_friction[2];
+                    //	q_mutex.lock();   // this avoids double writing on shared q vector
+                    mconstraints[ic - 2]->Increment_q(true_delta_0);
+                    mconstraints[ic - 1]->Increment_q(true_delta_1);
+                    mconstraints[ic - 0]->Increment_q(true_delta_2);
+                    //	q_mutex.unlock(); // end critical section
+
+                    maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_0));
+                    maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_1));
+                    maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_2));
+                    i_friction_comp = 0;
                 }
-            }
-
-            break;  // end stage
-        }
-
-        case thread_data::STAGE2_ADDFORCES: {
-            //     Compute, for all items with variables, the initial guess for
-            //     still unconstrained system:
-            //
-            for (unsigned int iv = tdata->var_from; iv < tdata->var_to; iv++)
-                if ((*mvariables)[iv]->IsActive())
-                    (*mvariables)[iv]->Compute_invMb_v((*mvariables)[iv]->Get_qb(),
-                                                       (*mvariables)[iv]->Get_fb());  // q = [M]'*fb
-
-            break;  // end stage
-        }
-
-        case thread_data::STAGE3_LOOPCONSTRAINTS: {
-            //     For all items with variables, add the effect of initial (guessed)
-            //     lagrangian reactions of constraints, if a warm start is desired.
-            //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
-            //
-            if (tdata->solver->GetWarmStart()) {
-                for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++)
-                    if ((*mconstraints)[ic]->IsActive()) {
-                        //	tdata->mutex->Lock();   // this avoids double writing on shared q vector
-                        (*mconstraints)[ic]->Increment_q((*mconstraints)[ic]->Get_l_i());
-                        //	tdata->mutex->Unlock(); // end critical section
-                    }
             } else {
-                for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++)
-                    (*mconstraints)[ic]->Set_l_i(0.);
-            }
+                // update:   lambda += delta_lambda;
+                double old_lambda = mconstraints[ic]->Get_l_i();
+                mconstraints[ic]->Set_l_i(old_lambda + deltal);
 
-            //    Perform the solver iteration loops
-            //
-            for (int iter = 0; iter < tdata->solver->GetMaxIterations(); iter++) {
-                // The iteration on all constraints
-                //
-
-                maxviolation = 0;
-                maxdeltalambda = 0;
-                i_friction_comp = 0;
-
-                for (unsigned int ic = tdata->constr_from; ic < tdata->constr_to; ic++) {
-                    // skip computations if constraint not active.
-                    if ((*mconstraints)[ic]->IsActive()) {
-                        // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
-                        double mresidual = (*mconstraints)[ic]->Compute_Cq_q() + (*mconstraints)[ic]->Get_b_i() +
-                                           (*mconstraints)[ic]->Get_cfm_i() * (*mconstraints)[ic]->Get_l_i();
-
-                        // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
-                        double candidate_violation = fabs((*mconstraints)[ic]->Violation(mresidual));
-
-                        // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
-                        double deltal = (tdata->solver->GetOmega() / (*mconstraints)[ic]->Get_g_i()) * (-mresidual);
-
-                        if ((*mconstraints)[ic]->GetMode() == CONSTRAINT_FRIC) {
-                            candidate_violation = 0;
-                            
-                            // update:   lambda += delta_lambda;
-                            old_lambda_friction[i_friction_comp] = (*mconstraints)[ic]->Get_l_i();
-                            (*mconstraints)[ic]->Set_l_i(old_lambda_friction[i_friction_comp] + deltal);
-                            i_friction_comp++;
-
-                            if (i_friction_comp == 1)
-                                candidate_violation = fabs(ChMin(0.0, mresidual));
-
-                            if (i_friction_comp == 3) {
-                                (*mconstraints)[ic - 2]->Project();  // the N normal component will take care of N,U,V
-                                double new_lambda_0 = (*mconstraints)[ic - 2]->Get_l_i();
-                                double new_lambda_1 = (*mconstraints)[ic - 1]->Get_l_i();
-                                double new_lambda_2 = (*mconstraints)[ic - 0]->Get_l_i();
-                                // Apply the smoothing: lambda= sharpness*lambda_new_projected +
-                                // (1-sharpness)*lambda_old
-                                if (tdata->solver->GetSharpnessLambda() != 1.0) {
-                                    double shlambda = tdata->solver->GetSharpnessLambda();
-                                    new_lambda_0 = shlambda * new_lambda_0 + (1.0 - shlambda) * old_lambda_friction[0];
-                                    new_lambda_1 = shlambda * new_lambda_1 + (1.0 - shlambda) * old_lambda_friction[1];
-                                    new_lambda_2 = shlambda * new_lambda_2 + (1.0 - shlambda) * old_lambda_friction[2];
-                                    (*mconstraints)[ic - 2]->Set_l_i(new_lambda_0);
-                                    (*mconstraints)[ic - 1]->Set_l_i(new_lambda_1);
-                                    (*mconstraints)[ic - 0]->Set_l_i(new_lambda_2);
-                                }
-                                double true_delta_0 = new_lambda_0 - old_lambda_friction[0];
-                                double true_delta_1 = new_lambda_1 - old_lambda_friction[1];
-                                double true_delta_2 = new_lambda_2 - old_lambda_friction[2];
-                                //	tdata->mutex->Lock();   // this avoids double writing on shared q vector
-                                (*mconstraints)[ic - 2]->Increment_q(true_delta_0);
-                                (*mconstraints)[ic - 1]->Increment_q(true_delta_1);
-                                (*mconstraints)[ic - 0]->Increment_q(true_delta_2);
-                                //	tdata->mutex->Unlock(); // end critical section
-                                /*
-								if (this->record_violation_history)
-								{
-									maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_0));
-									maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_1));
-									maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta_2));
-								}
-								*/  //***TO DO***
-                                i_friction_comp = 0;
-                            }
-                        } else {
-                            // update:   lambda += delta_lambda;
-                            double old_lambda = (*mconstraints)[ic]->Get_l_i();
-                            (*mconstraints)[ic]->Set_l_i(old_lambda + deltal);
-
-                            // If new lagrangian multiplier does not satisfy inequalities, project
-                            // it into an admissible orthant (or, in general, onto an admissible set)
-                            (*mconstraints)[ic]->Project();
-
-                            // After projection, the lambda may have changed a bit..
-                            double new_lambda = (*mconstraints)[ic]->Get_l_i();
-
-                            // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
-                            if (tdata->solver->GetSharpnessLambda() != 1.0) {
-                                double shlambda = tdata->solver->GetSharpnessLambda();
-                                new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda;
-                                (*mconstraints)[ic]->Set_l_i(new_lambda);
-                            }
-
-                            double true_delta = new_lambda - old_lambda;
-
-                            // For all items with variables, add the effect of incremented
-                            // (and projected) lagrangian reactions:
-                            tdata->mutex->Lock();  // this avoids double writing on shared q vector
-                            (*mconstraints)[ic]->Increment_q(true_delta);
-                            tdata->mutex->Unlock();  // end critical section
-                            /*
-							if (this->record_violation_history)
-								maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta)); 
-							*/                       //***TO DO***
-                        }
-
-                        maxviolation = ChMax(maxviolation, fabs(candidate_violation));
-
-                    }  // end IsActive()
-
-                }  // end loop on constraints
-
-                // For recording into violation history, if debugging
-                // if (this->record_violation_history)
-                //	AtIterationEnd(maxviolation, maxdeltalambda, iter);  //***TO DO***
-
-                // Terminate the loop if violation in constraints has been successfully limited.
-                if (maxviolation < tdata->solver->GetTolerance())
-                    break;
-
-            }  // end iteration loop
+                // If new lagrangian multiplier does not satisfy inequalities, project
+                // it into an admissible orthant (or, in general, onto an admissible set)
+                mconstraints[ic]->Project();
 
-            break;
-        }  // end stage
+                // After projection, the lambda may have changed a bit..
+                double new_lambda = mconstraints[ic]->Get_l_i();
 
-        default: { break; }
-    }  // end stage  switching
-}
+                // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+                if (shlambda != 1.0) {
+                    new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda;
+                    mconstraints[ic]->Set_l_i(new_lambda);
+                }
 
-// When the solver object is created, threads are also
-// created and initialized, in 'wait' mode.
+                double true_delta = new_lambda - old_lambda;
 
-ChSolverSORmultithread::ChSolverSORmultithread(const char* uniquename,
-                                               int nthreads,
-                                               int mmax_iters,
-                                               bool mwarm_start,
-                                               double mtolerance,
-                                               double momega)
-    : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega) {
-    ChThreadConstructionInfo create_args(uniquename, SolverThreadFunc, SolverMemoryFunc, nthreads);
+                // For all items with variables, add the effect of incremented
+                // (and projected) lagrangian reactions:
+                {
+                    std::lock_guard<std::mutex> lock(q_mutex);  // this avoids double writing on shared q vector
+                    mconstraints[ic]->Increment_q(true_delta);
+                }
 
-    solver_threads = new ChThreads(create_args);
-}
+                maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta));
+            }
 
-ChSolverSORmultithread::~ChSolverSORmultithread() {
-    if (solver_threads) {
-        solver_threads->flush();
-        delete (solver_threads);
-        solver_threads = 0;
-    }
+            maxviolation = ChMax(maxviolation, fabs(candidate_violation));
+
+        }  // end IsActive()
+
+    }  // end loop on constraints
 }
 
-// The SOR solver process has been modified so that some
-// parallelizable code has been moved to the SolverThreadFunc().
-// So, the N threads must be started (each executing SolverThreadFunc() )
-// and, after waiting for all them to be completed, with flush(), the
-// solution is done.
+// The constraints are split in blocks (several per thread) that are processed as tasks of the
+// task scheduler, with at most num_threads tasks running at the same time. Each SOR sweep
+// is a parallel loop on the blocks; blocks are handed out dynamically, so that the load is
+// balanced between threads even if the cost of the constraints is uneven.
 
 double ChSolverSORmultithread::Solve(
     ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -283,102 +173,114 @@ double ChSolverSORmultithread::Solve(
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
+    ChTaskScheduler& scheduler = ChTaskScheduler::GetInstance();
+    std::mutex q_mutex;
+
+    tot_iterations = 0;
     double maxviolation = 0.;
     double maxdeltalambda = 0.;
-    int i_friction_comp = 0;
-
-    /////////////////////////////////////////////
-    /// THE PARALLEL SOLVER, PERFORMED IN STAGES
-
-    ChMutexSpinlock spinlock;
-
-    // --0--  preparation:
-    //        subdivide the workload to the threads and prepare their 'thread_data':
-
-    int numthreads = this->solver_threads->getNumberOfThreads();
-    std::vector<thread_data> mdataN(numthreads);
-
-    int var_slice = 0;
-    int constr_slice = 0;
-    for (int nth = 0; nth < numthreads; nth++) {
-        unsigned int var_from = var_slice;
-        unsigned int var_to = var_from + ((unsigned int)mvariables.size() - var_from) / (numthreads - nth);
-        unsigned int constr_from = constr_slice;
-        unsigned int constr_to = constr_from + ((unsigned int)mconstraints.size() - constr_from) / (numthreads - nth);
-        if (constr_to < mconstraints.size())  // do not slice the three contact multipliers (or six in case of rolling)
-        {
-            if (dynamic_cast<ChConstraintTwoTuplesFrictionTall*>(mconstraints[constr_to]))
-                constr_to++;
-            if (dynamic_cast<ChConstraintTwoTuplesFrictionTall*>(mconstraints[constr_to]))
-                constr_to++;
-            if (constr_to < mconstraints.size()) {
-                if (dynamic_cast<ChConstraintTwoTuplesRollingNall*>(mconstraints[constr_to]))
-                    constr_to++;
-                if (dynamic_cast<ChConstraintTwoTuplesRollingTall*>(mconstraints[constr_to]))
-                    constr_to++;
-                if (dynamic_cast<ChConstraintTwoTuplesRollingTall*>(mconstraints[constr_to]))
-                    constr_to++;
-            }
-        }
-        mdataN[nth].solver = this;
-        mdataN[nth].mutex = &spinlock;
-        mdataN[nth].constr_from = constr_from;
-        mdataN[nth].constr_to = constr_to;
-        mdataN[nth].var_from = var_from;
-        mdataN[nth].var_to = var_to;
-        mdataN[nth].mconstraints = &mconstraints;
-        mdataN[nth].mvariables = &mvariables;
-
-        var_slice = var_to;
-        constr_slice = constr_to;
-    }
 
-    // LAUNCH THE PARALLEL COMPUTATION ON THREADS !!!!
+    // 0)  Split the constraints in blocks, without separating the multipliers of a contact
+    std::vector<unsigned int> block_start;
+    unsigned int block_size = std::max((unsigned int)mconstraints.size() / (8 * num_threads), 1u);
+    SplitConstraints(mconstraints, block_size, block_start);
+    int nblocks = (int)block_start.size() - 1;
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+    //     Average all g_i for the triplet of contact constraints n,u,v.
+    scheduler.ParallelFor(0, nblocks, 1,
+                          [&](int b_from, int b_to) {
+                              for (unsigned int ic = block_start[b_from]; ic < block_start[b_to]; ic++)
+                                  mconstraints[ic]->Update_auxiliary();
+
+                              int j_friction_comp = 0;
+                              double gi_values[3];
+                              for (unsigned int ic = block_start[b_from]; ic < block_start[b_to]; ic++) {
+                                  if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+                                      gi_values[j_friction_comp] = mconstraints[ic]->Get_g_i();
+                                      j_friction_comp++;
+                                      if (j_friction_comp == 3) {
+                                          double average_g_i = (gi_values[0] + gi_values[1] + gi_values[2]) / 3.0;
+                                          mconstraints[ic - 2]->Set_g_i(average_g_i);
+                                          mconstraints[ic - 1]->Set_g_i(average_g_i);
+                                          mconstraints[ic - 0]->Set_g_i(average_g_i);
+                                          j_friction_comp = 0;
+                                      }
+                                  }
+                              }
+                          },
+                          num_threads);
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+    scheduler.ParallelFor(0, (int)mvariables.size(), 0,
+                          [&](int from, int to) {
+                              for (int iv = from; iv < to; iv++) {
+                                  if (mvariables[iv]->IsActive())
+                                      mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(),
+                                                                      mvariables[iv]->Get_fb());  // q = [M]'*fb
+                              }
+                          },
+                          num_threads);
+
+    // 3)  For all items with variables, add the effect of initial (guessed)
+    //     lagrangian reactions of constraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    scheduler.ParallelFor(0, nblocks, 1,
+                          [&](int b_from, int b_to) {
+                              for (unsigned int ic = block_start[b_from]; ic < block_start[b_to]; ic++) {
+                                  if (!warm_start)
+                                      mconstraints[ic]->Set_l_i(0.);
+                                  else if (mconstraints[ic]->IsActive()) {
+                                      //	q_mutex.lock();   // this avoids double writing on shared q vector
+                                      mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+                                      //	q_mutex.unlock(); // end critical section
+                                  }
+                              }
+                          },
+                          num_threads);
+
+    // 4)  Perform the iteration loops, with one parallel sweep on the blocks per iteration
+    //
+    typedef std::pair<double, double> Maxima;  // max violation, max delta lambda
+    auto max_reduce = [](const Maxima& a, const Maxima& b) {
+        return Maxima(ChMax(a.first, b.first), ChMax(a.second, b.second));
+    };
+
+    for (int iter = 0; iter < max_iterations; iter++) {
+        Maxima maxima = scheduler.ParallelReduce(0, nblocks, 1, Maxima(0, 0),
+                                                 [&](int b_from, int b_to, Maxima m) {
+                                                     for (int ib = b_from; ib < b_to; ib++)
+                                                         ProcessBlock(mconstraints, block_start[ib],
+                                                                      block_start[ib + 1], q_mutex, m.first,
+                                                                      m.second);
+                                                     return m;
+                                                 },
+                                                 max_reduce, num_threads);
+
+        maxviolation = maxima.first;
+        maxdeltalambda = maxima.second;
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        tot_iterations++;
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < tolerance)
+            break;
 
-    // --1--  stage:
-    //        precompute aux variables in constraints.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE1_PREPARE;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
-
-    // --2--  stage:
-    //        add external forces and mass effects, on variables.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE2_ADDFORCES;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
-
-    // --3--  stage:
-    //        loop on constraints.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE3_LOOPCONSTRAINTS;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
+    }  // end iteration loop
 
-    return 0;
+    return maxviolation;
 }
 
 void ChSolverSORmultithread::ChangeNumberOfThreads(int mthreads) {
     if (mthreads < 1)
         mthreads = 1;
 
-    char mname[100];
-    strncpy(mname, solver_threads->getUniqueName().c_str(), sizeof(mname)-1);
-
-    solver_threads->flush();
-    delete (solver_threads);
-    solver_threads = 0;
-
-    ChThreadConstructionInfo create_args(mname, SolverThreadFunc, SolverMemoryFunc, mthreads);
-
-    solver_threads = new ChThreads(create_args);
+    num_threads = mthreads;
 }
 
 } // end namespace chrono
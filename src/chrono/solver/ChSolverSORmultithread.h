@@ -15,22 +15,25 @@
 #ifndef CHSOLVERSORMULTITHREAD_H
 #define CHSOLVERSORMULTITHREAD_H
 
+#include <mutex>
+
 #include "chrono/solver/ChIterativeSolver.h"
-#include "chrono/parallel/ChThreads.h"
 
 namespace chrono {
 /// An iterative solver based on projective fixed point method, with overrelaxation
 /// and immediate variable update as in SOR methods. Multi-threaded.\n
+/// Each SOR sweep is a parallel loop on blocks of constraints, run on the process-wide ChTaskScheduler with at
+/// most as many concurrent tasks as the number of threads of the solver.\n
 /// See ChSystemDescriptor for more information about the problem formulation and the data structures
 /// passed to the solver.
 
 class ChApi ChSolverSORmultithread : public ChIterativeSolver {
 
   protected:
-    ChThreads* solver_threads;
+    int num_threads;
 
   public:
-    ChSolverSORmultithread(const char* uniquename = "solver",  ///< this name must be unique.
+    ChSolverSORmultithread(const char* uniquename = "solver",  ///< unused (deprecated, kept for compatibility)
                            int nthreads = 2,                   ///< number of threads
                            int mmax_iters = 50,                ///< max.number of iterations
                            bool mwarm_start = false,           ///< uses warm start?
@@ -50,6 +53,17 @@ class ChApi ChSolverSORmultithread : public ChIterativeSolver {
 
     /// Changes the number of threads which run in parallel (should be > 1 )
     void ChangeNumberOfThreads(int mthreads = 2);
+
+    /// Return the number of threads (i.e., the maximum number of constraint blocks processed in parallel).
+    int GetNumberOfThreads() const { return num_threads; }
+
+  private:
+    void ProcessBlock(std::vector<ChConstraint*>& mconstraints,
+                      unsigned int constr_from,
+                      unsigned int constr_to,
+                      std::mutex& q_mutex,
+                      double& maxviolation,
+                      double& maxdeltalambda);
 };
 
 }  // end namespace chrono
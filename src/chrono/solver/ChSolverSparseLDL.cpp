@@ -0,0 +1,174 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/solver/ChSolverSparseLDL.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChSolverSparseLDL)
+
+ChSolverSparseLDL::ChSolverSparseLDL() : m_mat(1, 1) {
+    m_mat.SetSparsityPatternLock(true);
+}
+
+bool ChSolverSparseLDL::Setup(ChSystemDescriptor& sysd) {
+    m_timer_setup_assembly.start();
+
+    // Learn the sparsity pattern whenever the problem size changes, so that the matrix is allocated only once.
+    int dim = sysd.CountActiveVariables() + sysd.CountActiveConstraints();
+    if (m_setup_call == 0 || dim != m_dim) {
+        m_dim = dim;
+        ChSparsityPatternLearner sparsity_learner(m_dim, m_dim, true);
+        sysd.ConvertToMatrixForm(&sparsity_learner, nullptr);
+        m_mat.LoadSparsityPattern(sparsity_learner);
+    }
+
+    // With the sparsity lock, the Reset performed in ConvertToMatrixForm only zeroes the values
+    sysd.ConvertToMatrixForm(&m_mat, nullptr);
+    m_mat.Compress();
+
+    // Redo the symbolic analysis only if the sparsity pattern changed; redo the numeric factorization only if the
+    // matrix values changed beyond the tolerance.
+    size_t pattern_hash = m_mat.GetSparsityPatternHash();
+    bool analyze = !m_factorized || pattern_hash != m_pattern_hash;
+    bool factorize = analyze || !FactorizationIsCurrent();
+    m_pattern_hash = pattern_hash;
+
+    m_timer_setup_assembly.stop();
+
+    m_timer_setup_solvercall.start();
+    bool success = true;
+    if (analyze) {
+        success = m_ldl.Analyze(m_mat);
+        m_analysis_call++;
+    }
+    if (success && factorize) {
+        success = m_ldl.Factorize(m_mat);
+        m_factorization_call++;
+    }
+    m_timer_setup_solvercall.stop();
+
+    if (factorize) {
+        double* values = m_mat.GetCS_ValueArray();
+        m_factor_values.assign(values, values + m_mat.GetNNZ());
+    }
+    m_factorized = success;
+
+    // Refine the solution if pivots were perturbed or if the factorization is not the one of the current matrix
+    m_refine = m_ldl.GetNumPerturbedPivots() > 0 || (!factorize && m_refactor_tol > 0);
+
+    m_setup_call++;
+
+    if (verbose) {
+        GetLog() << " SparseLDL setup n = " << m_dim << "  nnz = " << m_mat.GetNNZ()
+                 << "  nnz(L) = " << (int)m_ldl.GetNNZ_L()
+                 << (analyze ? "  (analysis+factorization)" : factorize ? "  (factorization)" : "  (reused)") << "\n";
+        GetLog() << "  assembly: " << m_timer_setup_assembly.GetTimeSecondsIntermediate() << "s"
+                 << "  solver_call: " << m_timer_setup_solvercall.GetTimeSecondsIntermediate() << "\n";
+        if (m_ldl.GetNumPerturbedPivots() > 0)
+            GetLog() << "  perturbed pivots: " << m_ldl.GetNumPerturbedPivots() << "\n";
+    }
+
+    if (!success) {
+        GetLog() << "SparseLDL factorization failed\n";
+        return false;
+    }
+
+    return true;
+}
+
+double ChSolverSparseLDL::Solve(ChSystemDescriptor& sysd) {
+    // Assemble the problem right-hand side vector.
+    m_timer_solve_assembly.start();
+    sysd.ConvertToMatrixForm(nullptr, &m_rhs);
+    m_sol = m_rhs;
+    m_timer_solve_assembly.stop();
+
+    m_timer_solve_solvercall.start();
+    m_ldl.Solve(m_sol.GetAddress());
+
+    // Iterative refinement against the assembled matrix, while the residual decreases.
+    m_refinement_steps = 0;
+    if (m_refine && m_max_refinement > 0) {
+        m_res.Resize(m_dim, 1);
+        double res_norm = 0;
+        for (int step = 0; step < m_max_refinement; step++) {
+            m_mat.MatrMultiply(m_sol, m_res);
+            double norm = 0;
+            for (int i = 0; i < m_dim; i++) {
+                m_res(i) = m_rhs(i) - m_res(i);
+                norm = std::max(norm, std::abs(m_res(i)));
+            }
+            if (norm == 0 || (step > 0 && norm > 0.5 * res_norm))
+                break;
+            res_norm = norm;
+            m_ldl.Solve(m_res.GetAddress());
+            m_sol += m_res;
+            m_refinement_steps++;
+        }
+    }
+    m_timer_solve_solvercall.stop();
+
+    m_solve_call++;
+
+    if (verbose) {
+        GetLog() << " SparseLDL solve call " << m_solve_call << "  refinement steps = " << m_refinement_steps << "\n";
+        GetLog() << "  assembly: " << m_timer_solve_assembly.GetTimeSecondsIntermediate() << "s\n"
+                 << "  solver_call: " << m_timer_solve_solvercall.GetTimeSecondsIntermediate() << "\n";
+    }
+
+    // Scatter solution vector to the system descriptor.
+    m_timer_solve_assembly.start();
+    sysd.FromVectorToUnknowns(m_sol);
+    m_timer_solve_assembly.stop();
+
+    return 0;
+}
+
+bool ChSolverSparseLDL::FactorizationIsCurrent() const {
+    if (m_refactor_tol < 0 || m_factor_values.size() != static_cast<size_t>(m_mat.GetNNZ()))
+        return false;
+    const double* values = m_mat.GetCS_ValueArray();
+    double max_value = 0;
+    double max_change = 0;
+    for (size_t i = 0; i < m_factor_values.size(); i++) {
+        max_value = std::max(max_value, std::abs(m_factor_values[i]));
+        max_change = std::max(max_change, std::abs(values[i] - m_factor_values[i]));
+    }
+    return max_change <= m_refactor_tol * max_value;
+}
+
+void ChSolverSparseLDL::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChSolverSparseLDL>();
+    // serialize parent class
+    ChSolver::ArchiveOUT(marchive);
+    // serialize all member data:
+    marchive << CHNVP(m_refactor_tol);
+    marchive << CHNVP(m_max_refinement);
+}
+
+void ChSolverSparseLDL::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChSolverSparseLDL>();
+    // deserialize parent class
+    ChSolver::ArchiveIN(marchive);
+    // stream in all member data:
+    marchive >> CHNVP(m_refactor_tol);
+    marchive >> CHNVP(m_max_refinement);
+}
+
+}  // end namespace chrono
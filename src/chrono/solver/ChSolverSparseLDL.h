@@ -0,0 +1,161 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSOLVERSPARSELDL_H
+#define CHSOLVERSPARSELDL_H
+
+#include <vector>
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChSparseLDL.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/solver/ChSolver.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/** \class ChSolverSparseLDL
+\brief Native sparse direct solver, based on a multifrontal LDL' factorization (see ChSparseLDL).
+
+Sparse linear direct solver for the symmetric KKT systems of smooth problems (implicit integrators, static analysis),
+available without external dependencies.
+Cannot handle VI and complementarity problems, so it cannot be used with NSC formulations.
+
+The symbolic analysis (fill-reducing ordering and structure of the factor) is performed only when the sparsity
+pattern of the assembled matrix changes (detected through a hash of the matrix structure); otherwise, only the
+numeric factorization is redone, using the threads of the process-wide ChTaskScheduler.\n
+Optionally, the numeric factorization itself can be reused (modified Newton) while the matrix values differ from the
+factorized ones by less than a given relative tolerance (see #SetRefactorizationTolerance()).
+
+Since no dynamic pivoting is performed, tiny pivots are perturbed (see ChSparseLDL::SetPivotPerturbation()); when
+this happens, or when a factorization is reused for a changed matrix, the solution is improved with a few steps of
+iterative refinement against the current matrix (see #SetMaxRefinementSteps()).
+
+Minimal usage example:
+\code{.cpp}
+system.SetSolverType(ChSolver::Type::SPARSE_LDL);
+\endcode
+
+See ChSystemDescriptor for more information about the problem formulation and the data structures
+passed to the solver.
+*/
+class ChApi ChSolverSparseLDL : public ChSolver {
+  public:
+    ChSolverSparseLDL();
+
+    ~ChSolverSparseLDL() override {}
+
+    virtual Type GetType() const override { return Type::SPARSE_LDL; }
+
+    /// Get a handle to the underlying factorization.
+    ChSparseLDL& GetFactorization() { return m_ldl; }
+
+    /// Get a handle to the underlying matrix.
+    ChCSMatrix& GetMatrix() { return m_mat; }
+
+    /// Set the tolerance for reusing the last numeric factorization (default: 0).
+    /// If the sparsity pattern is unchanged and the largest change of the matrix entries, relative to the largest
+    /// entry of the factorized matrix, does not exceed \a tol, the factorization is not recomputed (modified Newton).
+    /// With the default value, the factorization is reused only if the matrix is unchanged.
+    /// A negative value forces a new factorization at each call to Setup().
+    void SetRefactorizationTolerance(double tol) { m_refactor_tol = tol; }
+
+    /// Set the maximum number of iterative refinement steps (default: 3).
+    void SetMaxRefinementSteps(int steps) { m_max_refinement = steps; }
+
+    /// Set the relative threshold for static pivoting (default: 1e-10).
+    void SetPivotPerturbation(double eps) { m_ldl.SetPivotPerturbation(eps); }
+
+    /// Reset timers for internal phases in Solve and Setup.
+    void ResetTimers() {
+        m_timer_setup_assembly.reset();
+        m_timer_setup_solvercall.reset();
+        m_timer_solve_assembly.reset();
+        m_timer_solve_solvercall.reset();
+    }
+
+    /// Get cumulative time for assembly operations in Solve phase.
+    double GetTimeSolve_Assembly() const { return m_timer_solve_assembly(); }
+    /// Get cumulative time for the triangular solves (and refinement) in Solve phase.
+    double GetTimeSolve_SolverCall() const { return m_timer_solve_solvercall(); }
+    /// Get cumulative time for assembly operations in Setup phase.
+    double GetTimeSetup_Assembly() const { return m_timer_setup_assembly(); }
+    /// Get cumulative time for analysis and factorization in Setup phase.
+    double GetTimeSetup_SolverCall() const { return m_timer_setup_solvercall(); }
+    /// Return the number of calls to the solver's Setup function.
+    int GetNumSetupCalls() const { return m_setup_call; }
+    /// Return the number of calls to the solver's Solve function.
+    int GetNumSolveCalls() const { return m_solve_call; }
+    /// Return the number of symbolic analyses performed.
+    int GetNumAnalysisCalls() const { return m_analysis_call; }
+    /// Return the number of numeric factorizations performed.
+    int GetNumFactorizationCalls() const { return m_factorization_call; }
+    /// Return the number of iterative refinement steps performed in the last call to Solve.
+    int GetNumRefinementSteps() const { return m_refinement_steps; }
+
+    /// Indicate whether or not the #Solve() phase requires an up-to-date problem matrix.
+    /// As typical of direct solvers, this solver only requires the matrix for its #Setup() phase.
+    virtual bool SolveRequiresMatrix() const override { return false; }
+
+    /// Perform the solver setup operations: assemble the system matrix and factorize it.
+    /// Returns true if successful and false otherwise.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+    /// Solve using the factorization obtained at the last call to Setup().
+    virtual double Solve(ChSystemDescriptor& sysd) override;
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    /// Check whether the current matrix values are within the refactorization tolerance of the factorized ones.
+    /// Assumes an unchanged sparsity pattern.
+    bool FactorizationIsCurrent() const;
+
+    ChSparseLDL m_ldl;              ///< sparse factorization
+    ChCSMatrix m_mat;               ///< problem matrix
+    ChMatrixDynamic<double> m_rhs;  ///< right-hand side vector
+    ChMatrixDynamic<double> m_sol;  ///< solution vector
+    ChMatrixDynamic<double> m_res;  ///< residual vector (iterative refinement)
+
+    int m_dim = 0;                 ///< problem size
+    int m_solve_call = 0;          ///< counter for calls to Solve
+    int m_setup_call = 0;          ///< counter for calls to Setup
+    int m_analysis_call = 0;       ///< counter for symbolic analyses
+    int m_factorization_call = 0;  ///< counter for numeric factorizations
+    int m_refinement_steps = 0;    ///< refinement steps in the last call to Solve
+
+    bool m_factorized = false;            ///< is there a valid factorization?
+    bool m_refine = false;                ///< does the solution need iterative refinement?
+    size_t m_pattern_hash = 0;            ///< hash of the sparsity pattern of the factorized matrix
+    std::vector<double> m_factor_values;  ///< values of the factorized matrix
+    double m_refactor_tol = 0;            ///< relative tolerance for reusing the factorization
+    int m_max_refinement = 3;             ///< maximum number of refinement steps
+
+    ChTimer<> m_timer_setup_assembly;    ///< timer for matrix assembly
+    ChTimer<> m_timer_setup_solvercall;  ///< timer for analysis and factorization
+    ChTimer<> m_timer_solve_assembly;    ///< timer for RHS assembly
+    ChTimer<> m_timer_solve_solvercall;  ///< timer for solution
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -10,10 +10,13 @@
 //
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
 #include "chrono/core/ChLinkedListMatrix.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 
 namespace chrono {
 
@@ -30,6 +33,9 @@ ChSystemDescriptor::ChSystemDescriptor() {
 
     c_a = 1.0;
 
+    assembled_shur = false;
+    assembled_shur_valid = false;
+
     n_q = 0;
     n_c = 0;
     freeze_count = false;
@@ -542,6 +548,167 @@ int ChSystemDescriptor::FromVectorToUnknowns(ChMatrix<>& mvector) {
     return n_q + n_c;
 }
 
+namespace {
+
+// Sparse matrix that only collects the (row, column, value) triplets of the non-zero elements
+// that are pasted into it, as done by ChConstraint::Build_Cq().
+class ChTripletCollector : public ChSparseMatrix {
+  public:
+    struct Triplet {
+        int row;
+        int col;
+        double val;
+    };
+
+    ChTripletCollector(int nrows, int ncols) : ChSparseMatrix(nrows, ncols) {}
+
+    virtual void SetElement(int insrow, int inscol, double insval, bool overwrite = true) override {
+        if (insval != 0)
+            triplets.push_back(Triplet{insrow, inscol, insval});
+    }
+    virtual double GetElement(int row, int col) const override { return 0; }
+    virtual void Reset(int row, int col, int nonzeros = 0) override { triplets.clear(); }
+    virtual bool Resize(int nrows, int ncols, int nonzeros = 0) override { return false; }
+
+    std::vector<Triplet> triplets;
+};
+
+}  // end anonymous namespace
+
+void ChSystemDescriptor::AssembleShurProduct() {
+    ChTaskScheduler& scheduler = ChTaskScheduler::GetInstance();
+
+    std::vector<ChConstraint*> active_constraints;
+    active_constraints.reserve(n_c);
+    for (auto constr : vconstraints) {
+        if (constr->IsActive())
+            active_constraints.push_back(constr);
+    }
+    int nc = (int)active_constraints.size();
+
+    // Map each active scalar variable to its variables block.
+    std::vector<ChVariables*> col_variables(n_q, nullptr);
+    for (auto var : vvariables) {
+        if (var->IsActive()) {
+            for (int k = 0; k < var->Get_ndof(); k++)
+                col_variables[var->GetOffset() + k] = var;
+        }
+    }
+
+    // 1 - collect the rows of [Cq] in chunks of constraints, then pack them in CSR format.
+    //     Duplicate entries (if any) are summed, as in the matrix-free product.
+
+    int grain = std::max(64, nc / (4 * scheduler.GetNumThreads()) + 1);
+    int num_chunks = (nc + grain - 1) / grain;
+    std::vector<ChTripletCollector> chunks(num_chunks, ChTripletCollector(n_c, n_q));
+    scheduler.ParallelFor(0, num_chunks, 1, [&](int from, int to) {
+        for (int ichunk = from; ichunk < to; ichunk++) {
+            ChTripletCollector& collector = chunks[ichunk];
+            int end = std::min(nc, (ichunk + 1) * grain);
+            for (int ic = ichunk * grain; ic < end; ic++)
+                active_constraints[ic]->Build_Cq(collector, active_constraints[ic]->GetOffset());
+            std::sort(collector.triplets.begin(), collector.triplets.end(),
+                      [](const ChTripletCollector::Triplet& a, const ChTripletCollector::Triplet& b) {
+                          return a.row < b.row || (a.row == b.row && a.col < b.col);
+                      });
+        }
+    });
+
+    cq_rowptr.assign(n_c + 1, 0);
+    cq_colind.clear();
+    cq_values.clear();
+    int last_row = -1;
+    int last_col = -1;
+    for (auto& collector : chunks) {
+        for (auto& t : collector.triplets) {
+            if (t.col < 0 || t.col >= n_q || !col_variables[t.col])
+                continue;
+            if (t.row == last_row && t.col == last_col) {
+                cq_values.back() += t.val;
+                continue;
+            }
+            cq_colind.push_back(t.col);
+            cq_values.push_back(t.val);
+            cq_rowptr[t.row + 1]++;
+            last_row = t.row;
+            last_col = t.col;
+        }
+    }
+    for (int i = 0; i < n_c; i++)
+        cq_rowptr[i + 1] += cq_rowptr[i];
+
+    shur_cfm.resize(n_c);
+    for (int ic = 0; ic < nc; ic++)
+        shur_cfm[active_constraints[ic]->GetOffset()] = active_constraints[ic]->Get_cfm_i();
+
+    // 2 - compute the columns of [M^(-1)][Cq'], one per constraint, block by block.
+    //     Each column gets as many slots as the degrees of freedom of the variables it touches.
+
+    std::vector<int> eq_colptr(n_c + 1, 0);
+    for (int i = 0; i < n_c; i++) {
+        int count = 0;
+        ChVariables* last = nullptr;
+        for (int k = cq_rowptr[i]; k < cq_rowptr[i + 1]; k++) {
+            ChVariables* var = col_variables[cq_colind[k]];
+            if (var != last) {
+                count += var->Get_ndof();
+                last = var;
+            }
+        }
+        eq_colptr[i + 1] = eq_colptr[i] + count;
+    }
+    std::vector<int> eq_rowind(eq_colptr[n_c]);
+    std::vector<double> eq_values(eq_colptr[n_c]);
+
+    scheduler.ParallelFor(0, n_c, 0, [&](int from, int to) {
+        ChMatrixDynamic<double> vect;
+        ChMatrixDynamic<double> res;
+        for (int i = from; i < to; i++) {
+            int slot = eq_colptr[i];
+            int k = cq_rowptr[i];
+            while (k < cq_rowptr[i + 1]) {
+                ChVariables* var = col_variables[cq_colind[k]];
+                int offset = var->GetOffset();
+                int ndof = var->Get_ndof();
+                vect.Reset(ndof, 1);
+                res.Reset(ndof, 1);
+                for (; k < cq_rowptr[i + 1] && col_variables[cq_colind[k]] == var; k++)
+                    vect(cq_colind[k] - offset) = cq_values[k];
+                var->Compute_invMb_v(res, vect);
+                for (int j = 0; j < ndof; j++) {
+                    eq_rowind[slot] = offset + j;
+                    eq_values[slot] = res(j);
+                    slot++;
+                }
+            }
+        }
+    });
+
+    // 3 - transpose to CSR format, one row per active scalar variable, to allow a parallel
+    //     product without concurrent writes.
+
+    eqT_rowptr.assign(n_q + 1, 0);
+    for (auto row : eq_rowind)
+        eqT_rowptr[row + 1]++;
+    for (int r = 0; r < n_q; r++)
+        eqT_rowptr[r + 1] += eqT_rowptr[r];
+    eqT_colind.resize(eq_rowind.size());
+    eqT_values.resize(eq_values.size());
+    std::vector<int> fill(eqT_rowptr.begin(), eqT_rowptr.end() - 1);
+    for (int i = 0; i < n_c; i++) {
+        for (int k = eq_colptr[i]; k < eq_colptr[i + 1]; k++) {
+            int pos = fill[eq_rowind[k]]++;
+            eqT_colind[pos] = i;
+            eqT_values[pos] = eq_values[k];
+        }
+    }
+
+    shur_l.resize(n_c);
+    shur_q.resize(n_q);
+
+    assembled_shur_valid = true;
+}
+
 void ChSystemDescriptor::ShurComplementProduct(ChMatrix<>& result, ChMatrix<>* lvector, std::vector<bool>* enabled) {
     assert(this->vstiffness.size() == 0); // currently, the case with ChKblock items is not supported (only diagonal M is supported, no K)
     assert(lvector->GetRows() == CountActiveConstraints());
@@ -549,6 +716,50 @@ void ChSystemDescriptor::ShurComplementProduct(ChMatrix<>& result, ChMatrix<>* l
 
     result.Reset(n_c, 1);  // fast! Reset() method does not realloc if size doesn't change
 
+    if (assembled_shur) {
+        if (!assembled_shur_valid)
+            AssembleShurProduct();
+
+        ChTaskScheduler& scheduler = ChTaskScheduler::GetInstance();
+
+        // l, with zeros for the not enabled constraints
+        for (auto constr : vconstraints) {
+            if (constr->IsActive()) {
+                int s_c = constr->GetOffset();
+                if (enabled && (*enabled)[s_c] == false)
+                    shur_l[s_c] = 0;
+                else
+                    shur_l[s_c] = lvector ? (*lvector)(s_c, 0) : constr->Get_l_i();
+            }
+        }
+
+        // q = [M^(-1)][Cq']*l
+        scheduler.ParallelFor(0, n_q, 0, [this](int from, int to) {
+            for (int r = from; r < to; r++) {
+                double sum = 0;
+                for (int k = eqT_rowptr[r]; k < eqT_rowptr[r + 1]; k++)
+                    sum += eqT_values[k] * shur_l[eqT_colind[k]];
+                shur_q[r] = sum;
+            }
+        });
+
+        // result = [Cq]*q + cfm*l
+        scheduler.ParallelFor(0, n_c, 0, [this, &result, enabled](int from, int to) {
+            for (int i = from; i < to; i++) {
+                if (enabled && (*enabled)[i] == false) {
+                    result(i, 0) = 0;
+                    continue;
+                }
+                double sum = shur_cfm[i] * shur_l[i];
+                for (int k = cq_rowptr[i]; k < cq_rowptr[i + 1]; k++)
+                    sum += cq_values[k] * shur_q[cq_colind[k]];
+                result(i, 0) = sum;
+            }
+        });
+
+        return;
+    }
+
 // Performs the sparse product    result = [N]*l = [ [Cq][M^(-1)][Cq'] - [E] ] *l
 // in different phases:
 
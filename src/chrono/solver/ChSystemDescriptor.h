@@ -84,6 +84,22 @@ class ChApi ChSystemDescriptor {
 
     double c_a;  // coefficient form M mass matrices in vvariables
 
+    bool assembled_shur;        ///< use assembled jacobians in ShurComplementProduct()
+    bool assembled_shur_valid;  ///< assembled jacobians are up to date
+
+    std::vector<int> cq_rowptr;      ///< CSR row pointers of the assembled [Cq] (one row per active constraint)
+    std::vector<int> cq_colind;      ///< CSR column indices of the assembled [Cq]
+    std::vector<double> cq_values;   ///< CSR values of the assembled [Cq]
+    std::vector<int> eqT_rowptr;     ///< CSR row pointers of [M^(-1)][Cq'] (one row per active scalar variable)
+    std::vector<int> eqT_colind;     ///< CSR column indices of [M^(-1)][Cq']
+    std::vector<double> eqT_values;  ///< CSR values of [M^(-1)][Cq']
+    std::vector<double> shur_cfm;    ///< cfm terms of the active constraints
+    std::vector<double> shur_l;      ///< work vector of multipliers
+    std::vector<double> shur_q;      ///< work vector of variables
+
+    /// Pack the jacobians in compressed sparse row storage, for the assembled mode of ShurComplementProduct().
+    void AssembleShurProduct();
+
   private:
     int n_q;            ///< number of active variables
     int n_c;            ///< number of active constraints
@@ -116,6 +132,14 @@ class ChApi ChSystemDescriptor {
         vstiffness.clear();
     }
 
+    /// Begin insertion of items, keeping the first items of each list.
+    /// Used for incremental updates, when only the items inserted last (e.g., contacts) change.
+    virtual void ResumeInsertion(size_t nconstraints, size_t nvariables, size_t nkblocks) {
+        vconstraints.resize(nconstraints);
+        vvariables.resize(nvariables);
+        vstiffness.resize(nkblocks);
+    }
+
     /// Insert reference to a ChConstraint object
     virtual void InsertConstraint(ChConstraint* mc) { vconstraints.push_back(mc); }
 
@@ -126,7 +150,10 @@ class ChApi ChSystemDescriptor {
     virtual void InsertKblock(ChKblock* mk) { vstiffness.push_back(mk); }
 
     /// End insertion of items
-    virtual void EndInsertion() { UpdateCountsAndOffsets(); }
+    virtual void EndInsertion() {
+        UpdateCountsAndOffsets();
+        InvalidateAssembledShurProduct();
+    }
 
     /// Count & returns the scalar variables in the system (excluding ChVariable objects
     /// that have  IsActive() as false). Note: the number of scalar variables is not necessarily
@@ -268,6 +295,9 @@ class ChApi ChSystemDescriptor {
     /// NOTE! currently this function does NOT support the cases that use also ChKblock
     /// objects, because it would need to invert the global M+K, that is not diagonal,
     /// for doing = [N]*l = [ [Cq][(M+K)^(-1)][Cq'] - [E] ] * l
+    /// If the assembled mode is enabled (see SetAssembledShurProduct()), the jacobians are not accessed through
+    /// the constraints but through compressed sparse row copies, and the 'q' data in the ChVariables is left
+    /// untouched.
     virtual void ShurComplementProduct(ChMatrix<>& result,   ///< matrix which contains the result of  N*l_i
                                        ChMatrix<>* lvector,  ///< optional matrix with the vector to be multiplied (if
                                        /// null, use current constr. multipliers l_i)
@@ -327,6 +357,25 @@ class ChApi ChSystemDescriptor {
     virtual void SetNumThreads(int nthreads);
     virtual int GetNumThreads() { return this->num_threads; }
 
+    /// Enable/disable the assembled mode for ShurComplementProduct() (default: false).
+    /// In assembled mode, the constraint jacobians [Cq] and the products [M^(-1)][Cq'] are packed in compressed
+    /// sparse row storage at the first ShurComplementProduct() after the jacobians change; the following products
+    /// (typically, one or more per iteration of the iterative solver) are then multithreaded sparse matrix-vector
+    /// products, without calls to the ChConstraint and ChVariables objects. Only diagonal-block mass matrices
+    /// are supported (no ChKblock), as in the default mode.
+    void SetAssembledShurProduct(bool val) {
+        assembled_shur = val;
+        assembled_shur_valid = false;
+    }
+
+    /// Tell if the assembled mode for ShurComplementProduct() is enabled.
+    bool GetAssembledShurProduct() const { return assembled_shur; }
+
+    /// Mark the assembled jacobians (if any) as out of date.
+    /// This must be called whenever the jacobians or masses change; ChSystem does this after loading the
+    /// jacobians, and EndInsertion() does it as well.
+    void InvalidateAssembledShurProduct() { assembled_shur_valid = false; }
+
     //
     // LOGGING/OUTPUT/ETC.
     //
@@ -298,6 +298,73 @@ void ChTimestepperLeapfrog::Advance(const double dt) {
 
 // -----------------------------------------------------------------------------
 
+// Local error norm: WRMS norm of the estimated position (and velocity) errors, with weights relative to the
+// position increment and to the velocity over the step.
+double ChImplicitIterativeTimestepper::LocalErrorNorm(const ChVectorDynamic<>& ex,
+                                                      const ChVectorDynamic<>* ev,
+                                                      const ChVectorDynamic<>& V,
+                                                      const ChVectorDynamic<>& Vnew,
+                                                      double h) const {
+    int n = ex.GetLength();
+    if (n == 0)
+        return 0;
+
+    double sum = 0;
+    for (int i = 0; i < n; ++i) {
+        double v = ChMax(std::abs(V.ElementN(i)), std::abs(Vnew.ElementN(i)));
+        double wx = ex.ElementN(i) / (err_reltol * h * v + err_abstol);
+        sum += wx * wx;
+        if (ev) {
+            double wv = ev->ElementN(i) / (err_reltol * v + err_abstol);
+            sum += wv * wv;
+        }
+    }
+
+    return std::sqrt(sum / (ev ? 2 * n : n));
+}
+
+// Step size selection (Hairer, Wanner: Solving ODEs II, IV.2):
+//   accepted step:  h_new = h * safety * err^(-0.7/k) * err_prev^(0.4/k)   (PI controller)
+//   rejected step:  h_new = h * safety * err^(-1/k)                        (I controller)
+// with k the order of the error estimate and the factor limited to [0.2, 5].
+double ChImplicitIterativeTimestepper::ProposeStepSize(double h,
+                                                       double err,
+                                                       int order,
+                                                       bool accepted,
+                                                       bool after_rejection) {
+    const double safety = 0.9;
+    const double fac_min = 0.2;
+    const double fac_max = 5.0;
+
+    err = ChMax(err, 1e-10);
+
+    double fac;
+    if (!accepted) {
+        fac = ChMin(safety * std::pow(err, -1.0 / order), 1.0);
+    } else {
+        fac = safety * std::pow(err, -0.7 / order);
+        if (err_prev > 0)
+            fac *= std::pow(err_prev, 0.4 / order);
+        else
+            fac *= std::pow(err, -0.3 / order);
+        err_prev = ChMax(err, 1e-4);
+    }
+
+    fac = ChClamp(fac, fac_min, after_rejection ? 1.0 : fac_max);
+
+    return ChClamp(h * fac, err_h_min, err_h_max);
+}
+
+double ChImplicitIterativeTimestepper::FitStepSize(double h, double remaining) {
+    if (remaining <= h * (1 + 1e-6))
+        return remaining;
+    if (remaining < 2 * h)
+        return remaining / 2;
+    return h;
+}
+
+// -----------------------------------------------------------------------------
+
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChTimestepperEulerImplicit)
 
@@ -320,66 +387,164 @@ void ChTimestepperEulerImplicit::Advance(const double dt) {
 
     mintegrable->StateGather(X, V, T);  // state <- system
 
+    numiters = 0;
+    numsetups = 0;
+    numsolves = 0;
+
+    if (!err_control) {
+        SolveStep(mintegrable, dt);
+
+        mintegrable->StateScatterAcceleration(
+            (Vnew - V) * (1 / dt));  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
+
+        X = Xnew;
+        V = Vnew;
+        T += dt;
+
+        mintegrable->StateScatter(X, V, T);     // state -> system
+        mintegrable->StateScatterReactions(L);  // -> system auxiliary data
+
+        num_accepted++;
+        return;
+    }
+
+    // Error control: reach T+dt with internal steps of size h, each with a local error below the tolerances.
+    // The local error is estimated by the difference with the trapezoidal rule:
+    //   e_x = h/2 (v_new - v_old),  e_v = h/2 (a_new - a_old)
+    // with a_new = (v_new - v_old)/h the acceleration (as measure) of the step.
+    mintegrable->StateGatherAcceleration(A);  // <- system
+
+    double tfinal = T + dt;
+    double h = err_step > 0 ? err_step : dt;
+    h = ChMax(ChMin(h, err_h_max), err_h_min);
+    int rejections = 0;
+
+    while (T < tfinal) {
+        double h_desired = h;
+        h = FitStepSize(h, tfinal - T);
+        bool last = (h == tfinal - T);
+
+        SolveStep(mintegrable, h);
+
+        ChStateDelta Anew = (Vnew - V) * (1 / h);
+        ChStateDelta ex = (Vnew - V) * (h / 2);
+        ChStateDelta ev = (Anew - A) * (h / 2);
+        err_last = LocalErrorNorm(ex, &ev, V, Vnew, h);
+
+        if (AcceptStep(h, err_last, rejections)) {
+            // accept the step
+            double h_next = ProposeStepSize(h, err_last, 2, true, rejections > 0);
+            X = Xnew;
+            V = Vnew;
+            A = Anew;
+            T = last ? tfinal : T + h;
+            num_accepted++;
+            rejections = 0;
+            // a step shortened to hit the final time does not limit the following ones
+            h = (last && h < h_desired) ? ChMax(h_next, h_desired) : h_next;
+            if (verbose)
+                GetLog() << " Euler accepted step  T = " << T << "  err = " << err_last << "  next h = " << h << "\n";
+        } else {
+            // reject the step and retry from the current state with a smaller step
+            h = ProposeStepSize(h, err_last, 2, false, rejections > 0);
+            num_rejected++;
+            rejections++;
+            if (verbose)
+                GetLog() << " Euler rejected step  err = " << err_last << "  retry h = " << h << "\n";
+        }
+
+        mintegrable->StateScatter(X, V, T);  // state -> system
+    }
+
+    err_step = h;
+
+    mintegrable->StateScatterAcceleration(A);  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
+    mintegrable->StateScatterReactions(L);     // -> system auxiliary data
+}
+
+void ChTimestepperEulerImplicit::SolveStep(ChIntegrableIIorder* mintegrable, double h) {
+    bool setup = SetupRequired(h, mintegrable->GetNcoords_v() + mintegrable->GetNconstr());
+    if (!NewtonIteration(mintegrable, h, setup) && !setup) {
+        if (verbose)
+            GetLog() << " Euler re-attempt step with updated matrix.\n";
+        NewtonIteration(mintegrable, h, true);
+    }
+}
+
+bool ChTimestepperEulerImplicit::NewtonIteration(ChIntegrableIIorder* mintegrable, double h, bool setup) {
+    int size = mintegrable->GetNcoords_v() + mintegrable->GetNconstr();
+
+    L.Reset(mintegrable->GetNconstr());
+
     // Extrapolate a prediction as warm start
 
-    Xnew = X + V * dt;
-    Vnew = V;  //+ A()*dt;
+    Xnew = X + V * h;
+    Vnew = V;  //+ A()*h;
 
     // use Newton Raphson iteration to solve implicit Euler for v_new
     //
     // [ M - dt*dF/dv - dt^2*dF/dx    Cq' ] [ Dv     ] = [ M*(v_old - v_new) + dt*f + dt*Cq'*l ]
     // [ Cq                           0   ] [ -dt*Dl ] = [ -C/dt  ]
 
-    numiters = 0;
-    numsetups = 0;
-    numsolves = 0;
+    call_setup = setup;
+    double Dv_norm_prev = 0;
 
     for (int i = 0; i < this->GetMaxiters(); ++i) {
-        mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
+        mintegrable->StateScatter(Xnew, Vnew, T + h);  // state -> system
         R.Reset();
         Qc.Reset();
-        mintegrable->LoadResidual_F(R, dt);
+        mintegrable->LoadResidual_F(R, h);
         mintegrable->LoadResidual_Mv(R, (V - Vnew), 1.0);
-        mintegrable->LoadResidual_CqL(R, L, dt);
-        mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);
+        mintegrable->LoadResidual_CqL(R, L, h);
+        mintegrable->LoadConstraint_C(Qc, 1.0 / h, Qc_do_clamp, Qc_clamping);
 
         if (verbose)
             GetLog() << " Euler iteration=" << i << "  |R|=" << R.NormInf() << "  |Qc|=" << Qc.NormInf() << "\n";
 
         if ((R.NormInf() < abstolS) && (Qc.NormInf() < abstolL))
-            break;
+            return true;
 
         mintegrable->StateSolveCorrection(
             Dv, Dl, R, Qc,
-            1.0,                 // factor for  M
-            -dt,                 // factor for  dF/dv
-            -dt * dt,            // factor for  dF/dx
-            Xnew, Vnew, T + dt,  // not used here (scatter = false)
-            false,               // do not StateScatter update to Xnew Vnew T+dt before computing correction
-            true                 // always call the solver's Setup
+            1.0,                // factor for  M
+            -h,                 // factor for  dF/dv
+            -h * h,             // factor for  dF/dx
+            Xnew, Vnew, T + h,  // not used here (scatter = false)
+            false,              // do not StateScatter update to Xnew Vnew T+dt before computing correction
+            call_setup          // call the solver's Setup? (always, unless using modified Newton)
             );
 
         numiters++;
-        numsetups++;
         numsolves++;
+        RecordSetup(call_setup, h, size);
 
-        Dl *= (1.0 / dt);  // Note it is not -(1.0/dt) because we assume StateSolveCorrection already flips sign of Dl
+        // If using modified Newton, do not call Setup again unless the convergence rate degrades
+        double Dv_norm = Dv.NormInf();
+        call_setup = !modified_Newton || ConvergenceDegraded(Dv_norm, Dv_norm_prev);
+        Dv_norm_prev = Dv_norm;
+
+        Dl *= (1.0 / h);  // Note it is not -(1.0/dt) because we assume StateSolveCorrection already flips sign of Dl
         L += Dl;
 
         Vnew += Dv;
 
-        Xnew = X + Vnew * dt;
+        Xnew = X + Vnew * h;
     }
 
-    mintegrable->StateScatterAcceleration(
-        (Vnew - V) * (1 / dt));  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
+    return false;
+}
 
-    X = Xnew;
-    V = Vnew;
-    T += dt;
+void ChTimestepperEulerImplicit::GetInternalState(std::vector<double>& state) const {
+    state.resize(2);
+    state[0] = err_step;
+    state[1] = err_prev;
+}
 
-    mintegrable->StateScatter(X, V, T);     // state -> system
-    mintegrable->StateScatterReactions(L);  // -> system auxiliary data
+void ChTimestepperEulerImplicit::SetInternalState(const std::vector<double>& state) {
+    if (state.size() != 2)
+        return;
+    err_step = state[0];
+    err_prev = state[1];
 }
 
 // -----------------------------------------------------------------------------
@@ -573,71 +738,172 @@ void ChTimestepperTrapezoidal::Advance(const double dt) {
     mintegrable->StateGather(X, V, T);  // state <- system
     // mintegrable->StateGatherReactions(L); // <- system  assume l_old = 0;  otherwise DAE gives oscillatory reactions
 
-    // extrapolate a prediction as a warm start
+    numiters = 0;
+    numsetups = 0;
+    numsolves = 0;
 
-    Xnew = X + V * dt;
-    Vnew = V;  // +A()*dt;
+    if (!err_control) {
+        SolveStep(mintegrable, dt);
+
+        mintegrable->StateScatterAcceleration(
+            (Vnew - V) * (1 / dt));  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
+
+        X = Xnew;
+        V = Vnew;
+        T += dt;
+
+        mintegrable->StateScatter(X, V, T);  // state -> system
+        mintegrable->StateScatterReactions(L *=
+                                           0.5);  // -> system auxiliary data   (*=0.5 cause we used the hack of l_old = 0)
+
+        num_accepted++;
+        return;
+    }
+
+    // Error control: reach T+dt with internal steps of size h, each with a local error below the tolerances.
+    // The local error is estimated as for Newmark schemes (Zienkiewicz-Xie), with beta = 1/4:
+    //   e_x = h^2 (beta - 1/6) (a_new - a_old)
+    // using the average accelerations (v_new - v_old)/h of consecutive steps.
+    mintegrable->StateGatherAcceleration(A);  // <- system
+
+    double tfinal = T + dt;
+    double h = err_step > 0 ? err_step : dt;
+    h = ChMax(ChMin(h, err_h_max), err_h_min);
+    int rejections = 0;
+
+    while (T < tfinal) {
+        double h_desired = h;
+        h = FitStepSize(h, tfinal - T);
+        bool last = (h == tfinal - T);
+
+        SolveStep(mintegrable, h);
+
+        ChStateDelta Anew = (Vnew - V) * (1 / h);
+        ChStateDelta ex = (Anew - A) * (h * h / 12);
+        err_last = LocalErrorNorm(ex, nullptr, V, Vnew, h);
+
+        if (AcceptStep(h, err_last, rejections)) {
+            // accept the step
+            double h_next = ProposeStepSize(h, err_last, 3, true, rejections > 0);
+            X = Xnew;
+            V = Vnew;
+            A = Anew;
+            T = last ? tfinal : T + h;
+            num_accepted++;
+            rejections = 0;
+            // a step shortened to hit the final time does not limit the following ones
+            h = (last && h < h_desired) ? ChMax(h_next, h_desired) : h_next;
+            if (verbose)
+                GetLog() << " Trapezoidal accepted step  T = " << T << "  err = " << err_last << "  next h = " << h
+                         << "\n";
+        } else {
+            // reject the step and retry from the current state with a smaller step
+            h = ProposeStepSize(h, err_last, 3, false, rejections > 0);
+            num_rejected++;
+            rejections++;
+            if (verbose)
+                GetLog() << " Trapezoidal rejected step  err = " << err_last << "  retry h = " << h << "\n";
+        }
+
+        mintegrable->StateScatter(X, V, T);  // state -> system
+    }
+
+    err_step = h;
+
+    mintegrable->StateScatterAcceleration(A);  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
+    mintegrable->StateScatterReactions(L *=
+                                       0.5);  // -> system auxiliary data   (*=0.5 cause we used the hack of l_old = 0)
+}
+
+void ChTimestepperTrapezoidal::SolveStep(ChIntegrableIIorder* mintegrable, double h) {
+    Rold.Reset(mintegrable->GetNcoords_v());
 
-    // use Newton Raphson iteration to solve implicit trapezoidal for v_new
-    //
     // [ M - dt/2*dF/dv - dt^2/4*dF/dx    Cq' ] [ Dv       ] = [ M*(v_old - v_new) + dt/2(f_old + f_new  + Cq*l_old + Cq*l_new)]
     // [ Cq                               0   ] [ -dt/2*Dl ] = [ -C/dt ]
 
-    mintegrable->LoadResidual_F(Rold, dt * 0.5);  // dt/2*f_old
-    mintegrable->LoadResidual_Mv(Rold, V, 1.0);   // M*v_old
+    mintegrable->LoadResidual_F(Rold, h * 0.5);  // dt/2*f_old
+    mintegrable->LoadResidual_Mv(Rold, V, 1.0);  // M*v_old
     // mintegrable->LoadResidual_CqL(Rold, L, dt*0.5); // dt/2*l_old   assume L_old = 0
 
-    numiters = 0;
-    numsetups = 0;
-    numsolves = 0;
+    bool setup = SetupRequired(h, mintegrable->GetNcoords_v() + mintegrable->GetNconstr());
+    if (!NewtonIteration(mintegrable, h, setup) && !setup) {
+        if (verbose)
+            GetLog() << " Trapezoidal re-attempt step with updated matrix.\n";
+        NewtonIteration(mintegrable, h, true);
+    }
+}
+
+bool ChTimestepperTrapezoidal::NewtonIteration(ChIntegrableIIorder* mintegrable, double h, bool setup) {
+    int size = mintegrable->GetNcoords_v() + mintegrable->GetNconstr();
+
+    L.Reset(mintegrable->GetNconstr());
+
+    // extrapolate a prediction as a warm start
+
+    Xnew = X + V * h;
+    Vnew = V;  // +A()*h;
+
+    // use Newton Raphson iteration to solve implicit trapezoidal for v_new (residual terms at the old state in Rold)
+
+    call_setup = setup;
+    double Dv_norm_prev = 0;
 
     for (int i = 0; i < this->GetMaxiters(); ++i) {
-        mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
+        mintegrable->StateScatter(Xnew, Vnew, T + h);  // state -> system
         R = Rold;
         Qc.Reset();
-        mintegrable->LoadResidual_F(R, dt * 0.5);                               // + dt/2*f_new
-        mintegrable->LoadResidual_Mv(R, Vnew, -1.0);                            // - M*v_new
-        mintegrable->LoadResidual_CqL(R, L, dt * 0.5);                          // + dt/2*Cq*l_new
-        mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);  // -C/dt
+        mintegrable->LoadResidual_F(R, h * 0.5);                               // + dt/2*f_new
+        mintegrable->LoadResidual_Mv(R, Vnew, -1.0);                           // - M*v_new
+        mintegrable->LoadResidual_CqL(R, L, h * 0.5);                          // + dt/2*Cq*l_new
+        mintegrable->LoadConstraint_C(Qc, 1.0 / h, Qc_do_clamp, Qc_clamping);  // -C/dt
 
         if (verbose)
             GetLog() << " Trapezoidal iteration=" << i << "  |R|=" << R.NormTwo() << "  |Qc|=" << Qc.NormTwo() << "\n";
 
         if ((R.NormInf() < abstolS) && (Qc.NormInf() < abstolL))
-            break;
+            return true;
 
         mintegrable->StateSolveCorrection(
             Dv, Dl, R, Qc,
-            1.0,                 // factor for  M
-            -dt * 0.5,           // factor for  dF/dv
-            -dt * dt * 0.25,     // factor for  dF/dx
-            Xnew, Vnew, T + dt,  // not used here (scatter = false)
-            false,               // do not StateScatter update to Xnew Vnew T+dt before computing correction
-            true                 // always force a call to the solver's Setup() function
+            1.0,                // factor for  M
+            -h * 0.5,           // factor for  dF/dv
+            -h * h * 0.25,      // factor for  dF/dx
+            Xnew, Vnew, T + h,  // not used here (scatter = false)
+            false,              // do not StateScatter update to Xnew Vnew T+dt before computing correction
+            call_setup          // call the solver's Setup? (always, unless using modified Newton)
             );
 
         numiters++;
-        numsetups++;
         numsolves++;
+        RecordSetup(call_setup, h, size);
 
-        Dl *= (2.0 / dt);  // Note it is not -(2.0/dt) because we assume StateSolveCorrection already flips sign of Dl
+        // If using modified Newton, do not call Setup again unless the convergence rate degrades
+        double Dv_norm = Dv.NormInf();
+        call_setup = !modified_Newton || ConvergenceDegraded(Dv_norm, Dv_norm_prev);
+        Dv_norm_prev = Dv_norm;
+
+        Dl *= (2.0 / h);  // Note it is not -(2.0/dt) because we assume StateSolveCorrection already flips sign of Dl
         L += Dl;
 
         Vnew += Dv;
 
-        Xnew = X + ((Vnew + V) * (dt * 0.5));  // Xnew = Xold + h/2(Vnew+Vold)
+        Xnew = X + ((Vnew + V) * (h * 0.5));  // Xnew = Xold + h/2(Vnew+Vold)
     }
 
-    mintegrable->StateScatterAcceleration(
-        (Vnew - V) * (1 / dt));  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
+    return false;
+}
 
-    X = Xnew;
-    V = Vnew;
-    T += dt;
+void ChTimestepperTrapezoidal::GetInternalState(std::vector<double>& state) const {
+    state.resize(2);
+    state[0] = err_step;
+    state[1] = err_prev;
+}
 
-    mintegrable->StateScatter(X, V, T);  // state -> system
-    mintegrable->StateScatterReactions(L *=
-                                       0.5);  // -> system auxiliary data   (*=0.5 cause we used the hack of l_old = 0)
+void ChTimestepperTrapezoidal::SetInternalState(const std::vector<double>& state) {
+    if (state.size() != 2)
+        return;
+    err_step = state[0];
+    err_prev = state[1];
 }
 
 // -----------------------------------------------------------------------------
@@ -16,6 +16,8 @@
 #define CHTIMESTEPPER_H
 
 #include <cstdlib>
+#include <vector>
+
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChMath.h"
 #include "chrono/core/ChVectorDynamic.h"
@@ -94,6 +96,13 @@ class ChApi ChTimestepper {
     /// Turn on/off clamping on the Qcterm.
     void SetQcClamping(double mcl) { Qc_clamping = mcl; }
 
+    /// Get the internal data carried over from one step to the next (e.g., the current step size
+    /// of an adaptive method). Used for system snapshots. By default, there is no such data.
+    virtual void GetInternalState(std::vector<double>& state) const { state.clear(); }
+
+    /// Set the internal data carried over from one step to the next (see GetInternalState).
+    virtual void SetInternalState(const std::vector<double>& state) {}
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive);
 
@@ -200,9 +209,55 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
     int numsetups;  ///< number of calls to the solver's Setup function
     int numsolves;  ///< number of calls to the solver's Solve function
 
+    bool err_control;    ///< local error control enabled?
+    double err_reltol;   ///< relative tolerance for the local error
+    double err_abstol;   ///< absolute tolerance for the local error
+    double err_h_min;    ///< minimum step size under error control
+    double err_h_max;    ///< maximum step size under error control
+    int err_max_reject;  ///< consecutive rejections after which a step is accepted regardless of its error
+    double err_step;     ///< step size proposed for the next internal step (0 if none yet)
+    double err_prev;     ///< error norm of the last accepted step (0 if none yet)
+    double err_last;     ///< error norm of the last attempted step
+    int num_accepted;    ///< number of accepted internal steps
+    int num_rejected;    ///< number of rejected internal steps
+
+    bool modified_Newton;      ///< use modified Newton?
+    bool reuse_matrix_steps;   ///< reuse the Newton matrix across steps (modified Newton only)?
+    double max_conv_rate;      ///< convergence rate triggering a Newton matrix update (modified Newton only)
+    bool call_setup;           ///< should the solver's Setup function be called?
+    bool matrix_is_current;    ///< was the Newton matrix evaluated at the current iteration?
+    double matrix_h;           ///< step size of the last Newton matrix (0 if none)
+    int matrix_size;           ///< problem size of the last Newton matrix
+    int num_setups_saved;      ///< number of solver Setup calls avoided by modified Newton
+
   public:
     ChImplicitIterativeTimestepper()
-        : maxiters(6), reltol(1e-4), abstolS(1e-10), abstolL(1e-10), numiters(0), numsetups(0), numsolves(0) {}
+        : maxiters(6),
+          reltol(1e-4),
+          abstolS(1e-10),
+          abstolL(1e-10),
+          numiters(0),
+          numsetups(0),
+          numsolves(0),
+          err_control(false),
+          err_reltol(1e-3),
+          err_abstol(1e-5),
+          err_h_min(1e-6),
+          err_h_max(1e30),
+          err_max_reject(10),
+          err_step(0),
+          err_prev(0),
+          err_last(0),
+          num_accepted(0),
+          num_rejected(0),
+          modified_Newton(false),
+          reuse_matrix_steps(false),
+          max_conv_rate(0.5),
+          call_setup(true),
+          matrix_is_current(false),
+          matrix_h(0),
+          matrix_size(-1),
+          num_setups_saved(0) {}
     virtual ~ChImplicitIterativeTimestepper() {}
 
     /// Set the max number of iterations using the Newton Raphson procedure
@@ -242,15 +297,110 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
     /// Return the number of calls to the solver's Solve function.
     int GetNumSolveCalls() const { return numsolves; }
 
+    /// Enable/disable modified Newton.
+    /// If enabled, the Newton matrix is evaluated, assembled, and factorized (i.e., the solver's Setup function is
+    /// called) only at the first iteration of a step, on a step size change, if the convergence rate of the Newton
+    /// iteration degrades (see SetConvergenceRateThreshold), or if the Newton iteration does not converge with an
+    /// out-of-date matrix. If disabled, the Newton matrix is evaluated at every iteration of the nonlinear solver.
+    /// Disabled by default, except for HHT. Note that with an out-of-date matrix the Newton iteration converges
+    /// linearly: the maximum number of iterations may need to be increased.
+    void SetModifiedNewton(bool val) { modified_Newton = val; }
+
+    /// Return true if modified Newton is enabled.
+    bool GetModifiedNewton() const { return modified_Newton; }
+
+    /// Allow modified Newton to reuse the Newton matrix (and its factorization) of a previous step (default: false).
+    /// The matrix is reused only for a step of the same size and the same problem size; it is re-evaluated as soon
+    /// as the convergence rate degrades. Effective only with solvers that do not require an up-to-date matrix for
+    /// their Solve function (i.e., direct solvers).
+    void SetMatrixReuseAcrossSteps(bool val) { reuse_matrix_steps = val; }
+
+    /// Set the convergence rate above which modified Newton re-evaluates the Newton matrix (default: 0.5).
+    /// The rate is the ratio between the norms of successive Newton corrections.
+    void SetConvergenceRateThreshold(double rate) { max_conv_rate = rate; }
+
+    /// Return the number of Newton iterations performed without calling the solver's Setup function
+    /// (since the last call to ResetStepStatistics).
+    int GetNumSetupsSaved() const { return num_setups_saved; }
+
+    /// Turn adaptive step size control, based on an estimate of the local truncation error, on/off.
+    /// If enabled, Advance(dt) reaches T+dt with as many internal steps as needed: a step whose error estimate
+    /// exceeds the tolerances (see SetErrorTolerances) is rejected, the state is rolled back and the step is
+    /// retried with a smaller step size; the size of the following step is selected with a PI controller.
+    /// Supported by the Euler implicit, trapezoidal and HHT timesteppers. Disabled by default.
+    void SetErrorControl(bool val) { err_control = val; }
+
+    /// Return true if adaptive step size control based on the local error is enabled.
+    bool GetErrorControl() const { return err_control; }
+
+    /// Set the tolerances for the local error (defaults: 1e-3 and 1e-5).
+    /// The error of each position coordinate is weighted by 1/(rel_tol * |h*v| + abs_tol), the error of each
+    /// velocity coordinate by 1/(rel_tol * |v| + abs_tol); a step is accepted if the WRMS norm of the weighted
+    /// errors does not exceed 1.
+    void SetErrorTolerances(double rel_tol, double abs_tol) {
+        err_reltol = rel_tol;
+        err_abstol = abs_tol;
+    }
+
+    /// Set the range of step sizes used under error control (defaults: 1e-6 and unlimited).
+    /// A step taken with the minimum step size is accepted regardless of its error estimate.
+    /// When the timestepper is used by a ChSystem, a limit set with ChSystem::SetStepMin or ChSystem::SetStepMax
+    /// overrides the corresponding one set here.
+    void SetStepSizeLimits(double min_step, double max_step) {
+        err_h_min = min_step;
+        err_h_max = max_step;
+    }
+
+    /// Return the minimum step size under error control.
+    double GetStepSizeMin() const { return err_h_min; }
+
+    /// Return the maximum step size under error control.
+    double GetStepSizeMax() const { return err_h_max; }
+
+    /// Set the number of consecutive rejections of a step after which the step is accepted regardless of its
+    /// error estimate (default: 10). This bounds the work spent on a step whose error estimate does not decrease
+    /// with the step size, e.g. when it is dominated by the correction of the constraint drift left by previous
+    /// steps; such a step is accepted with an error norm larger than 1 (see GetErrorEstimate).
+    void SetMaxStepRejections(int max_rejections) { err_max_reject = max_rejections; }
+
+    /// Return the step size proposed for the next internal step (0 if not available yet).
+    virtual double GetStepSize() const { return err_step; }
+
+    /// Return the number of accepted internal steps (since the last call to ResetStepStatistics).
+    int GetNumAcceptedSteps() const { return num_accepted; }
+
+    /// Return the number of rejected internal steps (since the last call to ResetStepStatistics).
+    /// Steps are rejected because of a large local error or, for HHT, of a failed Newton iteration.
+    int GetNumRejectedSteps() const { return num_rejected; }
+
+    /// Return the norm of the local error estimate of the last attempted step (error control only).
+    double GetErrorEstimate() const { return err_last; }
+
+    /// Reset the counters of accepted and rejected steps, and of saved solver setups.
+    void ResetStepStatistics() {
+        num_accepted = 0;
+        num_rejected = 0;
+        num_setups_saved = 0;
+    }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) {
         // version number
-        marchive.VersionWrite(1);
+        marchive.VersionWrite(2);
         // serialize all member data:
         marchive << CHNVP(maxiters);
         marchive << CHNVP(reltol);
         marchive << CHNVP(abstolS);
         marchive << CHNVP(abstolL);
+        marchive << CHNVP(err_control);
+        marchive << CHNVP(err_reltol);
+        marchive << CHNVP(err_abstol);
+        marchive << CHNVP(err_h_min);
+        marchive << CHNVP(err_h_max);
+        marchive << CHNVP(err_max_reject);
+        marchive << CHNVP(modified_Newton);
+        marchive << CHNVP(reuse_matrix_steps);
+        marchive << CHNVP(max_conv_rate);
     }
 
     /// Method to allow de-serialization of transient data from archives.
@@ -262,7 +412,74 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
         marchive >> CHNVP(reltol);
         marchive >> CHNVP(abstolS);
         marchive >> CHNVP(abstolL);
+        if (version >= 2) {
+            marchive >> CHNVP(err_control);
+            marchive >> CHNVP(err_reltol);
+            marchive >> CHNVP(err_abstol);
+            marchive >> CHNVP(err_h_min);
+            marchive >> CHNVP(err_h_max);
+            marchive >> CHNVP(err_max_reject);
+            marchive >> CHNVP(modified_Newton);
+            marchive >> CHNVP(reuse_matrix_steps);
+            marchive >> CHNVP(max_conv_rate);
+        }
+    }
+
+  protected:
+    /// WRMS norm of the local error estimate of a step of size h from velocities V to Vnew, with position errors
+    /// ex and (optional) velocity errors ev, using the weights described in SetErrorTolerances.
+    double LocalErrorNorm(const ChVectorDynamic<>& ex,
+                          const ChVectorDynamic<>* ev,
+                          const ChVectorDynamic<>& V,
+                          const ChVectorDynamic<>& Vnew,
+                          double h) const;
+
+    /// Size of the next step attempt after a step of size h with error norm err, for an error estimate that
+    /// scales as h^order. Uses a PI controller after accepted steps and an I controller after rejected ones;
+    /// the step size is not increased right after a rejection. The result is within the step size limits.
+    double ProposeStepSize(double h, double err, int order, bool accepted, bool after_rejection);
+
+    /// Return true if a step of size h with error norm err is accepted, after the given number of consecutive
+    /// rejections of the same step. Besides steps within the tolerances, steps of minimum size and steps rejected
+    /// the maximum number of times (see SetMaxStepRejections) are accepted.
+    bool AcceptStep(double h, double err, int rejections) const {
+        return err <= 1 || h <= err_h_min || rejections >= err_max_reject;
+    }
+
+    /// Return true if the solver's Setup function must be called at the first Newton iteration of a step of size h,
+    /// for a problem of the given size (number of velocity coordinates plus number of constraints).
+    bool SetupRequired(double h, int size) const {
+        return !modified_Newton || !reuse_matrix_steps || !MatrixMatches(h, size);
+    }
+
+    /// Return true if the last Newton matrix was evaluated for a step of size h (up to roundoff) and a problem
+    /// of the given size.
+    bool MatrixMatches(double h, int size) const {
+        return size == matrix_size && std::abs(h - matrix_h) <= 1e-6 * h;
     }
+
+    /// Record whether the solver's Setup function was called at the current Newton iteration, for a step of size h
+    /// and a problem of the given size. Updates the counters and the matrix_is_current flag.
+    void RecordSetup(bool setup, double h, int size) {
+        matrix_is_current = setup;
+        if (setup) {
+            numsetups++;
+            matrix_h = h;
+            matrix_size = size;
+        } else {
+            num_setups_saved++;
+        }
+    }
+
+    /// Return true if, with an out-of-date Newton matrix, the Newton correction of norm 'norm' did not decrease
+    /// enough with respect to the previous one, of norm 'norm_prev' (0 at the first iteration).
+    bool ConvergenceDegraded(double norm, double norm_prev) const {
+        return modified_Newton && !matrix_is_current && norm_prev > 0 && norm > max_conv_rate * norm_prev;
+    }
+
+    /// Size of the next internal step to reach the final time, given the desired size h and the remaining time.
+    /// The last two steps are balanced to avoid a tiny final step.
+    static double FitStepSize(double h, double remaining);
 };
 
 /// Euler explicit timestepper.
@@ -397,6 +614,21 @@ class ChApi ChTimestepperEulerImplicit : public ChTimestepperIIorder, public ChI
     /// Performs an integration timestep
     virtual void Advance(const double dt  ///< timestep to advance
                          ) override;
+
+    /// Get the proposed step size and the last accepted error norm (error control).
+    virtual void GetInternalState(std::vector<double>& state) const override;
+
+    /// Set the proposed step size and the last accepted error norm (error control).
+    virtual void SetInternalState(const std::vector<double>& state) override;
+
+  protected:
+    /// Solve the nonlinear problem of a step of size h from the current state (X, V, T) for (Xnew, Vnew, L).
+    /// With modified Newton, the iteration is repeated with a new Newton matrix if it does not converge
+    /// with the matrix of a previous step.
+    void SolveStep(ChIntegrableIIorder* mintegrable, double h);
+
+    /// Newton iteration for a step of size h, starting from an explicit prediction. Return true if converged.
+    bool NewtonIteration(ChIntegrableIIorder* mintegrable, double h, bool setup);
 };
 
 /// Performs a step of Euler implicit for II order systems using the Anitescu/Stewart/Trinkle
@@ -474,6 +706,22 @@ class ChApi ChTimestepperTrapezoidal : public ChTimestepperIIorder, public ChImp
     /// Performs an integration timestep
     virtual void Advance(const double dt  ///< timestep to advance
                          ) override;
+
+    /// Get the proposed step size and the last accepted error norm (error control).
+    virtual void GetInternalState(std::vector<double>& state) const override;
+
+    /// Set the proposed step size and the last accepted error norm (error control).
+    virtual void SetInternalState(const std::vector<double>& state) override;
+
+  protected:
+    /// Solve the nonlinear problem of a step of size h from the current state (X, V, T) for (Xnew, Vnew, L).
+    /// Assumes the current state is scattered to the integrable object.
+    /// With modified Newton, the iteration is repeated with a new Newton matrix if it does not converge
+    /// with the matrix of a previous step.
+    void SolveStep(ChIntegrableIIorder* mintegrable, double h);
+
+    /// Newton iteration for a step of size h, starting from an explicit prediction. Return true if converged.
+    bool NewtonIteration(ChIntegrableIIorder* mintegrable, double h, bool setup);
 };
 
 /// Performs a step of trapezoidal implicit linearized for II order systems.
@@ -34,8 +34,9 @@ ChTimestepperHHT::ChTimestepperHHT(ChIntegrableIIorder* mintegrable)
       h_min(1e-10),
       h(1e6),
       num_successful_steps(0),
-      modified_Newton(true) {
-    SetAlpha(-0.2);  // default: some dissipation
+      conv_norm(0) {
+    SetAlpha(-0.2);          // default: some dissipation
+    SetModifiedNewton(true);  // default: modified Newton
 }
 
 void ChTimestepperHHT::SetAlpha(double malpha) {
@@ -86,7 +87,10 @@ void ChTimestepperHHT::Advance(const double dt) {
     // If we had a streak of successful steps, consider a stepsize increase.
     // Note that we never attempt a step larger than the specified dt value.
     // If step size control is disabled, always use h = dt.
-    if (!step_control) {
+    // With error control, start from the step size proposed at the end of the previous step.
+    if (err_control) {
+        h = ChMax(ChMin(h, err_h_max), err_h_min);
+    } else if (!step_control) {
         h = dt;
         num_successful_steps = 0;
     } else if (num_successful_steps >= req_successful_steps) {
@@ -103,20 +107,39 @@ void ChTimestepperHHT::Advance(const double dt) {
 
     // Monitor flags controlling whther or not the Newton matrix must be updated.
     // If using modified Newton, a matrix update occurs:
-    //   - at the beginning of a step
-    //   - on a stepsize decrease
+    //   - at the beginning of a step (unless reusing the matrix across steps)
+    //   - on a stepsize change
+    //   - if the convergence rate degrades
     //   - if the Newton iteration does not converge with an out-of-date matrix
     // Otherwise, the matrix is updated at each iteration.
+    int size = mintegrable->GetNcoords_v() + mintegrable->GetNconstr();
     matrix_is_current = false;
-    call_setup = true;
+    call_setup = SetupRequired(h, size);
+
+    bool after_rejection = false;
+    int rejections = 0;
 
     // Loop until reaching final time
     while (T < tfinal) {
+        // With error control, fit the step to the final time
+        double h_desired = h;
+        bool last = false;
+        if (err_control) {
+            h = FitStepSize(h, tfinal - T);
+            last = (h == tfinal - T);
+        }
+
+        // The Newton matrix depends on the step size
+        if (!MatrixMatches(h, size))
+            call_setup = true;
+
         double scaling_factor = scaling ? beta * h * h : 1;
         Prepare(mintegrable, scaling_factor);
 
         // Newton-Raphson for state at T+h
         bool converged;
+        bool fresh_matrix = call_setup;  // was the matrix evaluated during this attempt?
+        double conv_norm_prev = 0;
         int it;
 
         for (it = 0; it < maxiters; it++) {
@@ -129,9 +152,8 @@ void ChTimestepperHHT::Advance(const double dt) {
             // Increment counters
             numiters++;
             numsolves++;
-            if (call_setup) {
-                numsetups++;
-            }
+            RecordSetup(call_setup, h, size);
+            fresh_matrix = fresh_matrix || call_setup;
 
             // If using modified Newton, do not call Setup again
             call_setup = !modified_Newton;
@@ -140,9 +162,54 @@ void ChTimestepperHHT::Advance(const double dt) {
             converged = CheckConvergence(scaling_factor);
             if (converged)
                 break;
+
+            // Update an out-of-date matrix if the convergence rate degrades
+            if (ConvergenceDegraded(conv_norm, conv_norm_prev))
+                call_setup = true;
+            conv_norm_prev = conv_norm;
         }
 
-        if (converged) {
+        if (converged && err_control) {
+            // ------ NR converged, check the local error estimate (Zienkiewicz-Xie):
+            //   e_x = h^2 (beta - 1/6) (a_new - a_old)
+            // The velocity error is not controlled, as it is dominated by the numerical damping of the method.
+
+            err_last = LocalErrorNorm((Anew - A) * (h * h * std::abs(beta - 1.0 / 6.0)), nullptr, V, Vnew, h);
+
+            if (AcceptStep(h, err_last, rejections)) {
+                double h_next = ProposeStepSize(h, err_last, 3, true, after_rejection);
+                after_rejection = false;
+                rejections = 0;
+                num_accepted++;
+
+                if (verbose) {
+                    GetLog() << " HHT NR converged, error = " << err_last << ".";
+                    GetLog() << "  T = " << T + h << "  h = " << h << "\n";
+                }
+
+                // advance time and set the state
+                T = last ? tfinal : T + h;
+                X = Xnew;
+                V = Vnew;
+                A = Anew;
+                L = Lnew;
+
+                // a step shortened to hit the final time does not limit the following ones
+                h = (last && h < h_desired) ? ChMax(h_next, h_desired) : h_next;
+            } else {
+                h = ProposeStepSize(h, err_last, 3, false, after_rejection);
+                after_rejection = true;
+                rejections++;
+                num_rejected++;
+
+                if (verbose)
+                    GetLog() << " ---HHT error = " << err_last << ", reduce stepsize to " << h << "\n";
+            }
+
+            // force a matrix re-evaluation (due to change in stepsize)
+            call_setup = true;
+
+        } else if (converged) {
             // ------ NR converged
 
             // if the number of iterations was low enough, increase the count of successive
@@ -168,9 +235,10 @@ void ChTimestepperHHT::Advance(const double dt) {
             A = Anew;
             L = Lnew;
 
-        /*
-        } else if (!matrix_is_current) {
-            // ------ NR did not converge but the matrix was out-of-date
+            num_accepted++;
+
+        } else if (modified_Newton && !fresh_matrix) {
+            // ------ NR did not converge but the matrix was out-of-date (from a previous step)
 
             // reset the count of successive successful steps
             num_successful_steps = 0;
@@ -181,9 +249,8 @@ void ChTimestepperHHT::Advance(const double dt) {
             }
 
             call_setup = true;
-        */
 
-        } else if (!step_control) {
+        } else if (!step_control && !err_control) {
             // ------ NR did not converge and we do not control stepsize
 
             // reset the count of successive successful steps
@@ -201,6 +268,8 @@ void ChTimestepperHHT::Advance(const double dt) {
             A = Anew;
             L = Lnew;
 
+            num_accepted++;
+
         } else {
             // ------ NR did not converge
 
@@ -209,6 +278,8 @@ void ChTimestepperHHT::Advance(const double dt) {
 
             // decrease stepsize
             h *= step_decrease_factor;
+            after_rejection = true;
+            num_rejected++;
 
             if (verbose)
                 GetLog() << " ---HHT reduce stepsize to " << h << "\n";
@@ -247,7 +318,7 @@ void ChTimestepperHHT::Advance(const double dt) {
 void ChTimestepperHHT::Prepare(ChIntegrableIIorder* integrable, double scaling_factor) {
     switch (mode) {
         case ACCELERATION:
-            if (step_control)
+            if (step_control || err_control)
                 Anew = A;
             Vnew = V + Anew * h;
             Xnew = X + Vnew * h + Anew * (h * h);
@@ -347,9 +418,6 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
 
             break;
     }
-
-    // If Setup was called at this iteration, mark the Newton matrix as up-to-date
-    matrix_is_current = call_setup;
 }
 
 // Convergence test
@@ -367,6 +435,7 @@ bool ChTimestepperHHT::CheckConvergence(double scaling_factor) {
             double Qc_nrm = Qc.NormTwo();
             double Da_nrm = Da.NormWRMS(ewtS);
             double Dl_nrm = Dl.NormWRMS(ewtL);
+            conv_norm = Da_nrm;
 
             if (verbose) {
                 GetLog() << " HHT iteration=" << numiters << "  |R|=" << R_nrm << "  |Qc|=" << Qc_nrm
@@ -386,6 +455,7 @@ bool ChTimestepperHHT::CheckConvergence(double scaling_factor) {
             // the Lagrange multipliers.
             double Dx_nrm = (Xnew - Xprev).NormWRMS(ewtS);
             Xprev = Xnew;
+            conv_norm = Dx_nrm;
 
             double Dl_nrm = Dl.NormWRMS(ewtL);
             Dl_nrm /= scaling_factor;
@@ -413,6 +483,23 @@ void ChTimestepperHHT::CalcErrorWeights(const ChVectorDynamic<>& x, double rtol,
     }
 }
 
+// The internal step size, the count of successful steps and the last accepted error norm (error control)
+// are carried over between steps.
+void ChTimestepperHHT::GetInternalState(std::vector<double>& state) const {
+    state.resize(3);
+    state[0] = h;
+    state[1] = num_successful_steps;
+    state[2] = err_prev;
+}
+
+void ChTimestepperHHT::SetInternalState(const std::vector<double>& state) {
+    if (state.size() != 2 && state.size() != 3)
+        return;
+    h = state[0];
+    num_successful_steps = (int)state[1];
+    err_prev = state.size() == 3 ? state[2] : 0;
+}
+
 // Trick to avoid putting the following mapper macro inside the class definition in .h file:
 // enclose macros in local 'my_enum_mappers', just to avoid avoiding cluttering of the parent class.
 class my_enum_mappers : public ChTimestepperHHT {
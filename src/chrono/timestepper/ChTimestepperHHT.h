@@ -25,6 +25,8 @@ namespace chrono {
 /// Implementation of the HHT implicit integrator for II order systems.
 /// This timestepper allows use of an adaptive time-step, as well as optional use of a modified
 /// Newton scheme for the solution of the resulting nonlinear problem.
+/// The step size is adapted either on the convergence of the Newton iteration (see SetStepControl)
+/// or, if error control is enabled (see SetErrorControl), on an estimate of the local error.
 class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIterativeTimestepper {
 
   public:
@@ -61,9 +63,7 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     double h;                     ///< internal stepsize
     int num_successful_steps;     ///< number of successful steps
 
-    bool modified_Newton;    ///< use modified Newton?
-    bool matrix_is_current;  ///< is the Newton matrix up-to-date?
-    bool call_setup;         ///< should the solver's Setup function be called?
+    double conv_norm;  ///< norm of the last Newton correction (convergence rate monitor)
 
     ChVectorDynamic<> ewtS;  ///< vector of error weights (states)
     ChVectorDynamic<> ewtL;  ///< vector of error weights (Lagrange multipliers)
@@ -111,17 +111,19 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     /// Must be a value smaller than 1.
     void SetStepDecreaseFactor(double factor) { step_decrease_factor = factor; }
 
-    /// Enable/disable modified Newton.
-    /// If enabled, the Newton matrix is evaluated, assembled, and factorized only once
-    /// per step or if the Newton iteration does not converge with an out-of-date matrix.
-    /// If disabled, the Newton matrix is evaluated at every iteration of the nonlinear solver.
-    /// Modified Newton iteration is enabled by default.
-    void SetModifiedNewton(bool val) { modified_Newton = val; }
-
     /// Perform an integration timestep.
     virtual void Advance(const double dt  ///< timestep to advance
                          ) override;
 
+    /// Return the internal step size, used for the next step attempt.
+    virtual double GetStepSize() const override { return h; }
+
+    /// Get the internal step size, the number of successful steps and the last accepted error norm.
+    virtual void GetInternalState(std::vector<double>& state) const override;
+
+    /// Set the internal step size, the number of successful steps and the last accepted error norm.
+    virtual void SetInternalState(const std::vector<double>& state) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) override;
 
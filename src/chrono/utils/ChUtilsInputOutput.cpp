@@ -291,6 +291,40 @@ void ReadCheckpoint(ChSystem* system, const std::string& filename) {
     }
 }
 
+// -----------------------------------------------------------------------------
+// WriteSnapshot
+//
+// Write a binary file with a snapshot of the system state (see
+// ChSystem::WriteSnapshot).
+// -----------------------------------------------------------------------------
+bool WriteSnapshot(ChSystem* system, const std::string& filename) {
+    std::vector<char> buffer;
+    system->WriteSnapshot(buffer);
+
+    std::ofstream ofile(filename, std::ios::binary);
+    if (!ofile.good())
+        return false;
+    ofile.write(buffer.data(), buffer.size());
+    return ofile.good();
+}
+
+// -----------------------------------------------------------------------------
+// ReadSnapshot
+//
+// Restore the system state from a binary snapshot file (see
+// ChSystem::ReadSnapshot).
+// -----------------------------------------------------------------------------
+bool ReadSnapshot(ChSystem* system, const std::string& filename) {
+    std::ifstream ifile(filename, std::ios::binary | std::ios::ate);
+    if (!ifile.good())
+        return false;
+    std::vector<char> buffer((size_t)ifile.tellg());
+    ifile.seekg(0);
+    if (!ifile.read(buffer.data(), buffer.size()))
+        return false;
+    return system->ReadSnapshot(buffer);
+}
+
 // -----------------------------------------------------------------------------
 // WriteShapesPovray
 //
@@ -25,6 +25,10 @@
 //      contact geometry.
 //    - only a subset of contact shapes are currently supported
 //
+// WriteSnapshot and ReadSnapshot
+//  these functions write and read, respectively, a binary snapshot of the
+//  state of a system, to be restored into an identically built system.
+//
 // WriteShapesPovray
 //  this function writes a CSV file appropriate for processing with a POV-Ray
 //  script.
@@ -143,6 +147,15 @@ bool WriteCheckpoint(ChSystem* system, const std::string& filename);
 ChApi
 void ReadCheckpoint(ChSystem* system, const std::string& filename);
 
+// Write a binary file with a snapshot of the system state (see ChSystem::WriteSnapshot).
+ChApi
+bool WriteSnapshot(ChSystem* system, const std::string& filename);
+
+// Restore the system state from a binary snapshot file (see ChSystem::ReadSnapshot).
+// The system must be built identically to the one that wrote the snapshot.
+ChApi
+bool ReadSnapshot(ChSystem* system, const std::string& filename);
+
 // Write CSV output file for PovRay.
 // Each line contains information about one visualization asset shape, as
 // follows:
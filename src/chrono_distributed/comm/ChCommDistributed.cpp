@@ -43,6 +43,10 @@ ChCommDistributed::ChCommDistributed(ChSystemDistributed* my_sys) {
 
     ddm = my_sys->ddm;
 
+    exchange_pending = false;
+    posted_time = 0;
+    ResetExchangeStats();
+
     /* Create and Commit all custom MPI Data Types */
     // Exchange
     MPI_Datatype type_exchange[5] = {MPI_UNSIGNED, MPI_BYTE, MPI_DOUBLE, MPI_FLOAT, MPI_INT};
@@ -239,23 +243,63 @@ void ChCommDistributed::ProcessShapes(int num_recv, Shape* buf) {
     }
 }
 
+// Message types; the tag of a message also encodes its direction of travel (up or down) so that
+// the messages from the lower and upper neighbors can never be confused.
+enum MessageKind { MSG_HEADER = 0, MSG_EXCHANGE = 1, MSG_UPDATE = 2, MSG_TAKE = 3, MSG_SHAPES = 4 };
+static int MessageTag(MessageKind kind, int dir) {
+    return 2 * kind + dir;
+}
+
+// Direction of travel encoded in the message tags
+static const int DIR_UP = 0;
+static const int DIR_DOWN = 1;
+
 // Handle all necessary communication
 void ChCommDistributed::Exchange() {
+    ExchangeBegin();
+    ExchangeEnd();
+}
+
+void ChCommDistributed::ExchangeBegin() {
+    double start_time = MPI_Wtime();
+
     int my_rank = my_sys->my_rank;
     int num_ranks = my_sys->num_ranks;
     std::forward_list<int> exchanges_up;
     std::forward_list<int> exchanges_down;
 
+    NeighborMessages& down = neighbors[0];
+    NeighborMessages& up = neighbors[1];
+    down.rank = (my_rank != 0) ? my_rank - 1 : -1;
+    up.rank = (my_rank != num_ranks - 1) ? my_rank + 1 : -1;
+
+    // Post the header receives first, so that the neighbors' messages can land while this rank is packing.
+    for (int k = 0; k < 2; k++) {
+        NeighborMessages& n = neighbors[k];
+        n.send_exchange.clear();
+        n.send_update.clear();
+        n.send_take.clear();
+        n.send_shapes.clear();
+        n.requests.clear();
+        n.payload_posted = false;
+        if (n.rank >= 0) {
+            // Messages from the lower neighbor travel up, those from the upper neighbor travel down
+            int from_dir = (k == 0) ? DIR_UP : DIR_DOWN;
+            MPI_Irecv(n.recv_counts, 4, MPI_INT, n.rank, MessageTag(MSG_HEADER, from_dir), my_sys->world,
+                      &n.header_request);
+        }
+    }
+
     // Saves a reference copy for consistency in the threads.
     ddm->curr_status = ddm->comm_status;
-    std::vector<BodyExchange> exchange_up_buf;
-    std::vector<BodyExchange> exchange_down_buf;
-    std::vector<BodyUpdate> update_up_buf;
-    std::vector<BodyUpdate> update_down_buf;
-    std::vector<Shape> shapes_up;
-    std::vector<Shape> shapes_down;
-    std::vector<uint> update_take_up;
-    std::vector<uint> update_take_down;
+    std::vector<BodyExchange>& exchange_up_buf = up.send_exchange;
+    std::vector<BodyExchange>& exchange_down_buf = down.send_exchange;
+    std::vector<BodyUpdate>& update_up_buf = up.send_update;
+    std::vector<BodyUpdate>& update_down_buf = down.send_update;
+    std::vector<Shape>& shapes_up = up.send_shapes;
+    std::vector<Shape>& shapes_down = down.send_shapes;
+    std::vector<uint>& update_take_up = up.send_take;
+    std::vector<uint>& update_take_down = down.send_take;
 
     // Send Counts
     int num_exchange_up = 0;
@@ -415,274 +459,183 @@ void ChCommDistributed::Exchange() {
         }      // End of update take loop
     }          // End of parallel sections
 
-    //MPI_Status status_exchange_up;
-    //MPI_Status status_exchange_down;
-    //MPI_Status status_update_up;
-    //MPI_Status status_update_down;
-    //MPI_Status status_take_up;
-    //MPI_Status status_take_down;
-    //MPI_Status status_shapes_up;
-    //MPI_Status status_shapes_down;
-
-    MPI_Request rq_exchange_up;
-    MPI_Request rq_exchange_down;
-    MPI_Request rq_update_up;
-    MPI_Request rq_update_down;
-    MPI_Request rq_take_up;
-    MPI_Request rq_take_down;
-    MPI_Request rq_shapes_up;
-    MPI_Request rq_shapes_down;
-
-    MPI_Status recv_status_exchange_up;
-    MPI_Status recv_status_exchange_down;
-    MPI_Status recv_status_update_up;
-    MPI_Status recv_status_update_down;
-    MPI_Status recv_status_take_up;
-    MPI_Status recv_status_take_down;
-    MPI_Status recv_status_shapes_up;
-    MPI_Status recv_status_shapes_down;
-
-    int num_recv_exchange_up;
-    int num_recv_exchange_down;
-    int num_recv_update_up;
-    int num_recv_update_down;
-    int num_recv_take_up;
-    int num_recv_take_down;
-    int num_recv_shapes_up;
-    int num_recv_shapes_down;
-
-    BodyExchange* recv_exchange_down = NULL;
-    BodyExchange* recv_exchange_up = NULL;
-    BodyUpdate* recv_update_down = NULL;
-    BodyUpdate* recv_update_up = NULL;
-    uint* recv_take_down = NULL;
-    uint* recv_take_up = NULL;
-    Shape* recv_shapes_down = NULL;
-    Shape* recv_shapes_up = NULL;
-
+    // Pack the shapes of the bodies sent to create new ghosts
 #pragma omp parallel sections
     {
-// Send/Recv
-#pragma omp section
-        {
-            // SENDING - TODO sequential for now
-
-            // Send empty message if there is nothing to send
-            if (num_exchange_up == 0) {
-                BodyExchange b_e = {};
-                b_e.gid = UINT_MAX;
-                exchange_up_buf.push_back(b_e);
-                num_exchange_up = 1;
-            }
-            if (num_exchange_down == 0) {
-                BodyExchange b_e = {};
-                b_e.gid = UINT_MAX;
-                exchange_down_buf.push_back(b_e);
-                num_exchange_down = 1;
-            }
-            if (num_update_up == 0) {
-                BodyUpdate b_u = {};
-                b_u.gid = UINT_MAX;
-                update_up_buf.push_back(b_u);
-                num_update_up = 1;
-            }
-            if (num_update_down == 0) {
-                BodyUpdate b_u = {};
-                b_u.gid = UINT_MAX;
-                update_down_buf.push_back(b_u);
-                num_update_down = 1;
-            }
-            if (num_take_up == 0) {
-                update_take_up.push_back(UINT_MAX);
-                num_take_up = 1;
-            }
-            if (num_take_down == 0) {
-                update_take_down.push_back(UINT_MAX);
-                num_take_down = 1;
-            }
-
-            // Send Exchanges
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(exchange_up_buf[0]), num_exchange_up, BodyExchangeType, my_rank + 1, 1, my_sys->world,
-                          &rq_exchange_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(exchange_down_buf[0]), num_exchange_down, BodyExchangeType, my_rank - 1, 2, my_sys->world,
-                          &rq_exchange_down);
-            }
-
-            // Recv Exchanges
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 1, my_sys->world, &recv_status_exchange_down);
-                MPI_Get_count(&recv_status_exchange_down, BodyExchangeType, &num_recv_exchange_down);
-                recv_exchange_down = new BodyExchange[num_recv_exchange_down];
-                MPI_Recv(recv_exchange_down, num_recv_exchange_down, BodyExchangeType, my_rank - 1, 1, my_sys->world,
-                         &recv_status_exchange_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 2, my_sys->world, &recv_status_exchange_up);
-                MPI_Get_count(&recv_status_exchange_up, BodyExchangeType, &num_recv_exchange_up);
-                recv_exchange_up = new BodyExchange[num_recv_exchange_up];
-                MPI_Recv(recv_exchange_up, num_recv_exchange_up, BodyExchangeType, my_rank + 1, 2, my_sys->world,
-                         &recv_status_exchange_up);
-            }
-
-            // Send Updates
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(update_up_buf[0]), num_update_up, BodyUpdateType, my_rank + 1, 3, my_sys->world,
-                          &rq_update_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(update_down_buf[0]), num_update_down, BodyUpdateType, my_rank - 1, 4, my_sys->world,
-                          &rq_update_down);
-            }
-
-            // Recv Updates
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 3, my_sys->world, &recv_status_update_down);
-                MPI_Get_count(&recv_status_update_down, BodyUpdateType, &num_recv_update_down);
-                recv_update_down = new BodyUpdate[num_recv_update_down];
-                MPI_Recv(recv_update_down, num_recv_update_down, BodyUpdateType, my_rank - 1, 3, my_sys->world,
-                         &recv_status_update_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 4, my_sys->world, &recv_status_update_up);
-                MPI_Get_count(&recv_status_update_up, BodyUpdateType, &num_recv_update_up);
-                recv_update_up = new BodyUpdate[num_recv_update_up];
-                MPI_Recv(recv_update_up, num_recv_update_up, BodyUpdateType, my_rank + 1, 4, my_sys->world,
-                         &recv_status_update_up);
-            }
-
-            // Send Takes
-            if (my_rank != num_ranks - 1) {
-                MPI_Isend(&(update_take_up[0]), num_take_up, MPI_UNSIGNED, my_rank + 1, 5, my_sys->world, &rq_take_up);
-            }
-            if (my_rank != 0) {
-                MPI_Isend(&(update_take_down[0]), num_take_down, MPI_UNSIGNED, my_rank - 1, 6, my_sys->world,
-                          &rq_take_down);
-            }
-
-            // Recv Takes
-            if (my_rank != 0) {
-                MPI_Probe(my_rank - 1, 5, my_sys->world, &recv_status_take_down);
-                MPI_Get_count(&recv_status_take_down, MPI_UNSIGNED, &num_recv_take_down);
-                recv_take_down = new uint[num_recv_take_down];
-                MPI_Recv(recv_take_down, num_recv_take_down, MPI_UNSIGNED, my_rank - 1, 5, my_sys->world,
-                         &recv_status_take_down);
-            }
-            if (my_rank != num_ranks - 1) {
-                MPI_Probe(my_rank + 1, 6, my_sys->world, &recv_status_take_up);
-                MPI_Get_count(&recv_status_take_up, MPI_UNSIGNED, &num_recv_take_up);
-                recv_take_up = new uint[num_recv_take_up];
-                MPI_Recv(recv_take_up, num_recv_take_up, MPI_UNSIGNED, my_rank + 1, 6, my_sys->world,
-                         &recv_status_take_up);
-            }
-
-            // Make sure all non-blocking communications are done.
-            if (my_rank != num_ranks - 1) {
-                MPI_Wait(&rq_exchange_up, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_update_up, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_take_up, MPI_STATUS_IGNORE);
-            }
-            if (my_rank != 0) {
-                MPI_Wait(&rq_exchange_down, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_update_down, MPI_STATUS_IGNORE);
-                MPI_Wait(&rq_take_down, MPI_STATUS_IGNORE);
-            }
-        }  // End of send/recv section
-
-// TODO could do in parallel if counting the spaces in the buffers in the first pass
-// Pack Shapes Up
 #pragma omp section
         {
             for (auto itr_up = exchanges_up.begin(); itr_up != exchanges_up.end(); itr_up++) {
                 num_shapes_up += PackShapes(&shapes_up, *itr_up);
             }
-
-            if (num_shapes_up == 0) {
-                Shape shape;
-                shape.gid = UINT_MAX;
-                shapes_up.push_back(shape);
-                num_shapes_up = 1;
-            }
         }  // End of pack shapes up section
 
-// Pack Shapes Down
 #pragma omp section
         {
             for (auto itr_down = exchanges_down.begin(); itr_down != exchanges_down.end(); itr_down++) {
                 num_shapes_down += PackShapes(&shapes_down, *itr_down);
             }
-            if (num_shapes_down == 0) {
-                Shape shape;
-                shape.gid = UINT_MAX;
-                shapes_down.push_back(shape);
-                num_shapes_down = 1;
-            }
         }  // End of pack shapes down section
     }      // End of parallel sections
 
-    // TODO sections?
-    if (my_rank != 0)
-        ProcessExchanges(num_recv_exchange_down, recv_exchange_down, 0);
-    if (my_rank != num_ranks - 1)
-        ProcessExchanges(num_recv_exchange_up, recv_exchange_up, 1);
-    if (my_rank != 0)
-        ProcessUpdates(num_recv_update_down, recv_update_down);
-    if (my_rank != num_ranks - 1)
-        ProcessUpdates(num_recv_update_up, recv_update_up);
-    if (my_rank != 0)
-        ProcessTakes(num_recv_take_down, recv_take_down);
-    if (my_rank != num_ranks - 1)
-        ProcessTakes(num_recv_take_up, recv_take_up);
-
-    // Send Shapes
-    if (my_rank != num_ranks - 1) {
-        MPI_Isend(&(shapes_up[0]), num_shapes_up, ShapeType, my_rank + 1, 7, my_sys->world, &rq_shapes_up);
+    down.send_counts[0] = num_exchange_down;
+    down.send_counts[1] = num_update_down;
+    down.send_counts[2] = num_take_down;
+    down.send_counts[3] = num_shapes_down;
+    up.send_counts[0] = num_exchange_up;
+    up.send_counts[1] = num_update_up;
+    up.send_counts[2] = num_take_up;
+    up.send_counts[3] = num_shapes_up;
+
+    // Post all sends: the counts first, then the non-empty payloads
+    for (int k = 0; k < 2; k++) {
+        NeighborMessages& n = neighbors[k];
+        if (n.rank < 0)
+            continue;
+        int dir = (k == 0) ? DIR_DOWN : DIR_UP;
+        MPI_Comm world = my_sys->world;
+        MPI_Request rq;
+
+        MPI_Isend(n.send_counts, 4, MPI_INT, n.rank, MessageTag(MSG_HEADER, dir), world, &rq);
+        n.requests.push_back(rq);
+        if (n.send_counts[0] > 0) {
+            MPI_Isend(n.send_exchange.data(), n.send_counts[0], BodyExchangeType, n.rank,
+                      MessageTag(MSG_EXCHANGE, dir), world, &rq);
+            n.requests.push_back(rq);
+        }
+        if (n.send_counts[1] > 0) {
+            MPI_Isend(n.send_update.data(), n.send_counts[1], BodyUpdateType, n.rank, MessageTag(MSG_UPDATE, dir),
+                      world, &rq);
+            n.requests.push_back(rq);
+        }
+        if (n.send_counts[2] > 0) {
+            MPI_Isend(n.send_take.data(), n.send_counts[2], MPI_UNSIGNED, n.rank, MessageTag(MSG_TAKE, dir), world,
+                      &rq);
+            n.requests.push_back(rq);
+        }
+        if (n.send_counts[3] > 0) {
+            MPI_Isend(n.send_shapes.data(), n.send_counts[3], ShapeType, n.rank, MessageTag(MSG_SHAPES, dir), world,
+                      &rq);
+            n.requests.push_back(rq);
+        }
     }
-    if (my_rank != 0) {
-        MPI_Isend(&(shapes_down[0]), num_shapes_down, ShapeType, my_rank - 1, 8, my_sys->world, &rq_shapes_down);
+
+    // Post the payload receives of the neighbors whose counts have already arrived
+    for (int k = 0; k < 2; k++) {
+        NeighborMessages& n = neighbors[k];
+        if (n.rank < 0)
+            continue;
+        int arrived = 0;
+        MPI_Test(&n.header_request, &arrived, MPI_STATUS_IGNORE);
+        if (arrived)
+            PostPayloadReceives(n, (k == 0) ? DIR_UP : DIR_DOWN);
     }
 
-    // Recv Shapes
-    if (my_rank != 0) {
-        MPI_Probe(my_rank - 1, 7, my_sys->world, &recv_status_shapes_down);
-        MPI_Get_count(&recv_status_shapes_down, ShapeType, &num_recv_shapes_down);
-        recv_shapes_down = new Shape[num_recv_shapes_down];
-        MPI_Recv(recv_shapes_down, num_recv_shapes_down, ShapeType, my_rank - 1, 7, my_sys->world,
-                 &recv_status_shapes_down);
+    exchange_pending = true;
+    posted_time = MPI_Wtime();
+    stats.post_time += posted_time - start_time;
+}
+
+void ChCommDistributed::PostPayloadReceives(NeighborMessages& n, int from_dir) {
+    MPI_Comm world = my_sys->world;
+    MPI_Request rq;
+
+    n.recv_exchange.resize(n.recv_counts[0]);
+    n.recv_update.resize(n.recv_counts[1]);
+    n.recv_take.resize(n.recv_counts[2]);
+    n.recv_shapes.resize(n.recv_counts[3]);
+
+    if (n.recv_counts[0] > 0) {
+        MPI_Irecv(n.recv_exchange.data(), n.recv_counts[0], BodyExchangeType, n.rank,
+                  MessageTag(MSG_EXCHANGE, from_dir), world, &rq);
+        n.requests.push_back(rq);
+    }
+    if (n.recv_counts[1] > 0) {
+        MPI_Irecv(n.recv_update.data(), n.recv_counts[1], BodyUpdateType, n.rank, MessageTag(MSG_UPDATE, from_dir),
+                  world, &rq);
+        n.requests.push_back(rq);
+    }
+    if (n.recv_counts[2] > 0) {
+        MPI_Irecv(n.recv_take.data(), n.recv_counts[2], MPI_UNSIGNED, n.rank, MessageTag(MSG_TAKE, from_dir), world,
+                  &rq);
+        n.requests.push_back(rq);
     }
-    if (my_rank != num_ranks - 1) {
-        MPI_Probe(my_rank + 1, 8, my_sys->world, &recv_status_shapes_up);
-        MPI_Get_count(&recv_status_shapes_up, ShapeType, &num_recv_shapes_up);
-        ////GetLog() << "num_recv_shapes_up" << num_recv_shapes_up << "\n";
-        recv_shapes_up = new Shape[num_recv_shapes_up];
-        MPI_Recv(recv_shapes_up, num_recv_shapes_up, ShapeType, my_rank + 1, 8, my_sys->world, &recv_status_shapes_up);
+    if (n.recv_counts[3] > 0) {
+        MPI_Irecv(n.recv_shapes.data(), n.recv_counts[3], ShapeType, n.rank, MessageTag(MSG_SHAPES, from_dir), world,
+                  &rq);
+        n.requests.push_back(rq);
     }
 
-    if (my_rank != 0)
-        ProcessShapes(num_recv_shapes_down, recv_shapes_down);
-    if (my_rank != num_ranks - 1)
-        ProcessShapes(num_recv_shapes_up, recv_shapes_up);
+    n.payload_posted = true;
+}
+
+void ChCommDistributed::ExchangeEnd() {
+    if (!exchange_pending)
+        return;
+
+    double start_time = MPI_Wtime();
+    stats.overlap_time += start_time - posted_time;
 
-    if (my_rank != num_ranks - 1) {
-        MPI_Wait(&rq_shapes_up, MPI_STATUS_IGNORE);
+    NeighborMessages& down = neighbors[0];
+    NeighborMessages& up = neighbors[1];
+
+    // Post the remaining payload receives as soon as the corresponding counts arrive
+    MPI_Request headers[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+    for (int k = 0; k < 2; k++) {
+        if (neighbors[k].rank >= 0 && !neighbors[k].payload_posted)
+            headers[k] = neighbors[k].header_request;
+    }
+    while (true) {
+        int k;
+        MPI_Waitany(2, headers, &k, MPI_STATUS_IGNORE);
+        if (k == MPI_UNDEFINED)
+            break;
+        PostPayloadReceives(neighbors[k], (k == 0) ? DIR_UP : DIR_DOWN);
     }
-    if (my_rank != 0) {
-        MPI_Wait(&rq_shapes_down, MPI_STATUS_IGNORE);
+
+    // Wait for all sends and payload receives
+    for (int k = 0; k < 2; k++) {
+        NeighborMessages& n = neighbors[k];
+        if (!n.requests.empty())
+            MPI_Waitall((int)n.requests.size(), n.requests.data(), MPI_STATUSES_IGNORE);
     }
 
-    // Free all dynamic memory used for recving
-    delete[] recv_exchange_down;
-    delete[] recv_exchange_up;
-    delete[] recv_update_down;
-    delete[] recv_update_up;
-    delete[] recv_take_down;
-    delete[] recv_take_up;
-    delete[] recv_shapes_down;
-    delete[] recv_shapes_up;
-
-    MPI_Barrier(my_sys->world);
+    double received_time = MPI_Wtime();
+    stats.wait_time += received_time - start_time;
+
+    // Process the received messages: all new ghosts must exist before they can be updated, taken or given shapes
+    if (down.rank >= 0 && down.recv_counts[0] > 0)
+        ProcessExchanges(down.recv_counts[0], down.recv_exchange.data(), 0);
+    if (up.rank >= 0 && up.recv_counts[0] > 0)
+        ProcessExchanges(up.recv_counts[0], up.recv_exchange.data(), 1);
+    if (down.rank >= 0 && down.recv_counts[1] > 0)
+        ProcessUpdates(down.recv_counts[1], down.recv_update.data());
+    if (up.rank >= 0 && up.recv_counts[1] > 0)
+        ProcessUpdates(up.recv_counts[1], up.recv_update.data());
+    if (down.rank >= 0 && down.recv_counts[2] > 0)
+        ProcessTakes(down.recv_counts[2], down.recv_take.data());
+    if (up.rank >= 0 && up.recv_counts[2] > 0)
+        ProcessTakes(up.recv_counts[2], up.recv_take.data());
+    if (down.rank >= 0 && down.recv_counts[3] > 0)
+        ProcessShapes(down.recv_counts[3], down.recv_shapes.data());
+    if (up.rank >= 0 && up.recv_counts[3] > 0)
+        ProcessShapes(up.recv_counts[3], up.recv_shapes.data());
+
+    exchange_pending = false;
+    stats.num_exchanges++;
+    stats.process_time += MPI_Wtime() - received_time;
+}
+
+double ChCommDistributed::GetOverlapRatio() const {
+    double in_flight = stats.overlap_time + stats.wait_time;
+    return (in_flight > 0) ? stats.overlap_time / in_flight : 0;
+}
+
+void ChCommDistributed::ResetExchangeStats() {
+    stats.num_exchanges = 0;
+    stats.post_time = 0;
+    stats.overlap_time = 0;
+    stats.wait_time = 0;
+    stats.process_time = 0;
 }
 
 void ChCommDistributed::PackExchange(BodyExchange* buf, int index) {
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "chrono/physics/ChBody.h"
 
@@ -103,14 +104,42 @@ class CH_DISTR_API ChCommDistributed {
     ChCommDistributed(ChSystemDistributed* my_sys);
     virtual ~ChCommDistributed();
 
+    /// Timing statistics of the exchanges, accumulated since the last call to ResetExchangeStats().
+    struct ExchangeStats {
+        int num_exchanges;    ///< number of completed exchanges
+        double post_time;     ///< time spent classifying and packing bodies and posting the messages
+        double overlap_time;  ///< time between posting and completion, available for computation
+        double wait_time;     ///< time spent waiting for the messages to complete
+        double process_time;  ///< time spent processing the received messages
+    };
+
     /// Scans the system's data structures for bodies that:
     ///	- need to be sent to another rank to create ghosts
     /// - need to be sent to another rank to update ghosts
     ///	- need to update their comm_status
     /// Sends updates via mpi to the appropriate rank
     /// Processes incoming updates from other ranks
+    /// Equivalent to ExchangeBegin() immediately followed by ExchangeEnd().
     void Exchange();
 
+    /// Classifies and packs the bodies, and posts all messages to and from the neighbor ranks
+    /// without waiting for them. Must be matched by a call to ExchangeEnd(); the body states must not
+    /// be modified in between, except for bodies not involved in the exchange.
+    void ExchangeBegin();
+
+    /// Waits for the messages posted by ExchangeBegin() and processes the received bodies.
+    void ExchangeEnd();
+
+    /// Return the timing statistics accumulated since the last reset.
+    const ExchangeStats& GetExchangeStats() const { return stats; }
+
+    /// Return the fraction of the time the messages were in flight that was available for computation,
+    /// i.e. overlap_time / (overlap_time + wait_time).
+    double GetOverlapRatio() const;
+
+    /// Reset the timing statistics.
+    void ResetExchangeStats();
+
   protected:
     ChSystemDistributed* my_sys;
 
@@ -126,6 +155,32 @@ class CH_DISTR_API ChCommDistributed {
     ChDistributedDataManager* ddm;
 
   private:
+    /// Buffers and requests for the messages exchanged with one neighbor rank.
+    struct NeighborMessages {
+        int rank;            ///< neighbor rank (-1 if there is no neighbor)
+        int send_counts[4];  ///< number of exchanges, updates, takes and shapes sent
+        int recv_counts[4];  ///< number of exchanges, updates, takes and shapes received
+        std::vector<BodyExchange> send_exchange;
+        std::vector<BodyUpdate> send_update;
+        std::vector<uint> send_take;
+        std::vector<Shape> send_shapes;
+        std::vector<BodyExchange> recv_exchange;
+        std::vector<BodyUpdate> recv_update;
+        std::vector<uint> recv_take;
+        std::vector<Shape> recv_shapes;
+        MPI_Request header_request;         ///< receive of recv_counts
+        std::vector<MPI_Request> requests;  ///< sends and payload receives
+        bool payload_posted;                ///< true once the payload receives have been posted
+    };
+
+    /// Posts the payload receives for a neighbor whose counts have arrived.
+    void PostPayloadReceives(NeighborMessages& n, int from_dir);
+
+    NeighborMessages neighbors[2];  ///< messages with the lower (0) and upper (1) neighbor
+    bool exchange_pending;          ///< true between ExchangeBegin() and ExchangeEnd()
+    double posted_time;             ///< time at which ExchangeBegin() returned
+    ExchangeStats stats;
+
     /// Helper function for processing incoming exchange messages.
     void ProcessExchanges(int num_recv, BodyExchange* buf, int updown);
 
@@ -23,6 +23,7 @@
 
 #include <mpi.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -33,6 +34,11 @@ ChDomainDistributed::ChDomainDistributed(ChSystemDistributed* sys) {
     split_axis = 0;
     split = false;
     axis_set = false;
+    balance_mode = LoadBalancing::NONE;
+    balance_interval = 100;
+    balance_tolerance = 0.1;
+    num_steps = 0;
+    sum_step_time = 0;
 }
 
 ChDomainDistributed::~ChDomainDistributed() {}
@@ -70,26 +76,33 @@ void ChDomainDistributed::SetSimDomain(double xlo, double xhi, double ylo, doubl
 }
 
 void ChDomainDistributed::SplitDomain() {
-    // Length of this subdomain along the long axis
-    double sub_len = (boxhi[split_axis] - boxlo[split_axis]) / my_sys->num_ranks;
+    int num_ranks = my_sys->num_ranks;
+
+    // Length of each subdomain along the long axis
+    double sub_len = (boxhi[split_axis] - boxlo[split_axis]) / num_ranks;
+
+    split_bounds.resize(num_ranks + 1);
+    for (int i = 0; i < num_ranks; i++) {
+        split_bounds[i] = boxlo[split_axis] + i * sub_len;
+    }
+    split_bounds[num_ranks] = boxhi[split_axis];
+    target_bounds = split_bounds;
 
     for (int i = 0; i < 3; i++) {
-        if (split_axis == i) {
-            sublo[i] = boxlo[i] + my_sys->my_rank * sub_len;
-            subhi[i] = sublo[i] + sub_len;
-        } else {
-            sublo[i] = boxlo[i];
-            subhi[i] = boxhi[i];
-        }
+        sublo[i] = boxlo[i];
+        subhi[i] = boxhi[i];
     }
+    sublo[split_axis] = split_bounds[my_sys->my_rank];
+    subhi[split_axis] = split_bounds[my_sys->my_rank + 1];
+
     split = true;
 }
 
 int ChDomainDistributed::GetRank(ChVector<double> pos) {
-    double sub_len = subhi[split_axis] - sublo[split_axis];
-    double pt = pos[split_axis] - boxlo[split_axis];
-
-    return (int)(pt / sub_len);
+    // Index of the first interior boundary above pos
+    auto first = split_bounds.begin() + 1;
+    auto last = split_bounds.end() - 1;
+    return (int)(std::upper_bound(first, last, pos[split_axis]) - first);
 }
 
 distributed::COMM_STATUS ChDomainDistributed::GetRegion(double pos) {
@@ -184,3 +197,155 @@ void ChDomainDistributed::PrintDomain() {
                 "\tZ: "
              << sublo.z() << " to " << subhi.z() << "\n";
 }
+
+void ChDomainDistributed::SetLoadBalancing(LoadBalancing mode, int interval, double tolerance) {
+    balance_mode = mode;
+    balance_interval = std::max(interval, 1);
+    balance_tolerance = tolerance;
+}
+
+void ChDomainDistributed::UpdateBalance(double step_time) {
+    num_steps++;
+    sum_step_time += step_time;
+
+    if (balance_mode != LoadBalancing::NONE && num_steps >= balance_interval) {
+        GatherLoads();
+        if (GetLoadImbalance() > 1 + balance_tolerance)
+            ComputeTargetBounds();
+    }
+
+    MoveBounds();
+}
+
+void ChDomainDistributed::GatherLoads() {
+    int num_ranks = my_sys->num_ranks;
+
+    int num_owned = 0;
+    int num_bodies = 0;
+    for (uint i = 0; i < my_sys->data_manager->num_rigid_bodies; i++) {
+        int status = my_sys->ddm->comm_status[i];
+        if (status == distributed::OWNED || status == distributed::SHARED_UP || status == distributed::SHARED_DOWN)
+            num_owned++;
+        if (status != distributed::EMPTY)
+            num_bodies++;
+    }
+
+    double local[3] = {(double)num_owned, (double)num_bodies, num_steps > 0 ? sum_step_time / num_steps : 0.0};
+    std::vector<double> all(3 * num_ranks);
+    MPI_Allgather(local, 3, MPI_DOUBLE, all.data(), 3, MPI_DOUBLE, my_sys->world);
+
+    rank_loads.resize(num_ranks);
+    for (int i = 0; i < num_ranks; i++) {
+        rank_loads[i].num_owned = (int)all[3 * i + 0];
+        rank_loads[i].num_bodies = (int)all[3 * i + 1];
+        rank_loads[i].step_time = all[3 * i + 2];
+        rank_loads[i].lo = split_bounds[i];
+        rank_loads[i].hi = split_bounds[i + 1];
+    }
+
+    num_steps = 0;
+    sum_step_time = 0;
+}
+
+double ChDomainDistributed::GetLoadImbalance() const {
+    if (rank_loads.empty())
+        return 1;
+
+    double max_load = 0;
+    double sum_load = 0;
+    for (auto& load : rank_loads) {
+        double l = (balance_mode == LoadBalancing::STEP_TIME) ? load.step_time : load.num_owned;
+        max_load = std::max(max_load, l);
+        sum_load += l;
+    }
+
+    return (sum_load > 0) ? max_load * rank_loads.size() / sum_load : 1;
+}
+
+void ChDomainDistributed::ComputeTargetBounds() {
+    int num_ranks = my_sys->num_ranks;
+    int my_rank = my_sys->my_rank;
+    double lo = boxlo[split_axis];
+    double hi = boxhi[split_axis];
+
+    // Sub-domains narrower than this would not have a well-defined owned region
+    double min_len = 3 * my_sys->GetGhostLayer();
+    if (num_ranks * min_len >= hi - lo)
+        return;
+
+    // Weight of each owned body: 1 for BODY_COUNT; with STEP_TIME, the measured time of this rank is spread
+    // evenly over its owned bodies.
+    double weight = 1;
+    if (balance_mode == LoadBalancing::STEP_TIME) {
+        const RankLoad& load = rank_loads[my_rank];
+        weight = (load.num_owned > 0) ? load.step_time / load.num_owned : 0;
+    }
+
+    // Global histogram of the body weights along the split axis
+    int num_bins = 32 * num_ranks;
+    double bin_len = (hi - lo) / num_bins;
+    std::vector<double> local_hist(num_bins, 0.0);
+    for (uint i = 0; i < my_sys->data_manager->num_rigid_bodies; i++) {
+        int status = my_sys->ddm->comm_status[i];
+        if (status != distributed::OWNED && status != distributed::SHARED_UP && status != distributed::SHARED_DOWN)
+            continue;
+        double pos = my_sys->data_manager->host_data.pos_rigid[i][split_axis];
+        int bin = std::min(std::max((int)((pos - lo) / bin_len), 0), num_bins - 1);
+        local_hist[bin] += weight;
+    }
+    std::vector<double> hist(num_bins);
+    MPI_Allreduce(local_hist.data(), hist.data(), num_bins, MPI_DOUBLE, MPI_SUM, my_sys->world);
+
+    double total = 0;
+    for (int b = 0; b < num_bins; b++)
+        total += hist[b];
+    if (total <= 0)
+        return;
+
+    // Place each boundary where the cumulative weight reaches its share, interpolating within the bin
+    target_bounds[0] = lo;
+    target_bounds[num_ranks] = hi;
+    double cumulative = 0;
+    int b = 0;
+    for (int k = 1; k < num_ranks; k++) {
+        double share = total * k / num_ranks;
+        while (b < num_bins - 1 && cumulative + hist[b] < share) {
+            cumulative += hist[b];
+            b++;
+        }
+        double frac = (hist[b] > 0) ? (share - cumulative) / hist[b] : 0;
+        target_bounds[k] = lo + (b + std::min(std::max(frac, 0.0), 1.0)) * bin_len;
+    }
+
+    // Enforce the minimum sub-domain length
+    for (int k = 1; k < num_ranks; k++)
+        target_bounds[k] = std::max(target_bounds[k], target_bounds[k - 1] + min_len);
+    for (int k = num_ranks - 1; k > 0; k--)
+        target_bounds[k] = std::min(target_bounds[k], target_bounds[k + 1] - min_len);
+}
+
+void ChDomainDistributed::MoveBounds() {
+    int num_ranks = my_sys->num_ranks;
+
+    // Limit the displacement so that bodies change region at most once per step, as assumed by the exchange.
+    double max_shift = 0.25 * my_sys->GetGhostLayer();
+    for (int k = 1; k < num_ranks; k++) {
+        double shift = target_bounds[k] - split_bounds[k];
+        split_bounds[k] += std::min(std::max(shift, -max_shift), max_shift);
+    }
+
+    sublo[split_axis] = split_bounds[my_sys->my_rank];
+    subhi[split_axis] = split_bounds[my_sys->my_rank + 1];
+}
+
+void ChDomainDistributed::PrintLoads() {
+    if (!my_sys->OnMaster())
+        return;
+
+    GetLog() << "Domain loads (imbalance " << GetLoadImbalance() << "):\n";
+    for (int i = 0; i < (int)rank_loads.size(); i++) {
+        const RankLoad& load = rank_loads[i];
+        GetLog() << "\tRank " << i << ": " << load.lo << " to " << load.hi << ", owned " << load.num_owned
+                 << ", total " << load.num_bodies << ", step time " << load.step_time << "\n";
+    }
+}
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "chrono/core/ChVector.h"
 #include "chrono/physics/ChBody.h"
@@ -105,8 +106,33 @@ class ChSystemDistributed;
 ///
 /// A body with a GHOST comm_status will become OWNED when it moves into the owned region of this rank.
 /// A body with a GHOST comm_status will be removed when it moves into the one of this rank's unowned regions.
+///
+///
+/// Load balancing:
+///
+/// By default the sub-domains are slabs of equal length along the split axis. With load balancing enabled, every
+/// few steps the ranks agree on new slab boundaries such that each rank carries roughly the same number of bodies
+/// (or the same measured computation time). The boundaries then move towards these targets by at most a quarter of
+/// the ghost layer per step, so that the bodies changing owner are migrated by the regular ChCommDistributed
+/// exchange exactly as if they had moved across a fixed boundary.
 class CH_DISTR_API ChDomainDistributed {
   public:
+    /// Criterion used to place the sub-domain boundaries.
+    enum class LoadBalancing {
+        NONE,        ///< fixed sub-domains of equal length
+        BODY_COUNT,  ///< equal number of owned bodies on each rank
+        STEP_TIME    ///< equal measured computation time on each rank
+    };
+
+    /// Load statistics of a single rank.
+    struct RankLoad {
+        int num_owned;     ///< number of bodies owned by the rank (OWNED, SHARED_UP or SHARED_DOWN)
+        int num_bodies;    ///< number of bodies present on the rank, including ghosts
+        double step_time;  ///< average computation time per step since the previous gathering
+        double lo;         ///< lower boundary of the sub-domain along the split axis
+        double hi;         ///< upper boundary of the sub-domain along the split axis
+    };
+
     ChDomainDistributed(ChSystemDistributed* sys);
     virtual ~ChDomainDistributed();
 
@@ -145,6 +171,33 @@ class CH_DISTR_API ChDomainDistributed {
     /// Prints basic information about the domain decomposition
     virtual void PrintDomain();
 
+    /// Enable or disable load balancing. Every 'interval' steps, the per-rank loads are gathered and, if the
+    /// most loaded rank exceeds the average load by more than the given relative tolerance, new sub-domain
+    /// boundaries are computed. Must be called with the same arguments on all ranks.
+    void SetLoadBalancing(LoadBalancing mode, int interval = 100, double tolerance = 0.1);
+    /// Return the current load balancing criterion.
+    LoadBalancing GetLoadBalancing() const { return balance_mode; }
+
+    /// Return the sub-domain boundaries along the split axis (num_ranks + 1 values, same on all ranks).
+    const std::vector<double>& GetSplitBounds() const { return split_bounds; }
+
+    /// Gather the load statistics of all ranks. Collective call; must be called on all ranks.
+    /// Called automatically when load balancing is enabled.
+    void GatherLoads();
+    /// Return the load statistics of all ranks, as of the last call to GatherLoads().
+    const std::vector<RankLoad>& GetRankLoads() const { return rank_loads; }
+    /// Return the ratio between the maximum and the average load over all ranks, as of the last call to
+    /// GatherLoads(). The load is the measured step time with STEP_TIME balancing and the number of owned
+    /// bodies otherwise.
+    double GetLoadImbalance() const;
+    /// Prints the per-rank load statistics (on the master rank only).
+    void PrintLoads();
+
+    /// Internal call, made by the system after each step and before the exchange, which records the
+    /// computation time of the step and moves the sub-domain boundaries if needed. Should not be called
+    /// by the user.
+    void UpdateBalance(double step_time);
+
     ChVector<double> boxlo;  ///< Lower coordinates of the global domain
     ChVector<double> boxhi;  ///< Upper coordinates of the global domain
 
@@ -162,7 +215,23 @@ class CH_DISTR_API ChDomainDistributed {
     bool split;     ///< Flag indicating that the domain has been divided into sub-domains.
     bool axis_set;  ///< Flag indicating that the splitting axis has been set.
 
+    /// Compute target sub-domain boundaries from a global histogram of the owned bodies along the split axis.
+    virtual void ComputeTargetBounds();
+
+    std::vector<double> split_bounds;   ///< current sub-domain boundaries along the split axis
+    std::vector<double> target_bounds;  ///< boundaries towards which split_bounds are moving
+    std::vector<RankLoad> rank_loads;   ///< per-rank statistics from the last GatherLoads()
+
+    LoadBalancing balance_mode;  ///< criterion used to place the boundaries
+    int balance_interval;        ///< number of steps between two rebalancings
+    double balance_tolerance;    ///< relative imbalance tolerated before moving the boundaries
+    int num_steps;               ///< steps since the last gathering of loads
+    double sum_step_time;        ///< computation time accumulated since the last gathering of loads
+
   private:
+    /// Move the boundaries towards their targets and update sublo and subhi.
+    void MoveBounds();
+
     /// Helper function that is called by the public GetRegion methods to get
     /// the region classification for a body based on the center position.
     distributed::COMM_STATUS GetRegion(double pos);
@@ -57,7 +57,7 @@ static void PrintNode(LocalShapeNode* node) {
 }
 
 ChSystemDistributed::ChSystemDistributed(MPI_Comm communicator, double ghostlayer, unsigned int maxobjects)
-    : ghost_layer(ghostlayer), master_rank(0), num_bodies_global(0) {
+    : ghost_layer(ghostlayer), master_rank(0), num_bodies_global(0), step_start_time(0) {
     MPI_Comm_dup(communicator, &world);
     MPI_Comm_size(world, &num_ranks);
     MPI_Comm_rank(world, &my_rank);
@@ -69,6 +69,7 @@ ChSystemDistributed::ChSystemDistributed(MPI_Comm communicator, double ghostlaye
     comm = new ChCommDistributed(this);
 
     data_manager->system_timer.AddTimer("Exchange");
+    data_manager->system_timer.AddTimer("LoadBalance");
 
     // Reserve starting space
     int init = maxobjects;  // / num_ranks;
@@ -134,10 +135,13 @@ bool ChSystemDistributed::Integrate_Y() {
     assert(domain->IsSplit());
     ddm->initial_add = false;
 
+    // The exchange is started from OnRigidBodiesAdvanced, as soon as the new body states are known, and runs
+    // while the remaining end-of-step updates are performed.
+    step_start_time = MPI_Wtime();
     bool ret = ChSystemParallelSMC::Integrate_Y();
     if (num_ranks != 1) {
         data_manager->system_timer.start("Exchange");
-        comm->Exchange();
+        comm->ExchangeEnd();
         data_manager->system_timer.stop("Exchange");
     }
 #ifdef DistrProfile
@@ -146,6 +150,20 @@ bool ChSystemDistributed::Integrate_Y() {
     return ret;
 }
 
+void ChSystemDistributed::OnRigidBodiesAdvanced() {
+    if (num_ranks == 1)
+        return;
+
+    // Possibly move the sub-domain boundaries; the exchange below migrates the affected bodies.
+    data_manager->system_timer.start("LoadBalance");
+    domain->UpdateBalance(MPI_Wtime() - step_start_time);
+    data_manager->system_timer.stop("LoadBalance");
+
+    data_manager->system_timer.start("Exchange");
+    comm->ExchangeBegin();
+    data_manager->system_timer.stop("Exchange");
+}
+
 void ChSystemDistributed::UpdateRigidBodies() {
     this->ChSystemParallel::UpdateRigidBodies();
 
@@ -107,7 +107,9 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemParallelSMC {
     virtual void RemoveBody(std::shared_ptr<ChBody> body) override;
 
     /// Wraps the super-class Integrate_Y call and introduces a call that carries
-    /// out all inter-rank communication.
+    /// out all inter-rank communication. The messages are posted as soon as the new
+    /// body states are known and completed at the end of the step, so that the
+    /// remaining body updates overlap with the communication.
     virtual bool Integrate_Y() override;
 
     /// Wraps super-class UpdateRigidBodies and adds a gid update.
@@ -243,6 +245,12 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemParallelSMC {
     /// called by the user.
     void AddBodyExchange(std::shared_ptr<ChBody> newbody, distributed::COMM_STATUS status);
 
+    /// Starts the exchange with the neighbor ranks once the new body states are known.
+    virtual void OnRigidBodiesAdvanced() override;
+
+    /// Wall-clock time at the beginning of the current step
+    double step_start_time;
+
     /// Type for internally sending contact forces
     MPI_Datatype InternalForceType;
 
@@ -15,6 +15,10 @@
 #ifndef CHSOLVERMKL_H
 #define CHSOLVERMKL_H
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "chrono/core/ChMatrixDynamic.h"
 #include "chrono/core/ChSparseMatrix.h"
 #include "chrono/core/ChTimer.h"
@@ -55,6 +59,13 @@ If the sparsity pattern \e learning is enabled, then is \e highly recommended to
 lock.
 </div>
 
+Independently of these options, the solver detects changes of the sparsity pattern from call to call (through a hash
+of the assembled matrix structure): the symbolic analysis (reordering) is performed only when the pattern changes, and
+only the numeric factorization is redone otherwise.\n
+Optionally, the numeric factorization itself can be reused (modified Newton) while the matrix values differ from the
+factorized ones by less than a given relative tolerance (see #SetRefactorizationTolerance()). The solution of the
+Pardiso solve phase is then refined against the current matrix.
+
 Minimal usage example, to be put anywhere in the code, before starting the main simulation loop:
 \code{.cpp}
 auto mkl_solver = std::make_shared<ChSolverMKL<>>();
@@ -106,6 +117,13 @@ class ChSolverMKL : public ChSolver {
     /// Set the number of non-zero entries in the problem matrix.
     void SetMatrixNNZ(int nnz) { m_nnz = nnz; }
 
+    /// Set the tolerance for reusing the last numeric factorization (default: 0).
+    /// If the sparsity pattern is unchanged and the largest change of the matrix entries, relative to the largest
+    /// entry of the factorized matrix, does not exceed \a tol, the factorization is not recomputed (modified Newton).
+    /// With the default value, the factorization is reused only if the matrix is unchanged.
+    /// A negative value forces a new factorization at each call to Setup().
+    void SetRefactorizationTolerance(double tol) { m_refactor_tol = tol; }
+
     /// Reset timers for internal phases in Solve and Setup.
     void ResetTimers() {
         m_timer_setup_assembly.reset();
@@ -126,6 +144,10 @@ class ChSolverMKL : public ChSolver {
     int GetNumSetupCalls() const { return m_setup_call; }
     /// Return the number of calls to the solver's Setup function.
     int GetNumSolveCalls() const { return m_solve_call; }
+    /// Return the number of symbolic analyses (reorderings) performed.
+    int GetNumAnalysisCalls() const { return m_analysis_call; }
+    /// Return the number of numeric factorizations performed.
+    int GetNumFactorizationCalls() const { return m_factorization_call; }
 
     /// Indicate whether or not the #Solve() phase requires an up-to-date problem matrix.
     /// As typical of direct solvers, the Pardiso solver only requires the matrix for its #Setup() phase.
@@ -178,17 +200,40 @@ class ChSolverMKL : public ChSolver {
         if (m_use_rhs_sparsity && !m_use_perm)
             m_engine.UsePartialSolution(2);
 
+        // Redo the symbolic analysis only if the sparsity pattern changed (or a new permutation must be output);
+        // redo the numeric factorization only if the matrix values changed beyond the tolerance.
+        size_t pattern_hash = m_mat.GetSparsityPatternHash();
+        bool analyze = !m_factorized || pattern_hash != m_pattern_hash || (change && m_use_perm);
+        bool factorize = analyze || !FactorizationIsCurrent();
+        m_pattern_hash = pattern_hash;
+
         m_timer_setup_assembly.stop();
 
         // Perform the factorization with the Pardiso sparse direct solver.
+        int pardiso_message_phase12 = 0;
         m_timer_setup_solvercall.start();
-        int pardiso_message_phase12 = m_engine.PardisoCall(ChMklEngine::phase_t::ANALYSIS_NUMFACTORIZATION, 0);
+        if (analyze) {
+            pardiso_message_phase12 = m_engine.PardisoCall(ChMklEngine::phase_t::ANALYSIS_NUMFACTORIZATION, 0);
+            m_analysis_call++;
+            m_factorization_call++;
+        } else if (factorize) {
+            pardiso_message_phase12 = m_engine.PardisoCall(ChMklEngine::phase_t::NUMFACTORIZATION, 0);
+            m_factorization_call++;
+        }
         m_timer_setup_solvercall.stop();
 
+        if (factorize) {
+            double* values = m_mat.GetCS_ValueArray();
+            m_factor_values.assign(values, values + m_mat.GetNNZ());
+        }
+        m_factorized = (pardiso_message_phase12 == 0);
+
         m_setup_call++;
 
         if (verbose) {
-            GetLog() << " MKL setup n = " << m_dim << "  nnz = " << m_mat.GetNNZ() << "\n";
+            GetLog() << " MKL setup n = " << m_dim << "  nnz = " << m_mat.GetNNZ()
+                     << (analyze ? "  (analysis+factorization)" : factorize ? "  (factorization)" : "  (reused)")
+                     << "\n";
             GetLog() << "  assembly: " << m_timer_setup_assembly.GetTimeSecondsIntermediate() << "s"
                      << "  solver_call: " << m_timer_setup_solvercall.GetTimeSecondsIntermediate() << "\n";
         }
@@ -264,6 +309,21 @@ class ChSolverMKL : public ChSolver {
     }
 
   private:
+    /// Check whether the current matrix values are within the refactorization tolerance of the factorized ones.
+    /// Assumes an unchanged sparsity pattern.
+    bool FactorizationIsCurrent() const {
+        if (m_refactor_tol < 0 || m_factor_values.size() != static_cast<size_t>(m_mat.GetNNZ()))
+            return false;
+        const double* values = m_mat.GetCS_ValueArray();
+        double max_value = 0;
+        double max_change = 0;
+        for (size_t i = 0; i < m_factor_values.size(); i++) {
+            max_value = std::max(max_value, std::abs(m_factor_values[i]));
+            max_change = std::max(max_change, std::abs(values[i] - m_factor_values[i]));
+        }
+        return max_change <= m_refactor_tol * max_value;
+    }
+
     ChMklEngine m_engine = {0, ChSparseMatrix::GENERAL};  ///< interface to MKL solver
     Matrix m_mat = {1, 1};                                ///< problem matrix
     ChMatrixDynamic<double> m_rhs;                        ///< right-hand side vector
@@ -274,6 +334,13 @@ class ChSolverMKL : public ChSolver {
     int m_solve_call = 0;  ///< counter for calls to Solve
     int m_setup_call = 0;  ///< counter for calls to Setup
 
+    int m_analysis_call = 0;              ///< counter for symbolic analyses
+    int m_factorization_call = 0;         ///< counter for numeric factorizations
+    bool m_factorized = false;            ///< is there a valid factorization?
+    size_t m_pattern_hash = 0;            ///< hash of the sparsity pattern of the factorized matrix
+    std::vector<double> m_factor_values;  ///< values of the factorized matrix
+    double m_refactor_tol = 0;            ///< relative tolerance for reusing the factorization
+
     bool m_lock = false;                           ///< is the matrix sparsity pattern locked?
     bool m_force_sparsity_pattern_update = false;  ///< is the sparsity pattern changed compared to last call?
     bool m_use_perm = false;                       ///< enable use of the permutation vector?
@@ -19,6 +19,7 @@
 #include "chrono_models/vehicle/generic/Generic_RigidMeshTire.h"
 
 #include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 
 namespace chrono {
 namespace vehicle {
@@ -54,8 +55,7 @@ Generic_RigidMeshTire::Generic_RigidMeshTire(const std::string& name) : ChRigidT
 
 void Generic_RigidMeshTire::AddVisualizationAssets(VisualizationType vis) {
     if (vis == VisualizationType::MESH) {
-        auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-        trimesh->LoadWavefrontMesh(vehicle::GetDataFile(m_meshFile), false, false);
+        auto trimesh = ChAssetCache::GetMesh(vehicle::GetDataFile(m_meshFile), false, false);
         m_trimesh_shape = std::make_shared<ChTriangleMeshShape>();
         m_trimesh_shape->SetMesh(trimesh);
         m_trimesh_shape->SetName(m_meshName);
@@ -19,6 +19,7 @@
 #include <algorithm>
 
 #include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 #include "chrono_models/vehicle/hmmwv/HMMWV_Pac02Tire.h"
 
 namespace chrono {
@@ -45,8 +46,7 @@ HMMWV_Pac02Tire::HMMWV_Pac02Tire(const std::string& name) : ChPacejkaTire(name,
 // -----------------------------------------------------------------------------
 void HMMWV_Pac02Tire::AddVisualizationAssets(VisualizationType vis) {
     if (vis == VisualizationType::MESH) {
-        auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-        trimesh->LoadWavefrontMesh(vehicle::GetDataFile(m_meshFile), false, false);
+        auto trimesh = ChAssetCache::GetMesh(vehicle::GetDataFile(m_meshFile), false, false);
         m_trimesh_shape = std::make_shared<ChTriangleMeshShape>();
         m_trimesh_shape->SetMesh(trimesh);
         m_trimesh_shape->SetName(m_meshName);
@@ -23,6 +23,7 @@
 #include <algorithm>
 
 #include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 #include "chrono_models/vehicle/hmmwv/HMMWV_Pac89Tire.h"
 
 namespace chrono {
@@ -132,8 +133,7 @@ double HMMWV_Pac89Tire::GetNormalStiffnessForce(double depth) const {
 // -----------------------------------------------------------------------------
 void HMMWV_Pac89Tire::AddVisualizationAssets(VisualizationType vis) {
     if (vis == VisualizationType::MESH) {
-        auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-        trimesh->LoadWavefrontMesh(vehicle::GetDataFile(m_meshFile), false, false);
+        auto trimesh = ChAssetCache::GetMesh(vehicle::GetDataFile(m_meshFile), false, false);
         m_trimesh_shape = std::make_shared<ChTriangleMeshShape>();
         m_trimesh_shape->SetMesh(trimesh);
         m_trimesh_shape->SetName(m_meshName);
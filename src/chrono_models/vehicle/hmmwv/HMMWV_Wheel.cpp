@@ -19,6 +19,7 @@
 #include <algorithm>
 
 #include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 
 #include "chrono_models/vehicle/hmmwv/HMMWV_Wheel.h"
 
@@ -54,8 +55,7 @@ HMMWV_WheelRight::HMMWV_WheelRight(const std::string& name) : HMMWV_Wheel(name)
 // -----------------------------------------------------------------------------
 void HMMWV_Wheel::AddVisualizationAssets(VisualizationType vis) {
     if (vis == VisualizationType::MESH) {
-        auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-        trimesh->LoadWavefrontMesh(GetMeshFile(), false, false);
+        auto trimesh = ChAssetCache::GetMesh(GetMeshFile(), false, false);
         m_trimesh_shape = std::make_shared<ChTriangleMeshShape>();
         m_trimesh_shape->SetMesh(trimesh);
         m_trimesh_shape->SetName(GetMeshName());
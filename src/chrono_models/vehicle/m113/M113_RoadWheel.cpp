@@ -20,6 +20,7 @@
 #include "chrono/utils/ChUtilsInputOutput.h"
 
 #include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 
 #include "chrono_models/vehicle/m113/M113_RoadWheel.h"
 
@@ -55,8 +56,7 @@ M113_RoadWheel::M113_RoadWheel(const std::string& name) : ChDoubleRoadWheel(name
 // -----------------------------------------------------------------------------
 void M113_RoadWheel::AddVisualizationAssets(VisualizationType vis) {
     if (vis == VisualizationType::MESH) {
-        auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-        trimesh->LoadWavefrontMesh(GetMeshFile(), false, false);
+        auto trimesh = ChAssetCache::GetMesh(GetMeshFile(), false, false);
         auto trimesh_shape = std::make_shared<ChTriangleMeshShape>();
         trimesh_shape->SetMesh(trimesh);
         trimesh_shape->SetName(GetMeshName());
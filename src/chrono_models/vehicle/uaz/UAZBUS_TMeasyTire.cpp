@@ -21,6 +21,7 @@
 
 #include "chrono_models/vehicle/uaz/UAZBUS_TMeasyTire.h"
 #include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 
 namespace chrono {
 namespace vehicle {
@@ -79,8 +80,7 @@ void UAZBUS_TMeasyTireFront::GenerateCharacteristicPlots(const std::string& dirn
 // -----------------------------------------------------------------------------
 void UAZBUS_TMeasyTireFront::AddVisualizationAssets(VisualizationType vis) {
     if (vis == VisualizationType::MESH) {
-        auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-        trimesh->LoadWavefrontMesh(vehicle::GetDataFile(m_meshFile), false, false);
+        auto trimesh = ChAssetCache::GetMesh(vehicle::GetDataFile(m_meshFile), false, false);
         m_trimesh_shape = std::make_shared<ChTriangleMeshShape>();
         m_trimesh_shape->SetMesh(trimesh);
         m_trimesh_shape->SetName(m_meshName);
@@ -151,8 +151,7 @@ void UAZBUS_TMeasyTireRear::GenerateCharacteristicPlots(const std::string& dirna
 // -----------------------------------------------------------------------------
 void UAZBUS_TMeasyTireRear::AddVisualizationAssets(VisualizationType vis) {
     if (vis == VisualizationType::MESH) {
-        auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-        trimesh->LoadWavefrontMesh(vehicle::GetDataFile(m_meshFile), false, false);
+        auto trimesh = ChAssetCache::GetMesh(vehicle::GetDataFile(m_meshFile), false, false);
         m_trimesh_shape = std::make_shared<ChTriangleMeshShape>();
         m_trimesh_shape->SetMesh(trimesh);
         m_trimesh_shape->SetName(m_meshName);
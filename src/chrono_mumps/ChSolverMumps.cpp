@@ -12,6 +12,9 @@
 // Authors: Dario Mangoni
 // =============================================================================
 
+#include <algorithm>
+#include <cmath>
+
 #include "chrono_mumps/ChSolverMumps.h"
 
 namespace chrono {
@@ -52,17 +55,39 @@ bool ChSolverMumps::Setup(ChSystemDescriptor& sysd) {
     // Set current matrix in the MKL engine.
     m_engine.SetMatrix(m_mat);
 
+    // Redo the analysis only if the sparsity pattern changed; redo the numeric factorization only if the matrix
+    // values changed beyond the tolerance.
+    size_t pattern_hash = m_mat.GetSparsityPatternHash();
+    bool analyze = !m_factorized || pattern_hash != m_pattern_hash;
+    bool factorize = analyze || !FactorizationIsCurrent();
+    m_pattern_hash = pattern_hash;
+
     m_timer_setup_assembly.stop();
 
-    // Perform the factorization with the Pardiso sparse direct solver.
+    // Perform the factorization with the Mumps sparse direct solver.
+    int mumps_message = 0;
     m_timer_setup_solvercall.start();
-    auto mumps_message = m_engine.MumpsCall(ChMumpsEngine::mumps_JOB::ANALYZE_FACTORIZE);
+    if (analyze) {
+        mumps_message = m_engine.MumpsCall(ChMumpsEngine::mumps_JOB::ANALYZE_FACTORIZE);
+        m_analysis_call++;
+        m_factorization_call++;
+    } else if (factorize) {
+        mumps_message = m_engine.MumpsCall(ChMumpsEngine::mumps_JOB::FACTORIZE);
+        m_factorization_call++;
+    }
     m_timer_setup_solvercall.stop();
 
+    if (factorize) {
+        double* values = m_mat.GetCS_ValueArray();
+        m_factor_values.assign(values, values + m_mat.GetNNZ());
+    }
+    m_factorized = (mumps_message == 0);
+
     m_setup_call++;
 
     if (verbose) {
-        GetLog() << " Mumps Setup call: " << m_setup_call << "; n = " << m_dim << "  nnz = " << m_mat.GetNNZ() << "\n";
+        GetLog() << " Mumps Setup call: " << m_setup_call << "; n = " << m_dim << "  nnz = " << m_mat.GetNNZ()
+                 << (analyze ? "  (analysis+factorization)" : factorize ? "  (factorization)" : "  (reused)") << "\n";
         if (m_null_pivot_detection && m_engine.GetINFOG(28) != 0)
             GetLog() << "  Encountered " << m_engine.GetINFOG(28) << " null pivots\n";
         GetLog() << "  Assembly: " << m_timer_setup_assembly.GetTimeSecondsIntermediate() << "s"
@@ -110,6 +135,19 @@ double ChSolverMumps::Solve(ChSystemDescriptor& sysd)  ///< system description w
     return 0.0;
 }
 
+bool ChSolverMumps::FactorizationIsCurrent() const {
+    if (m_refactor_tol < 0 || m_factor_values.size() != static_cast<size_t>(m_mat.GetNNZ()))
+        return false;
+    const double* values = m_mat.GetCS_ValueArray();
+    double max_value = 0;
+    double max_change = 0;
+    for (size_t i = 0; i < m_factor_values.size(); i++) {
+        max_value = std::max(max_value, std::abs(m_factor_values[i]));
+        max_change = std::max(max_change, std::abs(values[i] - m_factor_values[i]));
+    }
+    return max_change <= m_refactor_tol * max_value;
+}
+
 void ChSolverMumps::SetSparsityPatternLock(bool val) {
     m_lock = val;
     m_mat.SetSparsityPatternLock(m_lock);
@@ -15,6 +15,8 @@
 #ifndef CHSOLVERMUMPS_H
 #define CHSOLVERMUMPS_H
 
+#include <vector>
+
 #include "chrono/core/ChTimer.h"
 #include "chrono/solver/ChSolver.h"
 #include "chrono/solver/ChSystemDescriptor.h"
@@ -30,6 +32,9 @@ namespace chrono {
 /// \class ChSolverMumps
 /// Class that leverages the MUMPS library in order to solve Chrono problems.
 /// It can solve linear systems. It cannot solve VI and complementarity problems.
+/// The analysis phase is performed only when the sparsity pattern of the problem matrix changes (detected through a
+/// hash of the assembled matrix structure); otherwise only the numeric factorization is redone. Optionally, the
+/// factorization itself can be reused while the matrix changes less than a given tolerance (modified Newton).
 
 class ChApiMumps ChSolverMumps : public ChSolver {
   public:
@@ -51,6 +56,13 @@ class ChApiMumps ChSolverMumps : public ChSolver {
 
     void SetNullPivotDetection(bool val, double threshold = 0);
 
+    /// Set the tolerance for reusing the last numeric factorization (default: 0).
+    /// If the sparsity pattern is unchanged and the largest change of the matrix entries, relative to the largest
+    /// entry of the factorized matrix, does not exceed \a tol, the factorization is not recomputed (modified Newton).
+    /// With the default value, the factorization is reused only if the matrix is unchanged.
+    /// A negative value forces a new factorization at each call to Setup().
+    void SetRefactorizationTolerance(double tol) { m_refactor_tol = tol; }
+
     /// Get cumulative time for assembly operations in Solve phase.
     double GetTimeSolve_Assembly() const { return m_timer_solve_assembly(); }
     /// Get cumulative time for Pardiso calls in Solve phase.
@@ -63,6 +75,10 @@ class ChApiMumps ChSolverMumps : public ChSolver {
     int GetNumSetupCalls() const { return m_setup_call; }
     /// Return the number of calls to the solver's Setup function.
     int GetNumSolveCalls() const { return m_solve_call; }
+    /// Return the number of analysis phases performed.
+    int GetNumAnalysisCalls() const { return m_analysis_call; }
+    /// Return the number of numeric factorizations performed.
+    int GetNumFactorizationCalls() const { return m_factorization_call; }
 
     bool Setup(ChSystemDescriptor& sysd) override;
 
@@ -75,6 +91,9 @@ class ChApiMumps ChSolverMumps : public ChSolver {
     ChMumpsEngine& GetMumpsEngine() { return m_engine; }
 
   private:
+    /// Check whether the current matrix values are within the refactorization tolerance of the factorized ones.
+    bool FactorizationIsCurrent() const;
+
     ChMumpsEngine m_engine;                       ///< interface to Mumps solver
     ChCOOMatrix m_mat = ChCOOMatrix(1, 1, true);  ///< problem matrix
     ChMatrixDynamic<double> m_rhs_sol;            ///< right-hand side vector (will be overridden by solution)
@@ -85,6 +104,13 @@ class ChApiMumps ChSolverMumps : public ChSolver {
     int m_solve_call = 0;  ///< counter for calls to Solve
     int m_setup_call = 0;  ///< counter for calls to Setup
 
+    int m_analysis_call = 0;              ///< counter for analysis phases
+    int m_factorization_call = 0;         ///< counter for numeric factorizations
+    bool m_factorized = false;            ///< is there a valid factorization?
+    size_t m_pattern_hash = 0;            ///< hash of the sparsity pattern of the factorized matrix
+    std::vector<double> m_factor_values;  ///< values of the factorized matrix
+    double m_refactor_tol = 0;            ///< relative tolerance for reusing the factorization
+
     bool m_lock = false;                           ///< is the matrix sparsity pattern locked?
     bool m_force_sparsity_pattern_update = false;  ///< is the sparsity pattern changed compared to last call?
     bool m_use_perm = false;                       ///< enable use of the permutation vector?
@@ -407,6 +407,21 @@ struct host_container {
     custom_vector<uint> bin_aabb_number;
     custom_vector<uint> bin_start_index;
     custom_vector<uint> bin_num_contact;
+    custom_vector<long long> bin_hash;      ///< Cell keys of the hashed broadphase
+    custom_vector<long long> bin_hash_out;  ///< Occupied cell keys of the hashed broadphase
+
+    //========Pair Cache Data========
+
+    custom_vector<real3> cache_aabb_min;        ///< Inflated AABBs of the pair cache (global frame)
+    custom_vector<real3> cache_aabb_max;        ///< Inflated AABBs of the pair cache (global frame)
+    custom_vector<char> cache_binned;           ///< Shapes binned in the pair cache
+    custom_vector<char> cache_moved;            ///< Shapes that left their inflated AABB
+    custom_vector<uint> cache_moved_shapes;     ///< Indices of the shapes that left their inflated AABB
+    custom_vector<long long> cache_hash;        ///< Sorted cell keys of the pair cache grid
+    custom_vector<uint> cache_aabb_number;      ///< Shapes associated with the sorted cell keys
+    custom_vector<long long> cache_hash_out;    ///< Occupied cell keys of the pair cache grid
+    custom_vector<uint> cache_start_index;      ///< Start of the occupied cells in the sorted entries
+    custom_vector<long long> cache_pairs;       ///< Cached pairs (encoded in a single long long)
 };
 
 /// Global data manager for Chrono::Parallel.
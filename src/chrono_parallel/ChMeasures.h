@@ -45,6 +45,15 @@ class collision_measures {
         number_of_contacts_possible = 0;
         number_of_bins_active = 0;
         number_of_bin_intersections = 0;
+        hashed_cell_size = 0;
+        hashed_large_cell_size = 0;
+        number_of_large_shapes = 0;
+        number_of_cached_pairs = 0;
+        pair_cache_moved_shapes = 0;
+        pair_cache_reuses = 0;
+        pair_cache_rebuilds = 0;
+        pair_cache_reuse_rate = 0;
+        number_of_batched_pairs = 0;
 
         rigid_min_bounding_point = real3(0);
         rigid_max_bounding_point = real3(0);
@@ -70,6 +79,21 @@ class collision_measures {
     uint number_of_bin_intersections;  ///< Number of AABB bin intersections
     uint number_of_contacts_possible;  ///< Number of contacts possible from broadphase
 
+    // Hashed broadphase info
+    real hashed_cell_size;        ///< Cell size of the first level of the hashed grid
+    real hashed_large_cell_size;  ///< Cell size of the second level of the hashed grid
+    uint number_of_large_shapes;  ///< Number of shapes in the second level of the hashed grid
+
+    // Pair cache info
+    uint number_of_cached_pairs;   ///< Number of pairs in the pair cache
+    uint pair_cache_moved_shapes;  ///< Number of shapes that left their inflated AABB in the last step
+    uint pair_cache_reuses;        ///< Number of steps in which the pair cache was reused (possibly updated)
+    uint pair_cache_rebuilds;      ///< Number of steps in which the pair cache was rebuilt from scratch
+    real pair_cache_reuse_rate;    ///< Fraction of the steps in which the pair cache was reused
+
+    // Narrowphase info
+    uint number_of_batched_pairs;  ///< Number of candidate pairs processed in SIMD packs in the last step
+
     real3 rigid_min_bounding_point;
     real3 rigid_max_bounding_point;
 
@@ -130,6 +130,12 @@ enum class CollisionSystemType {
     COLLSYS_BULLET_PARALLEL  ///< Bullet-based collision system
 };
 
+/// Enumeration of broad-phase collision methods.
+enum class BroadPhaseType {
+    BROADPHASE_GRID,   ///< uniform grid spanning the bounding box of all shapes
+    BROADPHASE_HASHED  ///< sparse hashed grid sized from the shapes, with a second level for large shapes
+};
+
 /// Enumeration of narrow-phase collision methods.
 enum class NarrowPhaseType {
     NARROWPHASE_MPR,        ///< Minkovski Portal Refinement
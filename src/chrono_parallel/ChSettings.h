@@ -52,7 +52,16 @@ class collision_settings {
         // NOTE!!! this really depends on the architecture that you run on and how
         // many cores you are using.
         bins_per_axis = vec3(20, 20, 20);
+        broadphase_algorithm = BroadPhaseType::BROADPHASE_GRID;
+        hashed_cell_size = 0;
+        hashed_cell_factor = 2;
+        hashed_large_ratio = 4;
+        use_pair_cache = false;
+        pair_cache_margin = real(0.1);
+        pair_cache_steps = 10;
+        pair_cache_update_fraction = real(0.25);
         narrowphase_algorithm = NarrowPhaseType::NARROWPHASE_HYBRID_MPR;
+        use_batched_narrowphase = false;
         grid_density = 5;
         fixed_bins = true;
     }
@@ -78,10 +87,40 @@ class collision_settings {
     /// the broadphase stage the extents of the simulation are computed and then
     /// sliced according to the variable.
     vec3 bins_per_axis;
+    /// The broadphase algorithm. The uniform grid spans the bounding box of all shapes, so that a
+    /// single escaping object or a tall, sparse scene degrades it to a few overloaded bins. The
+    /// hashed grid only stores the occupied cells and sizes them from the shapes themselves,
+    /// independently of the global extents; shapes much larger than a cell are moved to a second,
+    /// coarser level.
+    BroadPhaseType broadphase_algorithm;
+    /// Edge length of the cells of the hashed grid. If zero (default), it is set at each step to
+    /// hashed_cell_factor times the average size of the shape AABBs.
+    real hashed_cell_size;
+    /// Ratio between the automatic cell size of the hashed grid and the average shape size.
+    real hashed_cell_factor;
+    /// Shapes with an AABB larger than hashed_large_ratio cells are placed in the second level of
+    /// the hashed grid, whose cells are as large as the largest of these shapes.
+    real hashed_large_ratio;
+    /// Reuse the pairs found by the broadphase across steps (temporal coherence). The pairs are
+    /// collected with the hashed grid from inflated AABBs, and are only updated for the shapes that
+    /// leave their inflated AABB; this pays off when most objects move little, as in granular media.
+    bool use_pair_cache;
+    /// Minimum margin used to inflate the AABBs of the pair cache, as a fraction of the AABB size.
+    real pair_cache_margin;
+    /// The AABBs of the pair cache are inflated by the distance travelled in this many steps at the
+    /// current velocity of the body, if larger than the minimum margin.
+    real pair_cache_steps;
+    /// The pair cache is rebuilt from scratch when more than this fraction of the shapes left their
+    /// inflated AABB in a step.
+    real pair_cache_update_fraction;
     /// There are multiple narrowphase algorithms implemented in the collision
     /// detection code. The narrowphase_algorithm parameter can be used to change
     /// the type of narrowphase used at runtime.
     NarrowPhaseType narrowphase_algorithm;
+    /// With the analytical narrowphase (NARROWPHASE_R and NARROWPHASE_HYBRID_MPR), sort the
+    /// candidate pairs by shape-type combination and process the sphere-sphere, box-sphere, and
+    /// capsule-sphere pairs in SIMD packs, rather than one pair at a time.
+    bool use_batched_narrowphase;
     real grid_density;
     /// Use fixed number of bins instead of tuning them.
     bool fixed_bins;
@@ -24,7 +24,12 @@
 #include <thrust/transform_reduce.h>
 #include <thrust/sort.h>
 #include <thrust/sequence.h>
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/merge.h>
+#include <thrust/remove.h>
 #include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
 
 #if defined(CHRONO_OPENMP_ENABLED)
 #include <thrust/system/omp/execution_policy.h>
@@ -234,13 +239,26 @@ void ChCBroadphase::ComputeTopLevelResolution() {
 // =========================================================================================================
 ChCBroadphase::ChCBroadphase() {
     data_manager = 0;
+    cache_valid = false;
 }
 // =========================================================================================================
 // use spatial subdivision to detect the list of POSSIBLE collisions
 // let user define their own narrow-phase collision detection
 void ChCBroadphase::DispatchRigid() {
     if (data_manager->num_rigid_shapes != 0) {
-        OneLevelBroadphase();
+        if (data_manager->settings.collision.use_pair_cache) {
+            CachedBroadphase();
+        } else {
+            cache_valid = false;
+            switch (data_manager->settings.collision.broadphase_algorithm) {
+                case BroadPhaseType::BROADPHASE_HASHED:
+                    HashedBroadphase();
+                    break;
+                default:
+                    OneLevelBroadphase();
+                    break;
+            }
+        }
         data_manager->num_rigid_contacts = data_manager->measures.collision.number_of_contacts_possible;
     }
     return;
@@ -341,5 +359,508 @@ void ChCBroadphase::OneLevelBroadphase() {
     LOG(TRACE) << "Number of unique collisions: " << number_of_contacts_possible;
 }
 
+// =========================================================================================================
+
+// Size of a large shape, or zero for a small, inactive, or non-colliding shape.
+struct LargeShapeSize {
+    LargeShapeSize(const custom_vector<real3>* aabb_min,
+                   const custom_vector<real3>* aabb_max,
+                   const custom_vector<uint>* id,
+                   const custom_vector<char>* collide,
+                   real large_size)
+        : m_aabb_min(aabb_min), m_aabb_max(aabb_max), m_id(id), m_collide(collide), m_large_size(large_size) {}
+    real operator()(int i) const {
+        uint id = (*m_id)[i];
+        if (id == UINT_MAX || (*m_collide)[id] == 0)
+            return 0;
+        real size = Max((*m_aabb_max)[i] - (*m_aabb_min)[i]);
+        return size > m_large_size ? size : 0;
+    }
+    const custom_vector<real3>* m_aabb_min;
+    const custom_vector<real3>* m_aabb_max;
+    const custom_vector<uint>* m_id;
+    const custom_vector<char>* m_collide;
+    real m_large_size;
+};
+
+// Determine the cell sizes of the hashed grid from the sizes of the given shape AABBs.
+// Inactive shapes and shapes on non-colliding bodies are not counted; they are also left out of the grid.
+void ChCBroadphase::ComputeHashedResolution(const custom_vector<real3>& aabb_min,
+                                            const custom_vector<real3>& aabb_max) {
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    const collision_settings& settings = data_manager->settings.collision;
+    const int num_shapes = data_manager->num_rigid_shapes;
+
+    real& cell_size = data_manager->measures.collision.hashed_cell_size;
+    real& large_cell_size = data_manager->measures.collision.hashed_large_cell_size;
+    uint& number_of_large_shapes = data_manager->measures.collision.number_of_large_shapes;
+
+    cell_size = settings.hashed_cell_size;
+    if (cell_size <= 0) {
+        real total_size = 0;
+        int num_sized = 0;
+#pragma omp parallel for reduction(+ : total_size, num_sized)
+        for (int i = 0; i < num_shapes; i++) {
+            if (obj_data_id[i] == UINT_MAX || obj_collide[obj_data_id[i]] == 0)
+                continue;
+            total_size += Max(aabb_max[i] - aabb_min[i]);
+            num_sized++;
+        }
+        cell_size = (total_size > 0) ? settings.hashed_cell_factor * total_size / num_sized : real(1);
+    }
+
+    // The second level is only used if there are large shapes, with cells as large as the largest of them
+    LargeShapeSize large_op(&aabb_min, &aabb_max, &obj_data_id, &obj_collide, settings.hashed_large_ratio * cell_size);
+    thrust::counting_iterator<int> first(0);
+    thrust::counting_iterator<int> last(num_shapes);
+    large_cell_size = thrust::transform_reduce(THRUST_PAR first, last, large_op, real(0), thrust::maximum<real>());
+    number_of_large_shapes = (uint)thrust::count_if(THRUST_PAR first, last, large_op);
+
+    LOG(TRACE) << "ChCBroadphase::ComputeHashedResolution() cell_size: " << cell_size
+               << " large_cell_size: " << large_cell_size << " large shapes: " << number_of_large_shapes;
+}
+
+// Move the large shapes to the front of the occupied cells of the second level of the hashed grid.
+static void HashedSortLargeEntries(const custom_vector<real3>& aabb_min,
+                                   const custom_vector<real3>& aabb_max,
+                                   const real large_size,
+                                   const uint number_of_bins_active,
+                                   const custom_vector<long long>& bin_hash_out,
+                                   const custom_vector<uint>& bin_start_index,
+                                   custom_vector<uint>& bin_aabb_number) {
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < (signed)number_of_bins_active; i++) {
+        f_Hashed_Sort_Large_Entries(i, large_size, aabb_min, aabb_max, bin_hash_out, bin_start_index,
+                                    bin_aabb_number);
+    }
+}
+
+// Bin the given shape AABBs in the hashed grid (sized by ComputeHashedResolution) and collect the pairs
+// accepted by the filter in the occupied cells. The sorted bin entries and the occupied cells are left in
+// bin_hash/bin_aabb_number and bin_hash_out/bin_start_index, with the large shapes at the front of the cells
+// of the second level.
+template <typename Filter>
+static void HashedGridPairs(ChParallelDataManager* data_manager,
+                            const custom_vector<real3>& aabb_min,
+                            const custom_vector<real3>& aabb_max,
+                            const Filter& filter,
+                            custom_vector<long long>& bin_hash,
+                            custom_vector<uint>& bin_aabb_number,
+                            custom_vector<long long>& bin_hash_out,
+                            custom_vector<uint>& bin_start_index,
+                            custom_vector<long long>& pairs) {
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    custom_vector<uint>& bin_intersections = data_manager->host_data.bin_intersections;
+    custom_vector<uint>& bin_num_contact = data_manager->host_data.bin_num_contact;
+
+    const int num_shapes = data_manager->num_rigid_shapes;
+
+    uint& number_of_bins_active = data_manager->measures.collision.number_of_bins_active;
+    uint& number_of_bin_intersections = data_manager->measures.collision.number_of_bin_intersections;
+
+    const real cell_size = data_manager->measures.collision.hashed_cell_size;
+    const real large_cell_size = data_manager->measures.collision.hashed_large_cell_size;
+    const bool two_levels = data_manager->measures.collision.number_of_large_shapes > 0;
+    const real inv_cell_size = 1 / cell_size;
+    const real inv_large_cell_size = two_levels ? 1 / large_cell_size : 0;
+    const real large_size = data_manager->settings.collision.hashed_large_ratio * cell_size;
+
+    bin_intersections.resize(num_shapes + 1);
+    bin_intersections[num_shapes] = 0;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        if (obj_data_id[i] == UINT_MAX || obj_collide[obj_data_id[i]] == 0) {
+            bin_intersections[i] = 0;
+            continue;
+        }
+        f_Hashed_Count_AABB_BIN_Intersection(i, inv_cell_size, inv_large_cell_size, large_size, two_levels,
+                                             aabb_min, aabb_max, bin_intersections);
+    }
+
+    Thrust_Exclusive_Scan(bin_intersections);
+    number_of_bin_intersections = bin_intersections.back();
+
+    LOG(TRACE) << "Number of bin intersections: " << number_of_bin_intersections;
+
+    bin_hash.resize(number_of_bin_intersections);
+    bin_hash_out.resize(number_of_bin_intersections);
+    bin_aabb_number.resize(number_of_bin_intersections);
+    bin_start_index.resize(number_of_bin_intersections);
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        if (obj_data_id[i] == UINT_MAX || obj_collide[obj_data_id[i]] == 0)
+            continue;
+        f_Hashed_Store_AABB_BIN_Intersection(i, inv_cell_size, inv_large_cell_size, large_size, two_levels,
+                                             aabb_min, aabb_max, bin_intersections, bin_hash, bin_aabb_number);
+    }
+
+    Thrust_Sort_By_Key(bin_hash, bin_aabb_number);
+    number_of_bins_active = (int)(Run_Length_Encode(bin_hash, bin_hash_out, bin_start_index));
+
+    bin_hash_out.resize(number_of_bins_active);
+    bin_start_index.resize(number_of_bins_active + 1);
+    bin_start_index[number_of_bins_active] = 0;
+
+    LOG(TRACE) << "Number of bins active: " << number_of_bins_active;
+
+    if (number_of_bins_active == 0) {
+        pairs.clear();
+        return;
+    }
+
+    Thrust_Exclusive_Scan(bin_start_index);
+    if (two_levels)
+        HashedSortLargeEntries(aabb_min, aabb_max, large_size, number_of_bins_active, bin_hash_out, bin_start_index,
+                               bin_aabb_number);
+
+    bin_num_contact.resize(number_of_bins_active + 1);
+    bin_num_contact[number_of_bins_active] = 0;
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < (signed)number_of_bins_active; i++) {
+        f_Hashed_Count_AABB_AABB_Intersection(i, inv_cell_size, inv_large_cell_size, large_size, aabb_min, aabb_max,
+                                              bin_hash_out, bin_aabb_number, bin_start_index, filter,
+                                              bin_num_contact);
+    }
+
+    Thrust_Exclusive_Scan(bin_num_contact);
+    pairs.resize(bin_num_contact.back());
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < (signed)number_of_bins_active; i++) {
+        f_Hashed_Store_AABB_AABB_Intersection(i, inv_cell_size, inv_large_cell_size, large_size, aabb_min, aabb_max,
+                                              bin_hash_out, bin_aabb_number, bin_start_index, bin_num_contact,
+                                              filter, pairs);
+    }
+}
+
+// Two-level broadphase on a sparse hashed grid.
+// Each shape is binned in the cells of the first level it intersects, unless it is much larger than these
+// cells; if there are such large shapes, all shapes are also binned in a coarser second level, where only
+// pairs involving a large shape are considered. Cells are identified by a unique key computed from their
+// coordinates, so that only the occupied cells are stored and the grid does not depend on the global extents.
+void ChCBroadphase::HashedBroadphase() {
+    LOG(TRACE) << "ChCBroadphase::HashedBroadphase()";
+    const custom_vector<real3>& aabb_min = data_manager->host_data.aabb_min;
+    const custom_vector<real3>& aabb_max = data_manager->host_data.aabb_max;
+    custom_vector<long long>& contact_pairs = data_manager->host_data.contact_pairs;
+
+    ComputeHashedResolution(aabb_min, aabb_max);
+
+    HashedContactFilter filter(&data_manager->shape_data.fam_rigid, &data_manager->host_data.active_rigid,
+                               &data_manager->shape_data.id_rigid);
+    HashedGridPairs(data_manager, aabb_min, aabb_max, filter, data_manager->host_data.bin_hash,
+                    data_manager->host_data.bin_aabb_number, data_manager->host_data.bin_hash_out,
+                    data_manager->host_data.bin_start_index, contact_pairs);
+
+    data_manager->measures.collision.number_of_contacts_possible = (uint)contact_pairs.size();
+    LOG(TRACE) << "Number of possible collisions: " << contact_pairs.size();
+}
+
+// =========================================================================================================
+
+// Entry of the hashed grid of the pair cache belonging to a shape that left its inflated AABB.
+struct CacheMovedEntry {
+    CacheMovedEntry(const custom_vector<char>* moved) : m_moved(moved) {}
+    bool operator()(const thrust::tuple<long long, uint>& entry) const {
+        return (*m_moved)[thrust::get<1>(entry)] != 0;
+    }
+    const custom_vector<char>* m_moved;
+};
+
+// Cached pair involving a shape that left its inflated AABB.
+struct CacheMovedPair {
+    CacheMovedPair(const custom_vector<char>* moved) : m_moved(moved) {}
+    bool operator()(const long long pair) const {
+        return (*m_moved)[int(pair >> 32)] != 0 || (*m_moved)[int(pair & 0xffffffff)] != 0;
+    }
+    const custom_vector<char>* m_moved;
+};
+
+// Cached pair that is a potential contact in the current configuration.
+struct CachePairContact {
+    CachePairContact(const HashedContactFilter& filter,
+                     const custom_vector<real3>* aabb_min,
+                     const custom_vector<real3>* aabb_max)
+        : m_filter(filter), m_aabb_min(aabb_min), m_aabb_max(aabb_max) {}
+    bool operator()(const long long pair) const {
+        uint shapeA = int(pair >> 32);
+        uint shapeB = int(pair & 0xffffffff);
+        return m_filter(shapeA, shapeB) &&
+               overlap((*m_aabb_min)[shapeA], (*m_aabb_max)[shapeA], (*m_aabb_min)[shapeB], (*m_aabb_max)[shapeB]);
+    }
+    HashedContactFilter m_filter;
+    const custom_vector<real3>* m_aabb_min;
+    const custom_vector<real3>* m_aabb_max;
+};
+
+// Broadphase with temporal coherence.
+// The pairs are collected with the hashed grid from AABBs inflated by a velocity-based margin, and reused
+// as long as each shape remains within its inflated AABB. Shapes that leave it are removed from the cached
+// grid and pairs, and inserted again with a new inflated AABB; the cache is rebuilt from scratch only when
+// too many shapes moved, or when the set of shapes changed. At each step, the cached pairs are filtered
+// with the current AABBs, activity flags, and collision families.
+void ChCBroadphase::CachedBroadphase() {
+    LOG(TRACE) << "ChCBroadphase::CachedBroadphase()";
+    const custom_vector<real3>& aabb_min = data_manager->host_data.aabb_min;
+    const custom_vector<real3>& aabb_max = data_manager->host_data.aabb_max;
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    const custom_vector<real3>& cache_aabb_min = data_manager->host_data.cache_aabb_min;
+    const custom_vector<real3>& cache_aabb_max = data_manager->host_data.cache_aabb_max;
+    const custom_vector<char>& cache_binned = data_manager->host_data.cache_binned;
+    custom_vector<char>& cache_moved = data_manager->host_data.cache_moved;
+    custom_vector<long long>& cache_pairs = data_manager->host_data.cache_pairs;
+    custom_vector<long long>& contact_pairs = data_manager->host_data.contact_pairs;
+    collision_measures& measures = data_manager->measures.collision;
+
+    const int num_shapes = data_manager->num_rigid_shapes;
+    const real3 origin = measures.global_origin;
+
+    // Find the shapes that left their inflated AABB, or that were added to or removed from the grid
+    bool rebuild = !cache_valid || cache_aabb_min.size() != (size_t)num_shapes;
+    uint num_moved = num_shapes;
+    if (!rebuild) {
+        cache_moved.resize(num_shapes);
+#pragma omp parallel for
+        for (int i = 0; i < num_shapes; i++) {
+            bool binned = obj_data_id[i] != UINT_MAX && obj_collide[obj_data_id[i]] != 0;
+            if (binned != (cache_binned[i] != 0)) {
+                cache_moved[i] = 1;
+            } else {
+                real3 Amin = aabb_min[i] + origin;
+                real3 Amax = aabb_max[i] + origin;
+                cache_moved[i] = binned && !(Amin.x >= cache_aabb_min[i].x && Amin.y >= cache_aabb_min[i].y &&
+                                             Amin.z >= cache_aabb_min[i].z && Amax.x <= cache_aabb_max[i].x &&
+                                             Amax.y <= cache_aabb_max[i].y && Amax.z <= cache_aabb_max[i].z);
+            }
+        }
+        num_moved = (uint)Thrust_Count(cache_moved, 1);
+    }
+    measures.pair_cache_moved_shapes = num_moved;
+
+    rebuild = rebuild || num_moved > data_manager->settings.collision.pair_cache_update_fraction * num_shapes;
+    if (rebuild || !UpdatePairCache(num_moved)) {
+        RebuildPairCache();
+        measures.pair_cache_rebuilds++;
+    } else {
+        measures.pair_cache_reuses++;
+    }
+    measures.pair_cache_reuse_rate =
+        real(measures.pair_cache_reuses) / real(measures.pair_cache_reuses + measures.pair_cache_rebuilds);
+    measures.number_of_cached_pairs = (uint)cache_pairs.size();
+
+    // Keep the cached pairs that are potential contacts in the current configuration
+    HashedContactFilter filter(&data_manager->shape_data.fam_rigid, &data_manager->host_data.active_rigid,
+                               &obj_data_id);
+    contact_pairs.resize(cache_pairs.size());
+    auto end = thrust::copy_if(THRUST_PAR cache_pairs.begin(), cache_pairs.end(), contact_pairs.begin(),
+                               CachePairContact(filter, &aabb_min, &aabb_max));
+    contact_pairs.resize(end - contact_pairs.begin());
+    measures.number_of_contacts_possible = (uint)contact_pairs.size();
+
+    LOG(TRACE) << "Pair cache: moved shapes: " << num_moved << " cached pairs: " << cache_pairs.size()
+               << " possible collisions: " << contact_pairs.size();
+}
+
+// Inflate the AABB of a shape, in the global frame, by a margin based on the velocity of its body.
+void ChCBroadphase::InflateCacheAABB(const int index) {
+    const uint body = data_manager->shape_data.id_rigid[index];
+    const DynamicVector<real>& v = data_manager->host_data.v;
+    const collision_settings& settings = data_manager->settings.collision;
+    const real3& origin = data_manager->measures.collision.global_origin;
+
+    real3 Amin = data_manager->host_data.aabb_min[index] + origin;
+    real3 Amax = data_manager->host_data.aabb_max[index] + origin;
+    real size = Max(Amax - Amin);
+
+    // Distance travelled in the given number of steps, including the rotation of the shape about its body
+    real3 lin_vel(v[body * 6 + 0], v[body * 6 + 1], v[body * 6 + 2]);
+    real3 ang_vel(v[body * 6 + 3], v[body * 6 + 4], v[body * 6 + 5]);
+    real speed = Length(lin_vel) + Length(ang_vel) * size;
+    real travel = settings.pair_cache_steps * data_manager->settings.step_size * speed;
+    real margin = Max(settings.pair_cache_margin * size, travel);
+
+    data_manager->host_data.cache_aabb_min[index] = Amin - margin;
+    data_manager->host_data.cache_aabb_max[index] = Amax + margin;
+}
+
+// Rebuild the pair cache from scratch.
+void ChCBroadphase::RebuildPairCache() {
+    LOG(TRACE) << "ChCBroadphase::RebuildPairCache()";
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    custom_vector<real3>& cache_aabb_min = data_manager->host_data.cache_aabb_min;
+    custom_vector<real3>& cache_aabb_max = data_manager->host_data.cache_aabb_max;
+    custom_vector<char>& cache_binned = data_manager->host_data.cache_binned;
+
+    const int num_shapes = data_manager->num_rigid_shapes;
+
+    cache_aabb_min.resize(num_shapes);
+    cache_aabb_max.resize(num_shapes);
+    cache_binned.resize(num_shapes);
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        cache_binned[i] = obj_data_id[i] != UINT_MAX && obj_collide[obj_data_id[i]] != 0;
+        if (cache_binned[i])
+            InflateCacheAABB(i);
+    }
+
+    ComputeHashedResolution(cache_aabb_min, cache_aabb_max);
+
+    HashedCacheFilter filter(&obj_data_id);
+    HashedGridPairs(data_manager, cache_aabb_min, cache_aabb_max, filter, data_manager->host_data.cache_hash,
+                    data_manager->host_data.cache_aabb_number, data_manager->host_data.cache_hash_out,
+                    data_manager->host_data.cache_start_index, data_manager->host_data.cache_pairs);
+
+    cache_valid = true;
+}
+
+// Update the pair cache for the shapes that left their inflated AABB (flagged in cache_moved).
+// Only the grid entries and pairs of these shapes are replaced. Return false if the cached grid cannot
+// accommodate the new AABBs, in which case the cache must be rebuilt.
+bool ChCBroadphase::UpdatePairCache(uint num_moved) {
+    if (num_moved == 0)
+        return true;
+
+    LOG(TRACE) << "ChCBroadphase::UpdatePairCache()";
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    custom_vector<real3>& cache_aabb_min = data_manager->host_data.cache_aabb_min;
+    custom_vector<real3>& cache_aabb_max = data_manager->host_data.cache_aabb_max;
+    custom_vector<char>& cache_binned = data_manager->host_data.cache_binned;
+    const custom_vector<char>& cache_moved = data_manager->host_data.cache_moved;
+    custom_vector<uint>& moved_shapes = data_manager->host_data.cache_moved_shapes;
+    custom_vector<long long>& cache_hash = data_manager->host_data.cache_hash;
+    custom_vector<uint>& cache_aabb_number = data_manager->host_data.cache_aabb_number;
+    custom_vector<long long>& cache_hash_out = data_manager->host_data.cache_hash_out;
+    custom_vector<uint>& cache_start_index = data_manager->host_data.cache_start_index;
+    custom_vector<long long>& cache_pairs = data_manager->host_data.cache_pairs;
+    // Scratch space, shared with the broadphase without cache
+    custom_vector<uint>& bin_intersections = data_manager->host_data.bin_intersections;
+    custom_vector<long long>& bin_hash = data_manager->host_data.bin_hash;
+    custom_vector<uint>& bin_aabb_number = data_manager->host_data.bin_aabb_number;
+    custom_vector<uint>& bin_num_contact = data_manager->host_data.bin_num_contact;
+    custom_vector<long long>& merged_hash = data_manager->host_data.bin_hash_out;
+    custom_vector<uint>& merged_aabb_number = data_manager->host_data.bin_start_index;
+
+    const int num_shapes = data_manager->num_rigid_shapes;
+
+    const real cell_size = data_manager->measures.collision.hashed_cell_size;
+    const real large_cell_size = data_manager->measures.collision.hashed_large_cell_size;
+    const bool two_levels = data_manager->measures.collision.number_of_large_shapes > 0;
+    const real inv_cell_size = 1 / cell_size;
+    const real inv_large_cell_size = two_levels ? 1 / large_cell_size : 0;
+    const real large_size = data_manager->settings.collision.hashed_large_ratio * cell_size;
+
+    moved_shapes.resize(num_moved);
+    thrust::counting_iterator<uint> first(0);
+    thrust::copy_if(THRUST_PAR first, first + num_shapes, cache_moved.begin(), moved_shapes.begin(),
+                    thrust::identity<char>());
+
+    // Inflate the AABBs of the moved shapes. A shape becoming large requires the second level of the grid.
+    uint num_large = 0;
+#pragma omp parallel for reduction(+ : num_large)
+    for (int k = 0; k < (signed)num_moved; k++) {
+        uint i = moved_shapes[k];
+        cache_binned[i] = obj_data_id[i] != UINT_MAX && obj_collide[obj_data_id[i]] != 0;
+        if (cache_binned[i]) {
+            InflateCacheAABB(i);
+            if (HashedIsLarge(cache_aabb_min[i], cache_aabb_max[i], large_size))
+                num_large++;
+        }
+    }
+    if (num_large > 0 && !two_levels)
+        return false;
+
+    // Remove the grid entries and the pairs of the moved shapes
+    auto entries = thrust::make_zip_iterator(thrust::make_tuple(cache_hash.begin(), cache_aabb_number.begin()));
+    auto entries_end = thrust::make_zip_iterator(thrust::make_tuple(cache_hash.end(), cache_aabb_number.end()));
+    size_t num_entries = thrust::remove_if(THRUST_PAR entries, entries_end, CacheMovedEntry(&cache_moved)) - entries;
+    cache_hash.resize(num_entries);
+    cache_aabb_number.resize(num_entries);
+
+    size_t num_pairs =
+        thrust::remove_if(THRUST_PAR cache_pairs.begin(), cache_pairs.end(), CacheMovedPair(&cache_moved)) -
+        cache_pairs.begin();
+    cache_pairs.resize(num_pairs);
+
+    // Bin the moved shapes with their new AABBs, and merge them with the other entries
+    bin_intersections.resize(num_shapes + 1);
+    thrust::fill(bin_intersections.begin(), bin_intersections.end(), 0);
+#pragma omp parallel for
+    for (int k = 0; k < (signed)num_moved; k++) {
+        uint i = moved_shapes[k];
+        if (cache_binned[i])
+            f_Hashed_Count_AABB_BIN_Intersection(i, inv_cell_size, inv_large_cell_size, large_size, two_levels,
+                                                 cache_aabb_min, cache_aabb_max, bin_intersections);
+    }
+    Thrust_Exclusive_Scan(bin_intersections);
+    size_t num_new_entries = bin_intersections.back();
+
+    bin_hash.resize(num_new_entries);
+    bin_aabb_number.resize(num_new_entries);
+#pragma omp parallel for
+    for (int k = 0; k < (signed)num_moved; k++) {
+        uint i = moved_shapes[k];
+        if (cache_binned[i])
+            f_Hashed_Store_AABB_BIN_Intersection(i, inv_cell_size, inv_large_cell_size, large_size, two_levels,
+                                                 cache_aabb_min, cache_aabb_max, bin_intersections, bin_hash,
+                                                 bin_aabb_number);
+    }
+    Thrust_Sort_By_Key(bin_hash, bin_aabb_number);
+
+    merged_hash.resize(num_entries + num_new_entries);
+    merged_aabb_number.resize(num_entries + num_new_entries);
+    thrust::merge_by_key(THRUST_PAR cache_hash.begin(), cache_hash.end(), bin_hash.begin(), bin_hash.end(),
+                         cache_aabb_number.begin(), bin_aabb_number.begin(), merged_hash.begin(),
+                         merged_aabb_number.begin());
+    cache_hash.swap(merged_hash);
+    cache_aabb_number.swap(merged_aabb_number);
+
+    cache_hash_out.resize(cache_hash.size());
+    cache_start_index.resize(cache_hash.size() + 1);
+    uint number_of_bins_active = (uint)(Run_Length_Encode(cache_hash, cache_hash_out, cache_start_index));
+    cache_hash_out.resize(number_of_bins_active);
+    cache_start_index.resize(number_of_bins_active + 1);
+    cache_start_index[number_of_bins_active] = 0;
+    Thrust_Exclusive_Scan(cache_start_index);
+    if (two_levels)
+        HashedSortLargeEntries(cache_aabb_min, cache_aabb_max, large_size, number_of_bins_active, cache_hash_out,
+                               cache_start_index, cache_aabb_number);
+    data_manager->measures.collision.number_of_bins_active = number_of_bins_active;
+
+    // Find the pairs of the moved shapes in the updated grid
+    HashedCacheFilter filter(&obj_data_id);
+    bin_num_contact.resize(num_moved + 1);
+    bin_num_contact[num_moved] = 0;
+#pragma omp parallel for schedule(dynamic, 16)
+    for (int k = 0; k < (signed)num_moved; k++) {
+        uint i = moved_shapes[k];
+        bin_num_contact[k] = cache_binned[i] ? f_Cache_Shape_Pairs(i, inv_cell_size, inv_large_cell_size, large_size,
+                                                                   two_levels, cache_aabb_min, cache_aabb_max,
+                                                                   cache_hash_out, cache_aabb_number, cache_start_index,
+                                                                   cache_moved, filter, 0, nullptr)
+                                             : 0;
+    }
+    Thrust_Exclusive_Scan(bin_num_contact);
+    cache_pairs.resize(num_pairs + bin_num_contact[num_moved]);
+#pragma omp parallel for schedule(dynamic, 16)
+    for (int k = 0; k < (signed)num_moved; k++) {
+        uint i = moved_shapes[k];
+        if (cache_binned[i])
+            f_Cache_Shape_Pairs(i, inv_cell_size, inv_large_cell_size, large_size, two_levels, cache_aabb_min,
+                                cache_aabb_max, cache_hash_out, cache_aabb_number, cache_start_index, cache_moved,
+                                filter, num_pairs + bin_num_contact[k], &cache_pairs);
+    }
+
+    return true;
+}
+
 } // end namespace collision
 } // end namespace chrono
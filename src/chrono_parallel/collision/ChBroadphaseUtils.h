@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <climits>
 
 #include "chrono_parallel/ChParallelDefines.h"
@@ -413,6 +414,344 @@ static inline void f_Store_AABB_AABB_Intersection(const uint index,
     }
 }
 
+// HASHED GRID FUNCTIONS ===================================================================================
+
+/// Number of bits used for each cell coordinate in the keys of the hashed grid.
+#define HASHED_CELL_BITS 20
+/// Cell coordinates of the hashed grid are clamped to [-HASHED_CELL_RANGE, HASHED_CELL_RANGE - 1].
+/// Objects beyond this range share the border cells, which is conservative.
+#define HASHED_CELL_RANGE (1 << (HASHED_CELL_BITS - 1))
+/// Bit flagging the keys of the second (large shape) level of the hashed grid.
+#define HASHED_LARGE_LEVEL (1LL << (3 * HASHED_CELL_BITS))
+
+/// Convert a position into the coordinates of the containing cell of the hashed grid.
+static inline vec3 HashedCell(const real3& A, real inv_cell_size) {
+    const real low = -HASHED_CELL_RANGE;
+    const real high = HASHED_CELL_RANGE - 1;
+    vec3 temp;
+    temp.x = (int)Clamp(Floor(A.x * inv_cell_size), low, high);
+    temp.y = (int)Clamp(Floor(A.y * inv_cell_size), low, high);
+    temp.z = (int)Clamp(Floor(A.z * inv_cell_size), low, high);
+    return temp;
+}
+
+/// Convert the coordinates of a cell into the key of the hashed grid.
+/// Keys are unique, so that only the occupied cells are stored and no two cells share a bin.
+static inline long long HashedKey(const vec3& A, bool large) {
+    const long long mask = (1LL << HASHED_CELL_BITS) - 1;
+    long long key = ((long long)(A.x + HASHED_CELL_RANGE) & mask) |
+                    (((long long)(A.y + HASHED_CELL_RANGE) & mask) << HASHED_CELL_BITS) |
+                    (((long long)(A.z + HASHED_CELL_RANGE) & mask) << (2 * HASHED_CELL_BITS));
+    return large ? key | HASHED_LARGE_LEVEL : key;
+}
+
+/// Check if a shape belongs to the second level of the hashed grid.
+static inline bool HashedIsLarge(const real3& Amin, const real3& Amax, real large_size) {
+    return Max(Amax - Amin) > large_size;
+}
+
+/// Count the cells of the hashed grid intersected by an AABB, on both levels.
+static inline void f_Hashed_Count_AABB_BIN_Intersection(const uint index,
+                                                        const real inv_cell_size,
+                                                        const real inv_large_cell_size,
+                                                        const real large_size,
+                                                        const bool two_levels,
+                                                        const custom_vector<real3>& aabb_min,
+                                                        const custom_vector<real3>& aabb_max,
+                                                        custom_vector<uint>& bins_intersected) {
+    uint count = 0;
+    if (!HashedIsLarge(aabb_min[index], aabb_max[index], large_size)) {
+        vec3 gmin = HashedCell(aabb_min[index], inv_cell_size);
+        vec3 gmax = HashedCell(aabb_max[index], inv_cell_size);
+        count += (gmax.x - gmin.x + 1) * (gmax.y - gmin.y + 1) * (gmax.z - gmin.z + 1);
+    }
+    if (two_levels) {
+        vec3 gmin = HashedCell(aabb_min[index], inv_large_cell_size);
+        vec3 gmax = HashedCell(aabb_max[index], inv_large_cell_size);
+        count += (gmax.x - gmin.x + 1) * (gmax.y - gmin.y + 1) * (gmax.z - gmin.z + 1);
+    }
+    bins_intersected[index] = count;
+}
+
+/// Store the cells of the hashed grid intersected by an AABB.
+/// Small shapes are stored in the first level only, unless there are large shapes: in that case
+/// all shapes are also stored in the second level, where they are tested against the large ones.
+static inline void f_Hashed_Store_AABB_BIN_Intersection(const uint index,
+                                                        const real inv_cell_size,
+                                                        const real inv_large_cell_size,
+                                                        const real large_size,
+                                                        const bool two_levels,
+                                                        const custom_vector<real3>& aabb_min,
+                                                        const custom_vector<real3>& aabb_max,
+                                                        const custom_vector<uint>& bins_intersected,
+                                                        custom_vector<long long>& bin_hash,
+                                                        custom_vector<uint>& aabb_number) {
+    uint count = bins_intersected[index];
+    if (!HashedIsLarge(aabb_min[index], aabb_max[index], large_size)) {
+        vec3 gmin = HashedCell(aabb_min[index], inv_cell_size);
+        vec3 gmax = HashedCell(aabb_max[index], inv_cell_size);
+        for (int i = gmin.x; i <= gmax.x; i++) {
+            for (int j = gmin.y; j <= gmax.y; j++) {
+                for (int k = gmin.z; k <= gmax.z; k++) {
+                    bin_hash[count] = HashedKey(vec3(i, j, k), false);
+                    aabb_number[count] = index;
+                    count++;
+                }
+            }
+        }
+    }
+    if (two_levels) {
+        vec3 gmin = HashedCell(aabb_min[index], inv_large_cell_size);
+        vec3 gmax = HashedCell(aabb_max[index], inv_large_cell_size);
+        for (int i = gmin.x; i <= gmax.x; i++) {
+            for (int j = gmin.y; j <= gmax.y; j++) {
+                for (int k = gmin.z; k <= gmax.z; k++) {
+                    bin_hash[count] = HashedKey(vec3(i, j, k), true);
+                    aabb_number[count] = index;
+                    count++;
+                }
+            }
+        }
+    }
+}
+
+/// Predicate for the shapes of the second level of the hashed grid.
+struct HashedLargeShape {
+    HashedLargeShape(const custom_vector<real3>* aabb_min, const custom_vector<real3>* aabb_max, real large_size)
+        : m_aabb_min(aabb_min), m_aabb_max(aabb_max), m_large_size(large_size) {}
+    bool operator()(const uint shape) const {
+        return HashedIsLarge((*m_aabb_min)[shape], (*m_aabb_max)[shape], m_large_size);
+    }
+    const custom_vector<real3>* m_aabb_min;
+    const custom_vector<real3>* m_aabb_max;
+    real m_large_size;
+};
+
+/// Move the large shapes to the front of an occupied cell of the second level of the hashed grid.
+/// All shapes are binned in the second level, but only the pairs involving a large shape are reported
+/// there, so that only the large shapes need to be tested against the other entries of the cell.
+static inline void f_Hashed_Sort_Large_Entries(const uint index,
+                                               const real large_size,
+                                               const custom_vector<real3>& aabb_min_data,
+                                               const custom_vector<real3>& aabb_max_data,
+                                               const custom_vector<long long>& bin_hash,
+                                               const custom_vector<uint>& bin_start_index,
+                                               custom_vector<uint>& aabb_number) {
+    if ((bin_hash[index] & HASHED_LARGE_LEVEL) == 0)
+        return;
+    std::partition(aabb_number.begin() + bin_start_index[index], aabb_number.begin() + bin_start_index[index + 1],
+                   HashedLargeShape(&aabb_min_data, &aabb_max_data, large_size));
+}
+
+/// End of the entries of an occupied cell of the hashed grid that are tested against all other entries of
+/// the cell: all entries on the first level, the large shapes only on the second level (which must have been
+/// moved to the front of the cell with f_Hashed_Sort_Large_Entries).
+static inline uint HashedOuterEnd(const uint index,
+                                  const real large_size,
+                                  const custom_vector<real3>& aabb_min_data,
+                                  const custom_vector<real3>& aabb_max_data,
+                                  const custom_vector<long long>& bin_hash,
+                                  const custom_vector<uint>& aabb_number,
+                                  const custom_vector<uint>& bin_start_index) {
+    uint start = bin_start_index[index];
+    uint end = bin_start_index[index + 1];
+    if ((bin_hash[index] & HASHED_LARGE_LEVEL) == 0)
+        return end;
+    return (uint)(std::partition_point(aabb_number.begin() + start, aabb_number.begin() + end,
+                                       HashedLargeShape(&aabb_min_data, &aabb_max_data, large_size)) -
+                  aabb_number.begin());
+}
+
+/// Check if a pair of overlapping shapes is to be reported by a cell of the hashed grid.
+/// A pair is reported only by the cell containing the lower corner of the intersection of the two
+/// AABBs, and, on the second level, only if at least one of the two shapes is large.
+static inline bool f_Hashed_Check_Pair(const uint shapeA,
+                                       const uint shapeB,
+                                       const long long key,
+                                       const real inv_cell_size,
+                                       const real inv_large_cell_size,
+                                       const real large_size,
+                                       const custom_vector<real3>& aabb_min_data,
+                                       const custom_vector<real3>& aabb_max_data) {
+    real3 Amin = aabb_min_data[shapeA];
+    real3 Amax = aabb_max_data[shapeA];
+    real3 Bmin = aabb_min_data[shapeB];
+    real3 Bmax = aabb_max_data[shapeB];
+    if (!overlap(Amin, Amax, Bmin, Bmax))
+        return false;
+
+    bool large = (key & HASHED_LARGE_LEVEL) != 0;
+    if (large && !HashedIsLarge(Amin, Amax, large_size) && !HashedIsLarge(Bmin, Bmax, large_size))
+        return false;
+
+    real inv_size = large ? inv_large_cell_size : inv_cell_size;
+    return HashedKey(HashedCell(Max(Amin, Bmin), inv_size), large) == key;
+}
+
+/// Filter for the pairs of shapes that can come into contact: shapes on different bodies, with at
+/// least one of the two bodies active, and with compatible collision families.
+struct HashedContactFilter {
+    HashedContactFilter(const custom_vector<short2>* fam_data,
+                        const custom_vector<char>* body_active,
+                        const custom_vector<uint>* body_id)
+        : m_fam_data(fam_data), m_body_active(body_active), m_body_id(body_id) {}
+    bool operator()(const uint shapeA, const uint shapeB) const {
+        uint bodyA = (*m_body_id)[shapeA];
+        uint bodyB = (*m_body_id)[shapeB];
+        if (bodyA == bodyB)
+            return false;
+        if (!(*m_body_active)[bodyA] && !(*m_body_active)[bodyB])
+            return false;
+        return collide((*m_fam_data)[shapeA], (*m_fam_data)[shapeB]);
+    }
+    const custom_vector<short2>* m_fam_data;
+    const custom_vector<char>* m_body_active;
+    const custom_vector<uint>* m_body_id;
+};
+
+/// Filter for the pairs of shapes kept in the pair cache: shapes on different bodies.
+/// The other criteria can change at each step, and are checked when the cached pairs are used.
+struct HashedCacheFilter {
+    HashedCacheFilter(const custom_vector<uint>* body_id) : m_body_id(body_id) {}
+    bool operator()(const uint shapeA, const uint shapeB) const { return (*m_body_id)[shapeA] != (*m_body_id)[shapeB]; }
+    const custom_vector<uint>* m_body_id;
+};
+
+/// Count the pairs accepted by the filter in an occupied cell of the hashed grid.
+/// On the second level, only the large shapes at the front of the cell are tested against the other entries.
+template <typename Filter>
+static inline void f_Hashed_Count_AABB_AABB_Intersection(const uint index,
+                                                         const real inv_cell_size,
+                                                         const real inv_large_cell_size,
+                                                         const real large_size,
+                                                         const custom_vector<real3>& aabb_min_data,
+                                                         const custom_vector<real3>& aabb_max_data,
+                                                         const custom_vector<long long>& bin_hash,
+                                                         const custom_vector<uint>& aabb_number,
+                                                         const custom_vector<uint>& bin_start_index,
+                                                         const Filter& filter,
+                                                         custom_vector<uint>& num_contact) {
+    uint start = bin_start_index[index];
+    uint end = bin_start_index[index + 1];
+    uint outer_end = HashedOuterEnd(index, large_size, aabb_min_data, aabb_max_data, bin_hash, aabb_number,
+                                    bin_start_index);
+    uint count = 0;
+    for (uint i = start; i < outer_end; i++) {
+        for (uint k = i + 1; k < end; k++) {
+            uint shapeA = aabb_number[i];
+            uint shapeB = aabb_number[k];
+            if (filter(shapeA, shapeB) && f_Hashed_Check_Pair(shapeA, shapeB, bin_hash[index], inv_cell_size,
+                                                              inv_large_cell_size, large_size, aabb_min_data,
+                                                              aabb_max_data))
+                count++;
+        }
+    }
+    num_contact[index] = count;
+}
+
+/// Store the pairs accepted by the filter in an occupied cell of the hashed grid.
+/// On the second level, only the large shapes at the front of the cell are tested against the other entries.
+template <typename Filter>
+static inline void f_Hashed_Store_AABB_AABB_Intersection(const uint index,
+                                                         const real inv_cell_size,
+                                                         const real inv_large_cell_size,
+                                                         const real large_size,
+                                                         const custom_vector<real3>& aabb_min_data,
+                                                         const custom_vector<real3>& aabb_max_data,
+                                                         const custom_vector<long long>& bin_hash,
+                                                         const custom_vector<uint>& aabb_number,
+                                                         const custom_vector<uint>& bin_start_index,
+                                                         const custom_vector<uint>& num_contact,
+                                                         const Filter& filter,
+                                                         custom_vector<long long>& potential_contacts) {
+    uint start = bin_start_index[index];
+    uint end = bin_start_index[index + 1];
+    uint offset = num_contact[index];
+    uint outer_end = HashedOuterEnd(index, large_size, aabb_min_data, aabb_max_data, bin_hash, aabb_number,
+                                    bin_start_index);
+    uint count = 0;
+    for (uint i = start; i < outer_end; i++) {
+        for (uint k = i + 1; k < end; k++) {
+            uint shapeA = aabb_number[i];
+            uint shapeB = aabb_number[k];
+            if (!filter(shapeA, shapeB) || !f_Hashed_Check_Pair(shapeA, shapeB, bin_hash[index], inv_cell_size,
+                                                                inv_large_cell_size, large_size, aabb_min_data,
+                                                                aabb_max_data))
+                continue;
+            if (shapeB < shapeA) {
+                uint t = shapeA;
+                shapeA = shapeB;
+                shapeB = t;
+            }
+            potential_contacts[offset + count] = ((long long)shapeA << 32 | (long long)shapeB);
+            count++;
+        }
+    }
+}
+
+/// Collect the pairs of a shape with the shapes in the cells of the hashed grid intersected by its AABB.
+/// Pairs with another moved shape are only collected by the shape with the lower index. The pairs are
+/// counted if no output vector is provided, otherwise they are stored starting at the given offset.
+template <typename Filter>
+static inline uint f_Cache_Shape_Pairs(const uint index,
+                                       const real inv_cell_size,
+                                       const real inv_large_cell_size,
+                                       const real large_size,
+                                       const bool two_levels,
+                                       const custom_vector<real3>& aabb_min_data,
+                                       const custom_vector<real3>& aabb_max_data,
+                                       const custom_vector<long long>& bin_hash,
+                                       const custom_vector<uint>& aabb_number,
+                                       const custom_vector<uint>& bin_start_index,
+                                       const custom_vector<char>& moved,
+                                       const Filter& filter,
+                                       const uint offset,
+                                       custom_vector<long long>* potential_contacts) {
+    uint count = 0;
+    for (int level = 0; level < 2; level++) {
+        bool large = (level == 1);
+        if (large && !two_levels)
+            break;
+        if (!large && HashedIsLarge(aabb_min_data[index], aabb_max_data[index], large_size))
+            continue;
+        real inv_size = large ? inv_large_cell_size : inv_cell_size;
+        vec3 gmin = HashedCell(aabb_min_data[index], inv_size);
+        vec3 gmax = HashedCell(aabb_max_data[index], inv_size);
+        for (int i = gmin.x; i <= gmax.x; i++) {
+            for (int j = gmin.y; j <= gmax.y; j++) {
+                for (int k = gmin.z; k <= gmax.z; k++) {
+                    long long key = HashedKey(vec3(i, j, k), large);
+                    auto bin = std::lower_bound(bin_hash.begin(), bin_hash.end(), key);
+                    if (bin == bin_hash.end() || *bin != key)
+                        continue;
+                    // A small shape is only tested against the large shapes on the second level
+                    uint b = (uint)(bin - bin_hash.begin());
+                    uint n_end = (large && !HashedIsLarge(aabb_min_data[index], aabb_max_data[index], large_size))
+                                     ? HashedOuterEnd(b, large_size, aabb_min_data, aabb_max_data, bin_hash,
+                                                      aabb_number, bin_start_index)
+                                     : bin_start_index[b + 1];
+                    for (uint n = bin_start_index[b]; n < n_end; n++) {
+                        uint shape = aabb_number[n];
+                        if (shape == index || (moved[shape] && shape < index))
+                            continue;
+                        if (!filter(index, shape) || !f_Hashed_Check_Pair(index, shape, key, inv_cell_size,
+                                                                          inv_large_cell_size, large_size,
+                                                                          aabb_min_data, aabb_max_data))
+                            continue;
+                        if (potential_contacts) {
+                            uint shapeA = index < shape ? index : shape;
+                            uint shapeB = index < shape ? shape : index;
+                            (*potential_contacts)[offset + count] = ((long long)shapeA << 32 | (long long)shapeB);
+                        }
+                        count++;
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
 /// @} parallel_colision
 
 } // end namespace collision
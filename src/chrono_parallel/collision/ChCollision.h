@@ -24,6 +24,7 @@
 #include "chrono_parallel/math/ChParallelMath.h"
 #include "chrono_parallel/ChParallelDefines.h"
 #include "chrono_parallel/ChDataManager.h"
+#include "chrono_parallel/collision/ChNarrowphaseR.h"
 
 namespace chrono {
 namespace collision {
@@ -47,6 +48,9 @@ class CH_PARALLEL_API ChCBroadphase {
     ChCBroadphase();
     void DispatchRigid();
     void OneLevelBroadphase();
+    void HashedBroadphase();
+    void ComputeHashedResolution(const custom_vector<real3>& aabb_min, const custom_vector<real3>& aabb_max);
+    void CachedBroadphase();
     void DetermineBoundingBox();
     void OffsetAABB();
     void ComputeTopLevelResolution();
@@ -56,12 +60,17 @@ class CH_PARALLEL_API ChCBroadphase {
     ChParallelDataManager* data_manager;
 
   private:
+    void InflateCacheAABB(const int index);
+    void RebuildPairCache();
+    bool UpdatePairCache(uint num_moved);
+
+    bool cache_valid;  ///< the pair cache was built and can be updated
 };
 
 /// Class for performing narrow-phase collision detection.
 class CH_PARALLEL_API ChCNarrowphaseDispatch {
   public:
-    ChCNarrowphaseDispatch() {}
+    ChCNarrowphaseDispatch() : use_batches(false) {}
     ~ChCNarrowphaseDispatch() {}
     /// Clear contact data structures.
     void ClearContacts();
@@ -135,6 +144,8 @@ class CH_PARALLEL_API ChCNarrowphaseDispatch {
     void DispatchMPR();
     void DispatchR();
     void DispatchHybridMPR();
+    void SortPairsByType();
+    void DispatchBatchedR();
     void Dispatch_Init(uint index, uint& icoll, uint& ID_A, uint& ID_B, ConvexShape* shapeA, ConvexShape* shapeB);
     void Dispatch_Finalize(uint icoll, uint ID_A, uint ID_B, int nC);
     ChParallelDataManager* data_manager;
@@ -144,6 +155,10 @@ class CH_PARALLEL_API ChCNarrowphaseDispatch {
     custom_vector<char> contact_rigid_fluid_active;
     custom_vector<char> contact_fluid_active;
     custom_vector<uint> contact_index;
+    custom_vector<int> batch_key;       // batch of each candidate pair (RBatchType)
+    custom_vector<uint> batch_order;    // candidate pairs, sorted by batch
+    uint batch_start[RBATCH_NONE + 1];  // start of each batch in batch_order
+    bool use_batches;                   // process the candidate pairs by batch
     uint num_potential_rigid_contacts;
     uint num_potential_fluid_contacts;
     uint num_potential_rigid_fluid_contacts;
@@ -27,7 +27,9 @@
 
 #include "chrono_parallel/physics/Ch3DOFContainer.h"
 
+#include <thrust/binary_search.h>
 #include <thrust/remove.h>
+#include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/transform_reduce.h>
 #include <thrust/count.h>
@@ -61,6 +63,9 @@ void ChCNarrowphaseDispatch::ProcessRigids() {
     num_potential_fluid_contacts = data_manager->num_fluid_contacts;
     narrowphase_algorithm = data_manager->settings.collision.narrowphase_algorithm;
     collision_envelope = data_manager->settings.collision.collision_envelope;
+    use_batches = data_manager->settings.collision.use_batched_narrowphase &&
+                  narrowphase_algorithm != NarrowPhaseType::NARROWPHASE_MPR;
+    data_manager->measures.collision.number_of_batched_pairs = 0;
     ClearContacts();
     // Transform Rigid body shapes to global coordinate system
     PreprocessLocalToParent();
@@ -231,8 +236,12 @@ void ChCNarrowphaseDispatch::DispatchR() {
     ConvexShape shapeA;
     ConvexShape shapeB;
 
+    // Pairs processed in batches are skipped
+    uint first = use_batches ? batch_start[RBATCH_NONE] : 0;
+
 #pragma omp parallel for private(shapeA, shapeB)
-    for (int index = 0; index < (signed)num_potential_rigid_contacts; index++) {
+    for (int i = (signed)first; i < (signed)num_potential_rigid_contacts; i++) {
+        uint index = use_batches ? batch_order[i] : i;
         uint ID_A, ID_B, icoll;
 
         int nC;
@@ -258,8 +267,12 @@ void ChCNarrowphaseDispatch::DispatchHybridMPR() {
 
     double default_eff_radius = ChCollisionInfo::GetDefaultEffectiveCurvatureRadius();
 
+    // Pairs processed in batches are skipped
+    uint first = use_batches ? batch_start[RBATCH_NONE] : 0;
+
 #pragma omp parallel for private(shapeA, shapeB)
-    for (int index = 0; index < (signed)num_potential_rigid_contacts; index++) {
+    for (int i = (signed)first; i < (signed)num_potential_rigid_contacts; i++) {
+        uint index = use_batches ? batch_order[i] : i;
         uint ID_A, ID_B, icoll;
 
         int nC;
@@ -279,6 +292,132 @@ void ChCNarrowphaseDispatch::DispatchHybridMPR() {
     }
 }
 
+void ChCNarrowphaseDispatch::SortPairsByType() {
+    // shape type (per shape)
+    const shape_type* obj_data_T = data_manager->shape_data.typ_rigid.data();
+    // encoded shape IDs (per collision pair)
+    const long long* collision_pair = data_manager->host_data.contact_pairs.data();
+
+    batch_key.resize(num_potential_rigid_contacts);
+    batch_order.resize(num_potential_rigid_contacts);
+
+#pragma omp parallel for
+    for (int index = 0; index < (signed)num_potential_rigid_contacts; index++) {
+        vec2 pair = I2(int(collision_pair[index] >> 32), int(collision_pair[index] & 0xffffffff));
+        bool swap;
+        batch_key[index] = RBatchClassify(obj_data_T[pair.x], obj_data_T[pair.y], swap);
+    }
+
+    // Sort the pairs by batch; the pairs processed one at a time come last
+    Thrust_Sequence(batch_order);
+    Thrust_Sort_By_Key(batch_key, batch_order);
+
+    for (int type = 0; type <= RBATCH_NONE; type++) {
+        batch_start[type] =
+            (uint)(thrust::lower_bound(THRUST_PAR batch_key.begin(), batch_key.end(), type) - batch_key.begin());
+    }
+    data_manager->measures.collision.number_of_batched_pairs = batch_start[RBATCH_NONE];
+}
+
+void ChCNarrowphaseDispatch::DispatchBatchedR() {
+    const shape_container& shape_data = data_manager->shape_data;
+    const custom_vector<long long>& contact_pair = data_manager->host_data.contact_pairs;
+
+    real3* norm = data_manager->host_data.norm_rigid_rigid.data();
+    real3* ptA = data_manager->host_data.cpta_rigid_rigid.data();
+    real3* ptB = data_manager->host_data.cptb_rigid_rigid.data();
+    real* contactDepth = data_manager->host_data.dpth_rigid_rigid.data();
+    real* effective_radius = data_manager->host_data.erad_rigid_rigid.data();
+
+    RBatch batch;
+
+    for (int type = 0; type < RBATCH_NONE; type++) {
+        int start = (int)batch_start[type];
+        int count = (int)batch_start[type + 1] - start;
+        int num_packs = (count + RBatch::width - 1) / RBatch::width;
+
+#pragma omp parallel for private(batch)
+        for (int pack = 0; pack < num_packs; pack++) {
+            uint index[RBatch::width];
+            vec2 pair[RBatch::width];
+            bool swap[RBatch::width];
+
+            // Gather the shape data of the pairs in the pack, with the sphere as second shape.
+            // The last pack is padded with copies of the last pair of the batch.
+            for (int l = 0; l < RBatch::width; l++) {
+                index[l] = batch_order[start + std::min(pack * RBatch::width + l, count - 1)];
+                long long p = contact_pair[index[l]];
+                pair[l] = I2(int(p >> 32), int(p & 0xffffffff));
+                RBatchClassify(shape_data.typ_rigid[pair[l].x], shape_data.typ_rigid[pair[l].y], swap[l]);
+
+                int shape1 = swap[l] ? pair[l].y : pair[l].x;
+                int shape2 = swap[l] ? pair[l].x : pair[l].y;
+                int start1 = shape_data.start_rigid[shape1];
+                real3 pos1 = shape_data.obj_data_A_global[shape1];
+                real3 pos2 = shape_data.obj_data_A_global[shape2];
+                quaternion rot1 = shape_data.obj_data_R_global[shape1];
+                batch.pos1[0][l] = pos1.x;
+                batch.pos1[1][l] = pos1.y;
+                batch.pos1[2][l] = pos1.z;
+                batch.rot1[0][l] = rot1.w;
+                batch.rot1[1][l] = rot1.x;
+                batch.rot1[2][l] = rot1.y;
+                batch.rot1[3][l] = rot1.z;
+                batch.pos2[0][l] = pos2.x;
+                batch.pos2[1][l] = pos2.y;
+                batch.pos2[2][l] = pos2.z;
+                batch.radius2[l] = shape_data.sphere_rigid[shape_data.start_rigid[shape2]];
+
+                switch (type) {
+                    case RBATCH_SPHERE_SPHERE:
+                        batch.dims1[0][l] = shape_data.sphere_rigid[start1];
+                        break;
+                    case RBATCH_BOX_SPHERE: {
+                        real3 hdims = shape_data.box_like_rigid[start1];
+                        batch.dims1[0][l] = hdims.x;
+                        batch.dims1[1][l] = hdims.y;
+                        batch.dims1[2][l] = hdims.z;
+                    } break;
+                    case RBATCH_CAPSULE_SPHERE: {
+                        real2 capsule = shape_data.capsule_rigid[start1];
+                        batch.dims1[0][l] = capsule.x;
+                        batch.dims1[1][l] = capsule.y;
+                    } break;
+                }
+            }
+
+            switch (type) {
+                case RBATCH_SPHERE_SPHERE:
+                    sphere_sphere(batch, 2 * collision_envelope);
+                    break;
+                case RBATCH_BOX_SPHERE:
+                    box_sphere(batch, 2 * collision_envelope);
+                    break;
+                case RBATCH_CAPSULE_SPHERE:
+                    capsule_sphere(batch, 2 * collision_envelope);
+                    break;
+            }
+
+            // Scatter the contacts, with the normal and the contact points in the order of the original pair.
+            int num_lanes = std::min(count - pack * RBatch::width, (int)RBatch::width);
+            for (int l = 0; l < num_lanes; l++) {
+                if (!batch.contact[l])
+                    continue;
+                uint icoll = contact_index[index[l]];
+                real3 n(batch.norm[0][l], batch.norm[1][l], batch.norm[2][l]);
+                real3 pt1(batch.pt1[0][l], batch.pt1[1][l], batch.pt1[2][l]);
+                real3 pt2(batch.pt2[0][l], batch.pt2[1][l], batch.pt2[2][l]);
+                norm[icoll] = swap[l] ? -n : n;
+                ptA[icoll] = swap[l] ? pt2 : pt1;
+                ptB[icoll] = swap[l] ? pt1 : pt2;
+                contactDepth[icoll] = batch.depth[l];
+                effective_radius[icoll] = batch.eff_radius[l];
+                Dispatch_Finalize(icoll, shape_data.id_rigid[pair[l].x], shape_data.id_rigid[pair[l].y], 1);
+            }
+        }
+    }
+}
+
 void ChCNarrowphaseDispatch::DispatchRigid() {
     LOG(TRACE) << "ChCNarrowphaseDispatch::DispatchRigid() S";
     custom_vector<real3>& norm_data = data_manager->host_data.norm_rigid_rigid;
@@ -313,6 +452,13 @@ void ChCNarrowphaseDispatch::DispatchRigid() {
     contact_rigid_active.resize(num_potentialContacts);
     thrust::fill(contact_rigid_active.begin(), contact_rigid_active.end(), false);
 
+    // Process the sphere-sphere, box-sphere, and capsule-sphere pairs in SIMD packs;
+    // the other pairs are then processed one at a time.
+    if (use_batches) {
+        SortPairsByType();
+        DispatchBatchedR();
+    }
+
     switch (narrowphase_algorithm) {
         case NarrowPhaseType::NARROWPHASE_MPR:
             DispatchMPR();
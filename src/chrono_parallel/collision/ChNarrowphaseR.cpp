@@ -22,6 +22,15 @@
 #include "chrono_parallel/collision/ChNarrowphaseR.h"
 #include "chrono_parallel/collision/ChNarrowphaseRUtils.h"
 
+#include "chrono_parallel/math/sse.h"
+#if defined(USE_SSE)
+#include "chrono_parallel/math/simd_sse.h"
+#elif defined(USE_AVX)
+#include "chrono_parallel/math/simd_avx.h"
+#else
+#include "chrono_parallel/math/simd_non.h"
+#endif
+
 namespace chrono {
 namespace collision {
 
@@ -936,5 +945,220 @@ int box_box(const real3& pos1,
     return 0;
 }
 
+// =============================================================================
+//              BATCHED COLLISION FUNCTIONS
+
+// The batched functions process the pairs of an RBatch in groups of
+// simd::packed_width lanes (4 with AVX or SSE, 1 otherwise), following the
+// same steps as the corresponding single-pair functions above.
+
+typedef decltype(simd::Broadcast(real(0))) packed;
+typedef decltype(simd::LessThan(packed(), packed())) packed_mask;
+
+struct packed3 {
+    packed x, y, z;
+};
+
+static inline packed3 Load3(const real (&v)[3][RBatch::width], int l) {
+    return {simd::Load(&v[0][l]), simd::Load(&v[1][l]), simd::Load(&v[2][l])};
+}
+
+static inline void Store3(real (&v)[3][RBatch::width], int l, const packed3& a) {
+    simd::Store(&v[0][l], a.x);
+    simd::Store(&v[1][l], a.y);
+    simd::Store(&v[2][l], a.z);
+}
+
+static inline packed3 Add3(const packed3& a, const packed3& b) {
+    return {simd::Add(a.x, b.x), simd::Add(a.y, b.y), simd::Add(a.z, b.z)};
+}
+
+static inline packed3 Sub3(const packed3& a, const packed3& b) {
+    return {simd::Sub(a.x, b.x), simd::Sub(a.y, b.y), simd::Sub(a.z, b.z)};
+}
+
+static inline packed3 Scale3(const packed3& a, packed s) {
+    return {simd::Mul(a.x, s), simd::Mul(a.y, s), simd::Mul(a.z, s)};
+}
+
+static inline packed3 Div3(const packed3& a, packed s) {
+    return {simd::Div(a.x, s), simd::Div(a.y, s), simd::Div(a.z, s)};
+}
+
+static inline packed Dot3(const packed3& a, const packed3& b) {
+    return simd::Add(simd::Add(simd::Mul(a.x, b.x), simd::Mul(a.y, b.y)), simd::Mul(a.z, b.z));
+}
+
+static inline packed3 Cross3(const packed3& a, const packed3& b) {
+    return {simd::Sub(simd::Mul(a.y, b.z), simd::Mul(a.z, b.y)), simd::Sub(simd::Mul(a.z, b.x), simd::Mul(a.x, b.z)),
+            simd::Sub(simd::Mul(a.x, b.y), simd::Mul(a.y, b.x))};
+}
+
+// Rotate v by the quaternion (e0, ev), as in Rotate.
+static inline packed3 Rotate3(const packed3& v, packed e0, const packed3& ev) {
+    packed3 t = Scale3(Cross3(ev, v), simd::Broadcast(2));
+    return Add3(Add3(v, Scale3(t, e0)), Cross3(ev, t));
+}
+
+static inline void StoreContact(RBatch& batch, int l, packed_mask contact) {
+    for (int k = 0; k < simd::packed_width; k++)
+        batch.contact[l + k] = simd::IsSet(contact, k);
+}
+
+// Sphere-sphere narrow phase collision detection, on a pack of pairs.
+
+void sphere_sphere(RBatch& batch, real separation) {
+    const packed sep = simd::Broadcast(separation);
+    const packed eps = simd::Broadcast(real(1e-12));
+
+    for (int l = 0; l < RBatch::width; l += simd::packed_width) {
+        packed3 pos1 = Load3(batch.pos1, l);
+        packed3 pos2 = Load3(batch.pos2, l);
+        packed radius1 = simd::Load(&batch.dims1[0][l]);
+        packed radius2 = simd::Load(&batch.radius2[l]);
+
+        packed3 delta = Sub3(pos2, pos1);
+        packed dist2 = Dot3(delta, delta);
+        packed radSum = simd::Add(radius1, radius2);
+        packed radSum_s = simd::Add(radSum, sep);
+
+        packed_mask contact =
+            simd::And(simd::LessThan(dist2, simd::Mul(radSum_s, radSum_s)), simd::GreaterEqual(dist2, eps));
+        StoreContact(batch, l, contact);
+
+        // Generate contact information (the lanes without contact are discarded).
+        packed dist = simd::Select(contact, simd::SquareRoot(dist2), simd::Broadcast(1));
+        packed3 norm = Div3(delta, dist);
+        Store3(batch.norm, l, norm);
+        Store3(batch.pt1, l, Add3(pos1, Scale3(norm, radius1)));
+        Store3(batch.pt2, l, Sub3(pos2, Scale3(norm, radius2)));
+        simd::Store(&batch.depth[l], simd::Sub(dist, radSum));
+        simd::Store(&batch.eff_radius[l], simd::Div(simd::Mul(radius1, radius2), radSum));
+    }
+}
+
+// Box-sphere narrow phase collision detection, on a pack of pairs.
+
+void box_sphere(RBatch& batch, real separation) {
+    const packed sep = simd::Broadcast(separation);
+    const packed eps = simd::Broadcast(real(1e-12f));
+    const packed edge = simd::Broadcast(edge_radius);
+
+    for (int l = 0; l < RBatch::width; l += simd::packed_width) {
+        packed3 pos1 = Load3(batch.pos1, l);
+        packed3 pos2 = Load3(batch.pos2, l);
+        packed e0 = simd::Load(&batch.rot1[0][l]);
+        packed3 ev = {simd::Load(&batch.rot1[1][l]), simd::Load(&batch.rot1[2][l]), simd::Load(&batch.rot1[3][l])};
+        packed3 hdims1 = Load3(batch.dims1, l);
+        packed radius2 = simd::Load(&batch.radius2[l]);
+
+        // Express the sphere position in the frame of the box.
+        packed3 ev_inv = {simd::Negate(ev.x), simd::Negate(ev.y), simd::Negate(ev.z)};
+        packed3 spherePos = Rotate3(Sub3(pos2, pos1), e0, ev_inv);
+
+        // Snap the sphere position to the surface of the box.
+        packed3 boxPos = {simd::Min(simd::Max(spherePos.x, simd::Negate(hdims1.x)), hdims1.x),
+                          simd::Min(simd::Max(spherePos.y, simd::Negate(hdims1.y)), hdims1.y),
+                          simd::Min(simd::Max(spherePos.z, simd::Negate(hdims1.z)), hdims1.z)};
+        packed_mask snap_x = simd::GreaterThan(simd::Abs(spherePos.x), hdims1.x);
+        packed_mask snap_y = simd::GreaterThan(simd::Abs(spherePos.y), hdims1.y);
+        packed_mask snap_z = simd::GreaterThan(simd::Abs(spherePos.z), hdims1.z);
+
+        packed3 delta = Sub3(spherePos, boxPos);
+        packed dist2 = Dot3(delta, delta);
+        packed radius2_s = simd::Add(radius2, sep);
+
+        packed_mask contact =
+            simd::And(simd::LessThan(dist2, simd::Mul(radius2_s, radius2_s)), simd::GreaterThan(dist2, eps));
+        StoreContact(batch, l, contact);
+
+        // Generate contact information (the lanes without contact are discarded).
+        packed dist = simd::Select(contact, simd::SquareRoot(dist2), simd::Broadcast(1));
+        packed3 norm = Rotate3(Div3(delta, dist), e0, ev);
+        Store3(batch.norm, l, norm);
+        Store3(batch.pt1, l, Add3(pos1, Rotate3(boxPos, e0, ev)));
+        Store3(batch.pt2, l, Sub3(pos2, Scale3(norm, radius2)));
+        simd::Store(&batch.depth[l], simd::Sub(dist, radius2));
+
+        // Contact with an edge or a corner if the sphere center was snapped along more than one axis.
+        packed_mask edge_contact = simd::Or(simd::Or(simd::And(snap_x, snap_y), simd::And(snap_x, snap_z)),
+                                            simd::And(snap_y, snap_z));
+        packed edge_eff_radius = simd::Div(simd::Mul(radius2, edge), simd::Add(radius2, edge));
+        simd::Store(&batch.eff_radius[l], simd::Select(edge_contact, edge_eff_radius, radius2));
+    }
+}
+
+// Capsule-sphere narrow phase collision detection, on a pack of pairs.
+
+void capsule_sphere(RBatch& batch, real separation) {
+    const packed sep = simd::Broadcast(separation);
+    const packed eps = simd::Broadcast(real(1e-12f));
+    const packed one = simd::Broadcast(1);
+    const packed two = simd::Broadcast(2);
+
+    for (int l = 0; l < RBatch::width; l += simd::packed_width) {
+        packed3 pos1 = Load3(batch.pos1, l);
+        packed3 pos2 = Load3(batch.pos2, l);
+        packed e0 = simd::Load(&batch.rot1[0][l]);
+        packed e1 = simd::Load(&batch.rot1[1][l]);
+        packed e2 = simd::Load(&batch.rot1[2][l]);
+        packed e3 = simd::Load(&batch.rot1[3][l]);
+        packed radius1 = simd::Load(&batch.dims1[0][l]);
+        packed hlen1 = simd::Load(&batch.dims1[1][l]);
+        packed radius2 = simd::Load(&batch.radius2[l]);
+
+        // Project the sphere center onto the capsule's centerline (the Y axis of
+        // the capsule frame, as in AMatV) and clamp to the capsule length.
+        packed3 V = {simd::Mul(simd::Sub(simd::Mul(e1, e2), simd::Mul(e0, e3)), two),
+                     simd::Sub(simd::Mul(simd::Add(simd::Mul(e0, e0), simd::Mul(e2, e2)), two), one),
+                     simd::Mul(simd::Add(simd::Mul(e2, e3), simd::Mul(e0, e1)), two)};
+        packed alpha = Dot3(Sub3(pos2, pos1), V);
+        alpha = simd::Min(simd::Max(alpha, simd::Negate(hlen1)), hlen1);
+
+        packed3 loc = Add3(pos1, Scale3(V, alpha));
+
+        packed radSum = simd::Add(radius1, radius2);
+        packed radSum_s = simd::Add(radSum, sep);
+        packed3 delta = Sub3(pos2, loc);
+        packed dist2 = Dot3(delta, delta);
+
+        packed_mask contact =
+            simd::And(simd::LessThan(dist2, simd::Mul(radSum_s, radSum_s)), simd::GreaterThan(dist2, eps));
+        StoreContact(batch, l, contact);
+
+        // Generate contact information (the lanes without contact are discarded).
+        packed dist = simd::Select(contact, simd::SquareRoot(dist2), one);
+        packed3 norm = Div3(delta, dist);
+        Store3(batch.norm, l, norm);
+        Store3(batch.pt1, l, Add3(loc, Scale3(norm, radius1)));
+        Store3(batch.pt2, l, Sub3(pos2, Scale3(norm, radius2)));
+        simd::Store(&batch.depth[l], simd::Sub(dist, radSum));
+        simd::Store(&batch.eff_radius[l], simd::Div(simd::Mul(radius1, radius2), radSum));
+    }
+}
+
+RBatchType RBatchClassify(int typeA, int typeB, bool& swap) {
+    swap = false;
+    if (typeA == SPHERE && typeB == SPHERE)
+        return RBATCH_SPHERE_SPHERE;
+
+    // The sphere goes second in box-sphere and capsule-sphere pairs.
+    int other = typeA;
+    if (typeA == SPHERE) {
+        other = typeB;
+        swap = true;
+    } else if (typeB != SPHERE) {
+        return RBATCH_NONE;
+    }
+
+    if (other == BOX)
+        return RBATCH_BOX_SPHERE;
+    if (other == CAPSULE)
+        return RBATCH_CAPSULE_SPHERE;
+
+    swap = false;
+    return RBATCH_NONE;
+}
+
 }  // end namespace collision
 }  // end namespace chrono
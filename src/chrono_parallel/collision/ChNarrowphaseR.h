@@ -29,6 +29,10 @@
 //
 // Note that some pairs may return more than one contact (e.g., box-box).
 //
+// Sphere-sphere, box-sphere, and capsule-sphere pairs can also be processed in
+// packs of pairs of the same type, in structure-of-arrays form, using the SIMD
+// instruction set selected at configuration (see RBatch).
+//
 // =============================================================================
 
 #pragma once
@@ -193,6 +197,47 @@ bool RCollision(const ConvexBase* shapeA,  ///< first candidate shape
                 int& nC                    ///< [output] number of contacts found
                 );
 
+/// Shape-type combinations processed in batches by the analytical narrowphase.
+enum RBatchType {
+    RBATCH_SPHERE_SPHERE,   ///< sphere vs. sphere
+    RBATCH_BOX_SPHERE,      ///< box vs. sphere
+    RBATCH_CAPSULE_SPHERE,  ///< capsule vs. sphere
+    RBATCH_NONE             ///< any other pair, processed one at a time by RCollision
+};
+
+/// Pack of candidate pairs of the same shape-type combination, in structure-of-arrays form.
+/// The second shape of each pair is a sphere. The results are those of the corresponding
+/// analytical collision function, for each pair of the pack.
+struct RBatch {
+    static const int width = 4;  ///< number of pairs in a pack
+
+    real pos1[3][width];   ///< position of the first shape
+    real rot1[4][width];   ///< orientation of the first shape, as (e0, e1, e2, e3) (box and capsule)
+    real dims1[3][width];  ///< radius (sphere), radius and half-length (capsule), or half-dimensions (box)
+    real pos2[3][width];   ///< center of the sphere
+    real radius2[width];   ///< radius of the sphere
+
+    real norm[3][width];     ///< [output] contact normal
+    real pt1[3][width];      ///< [output] contact point on the first shape
+    real pt2[3][width];      ///< [output] contact point on the sphere
+    real depth[width];       ///< [output] penetration depth
+    real eff_radius[width];  ///< [output] effective contact radius
+    bool contact[width];     ///< [output] true if the pair is in contact
+};
+
+/// Return the batch in which a pair of shapes with the given types is processed.
+/// 'swap' is set if the sphere is the first shape of a box-sphere or capsule-sphere pair.
+RBatchType RBatchClassify(int typeA, int typeB, bool& swap);
+
+/// Batched analytical sphere vs. sphere collision function.
+void sphere_sphere(RBatch& batch, real separation);
+
+/// Batched analytical box vs. sphere collision function.
+void box_sphere(RBatch& batch, real separation);
+
+/// Batched analytical capsule vs. sphere collision function.
+void capsule_sphere(RBatch& batch, real separation);
+
 /// Set the fictitious radius of curvature used for collision with a corner or an edge.
 CH_PARALLEL_API
 void SetDefaultEdgeRadius(real radius);
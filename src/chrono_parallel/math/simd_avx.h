@@ -281,6 +281,43 @@ inline __m256d QuatMult(__m256d a, __m256d b) {
 #endif
 }
 
+// Lane-wise functions for structure-of-arrays batches (one value per lane)
+//========================================================
+static const int packed_width = 4;
+
+inline __m256d Broadcast(real a) {
+    return _mm256_set1_pd(a);
+}
+inline __m256d Load(const real* p) {
+    return _mm256_loadu_pd(p);
+}
+inline void Store(real* p, __m256d a) {
+    _mm256_storeu_pd(p, a);
+}
+inline __m256d LessThan(__m256d a, __m256d b) {
+    return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+}
+inline __m256d GreaterThan(__m256d a, __m256d b) {
+    return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+}
+inline __m256d GreaterEqual(__m256d a, __m256d b) {
+    return _mm256_cmp_pd(a, b, _CMP_GE_OQ);
+}
+inline __m256d And(__m256d a, __m256d b) {
+    return _mm256_and_pd(a, b);
+}
+inline __m256d Or(__m256d a, __m256d b) {
+    return _mm256_or_pd(a, b);
+}
+// Select a where the mask is set, b elsewhere
+inline __m256d Select(__m256d mask, __m256d a, __m256d b) {
+    return _mm256_blendv_pd(b, a, mask);
+}
+inline bool IsSet(__m256d mask, int lane) {
+    return ((_mm256_movemask_pd(mask) >> lane) & 1) != 0;
+}
+//========================================================
+
 inline __m128i Set(int x) {
     return _mm_set1_epi32(x);
 }
@@ -216,6 +216,70 @@ CUDA_HOST_DEVICE inline quaternion Normalize(const quaternion& a) {
     return quaternion(a.w * length, a.x * length, a.y * length, a.z * length);
 }
 
+// Lane-wise functions for structure-of-arrays batches (one value per lane)
+//========================================================
+static const int packed_width = 1;
+
+CUDA_HOST_DEVICE inline real Broadcast(real a) {
+    return a;
+}
+CUDA_HOST_DEVICE inline real Load(const real* p) {
+    return *p;
+}
+CUDA_HOST_DEVICE inline void Store(real* p, real a) {
+    *p = a;
+}
+CUDA_HOST_DEVICE inline real Add(real a, real b) {
+    return a + b;
+}
+CUDA_HOST_DEVICE inline real Sub(real a, real b) {
+    return a - b;
+}
+CUDA_HOST_DEVICE inline real Mul(real a, real b) {
+    return a * b;
+}
+CUDA_HOST_DEVICE inline real Div(real a, real b) {
+    return a / b;
+}
+CUDA_HOST_DEVICE inline real Negate(real a) {
+    return -a;
+}
+CUDA_HOST_DEVICE inline real SquareRoot(real a) {
+    return Sqrt(a);
+}
+CUDA_HOST_DEVICE inline real Abs(real a) {
+    return chrono::Abs(a);
+}
+CUDA_HOST_DEVICE inline real Max(real a, real b) {
+    return chrono::Max(a, b);
+}
+CUDA_HOST_DEVICE inline real Min(real a, real b) {
+    return chrono::Min(a, b);
+}
+CUDA_HOST_DEVICE inline bool LessThan(real a, real b) {
+    return a < b;
+}
+CUDA_HOST_DEVICE inline bool GreaterThan(real a, real b) {
+    return a > b;
+}
+CUDA_HOST_DEVICE inline bool GreaterEqual(real a, real b) {
+    return a >= b;
+}
+CUDA_HOST_DEVICE inline bool And(bool a, bool b) {
+    return a && b;
+}
+CUDA_HOST_DEVICE inline bool Or(bool a, bool b) {
+    return a || b;
+}
+// Select a where the mask is set, b elsewhere
+CUDA_HOST_DEVICE inline real Select(bool mask, real a, real b) {
+    return mask ? a : b;
+}
+CUDA_HOST_DEVICE inline bool IsSet(bool mask, int lane) {
+    return mask;
+}
+//========================================================
+
 CUDA_HOST_DEVICE inline vec3 Set(int x) {
     return vec3(x, x, x);
 }
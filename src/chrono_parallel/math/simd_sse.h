@@ -177,6 +177,43 @@ inline bool IsZero(const real3& v, const real& a) {
     return chrono::Abs(v.x) < a && chrono::Abs(v.y) < a && chrono::Abs(v.z) < a;
 }
 
+// Lane-wise functions for structure-of-arrays batches (one value per lane)
+//========================================================
+static const int packed_width = 4;
+
+inline __m128 Broadcast(real a) {
+    return _mm_set1_ps(a);
+}
+inline __m128 Load(const real* p) {
+    return _mm_loadu_ps(p);
+}
+inline void Store(real* p, __m128 a) {
+    _mm_storeu_ps(p, a);
+}
+inline __m128 LessThan(__m128 a, __m128 b) {
+    return _mm_cmplt_ps(a, b);
+}
+inline __m128 GreaterThan(__m128 a, __m128 b) {
+    return _mm_cmpgt_ps(a, b);
+}
+inline __m128 GreaterEqual(__m128 a, __m128 b) {
+    return _mm_cmpge_ps(a, b);
+}
+inline __m128 And(__m128 a, __m128 b) {
+    return _mm_and_ps(a, b);
+}
+inline __m128 Or(__m128 a, __m128 b) {
+    return _mm_or_ps(a, b);
+}
+// Select a where the mask is set, b elsewhere
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_blendv_ps(b, a, mask);
+}
+inline bool IsSet(__m128 mask, int lane) {
+    return ((_mm_movemask_ps(mask) >> lane) & 1) != 0;
+}
+//========================================================
+
 inline __m128i Set(int x) {
     return _mm_set1_epi32(x);
 }
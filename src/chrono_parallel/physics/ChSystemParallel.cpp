@@ -162,8 +162,6 @@ bool ChSystemParallel::Integrate_Y() {
             bodylist[i]->VariablesQbIncrementPosition(this->GetStep());
             bodylist[i]->VariablesQbSetSpeed(this->GetStep());
 
-            bodylist[i]->Update(ChTime);
-
             // update the position and rotation vectors
             pos_pointer[i] = (real3(bodylist[i]->GetPos().x(), bodylist[i]->GetPos().y(), bodylist[i]->GetPos().z()));
             rot_pointer[i] = (quaternion(bodylist[i]->GetRot().e0(), bodylist[i]->GetRot().e1(),
@@ -171,6 +169,15 @@ bool ChSystemParallel::Integrate_Y() {
         }
     }
 
+    OnRigidBodiesAdvanced();
+
+#pragma omp parallel for
+    for (int i = 0; i < bodylist.size(); i++) {
+        if (data_manager->host_data.active_rigid[i] != 0) {
+            bodylist[i]->Update(ChTime);
+        }
+    }
+
     uint offset = data_manager->num_rigid_bodies * 6;
     ////#pragma omp parallel for
     for (int i = 0; i < (signed)data_manager->num_shafts; i++) {
@@ -157,6 +157,10 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
     int current_threads;
 
   protected:
+    /// Called at the end of a step, once the new rigid body positions and velocities are available (in the bodies
+    /// and in the data manager), but before the bodies and the other physics items are updated.
+    virtual void OnRigidBodiesAdvanced() {}
+
     double old_timer, old_timer_cd;
     bool detect_optimal_threads;
 
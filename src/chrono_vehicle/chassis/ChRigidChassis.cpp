@@ -25,6 +25,7 @@
 
 #include "chrono_vehicle/ChVehicleModelData.h"
 #include "chrono_vehicle/chassis/ChRigidChassis.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 
 namespace chrono {
 namespace vehicle {
@@ -101,8 +102,7 @@ void ChRigidChassis::AddVisualizationAssets(VisualizationType vis) {
         return;
 
     if (vis == VisualizationType::MESH && m_has_mesh) {
-        auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-        trimesh->LoadWavefrontMesh(vehicle::GetDataFile(m_vis_mesh_file), false, false);
+        auto trimesh = ChAssetCache::GetMesh(vehicle::GetDataFile(m_vis_mesh_file), false, false);
         auto trimesh_shape = std::make_shared<ChTriangleMeshShape>();
         trimesh_shape->SetMesh(trimesh);
         trimesh_shape->SetName(m_vis_mesh_name);
@@ -19,8 +19,7 @@
 #include "chrono/physics/ChGlobal.h"
 
 #include "chrono_vehicle/powertrain/SimpleCVTPowertrain.h"
-
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 
 using namespace rapidjson;
 
@@ -30,15 +29,8 @@ namespace vehicle {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 SimpleCVTPowertrain::SimpleCVTPowertrain(const std::string& filename) : ChSimpleCVTPowertrain("") {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    auto doc = ChAssetCache::GetDocument(filename);
+    const Document& d = *doc;
 
     Create(d);
 
@@ -16,12 +16,14 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 
 #include "chrono/assets/ChBoxShape.h"
 #include "chrono/assets/ChTexture.h"
 #include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/physics/ChMaterialSurfaceNSC.h"
 #include "chrono/physics/ChMaterialSurfaceSMC.h"
 #include "chrono/utils/ChUtilsInputOutput.h"
@@ -29,16 +31,175 @@
 #include "chrono_vehicle/ChVehicleModelData.h"
 #include "chrono_vehicle/terrain/RigidTerrain.h"
 
+#include "chrono_vehicle/utils/ChAssetCache.h"
 #include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 #include "chrono_thirdparty/Easy_BMP/EasyBMP.h"
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
 
 using namespace rapidjson;
 
 namespace chrono {
 namespace vehicle {
 
+// -----------------------------------------------------------------------------
+// 2.5D index of a mesh patch.
+// The triangles are expressed in the absolute frame (as positioned when the index
+// was built) and registered in all cells of a uniform (x,y) grid overlapped by
+// their projection. A vertical query only tests the triangles of one cell.
+// As seen by collision detection, each triangle plane is offset along its normal
+// by the sweep sphere radius of the mesh collision shape.
+// -----------------------------------------------------------------------------
+class RigidTerrain::MeshIndex {
+  public:
+    MeshIndex(const geometry::ChTriangleMeshConnected& trimesh, const ChFrame<>& frame, double radius);
+
+    /// Return true if the index is still valid for a patch body with the given frame.
+    bool IsValid(const ChFrame<>& frame) const { return frame.GetCoord() == m_frame.GetCoord(); }
+
+    /// Find the highest triangle above or below (x,y).
+    bool FindPoint(double x, double y, double& height, ChVector<>& normal) const;
+
+  private:
+    struct Triangle {
+        double x0, y0, z0;     // first vertex (z0 includes the sweep sphere offset)
+        double e1x, e1y;       // projected edge v1 - v0
+        double e2x, e2y;       // projected edge v2 - v0
+        double inv_det;        // inverse of the projected (signed) double area
+        ChVector<> normal;     // upward face normal
+    };
+
+    ChFrame<> m_frame;                  // patch body frame when the index was built
+    std::vector<Triangle> m_triangles;  // non-vertical triangles
+    double m_xmin, m_ymin;              // grid origin
+    double m_inv_dx, m_inv_dy;          // inverse cell dimensions
+    int m_nx, m_ny;                     // number of cells
+    std::vector<int> m_cell_start;      // start of each cell in m_cell_triangles (plus end marker)
+    std::vector<int> m_cell_triangles;  // triangle indices, sorted by cell
+};
+
+RigidTerrain::MeshIndex::MeshIndex(const geometry::ChTriangleMeshConnected& trimesh,
+                                   const ChFrame<>& frame,
+                                   double radius)
+    : m_frame(frame) {
+    const std::vector<ChVector<>>& vertices = trimesh.m_vertices;
+    const std::vector<ChVector<int>>& faces = trimesh.m_face_v_indices;
+
+    std::vector<ChVector<>> vabs(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+        vabs[i] = frame.TransformPointLocalToParent(vertices[i]);
+
+    // Projected bounding box of each triangle; vertical triangles cannot be hit by a vertical ray.
+    std::vector<ChVector2<>> tri_min;
+    std::vector<ChVector2<>> tri_max;
+    m_xmin = m_ymin = 1e300;
+    double xmax = -1e300;
+    double ymax = -1e300;
+    double sum_size = 0;
+    for (const auto& f : faces) {
+        const ChVector<>& v0 = vabs[f[0]];
+        const ChVector<>& v1 = vabs[f[1]];
+        const ChVector<>& v2 = vabs[f[2]];
+
+        Triangle t;
+        t.x0 = v0.x();
+        t.y0 = v0.y();
+        t.z0 = v0.z();
+        t.e1x = v1.x() - v0.x();
+        t.e1y = v1.y() - v0.y();
+        t.e2x = v2.x() - v0.x();
+        t.e2y = v2.y() - v0.y();
+        double det = t.e1x * t.e2y - t.e1y * t.e2x;
+        ChVector<> nrm = Vcross(v1 - v0, v2 - v0);
+        double len = nrm.Length();
+        if (len == 0 || std::abs(det) <= 1e-12 * len)
+            continue;
+        t.inv_det = 1 / det;
+        t.normal = (nrm.z() > 0 ? 1 / len : -1 / len) * nrm;
+        t.z0 += radius / t.normal.z();
+        m_triangles.push_back(t);
+
+        ChVector2<> bmin(std::min({v0.x(), v1.x(), v2.x()}), std::min({v0.y(), v1.y(), v2.y()}));
+        ChVector2<> bmax(std::max({v0.x(), v1.x(), v2.x()}), std::max({v0.y(), v1.y(), v2.y()}));
+        tri_min.push_back(bmin);
+        tri_max.push_back(bmax);
+        m_xmin = std::min(m_xmin, bmin.x());
+        m_ymin = std::min(m_ymin, bmin.y());
+        xmax = std::max(xmax, bmax.x());
+        ymax = std::max(ymax, bmax.y());
+        sum_size += (bmax.x() - bmin.x()) + (bmax.y() - bmin.y());
+    }
+
+    int num_triangles = (int)m_triangles.size();
+    if (num_triangles == 0) {
+        m_nx = m_ny = 0;
+        m_inv_dx = m_inv_dy = 0;
+        return;
+    }
+
+    // Cells about the size of an average triangle, with at most ~4 cells per triangle overall
+    double cell = std::max(0.5 * sum_size / num_triangles, 1e-6);
+    double lx = std::max(xmax - m_xmin, cell);
+    double ly = std::max(ymax - m_ymin, cell);
+    double scale = std::max(1.0, std::sqrt(lx * ly / (cell * cell) / (4.0 * num_triangles)));
+    m_nx = std::max(1, (int)std::ceil(lx / (cell * scale)));
+    m_ny = std::max(1, (int)std::ceil(ly / (cell * scale)));
+    m_inv_dx = m_nx / lx;
+    m_inv_dy = m_ny / ly;
+
+    auto cell_x = [this](double x) { return std::min(std::max((int)((x - m_xmin) * m_inv_dx), 0), m_nx - 1); };
+    auto cell_y = [this](double y) { return std::min(std::max((int)((y - m_ymin) * m_inv_dy), 0), m_ny - 1); };
+
+    // Bin the triangles (counting pass, then filling pass)
+    m_cell_start.assign(m_nx * m_ny + 1, 0);
+    for (int it = 0; it < num_triangles; it++) {
+        for (int iy = cell_y(tri_min[it].y()); iy <= cell_y(tri_max[it].y()); iy++)
+            for (int ix = cell_x(tri_min[it].x()); ix <= cell_x(tri_max[it].x()); ix++)
+                m_cell_start[iy * m_nx + ix + 1]++;
+    }
+    for (int ic = 0; ic < m_nx * m_ny; ic++)
+        m_cell_start[ic + 1] += m_cell_start[ic];
+    m_cell_triangles.resize(m_cell_start.back());
+    std::vector<int> fill(m_cell_start.begin(), m_cell_start.end() - 1);
+    for (int it = 0; it < num_triangles; it++) {
+        for (int iy = cell_y(tri_min[it].y()); iy <= cell_y(tri_max[it].y()); iy++)
+            for (int ix = cell_x(tri_min[it].x()); ix <= cell_x(tri_max[it].x()); ix++)
+                m_cell_triangles[fill[iy * m_nx + ix]++] = it;
+    }
+}
+
+bool RigidTerrain::MeshIndex::FindPoint(double x, double y, double& height, ChVector<>& normal) const {
+    if (m_nx == 0)
+        return false;
+
+    double fx = (x - m_xmin) * m_inv_dx;
+    double fy = (y - m_ymin) * m_inv_dy;
+    if (fx < 0 || fy < 0 || fx > m_nx || fy > m_ny)
+        return false;
+    int ic = std::min((int)fy, m_ny - 1) * m_nx + std::min((int)fx, m_nx - 1);
+
+    // Tolerance on the barycentric coordinates, so that points on shared edges are not missed
+    const double eps = 1e-10;
+
+    bool hit = false;
+    for (int k = m_cell_start[ic]; k < m_cell_start[ic + 1]; k++) {
+        const Triangle& t = m_triangles[m_cell_triangles[k]];
+        double px = x - t.x0;
+        double py = y - t.y0;
+        double b1 = (px * t.e2y - py * t.e2x) * t.inv_det;
+        double b2 = (t.e1x * py - t.e1y * px) * t.inv_det;
+        if (b1 < -eps || b2 < -eps || b1 + b2 > 1 + eps)
+            continue;
+        double z = t.z0 - (t.normal.x() * px + t.normal.y() * py) / t.normal.z();
+        if (!hit || z > height) {
+            hit = true;
+            height = z;
+            normal = t.normal;
+        }
+    }
+
+    return hit;
+}
+
 // -----------------------------------------------------------------------------
 // Default constructor.
 // -----------------------------------------------------------------------------
@@ -51,15 +212,8 @@ RigidTerrain::RigidTerrain(ChSystem* system)
 RigidTerrain::RigidTerrain(ChSystem* system, const std::string& filename)
     : m_system(system), m_num_patches(0), m_use_friction_functor(false), m_contact_callback(nullptr) {
     // Open the JSON file and read data
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    auto doc = ChAssetCache::GetDocument(filename);
+    const Document& d = *doc;
 
     // Read top-level data
     assert(d.HasMember("Type"));
@@ -165,6 +319,7 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>&
     patch->m_body->SetBodyFixed(true);
     patch->m_body->SetCollide(true);
     m_system->AddBody(patch->m_body);
+    patch->m_radius = 0;
 
     // Initialize contact material properties
     patch->m_friction = 0.7f;
@@ -218,6 +373,7 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>&
         patch->m_body->GetCollisionModel()->AddBox(0.5 * size.x(), 0.5 * size.y(), 0.5 * size.z());
     }
     patch->m_body->GetCollisionModel()->BuildModel();
+    patch->m_size = size;
 
     // Create visualization asset
     if (visualization) {
@@ -242,14 +398,16 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>&
     auto patch = AddPatch(position);
 
     // Load mesh from file
-    patch->m_trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-    patch->m_trimesh->LoadWavefrontMesh(mesh_file, true, true);
+    patch->m_trimesh = ChAssetCache::GetMesh(mesh_file, true, true);
 
     // Create the collision model
     patch->m_body->GetCollisionModel()->ClearModel();
     patch->m_body->GetCollisionModel()->AddTriangleMesh(patch->m_trimesh, true, false, VNULL, ChMatrix33<>(1),
                                                         sweep_sphere_radius);
     patch->m_body->GetCollisionModel()->BuildModel();
+    patch->m_radius = sweep_sphere_radius;
+    patch->m_index =
+        std::make_shared<MeshIndex>(*patch->m_trimesh, patch->m_body->GetFrame_REF_to_abs(), patch->m_radius);
 
     // Create the visualization asset.
     if (visualization) {
@@ -388,6 +546,8 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>&
     patch->m_body->GetCollisionModel()->ClearModel();
     patch->m_body->GetCollisionModel()->AddTriangleMesh(patch->m_trimesh, true, false, ChVector<>(0, 0, 0));
     patch->m_body->GetCollisionModel()->BuildModel();
+    patch->m_index =
+        std::make_shared<MeshIndex>(*patch->m_trimesh, patch->m_body->GetFrame_REF_to_abs(), patch->m_radius);
 
     // Create the visualization asset.
     if (visualization) {
@@ -566,24 +726,74 @@ void RigidTerrain::Initialize() {
 // -----------------------------------------------------------------------------
 // Functions for obtaining the terrain height, normal, and coefficient of
 // friction  at the specified location.
-// This is done by casting vertical rays into each patch collision model.
+// Mesh and height-map patches are queried through their 2.5D index; box patches
+// are intersected analytically with the vertical line. A vertical ray is cast
+// into the patch collision model only if a mesh patch was moved after creation.
 // -----------------------------------------------------------------------------
+bool RigidTerrain::Patch::FindPoint(double x, double y, double& height, ChVector<>& normal) const {
+    const ChFrame<>& frame = m_body->GetFrame_REF_to_abs();
+
+    if (m_type == BOX) {
+        // Intersect the downward vertical line with the box, in the box frame (slab method)
+        ChVector<> from = frame.TransformPointParentToLocal(ChVector<>(x, y, 1000));
+        ChVector<> dir = frame.TransformDirectionParentToLocal(ChVector<>(0, 0, -1));
+        ChVector<> hlen = 0.5 * m_size;
+        double t_enter = -1e300;
+        double t_exit = 1e300;
+        int axis_enter = -1;
+        for (int i = 0; i < 3; i++) {
+            if (std::abs(dir[i]) < 1e-12) {
+                if (std::abs(from[i]) > hlen[i])
+                    return false;
+                continue;
+            }
+            double t1 = (-hlen[i] - from[i]) / dir[i];
+            double t2 = (hlen[i] - from[i]) / dir[i];
+            if (t1 > t2)
+                std::swap(t1, t2);
+            if (t1 > t_enter) {
+                t_enter = t1;
+                axis_enter = i;
+            }
+            t_exit = std::min(t_exit, t2);
+        }
+        if (axis_enter < 0 || t_enter > t_exit || t_enter < 0 || t_enter > 2000)
+            return false;
+
+        ChVector<> nrm_loc(0, 0, 0);
+        nrm_loc[axis_enter] = (dir[axis_enter] > 0) ? -1 : 1;
+        height = 1000 - t_enter;
+        normal = frame.TransformDirectionLocalToParent(nrm_loc);
+        return true;
+    }
+
+    if (m_index && m_index->IsValid(frame))
+        return m_index->FindPoint(x, y, height, normal);
+
+    collision::ChCollisionSystem::ChRayhitResult result;
+    m_body->GetSystem()->GetCollisionSystem()->RayHit(ChVector<>(x, y, 1000), ChVector<>(x, y, -1000),
+                                                      m_body->GetCollisionModel().get(), result);
+    if (!result.hit)
+        return false;
+
+    height = result.abs_hitPoint.z();
+    normal = result.abs_hitNormal;
+    return true;
+}
+
 bool RigidTerrain::FindPoint(double x, double y, double& height, ChVector<>& normal, float& friction) const {
     bool hit = false;
     height = -1000;
     normal = ChVector<>(0, 0, 1);
     friction = 0.8f;
 
-    ChVector<> from(x, y, 1000);
-    ChVector<> to(x, y, -1000);
-
-    for (auto patch : m_patches) {
-        collision::ChCollisionSystem::ChRayhitResult result;
-        m_system->GetCollisionSystem()->RayHit(from, to, patch->m_body->GetCollisionModel().get(), result);
-        if (result.hit && result.abs_hitPoint.z() > height) {
+    for (auto& patch : m_patches) {
+        double patch_height;
+        ChVector<> patch_normal;
+        if (patch->FindPoint(x, y, patch_height, patch_normal) && patch_height > height) {
             hit = true;
-            height = result.abs_hitPoint.z();
-            normal = result.abs_hitNormal;
+            height = patch_height;
+            normal = patch_normal;
             friction = patch->m_friction;
         }
     }
@@ -624,6 +834,28 @@ float RigidTerrain::GetCoefficientFriction(double x, double y) const {
     return friction;
 }
 
+void RigidTerrain::GetProperties(const std::vector<ChVector2<>>& loc,
+                                 std::vector<double>& height,
+                                 std::vector<ChVector<>>& normal,
+                                 std::vector<float>& friction) const {
+    int num_points = (int)loc.size();
+    height.resize(num_points);
+    normal.resize(num_points);
+    friction.resize(num_points);
+
+    ChTaskScheduler::GetInstance().ParallelFor(0, num_points, 64, [&](int from, int to) {
+        for (int i = from; i < to; i++) {
+            double x = loc[i].x();
+            double y = loc[i].y();
+            bool hit = FindPoint(x, y, height[i], normal[i], friction[i]);
+            if (!hit)
+                height[i] = 0.0;
+            if (m_friction_fun)
+                friction[i] = (*m_friction_fun)(x, y);
+        }
+    });
+}
+
 // -----------------------------------------------------------------------------
 // Export all patch meshes as macros in PovRay include files.
 // -----------------------------------------------------------------------------
@@ -19,11 +19,13 @@
 #ifndef RIGID_TERRAIN_H
 #define RIGID_TERRAIN_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "chrono/assets/ChColor.h"
 #include "chrono/assets/ChColorAsset.h"
+#include "chrono/core/ChVector2.h"
 #include "chrono/geometry/ChTriangleMeshConnected.h"
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChSystem.h"
@@ -48,6 +50,9 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
   public:
     enum Type { BOX, MESH, HEIGHT_MAP };
 
+    /// Uniform 2.5D grid over the triangles of a mesh patch, used for fast vertical queries.
+    class MeshIndex;
+
     class CH_VEHICLE_API Patch {
       public:
         /// Set coefficient of friction.
@@ -94,9 +99,15 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
         std::shared_ptr<ChBody> GetGroundBody() const;
 
       private:
+        /// Find the highest intersection of the vertical line at (x,y) with this patch.
+        bool FindPoint(double x, double y, double& height, ChVector<>& normal) const;
+
         Type m_type;
         std::shared_ptr<ChBody> m_body;
         std::shared_ptr<geometry::ChTriangleMeshConnected> m_trimesh;
+        std::shared_ptr<MeshIndex> m_index;  ///< 2.5D search grid over the mesh triangles (MESH and HEIGHT_MAP)
+        ChVector<> m_size;                   ///< box dimensions (BOX)
+        double m_radius;                     ///< sweep sphere radius of the collision mesh (MESH)
         std::string m_mesh_name;
         float m_friction;
 
@@ -126,10 +137,12 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     );
 
     /// Add a terrain patch represented by a triangular mesh.
-    /// The mesh is specified through a Wavefront file and is used for both contact and visualization.
+    /// The mesh is specified through a Wavefront file (or a file in the Chrono binary mesh format) and is used for
+    /// both contact and visualization. The terrain height and normal reported for this patch are those of the
+    /// mesh surface inflated by the sweep sphere radius, as seen by the collision detection.
     std::shared_ptr<Patch> AddPatch(
         const ChCoordsys<>& position,    ///< [in] patch location and orientation
-        const std::string& mesh_file,    ///< [in] filename of the input mesh (OBJ)
+        const std::string& mesh_file,    ///< [in] filename of the input mesh (OBJ or binary)
         const std::string& mesh_name,    ///< [in] name of the mesh asset
         double sweep_sphere_radius = 0,  ///< [in] radius of sweep sphere
         bool visualization = true        ///< [in] enable/disable construction of visualization assets
@@ -179,6 +192,17 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     /// See UseLocationDependentFriction.
     virtual float GetCoefficientFriction(double x, double y) const override;
 
+    /// Get the terrain height, normal, and coefficient of friction at the specified (x,y) locations.
+    /// The output vectors are resized to the number of query points. Locations outside all patches are
+    /// reported with zero height and a vertical normal, as in GetHeight and GetNormal.
+    /// Queries on mesh and height-map patches use a precomputed 2.5D grid over the mesh triangles;
+    /// this function and the single-point queries are thread-safe.
+    void GetProperties(const std::vector<ChVector2<>>& loc,  ///< [in] query (x,y) locations
+                       std::vector<double>& height,          ///< [out] terrain heights
+                       std::vector<ChVector<>>& normal,      ///< [out] terrain normals
+                       std::vector<float>& friction          ///< [out] coefficients of friction
+                       ) const;
+
     /// Export all patch meshes as macros in PovRay include files.
     void ExportMeshPovray(const std::string& out_dir);
 
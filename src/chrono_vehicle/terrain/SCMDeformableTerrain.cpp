@@ -17,14 +17,16 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
-#include <queue>
 
 #include "chrono/physics/ChMaterialSurfaceNSC.h"
 #include "chrono/physics/ChMaterialSurfaceSMC.h"
 #include "chrono/assets/ChTexture.h"
 #include "chrono/assets/ChBoxShape.h"
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/utils/ChConvexHull.h"
 
 #include "chrono_vehicle/ChVehicleModelData.h"
@@ -205,6 +207,8 @@ void SCMDeformableTerrain::PrintStepStatistics(std::ostream& os) const {
     os << " Timers:" << std::endl;
     os << "   Calculate areas:         " << m_ground->m_timer_calc_areas() << std::endl;
     os << "   Ray casting:             " << m_ground->m_timer_ray_casting() << std::endl;
+    os << "   Contact patches:         " << m_ground->m_timer_contact_patches() << std::endl;
+    os << "   Contact forces:          " << m_ground->m_timer_contact_forces() << std::endl;
     if (m_ground->do_refinement)
         os << "   Refinements:             " << m_ground->m_timer_refinement() << std::endl;
     if (m_ground->do_bulldozing)
@@ -214,6 +218,7 @@ void SCMDeformableTerrain::PrintStepStatistics(std::ostream& os) const {
     os << " Counters:" << std::endl;
     os << "   Number vertices:         " << m_ground->m_num_vertices << std::endl;
     os << "   Number ray-casts:        " << m_ground->m_num_ray_casts << std::endl;
+    os << "   Number ray-hits:         " << m_ground->m_num_ray_hits << std::endl;
     os << "   Number faces:            " << m_ground->m_num_faces << std::endl;
     if (m_ground->do_refinement)
         os << "   Number faces refinement: " << m_ground->m_num_marked_faces << std::endl;
@@ -271,6 +276,7 @@ SCMDeformableSoil::SCMDeformableSoil(ChSystem* system) {
 // Initialize the terrain as a flat grid
 void SCMDeformableSoil::Initialize(double height, double sizeX, double sizeY, int nX, int nY) {
     m_trimesh_shape->GetMesh()->Clear();
+    tri_map.clear();
     // Readability aliases
     auto trimesh = m_trimesh_shape->GetMesh();
     std::vector<ChVector<> >& vertices = trimesh->getCoordsVertices();
@@ -331,10 +337,17 @@ void SCMDeformableSoil::Initialize(double height, double sizeX, double sizeY, in
     SetupAuxData();
 }
 
-// Initialize the terrain from a specified .obj mesh file.
+// Initialize the terrain from a specified mesh file (Wavefront .obj or Chrono binary format).
 void SCMDeformableSoil::Initialize(const std::string& mesh_file) {
     m_trimesh_shape->GetMesh()->Clear();
-    m_trimesh_shape->GetMesh()->LoadWavefrontMesh(mesh_file, true, true);
+    tri_map.clear();
+    if (geometry::ChTriangleMeshConnected::IsBinaryMeshFile(mesh_file)) {
+        // use the map of neighboring triangles, if saved in the file
+        if (!m_trimesh_shape->GetMesh()->LoadBinaryMesh(mesh_file, true, true, &tri_map))
+            throw ChException("Cannot read binary mesh file " + mesh_file);
+    } else {
+        m_trimesh_shape->GetMesh()->LoadWavefrontMesh(mesh_file, true, true);
+    }
 
     // Precompute aux. topology data structures for the mesh, aux. material data, etc.
     SetupAuxData();
@@ -349,6 +362,7 @@ void SCMDeformableSoil::Initialize(const std::string& heightmap_file,
                               double hMax) {
     auto trimesh = m_trimesh_shape->GetMesh();
     trimesh->Clear();
+    tri_map.clear();
 
     // Read the BMP file nd extract number of pixels.
     BMP hmap;
@@ -490,23 +504,53 @@ void SCMDeformableSoil::SetupAuxData() {
         p_level_initial[i] = p_level[i];
     }
 
-    connected_vertexes.resize( vertices.size() );
-    for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
-        connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][1]);
-        connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][2]);
-        connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][0]);
-        connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][2]);
-        connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][0]);
-        connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][1]);
+    ComputeConnectivity();
+
+    // The map of neighboring triangles may have been loaded with the mesh
+    if (tri_map.size() != idx_vertices.size())
+        m_trimesh_shape->GetMesh()->ComputeNeighbouringTriangleMap(this->tri_map);
+}
+
+// Build the lists of vertices connected to each vertex (sorted, without duplicates).
+void SCMDeformableSoil::ComputeConnectivity() {
+    std::vector<ChVector<int>>& idx_vertices = m_trimesh_shape->GetMesh()->getIndicesVertexes();
+    int num_vertices = (int)m_trimesh_shape->GetMesh()->getCoordsVertices().size();
+
+    // Count the (possibly duplicated) neighbors of each vertex, then fill them in
+    std::vector<int> start(num_vertices + 1, 0);
+    for (const auto& face : idx_vertices) {
+        for (int k = 0; k < 3; ++k)
+            start[face[k] + 1] += 2;
+    }
+    for (int iv = 0; iv < num_vertices; ++iv)
+        start[iv + 1] += start[iv];
+    std::vector<int> all(start[num_vertices]);
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (const auto& face : idx_vertices) {
+        for (int k = 0; k < 3; ++k) {
+            all[fill[face[k]]++] = face[(k + 1) % 3];
+            all[fill[face[k]]++] = face[(k + 2) % 3];
+        }
     }
 
-    m_trimesh_shape->GetMesh()->ComputeNeighbouringTriangleMap(this->tri_map);
+    // Sort and remove duplicates
+    connected_start.assign(num_vertices + 1, 0);
+    connected_vertexes.clear();
+    connected_vertexes.reserve(all.size() / 2);
+    for (int iv = 0; iv < num_vertices; ++iv) {
+        std::sort(all.begin() + start[iv], all.begin() + start[iv + 1]);
+        auto last = std::unique(all.begin() + start[iv], all.begin() + start[iv + 1]);
+        connected_vertexes.insert(connected_vertexes.end(), all.begin() + start[iv], last);
+        connected_start[iv + 1] = (int)connected_vertexes.size();
+    }
 }
 
 // Reset the list of forces, and fills it with forces from a soil contact model.
 void SCMDeformableSoil::ComputeInternalForces() {
     m_timer_calc_areas.reset();
     m_timer_ray_casting.reset();
+    m_timer_contact_patches.reset();
+    m_timer_contact_forces.reset();
     m_timer_refinement.reset();
     m_timer_bulldozing.reset();
     m_timer_visualization.reset();
@@ -524,6 +568,8 @@ void SCMDeformableSoil::ComputeInternalForces() {
     //
 
     this->GetLoadList().clear();
+    if (GetSystem())
+        GetSystem()->InvalidateDescriptor();
     m_contact_forces.clear();
 
     //
@@ -562,6 +608,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
     
     m_timer_ray_casting.start();
     m_num_ray_casts = 0;
+    m_num_ray_hits = 0;
 
     // If enabled, update the extent of the moving patch (no ray-hit tests performed outside)
     ChVector2<> patch_min;
@@ -574,72 +621,141 @@ void SCMDeformableSoil::ComputeInternalForces() {
         patch_max.y() = center.y() + m_patch_dim.y() / 2;
     }
 
-    // Loop through all vertices.
+    // If possible, collect the bounding boxes (in the reference plane frame) of all collision models that
+    // could be hit by the rays, and cast rays only from vertices below these boxes. This is possible only
+    // if all collision models belong to bodies in the system.
+    bool use_boxes = GetSystem()->Get_meshlist().empty();
+    for (const auto& item : GetSystem()->Get_otherphysicslist()) {
+        if (item.get() != this && (item->GetCollide() || std::dynamic_pointer_cast<ChAssembly>(item)))
+            use_boxes = false;
+    }
+    std::vector<ChVector<>> box_min;
+    std::vector<ChVector<>> box_max;
+    if (use_boxes) {
+        for (const auto& body : GetSystem()->Get_bodylist()) {
+            if (!body->GetCollide())
+                continue;
+            ChVector<> abs_min;
+            ChVector<> abs_max;
+            body->GetCollisionModel()->GetAABB(abs_min, abs_max);
+            ChVector<> loc_min(1e30);
+            ChVector<> loc_max(-1e30);
+            for (int ic = 0; ic < 8; ic++) {
+                ChVector<> corner((ic & 1) ? abs_max.x() : abs_min.x(), (ic & 2) ? abs_max.y() : abs_min.y(),
+                                  (ic & 4) ? abs_max.z() : abs_min.z());
+                ChVector<> loc = plane.TransformParentToLocal(corner);
+                loc_min.Set(std::min(loc_min.x(), loc.x()), std::min(loc_min.y(), loc.y()), std::min(loc_min.z(), loc.z()));
+                loc_max.Set(std::max(loc_max.x(), loc.x()), std::max(loc_max.y(), loc.y()), std::max(loc_max.z(), loc.z()));
+            }
+            box_min.push_back(loc_min);
+            box_max.push_back(loc_max);
+        }
+    }
+
+    // Loop through all vertices, in parallel.
     // - set default SCM quantities (in case no ray-hit)
-    // - skip vertices outside moving patch (if option enabled)
-    // - cast ray and record result in a map (key: vertex index)
-    // - initialize patch id to -1 (not set)
-    struct HitRecord {
-        ChContactable* contactable;  // pointer to hit object
-        ChVector<> abs_point;        // hit point, expressed in global frame
-        int patch_id;                // index of associated patch id
-    };
-    std::unordered_map<int, HitRecord> hits;
+    // - skip vertices outside moving patch (if option enabled) or not below any bounding box
+    // - cast ray and record result (null contactable if no hit)
+    std::vector<ChContactable*> hit_contactable(vertices.size(), nullptr);
+    std::vector<ChVector<>> hit_point(vertices.size());
+
+    ChTaskScheduler& scheduler = ChTaskScheduler::GetInstance();
+    auto collision_system = GetSystem()->GetCollisionSystem();
+
+    // Bullet ray casts against concave (GImpact) meshes modify the mesh shapes, so they are not thread-safe:
+    // if any collision model in the system uses such meshes, cast all rays from a single thread (one sub-range).
+    auto bullet_system = std::dynamic_pointer_cast<collision::ChCollisionSystemBullet>(collision_system);
+    int ray_grain = 0;
+    if (bullet_system && bullet_system->HasConcaveMeshes())
+        ray_grain = std::max((int)vertices.size(), 1);
+
+    m_num_ray_casts = scheduler.ParallelReduce(
+        0, (int)vertices.size(), ray_grain, (size_t)0,
+        [&](int from, int to, size_t num_casts) {
+            for (int i = from; i < to; ++i) {
+                // Initialize SCM quantities at current vertex
+                ChVector<> v = plane.TransformParentToLocal(vertices[i]);
+                p_sigma[i] = 0;
+                p_sinkage_elastic[i] = 0;
+                p_step_plastic_flow[i] = 0;
+                p_erosion[i] = false;
+                p_level[i] = v.y();
+                p_hit_level[i] = 1e9;
+
+                // Skip vertices outside moving patch
+                if (m_moving_patch) {
+                    if (vertices[i].x() < patch_min.x() || vertices[i].x() > patch_max.x() ||
+                        vertices[i].y() < patch_min.y() || vertices[i].y() > patch_max.y()) {
+                        continue;
+                    }
+                }
 
-    for (int i = 0; i < vertices.size(); ++i) {
-        // Initialize SCM quantities at current vertex
-        p_sigma[i] = 0;
-        p_sinkage_elastic[i] = 0;
-        p_step_plastic_flow[i] = 0;
-        p_erosion[i] = false;
-        p_level[i] = plane.TransformParentToLocal(vertices[i]).y();
-        p_hit_level[i] = 1e9;
+                // Skip vertices whose ray cannot intersect any bounding box
+                if (use_boxes) {
+                    double ray_min = v.y() + test_high_offset - test_low_offset;
+                    double ray_max = v.y() + test_high_offset;
+                    bool below = false;
+                    for (size_t ib = 0; ib < box_min.size() && !below; ++ib) {
+                        below = v.x() >= box_min[ib].x() && v.x() <= box_max[ib].x() && v.z() >= box_min[ib].z() &&
+                                v.z() <= box_max[ib].z() && ray_max >= box_min[ib].y() && ray_min <= box_max[ib].y();
+                    }
+                    if (!below)
+                        continue;
+                }
 
-        // Skip vertices outside moving patch
-        if (m_moving_patch) {
-            if (vertices[i].x() < patch_min.x() || vertices[i].x() > patch_max.x() || vertices[i].y() < patch_min.y() ||
-                vertices[i].y() > patch_max.y()) {
-                continue;
+                // Perform ray casting from current vertex
+                collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
+                ChVector<> to = vertices[i] + N * test_high_offset;
+                ChVector<> from = to - N * test_low_offset;
+                collision_system->RayHit(from, to, mrayhit_result);
+                num_casts++;
+                if (mrayhit_result.hit) {
+                    hit_contactable[i] = mrayhit_result.hitModel->GetContactable();
+                    hit_point[i] = mrayhit_result.abs_hitPoint;
+                }
             }
-        }
+            return num_casts;
+        },
+        [](size_t a, size_t b) { return a + b; });
 
-        // Perform ray casting from current vertex
-        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
-        ChVector<> to = vertices[i] + N * test_high_offset;
-        ChVector<> from = to - N * test_low_offset;
-        this->GetSystem()->GetCollisionSystem()->RayHit(from, to, mrayhit_result);
-        m_num_ray_casts++;
-        if (mrayhit_result.hit) {
-            HitRecord record = { mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1 };
-            hits.insert(std::make_pair(i, record));
-        }
+    // List of hit vertices, in increasing order.
+    std::vector<int> hits;
+    for (int i = 0; i < vertices.size(); ++i) {
+        if (hit_contactable[i])
+            hits.push_back(i);
     }
+    m_num_ray_hits = hits.size();
+
+    m_timer_ray_casting.stop();
+
+    //
+    // Compute the contact patches
+    //
+
+    m_timer_contact_patches.start();
 
     // Loop through all hit vertices and determine to which contact patch they belong.
-    // We use here the connected_vertexes map (from a vertex to its adjacent vertices) which is
+    // We use here the connected_vertexes adjacency lists (from a vertex to its adjacent vertices) which are
     // set up at initialization and updated when the mesh is refined (if refinement is enabled).
     // Use a queue-based flood-filling algorithm.
+    std::vector<int> hit_patch(vertices.size(), -1);
+    std::vector<int> todo;
     int num_patches = 0;
-    for (auto& h : hits) {
-        int i = h.first;
-        if (h.second.patch_id != -1)                               // move on if vertex already assigned to a patch
-            continue;                                              //
-        std::queue<int> todo;                                      //
-        h.second.patch_id = num_patches++;                         // assign this vertex to a new patch
-        todo.push(i);                                              // add vertex to end of queue
-        while (!todo.empty()) {                                    //
-            auto crt = hits.find(todo.front());                    // current vertex is first element in queue
-            todo.pop();                                            // remove first element of queue
-            auto crt_i = crt->first;                               //
-            auto crt_patch = crt->second.patch_id;                 //
-            for (const auto& nbr_i : connected_vertexes[crt_i]) {  // loop over all neighbors
-                auto nbr = hits.find(nbr_i);                       // look for neighbor in list of hit vertices
-                if (nbr == hits.end())                             // move on if neighbor is not a hit vertex
-                    continue;                                      //
-                if (nbr->second.patch_id != -1)                    // (COULD BE REMOVED, unless we update patch area)
-                    continue;                                      //
-                nbr->second.patch_id = crt_patch;                  // assign neighbor to same patch
-                todo.push(nbr_i);                                  // add neighbor to end of queue
+    for (auto i : hits) {
+        if (hit_patch[i] != -1)  // move on if vertex already assigned to a patch
+            continue;
+        int crt_patch = num_patches++;
+        hit_patch[i] = crt_patch;  // assign this vertex to a new patch
+        todo.clear();
+        todo.push_back(i);  // add vertex to end of queue
+        for (size_t k = 0; k < todo.size(); ++k) {
+            int crt_i = todo[k];  // current vertex is next element in queue
+            for (int j = connected_start[crt_i]; j < connected_start[crt_i + 1]; ++j) {  // loop over all neighbors
+                int nbr_i = connected_vertexes[j];
+                if (!hit_contactable[nbr_i] || hit_patch[nbr_i] != -1)  // move on if not a hit vertex or assigned
+                    continue;
+                hit_patch[nbr_i] = crt_patch;  // assign neighbor to same patch
+                todo.push_back(nbr_i);         // add neighbor to end of queue
             }
         }
     }
@@ -652,72 +768,85 @@ void SCMDeformableSoil::ComputeInternalForces() {
         double Kc_b;                      // approximate Bekker Kc/b value
     };
     std::vector<PatchRecord> patches(num_patches);
-    for (auto& h : hits) {
-        ChVector<> v = plane.TransformParentToLocal(vertices[h.first]);
-        patches[h.second.patch_id].points.push_back(ChVector2<>(v.x(), v.z()));
+    for (auto i : hits) {
+        ChVector<> v = plane.TransformParentToLocal(vertices[i]);
+        patches[hit_patch[i]].points.push_back(ChVector2<>(v.x(), v.z()));
     }
 
     // Calculate area and perimeter of each patch.
     // Calculate approximation to Beker term Kc/b.
-    for (auto& p : patches) {
-        if (Bekker_Kc == 0) {
-            p.Kc_b = 0;
-            continue;
-        }
+    scheduler.ParallelFor(0, num_patches, 1, [&](int from, int to) {
+        for (int ip = from; ip < to; ++ip) {
+            auto& p = patches[ip];
+            if (Bekker_Kc == 0) {
+                p.Kc_b = 0;
+                continue;
+            }
 
-        utils::ChConvexHull2D ch(p.points);
-        p.area = ch.GetArea();
-        p.perimeter = ch.GetPerimeter();
-        if (p.area < 1e-6) {
-            p.Kc_b = 0;
-        } else {
-            double b = 2 * p.area / p.perimeter;
-            p.Kc_b = Bekker_Kc / b;
+            utils::ChConvexHull2D ch(p.points);
+            p.area = ch.GetArea();
+            p.perimeter = ch.GetPerimeter();
+            if (p.area < 1e-6) {
+                p.Kc_b = 0;
+            } else {
+                double b = 2 * p.area / p.perimeter;
+                p.Kc_b = Bekker_Kc / b;
+            }
         }
-    }
+    });
 
-    // Process only hit vertices
-    for (auto& h : hits) {
-        int i = h.first;
-        ChContactable* contactable = h.second.contactable;
-        const ChVector<>& abs_point = h.second.abs_point;
-        int patch_id = h.second.patch_id;
+    m_timer_contact_patches.stop();
 
-        double p_hit_offset = 1e9;
+    //
+    // Compute the contact forces
+    //
 
-        p_hit_level[i] = plane.TransformParentToLocal(abs_point).y();
-        p_hit_offset = -p_hit_level[i] + p_level_initial[i];
+    m_timer_contact_forces.start();
 
-        p_speeds[i] = contactable->GetContactPointSpeed(vertices[i]);
+    // Process only hit vertices, in parallel: update the SCM quantities and the mesh, and create
+    // one load per vertex in contact.
+    double step = GetSystem()->GetStep();
+    std::vector<std::shared_ptr<ChLoadBase>> hit_loads(hits.size());
+    std::vector<TerrainForce> hit_force(hits.size());
 
-        ChVector<> T = -p_speeds[i];
-        T = plane.TransformDirectionParentToLocal(T);
-        double Vn = -T.y();
-        T.y() = 0;
-        T = plane.TransformDirectionLocalToParent(T);
-        T.Normalize();
+    scheduler.ParallelFor(0, (int)hits.size(), 0, [&](int from, int to) {
+        for (int k = from; k < to; ++k) {
+            int i = hits[k];
+            ChContactable* contactable = hit_contactable[i];
+            int patch_id = hit_patch[i];
 
-        // Compute i-th force:
-        ChVector<> Fn;
-        ChVector<> Ft;
+            double p_hit_offset = 1e9;
 
-        // Elastic try:
-        p_sigma[i] = elastic_K * (p_hit_offset - p_sinkage_plastic[i]);
+            p_hit_level[i] = plane.TransformParentToLocal(hit_point[i]).y();
+            p_hit_offset = -p_hit_level[i] + p_level_initial[i];
 
-        // Handle unilaterality:
-        if (p_sigma[i] < 0) {
-            p_sigma[i] = 0;
-        } else {
-            // add compressive speed-proportional damping
-            ////if (Vn < 0) {
-            ////    p_sigma[i] += -Vn * this->damping_R;
-            ////}
+            p_speeds[i] = contactable->GetContactPointSpeed(vertices[i]);
+
+            ChVector<> T = -p_speeds[i];
+            T = plane.TransformDirectionParentToLocal(T);
+            double Vn = -T.y();
+            T.y() = 0;
+            T = plane.TransformDirectionLocalToParent(T);
+            T.Normalize();
+
+            // Compute i-th force:
+            ChVector<> Fn;
+            ChVector<> Ft;
+
+            // Elastic try:
+            p_sigma[i] = elastic_K * (p_hit_offset - p_sinkage_plastic[i]);
+
+            // Handle unilaterality:
+            if (p_sigma[i] < 0) {
+                p_sigma[i] = 0;
+                continue;
+            }
 
             p_sinkage[i] = p_hit_offset;
             p_level[i] = p_hit_level[i];
 
             // Accumulate shear for Janosi-Hanamoto
-            p_kshear[i] += Vdot(p_speeds[i], -T) * GetSystem()->GetStep();
+            p_kshear[i] += Vdot(p_speeds[i], -T) * step;
 
             // Plastic correction:
             if (p_sigma[i] > p_sigma_yeld[i]) {
@@ -726,7 +855,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
                 p_sigma_yeld[i] = p_sigma[i];
                 double old_sinkage_plastic = p_sinkage_plastic[i];
                 p_sinkage_plastic[i] = p_sinkage[i] - p_sigma[i] / elastic_K;
-                p_step_plastic_flow[i] = (p_sinkage_plastic[i] - old_sinkage_plastic) / GetSystem()->GetStep();
+                p_step_plastic_flow[i] = (p_sinkage_plastic[i] - old_sinkage_plastic) / step;
             }
 
             p_sinkage_elastic[i] = p_sinkage[i] - p_sinkage_plastic[i];
@@ -750,35 +879,19 @@ void SCMDeformableSoil::ComputeInternalForces() {
                 // object, but an already used pointer because mrayhit_result.hitModel->GetPhysicsItem()
                 // cannot return it as shared_ptr, as needed by the ChLoadBodyForce:
                 std::shared_ptr<ChBody> srigidbody(rigidbody, [](ChBody*) {});
-                std::shared_ptr<ChLoadBodyForce> mload(
-                    new ChLoadBodyForce(srigidbody, Fn + Ft, false, vertices[i], false));
-                this->Add(mload);
-
-                // Accumulate contact force for this rigid body.
-                // The resultant force is assumed to be applied at the body COM.
-                // All components of the generalized terrain force are expressed in the global frame.
-                auto itr = m_contact_forces.find(contactable);
-                if (itr == m_contact_forces.end()) {
-                    // Create new entry and initialize generalized force.
-                    ChVector<> force = Fn + Ft;
-                    TerrainForce frc;
-                    frc.point = srigidbody->GetPos();
-                    frc.force = force;
-                    frc.moment = Vcross(Vsub(vertices[i], srigidbody->GetPos()), force);
-                    m_contact_forces.insert(std::make_pair(contactable, frc));
-                } else {
-                    // Update generalized force.
-                    ChVector<> force = Fn + Ft;
-                    itr->second.force += force;
-                    itr->second.moment += Vcross(Vsub(vertices[i], srigidbody->GetPos()), force);
-                }
+                hit_loads[k] = std::make_shared<ChLoadBodyForce>(srigidbody, Fn + Ft, false, vertices[i], false);
+
+                // Contact force on this rigid body, applied at the body COM (accumulated below).
+                hit_force[k].point = srigidbody->GetPos();
+                hit_force[k].force = Fn + Ft;
+                hit_force[k].moment = Vcross(Vsub(vertices[i], srigidbody->GetPos()), Fn + Ft);
             } else if (ChLoadableUV* surf = dynamic_cast<ChLoadableUV*>(contactable)) {
                 // [](){} Trick: no deletion for this shared ptr
                 std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*) {});
-                std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(new ChLoad<ChLoaderForceOnSurface>(ssurf));
+                auto mload = std::make_shared<ChLoad<ChLoaderForceOnSurface>>(ssurf);
                 mload->loader.SetForce(Fn + Ft);
                 mload->loader.SetApplication(0.5, 0.5);  //***TODO*** set UV, now just in middle
-                this->Add(mload);
+                hit_loads[k] = mload;
 
                 // Accumulate contact forces for this surface.
                 //// TODO
@@ -786,12 +899,42 @@ void SCMDeformableSoil::ComputeInternalForces() {
 
             // Update mesh representation
             vertices[i] = p_vertices_initial[i] - N * p_sinkage[i];
+        }
+    });
 
-        }  // end positive contact force
+    for (auto& mload : hit_loads) {
+        if (mload)
+            this->Add(mload);
+    }
 
-    } // end loop on ray hits
+    // Accumulate contact forces for the rigid bodies (in parallel, with partial results merged in order).
+    // All components of the generalized terrain force are expressed in the global frame.
+    typedef std::unordered_map<ChContactable*, TerrainForce> ForceMap;
+    auto add_force = [](ForceMap& forces, ChContactable* contactable, const TerrainForce& frc) {
+        auto itr = forces.find(contactable);
+        if (itr == forces.end()) {
+            forces.insert(std::make_pair(contactable, frc));
+        } else {
+            itr->second.force += frc.force;
+            itr->second.moment += frc.moment;
+        }
+    };
+    m_contact_forces = scheduler.ParallelReduce(
+        0, (int)hits.size(), 0, ForceMap(),
+        [&](int from, int to, ForceMap forces) {
+            for (int k = from; k < to; ++k) {
+                if (hit_loads[k] && dynamic_cast<ChBody*>(hit_contactable[hits[k]]))
+                    add_force(forces, hit_contactable[hits[k]], hit_force[k]);
+            }
+            return forces;
+        },
+        [&](ForceMap a, const ForceMap& b) {
+            for (const auto& f : b)
+                add_force(a, f.first, f.second);
+            return a;
+        });
 
-    m_timer_ray_casting.stop();
+    m_timer_contact_forces.stop();
 
     //
     // Refine the mesh detail
@@ -865,16 +1008,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
         }
         // TO DO adjust this incrementally
 
-        connected_vertexes.clear();
-        connected_vertexes.resize(vertices.size());
-        for (unsigned int iface = 0; iface < idx_vertices.size(); ++iface) {
-            connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][1]);
-            connected_vertexes[idx_vertices[iface][0]].insert(idx_vertices[iface][2]);
-            connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][0]);
-            connected_vertexes[idx_vertices[iface][1]].insert(idx_vertices[iface][2]);
-            connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][0]);
-            connected_vertexes[idx_vertices[iface][2]].insert(idx_vertices[iface][1]);
-        }
+        ComputeConnectivity();
 
         // Recompute areas (could be optimized)
         for (unsigned int iv = 0; iv < vertices.size(); ++iv) {
@@ -903,63 +1037,68 @@ void SCMDeformableSoil::ComputeInternalForces() {
     m_timer_bulldozing.start();
 
     if (do_bulldozing) {
-        std::set<int> touched_vertexes;
         for (int iv = 0; iv< vertices.size(); ++iv) {
             p_id_island[iv] = 0;
-            if (p_sigma[iv]>0)
-                touched_vertexes.insert(iv);
         }
 
-        std::set<int> domain_boundaries;
+        std::vector<int> domain_boundaries;
 
-        // Compute contact islands (and their displaced material) by flood-filling the mesh
+        // Compute contact islands (and their displaced material) by flood-filling the mesh.
+        // Seeds are the touched vertices not yet assigned to an island, in increasing order.
         int id_island = 0;
-        for (auto fillseed = touched_vertexes.begin(); fillseed != touched_vertexes.end(); fillseed = touched_vertexes.begin()) {
+        std::vector<int> fill_front;
+        std::vector<int> fill_front_2;
+        std::vector<int> boundary;
+        for (int fillseed = 0; fillseed < vertices.size(); ++fillseed) {
+            if (p_sigma[fillseed] <= 0 || p_id_island[fillseed] != 0)
+                continue;
+
             // new island:
             ++id_island;
-            std::set<int> fill_front;
+            fill_front.clear();
+            boundary.clear();
 
-            std::set<int> boundary;
             int n_vert_boundary = 0;
             double tot_area_boundary = 0;
 
             int n_vert_island = 1;
-            double tot_step_flow_island = p_area[*fillseed] * p_step_plastic_flow[*fillseed] * this->GetSystem()->GetStep();
-            double tot_Nforce_island = p_area[*fillseed] * p_sigma[*fillseed];
-            double tot_area_island = p_area[*fillseed];
-            fill_front.insert(*fillseed);
-            p_id_island[*fillseed] = id_island;
-            touched_vertexes.erase(fillseed);
+            double tot_step_flow_island = p_area[fillseed] * p_step_plastic_flow[fillseed] * this->GetSystem()->GetStep();
+            double tot_Nforce_island = p_area[fillseed] * p_sigma[fillseed];
+            double tot_area_island = p_area[fillseed];
+            fill_front.push_back(fillseed);
+            p_id_island[fillseed] = id_island;
             while (fill_front.size() >0) {
                 // fill next front
-                std::set<int> fill_front_2;
+                fill_front_2.clear();
                 for (const auto& ifront : fill_front) {
-                    for (const auto& ivconnect : connected_vertexes[ifront]) {
+                    for (int j = connected_start[ifront]; j < connected_start[ifront + 1]; ++j) {
+                        int ivconnect = connected_vertexes[j];
                         if ((p_sigma[ivconnect]>0) && (p_id_island[ivconnect]==0)) {
                             ++n_vert_island;
                             tot_step_flow_island += p_area[ivconnect] * p_step_plastic_flow[ivconnect] * this->GetSystem()->GetStep();
                             tot_Nforce_island += p_area[ivconnect] * p_sigma[ivconnect];
                             tot_area_island += p_area[ivconnect];
-                            fill_front_2.insert(ivconnect);
+                            fill_front_2.push_back(ivconnect);
                             p_id_island[ivconnect] = id_island;
-                            touched_vertexes.erase(ivconnect);
                         } 
                         else if ((p_sigma[ivconnect] == 0) && (p_id_island[ivconnect] <= 0) && (p_id_island[ivconnect] != -id_island)) {
                             ++n_vert_boundary;
                             tot_area_boundary += p_area[ivconnect];
                             p_id_island[ivconnect] = -id_island; // negative to mark as boundary
-                            boundary.insert(ivconnect);
+                            boundary.push_back(ivconnect);
                         }
                     }
                 }
-                // advance to next front
-                fill_front= fill_front_2;
+                // advance to next front (vertices are unique, as they are marked when added)
+                std::sort(fill_front_2.begin(), fill_front_2.end());
+                fill_front.swap(fill_front_2);
             }
             ////GetLog() << " island " << id_island << " flow volume =" << tot_step_flow_island << " N force=" << tot_Nforce_island << "\n"; 
 
             // Raise the boundary because of material flow (it gives a sharp spike around the
             // island boundary, but later we'll use the erosion algorithm to smooth it out)
 
+            std::sort(boundary.begin(), boundary.end());
             for (const auto& ibv : boundary) {
                 double d_y = bulldozing_flow_factor * ((p_area[ibv]/tot_area_boundary) *  (1/p_area[ibv]) * tot_step_flow_island);
                 double clamped_d_y = d_y; // ChMin(d_y, ChMin(p_hit_level[ibv]-p_level[ibv], test_high_offset) );
@@ -973,37 +1112,47 @@ void SCMDeformableSoil::ComputeInternalForces() {
                 p_vertices_initial[ibv] += N * clamped_d_y;
             }
 
-            domain_boundaries.insert(boundary.begin(), boundary.end());
+            domain_boundaries.insert(domain_boundaries.end(), boundary.begin(), boundary.end());
 
         }  // end for islands
 
+        // A vertex can be on the boundary of more than one island
+        std::sort(domain_boundaries.begin(), domain_boundaries.end());
+        domain_boundaries.erase(std::unique(domain_boundaries.begin(), domain_boundaries.end()), domain_boundaries.end());
+
         //***TEST***
         // int mm = p_massremainder.size();
         // p_massremainder.clear();p_massremainder.resize(mm);
 
         // Erosion domain area select, by topologically dilation of all the
-        // boundaries of the islands:
-        std::set<int> domain_erosion= domain_boundaries;
+        // boundaries of the islands (vertices are unique, as they are marked when added):
+        std::vector<int> domain_erosion = domain_boundaries;
         for (const auto& ie : domain_boundaries)
             p_erosion[ie] = true;
-        std::set<int> front_erosion = domain_boundaries;
+        std::vector<int> front_erosion = domain_boundaries;
+        std::vector<int> front_erosion2;
         for (int iloop = 0; iloop <10; ++iloop) {
-            std::set<int> front_erosion2;
+            front_erosion2.clear();
             for(const auto& is : front_erosion) {
-                for (const auto& ivconnect : connected_vertexes[is]) {
+                for (int j = connected_start[is]; j < connected_start[is + 1]; ++j) {
+                    int ivconnect = connected_vertexes[j];
                     if ((p_id_island[ivconnect]==0) && (p_erosion[ivconnect]==0)) {
-                        front_erosion2.insert(ivconnect);
+                        front_erosion2.push_back(ivconnect);
                         p_erosion[ivconnect] = true;
                     }
                 }
             }
-            domain_erosion.insert(front_erosion2.begin(), front_erosion2.end());
-            front_erosion = front_erosion2;
+            std::sort(front_erosion2.begin(), front_erosion2.end());
+            domain_erosion.insert(domain_erosion.end(), front_erosion2.begin(), front_erosion2.end());
+            front_erosion.swap(front_erosion2);
         }
+        std::sort(domain_erosion.begin(), domain_erosion.end());
         // Erosion smoothing algorithm on domain
         for (int ismo = 0; ismo <3; ++ismo) {
             for (const auto& is : domain_erosion) {
-                for (const auto& ivc : connected_vertexes[is]) {
+                double n_connected = (double)(connected_start[is + 1] - connected_start[is]);
+                for (int j = connected_start[is]; j < connected_start[is + 1]; ++j) {
+                    int ivc = connected_vertexes[j];
                     ChVector<> vis = this->plane.TransformParentToLocal(vertices[is]);
                     // flow remainder material 
                     if (true) {
@@ -1013,7 +1162,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
  
                             // if i higher than c: clamp c upward correction as it might invalidate 
                             // the ceiling constraint, if collision is nearby
-                            double d_y_c = (p_massremainder[is]-p_massremainder[ivc])* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
+                            double d_y_c = (p_massremainder[is]-p_massremainder[ivc])* (1/n_connected) *  p_area[is]/(p_area[is]+p_area[ivc]);
                             clamped_d_y_c = d_y_c; 
                             if (d_y_c > p_hit_level[ivc]-p_level[ivc]) {
                                 p_massremainder[ivc] += d_y_c - (p_hit_level[ivc]-p_level[ivc]);
@@ -1056,7 +1205,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
                             if (dy > 0) { 
                                 // if i higher than c: clamp c upward correction as it might invalidate 
                                 // the ceiling constraint, if collision is nearby
-                                double d_y_c = (fabs(dy)-dy_lim)* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
+                                double d_y_c = (fabs(dy)-dy_lim)* (1/n_connected) *  p_area[is]/(p_area[is]+p_area[ivc]);
                                 clamped_d_y_c = d_y_c; //clamped_d_y_c = ChMin(d_y_c, p_hit_level[ivc]-p_level[ivc] );
                                 if (d_y_c > p_hit_level[ivc]-p_level[ivc]) {
                                     p_massremainder[ivc] += d_y_c - (p_hit_level[ivc]-p_level[ivc]);
@@ -1075,7 +1224,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
                             } else {
                                 // if c higher than i: clamp i upward correction as it might invalidate 
                                 // the ceiling constraint, if collision is nearby
-                                double d_y_i = (fabs(dy)-dy_lim)* (1/(double)connected_vertexes[is].size()) *  p_area[is]/(p_area[is]+p_area[ivc]);
+                                double d_y_i = (fabs(dy)-dy_lim)* (1/n_connected) *  p_area[is]/(p_area[is]+p_area[ivc]);
                                 clamped_d_y_i = d_y_i; 
                                 if (d_y_i > p_hit_level[is]-p_level[is]) {
                                     p_massremainder[is] += d_y_i - (p_hit_level[is]-p_level[is]);
@@ -191,8 +191,8 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
                     );
 
     /// Initialize the terrain system (mesh).
-    /// The initial undeformed mesh is provided via a Wavefront .obj file.
-    void Initialize(const std::string& mesh_file  ///< [in] filename of the input mesh (.OBJ file in Wavefront format)
+    /// The initial undeformed mesh is provided via a Wavefront .obj file (or a file in the Chrono binary mesh format).
+    void Initialize(const std::string& mesh_file  ///< [in] filename of the input mesh (Wavefront .OBJ or binary)
                     );
 
     /// Initialize the terrain system (height map).
@@ -231,8 +231,8 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
                     );
 
     /// Initialize the terrain system (mesh).
-    /// The initial undeformed mesh is provided via a Wavefront .obj file.
-    void Initialize(const std::string& mesh_file  ///< [in] filename of the input mesh (.OBJ file in Wavefront format)
+    /// The initial undeformed mesh is provided via a Wavefront .obj file (or a file in the Chrono binary mesh format).
+    void Initialize(const std::string& mesh_file  ///< [in] filename of the input mesh (Wavefront .OBJ or binary)
                     );
 
     /// Initialize the terrain system (height map).
@@ -281,8 +281,12 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
 
     // This is called after Initialize(), it pre-computes aux.topology
     // data structures for the mesh, aux. material data, etc.
+    // The map of neighboring triangles is computed only if not loaded with the mesh.
     void SetupAuxData();
 
+    // Build the lists of vertices connected to each vertex (connected_start, connected_vertexes).
+    void ComputeConnectivity();
+
     std::shared_ptr<ChColorAsset> m_color;
     std::shared_ptr<ChTriangleMeshShape> m_trimesh_shape;
     double m_height;
@@ -321,7 +325,8 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     ChCoordsys<> plane;
 
     // aux. topology data
-    std::vector<std::set<int>> connected_vertexes;
+    std::vector<int> connected_start;     // start of the neighbors of each vertex in connected_vertexes (plus end)
+    std::vector<int> connected_vertexes;  // neighbors of all vertices, sorted
     std::vector<std::array<int, 4>> tri_map;
 
     bool do_bulldozing;
@@ -347,12 +352,15 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     // Timers and counters
     ChTimer<double> m_timer_calc_areas;
     ChTimer<double> m_timer_ray_casting;
+    ChTimer<double> m_timer_contact_patches;
+    ChTimer<double> m_timer_contact_forces;
     ChTimer<double> m_timer_refinement;
     ChTimer<double> m_timer_bulldozing;
     ChTimer<double> m_timer_visualization;
     size_t m_num_vertices;
     size_t m_num_faces;
     size_t m_num_ray_casts;
+    size_t m_num_ray_hits;
     size_t m_num_marked_faces;
 
     std::unordered_map<ChContactable*, TerrainForce> m_contact_forces;
@@ -31,9 +31,9 @@
 #include "chrono/core/ChMathematics.h"
 
 #include "chrono_vehicle/utils/ChAdaptiveSpeedController.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 
 #include "chrono_thirdparty/rapidjson/document.h"
-#include "chrono_thirdparty/rapidjson/filereadstream.h"
 
 using namespace rapidjson;
 
@@ -51,15 +51,8 @@ ChAdaptiveSpeedController::ChAdaptiveSpeedController()
 
 ChAdaptiveSpeedController::ChAdaptiveSpeedController(const std::string& filename)
     : m_speed(0), m_err(0), m_erri(0), m_errd(0), m_collect(false), m_csv(NULL) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream<ParseFlag::kParseCommentsFlag>(is);
+    auto doc = ChAssetCache::GetDocument(filename);
+    const Document& d = *doc;
 
     m_Kp = d["Gains"]["Kp"].GetDouble();
     m_Ki = d["Gains"]["Ki"].GetDouble();
@@ -0,0 +1,200 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Process-wide cache for the data files (JSON specification files and
+// triangle meshes) read by the Chrono::Vehicle subsystems.
+//
+// =============================================================================
+
+#include <sys/stat.h>
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include "chrono/core/ChLog.h"
+
+#include "chrono_vehicle/utils/ChAssetCache.h"
+
+using namespace rapidjson;
+
+namespace chrono {
+namespace vehicle {
+
+namespace {
+
+// Cache entry: the object loaded from a file, with the file modification time at load.
+template <typename T>
+struct CacheEntry {
+    time_t mtime;
+    std::shared_ptr<T> object;
+};
+
+struct AssetCache {
+    AssetCache() : enabled(true), num_hits(0), num_loads(0) {}
+
+    std::mutex mutex;
+    std::map<std::string, CacheEntry<const Document>> documents;
+    std::map<std::string, CacheEntry<geometry::ChTriangleMeshConnected>> meshes;
+    bool enabled;
+    unsigned int num_hits;
+    unsigned int num_loads;
+};
+
+AssetCache& GetCache() {
+    static AssetCache cache;
+    return cache;
+}
+
+// Return the modification time of the specified file (0 if the file does not exist).
+time_t GetModificationTime(const std::string& filename) {
+    struct stat buf;
+    if (stat(filename.c_str(), &buf) != 0)
+        return 0;
+    return buf.st_mtime;
+}
+
+// Find a valid cache entry for the given key. Must be called with the cache mutex locked.
+template <typename T>
+std::shared_ptr<T> Find(std::map<std::string, CacheEntry<T>>& entries, const std::string& key, time_t mtime) {
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second.mtime != mtime)
+        return nullptr;
+    return it->second.object;
+}
+
+}  // end anonymous namespace
+
+// -----------------------------------------------------------------------------
+// Objects are loaded without holding the cache mutex, so that different files
+// can be loaded concurrently. If two threads load the same file at the same time,
+// the first object inserted in the cache is the one returned to both.
+// -----------------------------------------------------------------------------
+std::shared_ptr<const Document> ChAssetCache::GetDocument(const std::string& filename) {
+    AssetCache& cache = GetCache();
+    time_t mtime = GetModificationTime(filename);
+
+    bool enabled;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        enabled = cache.enabled;
+        if (enabled && mtime != 0) {
+            auto d = Find(cache.documents, filename, mtime);
+            if (d) {
+                cache.num_hits++;
+                return d;
+            }
+        }
+        cache.num_loads++;
+    }
+
+    auto d = std::make_shared<Document>();
+    std::ifstream ifile(filename.c_str());
+    if (!ifile.good())
+        return d;
+    std::stringstream buffer;
+    buffer << ifile.rdbuf();
+    d->Parse<ParseFlag::kParseCommentsFlag>(buffer.str().c_str());
+
+    if (!enabled)
+        return d;
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto& entry = cache.documents[filename];
+    if (entry.mtime != mtime || !entry.object) {
+        entry.mtime = mtime;
+        entry.object = d;
+    }
+    return entry.object;
+}
+
+std::shared_ptr<geometry::ChTriangleMeshConnected> ChAssetCache::GetMesh(const std::string& filename,
+                                                                         bool load_normals,
+                                                                         bool load_uv) {
+    AssetCache& cache = GetCache();
+    time_t mtime = GetModificationTime(filename);
+    std::string key = filename + (load_normals ? "|n" : "|") + (load_uv ? "|uv" : "|");
+
+    bool enabled;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        enabled = cache.enabled;
+        if (enabled && mtime != 0) {
+            auto mesh = Find(cache.meshes, key, mtime);
+            if (mesh) {
+                cache.num_hits++;
+                return mesh;
+            }
+        }
+        cache.num_loads++;
+    }
+
+    auto mesh = std::make_shared<geometry::ChTriangleMeshConnected>();
+    if (geometry::ChTriangleMeshConnected::IsBinaryMeshFile(filename)) {
+        if (!mesh->LoadBinaryMesh(filename, load_normals, load_uv)) {
+            GetLog() << "ERROR: cannot read binary mesh file " << filename << "\n";
+            return mesh;
+        }
+    } else {
+        mesh->LoadWavefrontMesh(filename, load_normals, load_uv);
+    }
+
+    if (!enabled || mtime == 0)
+        return mesh;
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto& entry = cache.meshes[key];
+    if (entry.mtime != mtime || !entry.object) {
+        entry.mtime = mtime;
+        entry.object = mesh;
+    }
+    return entry.object;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChAssetCache::SetEnabled(bool val) {
+    AssetCache& cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.enabled = val;
+}
+
+bool ChAssetCache::IsEnabled() {
+    AssetCache& cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.enabled;
+}
+
+void ChAssetCache::Clear() {
+    AssetCache& cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.documents.clear();
+    cache.meshes.clear();
+    cache.num_hits = 0;
+    cache.num_loads = 0;
+}
+
+unsigned int ChAssetCache::GetNumHits() {
+    AssetCache& cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.num_hits;
+}
+
+unsigned int ChAssetCache::GetNumLoads() {
+    AssetCache& cache = GetCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.num_loads;
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,76 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Process-wide cache for the data files (JSON specification files and
+// triangle meshes) read by the Chrono::Vehicle subsystems.
+//
+// =============================================================================
+
+#ifndef CH_ASSET_CACHE_H
+#define CH_ASSET_CACHE_H
+
+#include <memory>
+#include <string>
+
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_thirdparty/rapidjson/document.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_utils
+/// @{
+
+/// Process-wide cache of the data files read by the vehicle subsystems.
+/// Parsed JSON documents and triangle meshes are kept in memory, keyed by file name and file modification time,
+/// so that constructing many copies of the same vehicle model reads and parses each file only once. A file
+/// modified on disk is reloaded at the next request.\n
+/// Cached objects are shared by all requesters and must be treated as read-only. All functions are thread safe.
+class CH_VEHICLE_API ChAssetCache {
+  public:
+    /// Return the JSON document parsed from the specified file.
+    /// If the file cannot be opened, an empty document is returned (and not cached).
+    static std::shared_ptr<const rapidjson::Document> GetDocument(const std::string& filename);
+
+    /// Return the triangle mesh loaded from the specified file (Wavefront OBJ or Chrono binary mesh format).
+    /// Meshes loaded with different options are cached separately. The returned mesh is shared and must not be
+    /// modified (make a copy if needed).
+    /// If a binary mesh file cannot be read, an error is reported and an empty mesh is returned (and not cached).
+    static std::shared_ptr<geometry::ChTriangleMeshConnected> GetMesh(const std::string& filename,
+                                                                      bool load_normals = true,
+                                                                      bool load_uv = false);
+
+    /// Enable or disable the cache (default: enabled).
+    /// If disabled, each request reads the file anew; objects already returned are not affected.
+    static void SetEnabled(bool val);
+
+    /// Return true if the cache is enabled.
+    static bool IsEnabled();
+
+    /// Release the cached objects and reset the counters (objects already returned remain valid).
+    static void Clear();
+
+    /// Return the number of requests served from the cache.
+    static unsigned int GetNumHits();
+
+    /// Return the number of requests that required reading a file.
+    static unsigned int GetNumLoads();
+};
+
+/// @} vehicle_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
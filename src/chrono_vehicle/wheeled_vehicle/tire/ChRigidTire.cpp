@@ -25,6 +25,7 @@
 #include "chrono_vehicle/wheeled_vehicle/tire/ChRigidTire.h"
 
 #include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
 
 namespace chrono {
 namespace vehicle {
@@ -56,8 +57,7 @@ void ChRigidTire::Initialize(std::shared_ptr<ChBody> wheel, VehicleSide side) {
 
     if (m_use_contact_mesh) {
         // Mesh contact
-        m_trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
-        m_trimesh->LoadWavefrontMesh(m_contact_meshFile, true, false);
+        m_trimesh = ChAssetCache::GetMesh(m_contact_meshFile, true, false);
 
         wheel->GetCollisionModel()->AddTriangleMesh(m_trimesh, false, false, ChVector<>(0), ChMatrix33<>(1),
                                                     m_sweep_sphere_radius);
@@ -0,0 +1,143 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Utility class for advancing a fleet of independent wheeled vehicles
+// concurrently.
+//
+// =============================================================================
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/parallel/ChTaskScheduler.h"
+
+#include "chrono_vehicle/wheeled_vehicle/utils/ChWheeledVehicleFleet.h"
+
+namespace chrono {
+namespace vehicle {
+
+ChWheeledVehicleFleet::ChWheeledVehicleFleet(double step_size) : m_step_size(step_size) {
+    ResetTimers();
+}
+
+// -----------------------------------------------------------------------------
+// Create the fleet members through the user-provided factory.
+// Construction is done serially: subsystem constructors are not guaranteed to be
+// thread-safe (e.g. some of them set global collision parameters).
+// -----------------------------------------------------------------------------
+void ChWheeledVehicleFleet::AddMembers(int num_members, MemberFactory& factory) {
+    int first = GetNumMembers();
+    for (int i = 0; i < num_members; i++) {
+        Member member;
+        factory.onCallback(first + i, member);
+        member.vehicle->GetSystem()->SetParallelThreadNumber(1);
+        AddMember(member);
+    }
+}
+
+void ChWheeledVehicleFleet::AddMember(const Member& member) {
+    int num_wheels = 2 * member.vehicle->GetNumberAxles();
+    m_members.push_back(member);
+    m_tire_forces.push_back(TerrainForces(num_wheels));
+    m_wheel_states.push_back(WheelStates(num_wheels));
+}
+
+// -----------------------------------------------------------------------------
+// Advance one member by one step: exchange data between its subsystems, then
+// advance each of them (as in the typical single-vehicle simulation loop).
+// -----------------------------------------------------------------------------
+void ChWheeledVehicleFleet::Advance(int index) {
+    Member& member = m_members[index];
+    TerrainForces& tire_forces = m_tire_forces[index];
+    WheelStates& wheel_states = m_wheel_states[index];
+    int num_wheels = (int)member.tires.size();
+
+    // Collect data from subsystems
+    double throttle_input = member.driver->GetThrottle();
+    double steering_input = member.driver->GetSteering();
+    double braking_input = member.driver->GetBraking();
+    double powertrain_torque = member.powertrain->GetOutputTorque();
+    double driveshaft_speed = member.vehicle->GetDriveshaftSpeed();
+    for (int i = 0; i < num_wheels; i++) {
+        tire_forces[i] = member.tires[i]->GetTireForce();
+        wheel_states[i] = member.vehicle->GetWheelState(i);
+    }
+
+    // Update subsystems (process inputs from other subsystems)
+    double time = member.vehicle->GetChTime();
+    member.driver->Synchronize(time);
+    member.powertrain->Synchronize(time, throttle_input, driveshaft_speed);
+    member.vehicle->Synchronize(time, steering_input, braking_input, powertrain_torque, tire_forces);
+    member.terrain->Synchronize(time);
+    for (int i = 0; i < num_wheels; i++)
+        member.tires[i]->Synchronize(time, wheel_states[i], *member.terrain);
+
+    // Advance simulation for one timestep for all subsystems
+    member.driver->Advance(m_step_size);
+    member.powertrain->Advance(m_step_size);
+    member.vehicle->Advance(m_step_size);
+    member.terrain->Advance(m_step_size);
+    for (int i = 0; i < num_wheels; i++)
+        member.tires[i]->Advance(m_step_size);
+}
+
+// -----------------------------------------------------------------------------
+// Advance all members, each one processed as a separate task.
+// In Run(), a task advances its member over the entire interval, so that members
+// never wait for each other.
+// -----------------------------------------------------------------------------
+void ChWheeledVehicleFleet::Step() {
+    int num_members = GetNumMembers();
+
+    ChTimer<double> timer;
+    timer.reset();
+    timer.start();
+    ChTaskScheduler::GetInstance().ParallelFor(0, num_members, 1, [&](int from, int to) {
+        for (int i = from; i < to; i++)
+            Advance(i);
+    });
+    timer.stop();
+
+    m_sim_time += num_members * m_step_size;
+    m_wall_time += timer.GetTimeSeconds();
+}
+
+void ChWheeledVehicleFleet::Run(double end_time) {
+    int num_members = GetNumMembers();
+    std::vector<double> start_time(num_members);
+    for (int i = 0; i < num_members; i++)
+        start_time[i] = m_members[i].vehicle->GetChTime();
+
+    // Avoid an extra step because of round-off in the accumulated time
+    double tol = 1e-6 * m_step_size;
+
+    ChTimer<double> timer;
+    timer.reset();
+    timer.start();
+    ChTaskScheduler::GetInstance().ParallelFor(0, num_members, 1, [&](int from, int to) {
+        for (int i = from; i < to; i++) {
+            while (m_members[i].vehicle->GetChTime() < end_time - tol)
+                Advance(i);
+        }
+    });
+    timer.stop();
+
+    for (int i = 0; i < num_members; i++)
+        m_sim_time += m_members[i].vehicle->GetChTime() - start_time[i];
+    m_wall_time += timer.GetTimeSeconds();
+}
+
+void ChWheeledVehicleFleet::ResetTimers() {
+    m_sim_time = 0;
+    m_wall_time = 0;
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,125 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Utility class for advancing a fleet of independent wheeled vehicles
+// concurrently.
+//
+// =============================================================================
+
+#ifndef CH_WHEELED_VEHICLE_FLEET_H
+#define CH_WHEELED_VEHICLE_FLEET_H
+
+#include <memory>
+#include <vector>
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_vehicle/ChDriver.h"
+#include "chrono_vehicle/ChPowertrain.h"
+#include "chrono_vehicle/ChTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/ChTire.h"
+#include "chrono_vehicle/wheeled_vehicle/ChWheeledVehicle.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_wheeled_utils
+/// @{
+
+/// Runner for a fleet of independent wheeled vehicles (e.g. for Monte Carlo studies).
+/// Each fleet member is a vehicle, with its own powertrain, tires, terrain, and driver, simulated in its own
+/// ChSystem. Members do not interact, so they are advanced concurrently on the process-wide ChTaskScheduler
+/// (parallel loops within a member, if any, share the same thread pool).\n
+/// Members are created serially, through a user-provided factory, which can share read-only model data (e.g.
+/// parsed JSON specification documents or driver inputs) among all members.
+class CH_VEHICLE_API ChWheeledVehicleFleet {
+  public:
+    /// Subsystems of one fleet member.
+    /// The vehicle must own its ChSystem (i.e., be constructed without an external system) and the terrain
+    /// must be associated with that same system.
+    struct Member {
+        std::shared_ptr<ChWheeledVehicle> vehicle;  ///< vehicle (owns its containing system)
+        std::shared_ptr<ChPowertrain> powertrain;    ///< powertrain, initialized on the vehicle
+        std::vector<std::shared_ptr<ChTire>> tires;  ///< one tire per wheel, initialized on the vehicle
+        std::shared_ptr<ChTerrain> terrain;          ///< terrain in the vehicle system
+        std::shared_ptr<ChDriver> driver;            ///< driver, already initialized
+    };
+
+    /// Callback class for constructing the fleet members.
+    class MemberFactory {
+      public:
+        virtual ~MemberFactory() {}
+
+        /// A derived class must implement the function onCallback() which must create and initialize the
+        /// subsystems of the member with specified index.
+        virtual void onCallback(int index,      ///< index of the member in the fleet
+                                Member& member  ///< [output] subsystems of the new member
+                                ) = 0;
+    };
+
+    /// Construct an empty fleet, with all members advanced using the specified step size.
+    ChWheeledVehicleFleet(double step_size);
+
+    ~ChWheeledVehicleFleet() {}
+
+    /// Add the specified number of members, created through the given factory.
+    /// Each new member system is set to use a single thread for its solver, the fleet providing the parallelism.
+    void AddMembers(int num_members, MemberFactory& factory);
+
+    /// Add one member to the fleet.
+    void AddMember(const Member& member);
+
+    /// Get the number of members in the fleet.
+    int GetNumMembers() const { return (int)m_members.size(); }
+
+    /// Get the subsystems of the specified member.
+    const Member& GetMember(int index) const { return m_members[index]; }
+
+    /// Get the integration step size.
+    double GetStepSize() const { return m_step_size; }
+
+    /// Advance all members by one step (synchronizing all members after the step).
+    void Step();
+
+    /// Advance all members until the specified time.
+    /// Members are advanced independently of each other, without synchronizing after each step.
+    void Run(double end_time);
+
+    /// Get the total simulated time (sum over all members) during the calls to Step() and Run().
+    double GetSimulatedTime() const { return m_sim_time; }
+
+    /// Get the total wall-clock time spent in Step() and Run().
+    double GetWallTime() const { return m_wall_time; }
+
+    /// Get the fleet throughput, in vehicle-seconds simulated per wall-clock second.
+    double GetThroughput() const { return (m_wall_time > 0) ? m_sim_time / m_wall_time : 0; }
+
+    /// Reset the simulated and wall-clock time counters.
+    void ResetTimers();
+
+  private:
+    /// Advance the member with specified index by one step.
+    void Advance(int index);
+
+    std::vector<Member> m_members;
+    std::vector<TerrainForces> m_tire_forces;
+    std::vector<WheelStates> m_wheel_states;
+    double m_step_size;
+    double m_sim_time;
+    double m_wall_time;
+};
+
+/// @} vehicle_wheeled_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
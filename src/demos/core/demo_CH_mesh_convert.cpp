@@ -0,0 +1,75 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Conversion of a Wavefront .obj mesh file to the Chrono binary mesh format.
+// The binary file can be used wherever a mesh file is accepted and is loaded
+// without parsing.
+//
+// Usage: demo_CH_mesh_convert input.obj output.bin [--neighbors]
+//   --neighbors   also store the map of neighboring triangles
+//
+// =============================================================================
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+
+using namespace chrono;
+using namespace chrono::geometry;
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " input.obj output.bin [--neighbors]" << std::endl;
+        return 1;
+    }
+
+    std::string input(argv[1]);
+    std::string output(argv[2]);
+    bool write_tri_map = (argc > 3 && std::strcmp(argv[3], "--neighbors") == 0);
+
+    // Load the Wavefront mesh
+    auto start = std::chrono::high_resolution_clock::now();
+    ChTriangleMeshConnected mesh;
+    mesh.LoadWavefrontMesh(input, true, true);
+    auto end = std::chrono::high_resolution_clock::now();
+    double time_obj = std::chrono::duration<double>(end - start).count();
+
+    if (mesh.getNumTriangles() == 0) {
+        std::cout << "Cannot read mesh from " << input << std::endl;
+        return 1;
+    }
+
+    std::cout << "Vertices:  " << mesh.getCoordsVertices().size() << std::endl;
+    std::cout << "Normals:   " << mesh.getCoordsNormals().size() << std::endl;
+    std::cout << "UVs:       " << mesh.getCoordsUV().size() << std::endl;
+    std::cout << "Triangles: " << mesh.getNumTriangles() << std::endl;
+
+    // Write the binary mesh
+    if (!mesh.WriteBinaryMesh(output, write_tri_map)) {
+        std::cout << "Cannot write mesh to " << output << std::endl;
+        return 1;
+    }
+
+    // Read it back, for comparison of load times
+    start = std::chrono::high_resolution_clock::now();
+    ChTriangleMeshConnected mesh_bin;
+    mesh_bin.LoadBinaryMesh(output, true, true);
+    end = std::chrono::high_resolution_clock::now();
+    double time_bin = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Load time (OBJ):    " << 1e3 * time_obj << " ms" << std::endl;
+    std::cout << "Load time (binary): " << 1e3 * time_bin << " ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Demonstration of a fleet of independent wheeled vehicles (specified through
+// JSON files), advanced concurrently. Each vehicle follows the same maneuver
+// with a different steering gain, as in a simple parametric study.
+//
+// The tire and powertrain specification files and the driver inputs are read
+// once and shared by all vehicles.
+//
+// Usage: demo_VEH_Fleet [num_vehicles] [num_threads]
+//
+// =============================================================================
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "chrono/parallel/ChTaskScheduler.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/driver/ChDataDriver.h"
+#include "chrono_vehicle/powertrain/SimplePowertrain.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/RigidTire.h"
+#include "chrono_vehicle/wheeled_vehicle/utils/ChWheeledVehicleFleet.h"
+#include "chrono_vehicle/wheeled_vehicle/vehicle/WheeledVehicle.h"
+
+#include "chrono_thirdparty/rapidjson/document.h"
+#include "chrono_thirdparty/rapidjson/filereadstream.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// =============================================================================
+
+// JSON files for the vehicle model
+std::string vehicle_file("hmmwv/vehicle/HMMWV_Vehicle.json");
+std::string simplepowertrain_file("generic/powertrain/SimplePowertrain.json");
+std::string rigidtire_file("hmmwv/tire/HMMWV_RigidTire.json");
+
+// Driver inputs
+std::string driver_file("generic/driver/Sample_Maneuver.txt");
+
+// Initial vehicle position
+ChVector<> initLoc(0, 0, 1.6);
+
+// Simulation step size and end time
+double step_size = 2e-3;
+double tend = 10.0;
+
+// =============================================================================
+
+// Parse a JSON specification file.
+static void ReadDocument(const std::string& filename, rapidjson::Document& d) {
+    FILE* fp = fopen(filename.c_str(), "r");
+    char readBuffer[65536];
+    rapidjson::FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+    d.ParseStream<rapidjson::ParseFlag::kParseCommentsFlag>(is);
+    fclose(fp);
+}
+
+// Factory for the fleet members. All members share the parsed tire and powertrain
+// specifications and the driver inputs; member i uses a scaled steering input.
+class FleetFactory : public ChWheeledVehicleFleet::MemberFactory {
+  public:
+    FleetFactory(int num_vehicles) : m_num_vehicles(num_vehicles) {
+        ReadDocument(vehicle::GetDataFile(rigidtire_file), m_tire_doc);
+        ReadDocument(vehicle::GetDataFile(simplepowertrain_file), m_powertrain_doc);
+
+        std::ifstream ifile(vehicle::GetDataFile(driver_file));
+        std::string line;
+        while (std::getline(ifile, line)) {
+            std::istringstream iss(line);
+            double time, steering, throttle, braking;
+            iss >> time >> steering >> throttle >> braking;
+            if (iss.fail())
+                break;
+            m_driver_data.push_back(ChDataDriver::Entry(time, steering, throttle, braking));
+        }
+    }
+
+    virtual void onCallback(int index, ChWheeledVehicleFleet::Member& member) override {
+        // Vehicle (in its own system)
+        auto vehicle = std::make_shared<WheeledVehicle>(vehicle::GetDataFile(vehicle_file), ChMaterialSurface::NSC);
+        vehicle->Initialize(ChCoordsys<>(initLoc, QUNIT));
+        vehicle->SetStepsize(step_size);
+        member.vehicle = vehicle;
+
+        // Terrain
+        auto terrain = std::make_shared<RigidTerrain>(vehicle->GetSystem());
+        auto patch = terrain->AddPatch(ChCoordsys<>(ChVector<>(0, 0, -5), QUNIT), ChVector<>(300, 300, 10));
+        patch->SetContactFrictionCoefficient(0.9f);
+        patch->SetContactRestitutionCoefficient(0.01f);
+        patch->SetContactMaterialProperties(2e7f, 0.3f);
+        terrain->Initialize();
+        member.terrain = terrain;
+
+        // Powertrain
+        auto powertrain = std::make_shared<SimplePowertrain>(m_powertrain_doc);
+        powertrain->Initialize(vehicle->GetChassisBody(), vehicle->GetDriveshaft());
+        member.powertrain = powertrain;
+
+        // Tires
+        int num_wheels = 2 * vehicle->GetNumberAxles();
+        for (int i = 0; i < num_wheels; i++) {
+            auto tire = std::make_shared<RigidTire>(m_tire_doc);
+            tire->Initialize(vehicle->GetWheelBody(i), VehicleSide(i % 2));
+            member.tires.push_back(tire);
+        }
+
+        // Driver, with steering gain between 0.5 and 1.5
+        double gain = (m_num_vehicles > 1) ? 0.5 + index / (m_num_vehicles - 1.0) : 1.0;
+        std::vector<ChDataDriver::Entry> data = m_driver_data;
+        for (auto& entry : data)
+            entry.m_steering *= gain;
+        auto driver = std::make_shared<ChDataDriver>(*vehicle, data);
+        driver->Initialize();
+        member.driver = driver;
+    }
+
+  private:
+    int m_num_vehicles;
+    rapidjson::Document m_tire_doc;
+    rapidjson::Document m_powertrain_doc;
+    std::vector<ChDataDriver::Entry> m_driver_data;
+};
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    GetLog() << "Copyright (c) 2017 projectchrono.org\nChrono version: " << CHRONO_VERSION << "\n\n";
+
+    int num_vehicles = (argc > 1) ? std::atoi(argv[1]) : 16;
+    if (argc > 2)
+        ChTaskScheduler::GetInstance().SetNumThreads(std::atoi(argv[2]));
+
+    // Create the fleet
+    ChWheeledVehicleFleet fleet(step_size);
+    FleetFactory factory(num_vehicles);
+    fleet.AddMembers(num_vehicles, factory);
+
+    std::cout << "Vehicles: " << fleet.GetNumMembers() << std::endl;
+    std::cout << "Threads:  " << ChTaskScheduler::GetInstance().GetNumThreads() << std::endl;
+
+    // Simulate, reporting progress every second of simulated time
+    for (double t = 1; t <= tend + 1e-6; t += 1) {
+        fleet.Run(t);
+        std::cout << "Time: " << t << "   throughput: " << fleet.GetThroughput() << " vehicle-s/s" << std::endl;
+    }
+
+    // Final vehicle positions
+    for (int i = 0; i < fleet.GetNumMembers(); i++) {
+        const ChVector<>& pos = fleet.GetMember(i).vehicle->GetVehiclePos();
+        std::cout << "Vehicle " << i << ":  " << pos.x() << "  " << pos.y() << std::endl;
+    }
+
+    std::cout << "Simulated:  " << fleet.GetSimulatedTime() << " vehicle-s" << std::endl;
+    std::cout << "Wall clock: " << fleet.GetWallTime() << " s" << std::endl;
+    std::cout << "Throughput: " << fleet.GetThroughput() << " vehicle-s/s" << std::endl;
+
+    return 0;
+}
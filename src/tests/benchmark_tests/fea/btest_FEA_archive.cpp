@@ -0,0 +1,183 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark test for the throughput of binary archives on large FEA meshes:
+// the nodal positions and velocities of a mesh are serialized node by node,
+// as arrays of vectors, and as the state vectors of the system (bulk paths).
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "chrono/ChConfig.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/fea/ChNodeFEAxyz.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/serialization/ChArchiveBinary.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// =============================================================================
+
+// A mesh with a cubic lattice of nodes, with initial velocities
+class MeshState {
+  public:
+    MeshState(int num_nodes);
+
+    ChSystemNSC system;
+    std::shared_ptr<ChMesh> mesh;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    ChState x;
+    ChStateDelta v;
+};
+
+MeshState::MeshState(int num_nodes) {
+    mesh = std::make_shared<ChMesh>();
+    int n = (int)std::ceil(std::cbrt(num_nodes));
+    for (int i = 0; i < num_nodes; i++) {
+        ChVector<> pos(0.01 * (i % n), 0.01 * ((i / n) % n), 0.01 * (i / (n * n)));
+        auto node = std::make_shared<ChNodeFEAxyz>(pos);
+        node->SetPos_dt(ChVector<>(0.1 * pos.z(), 0, -0.1 * pos.x()));
+        mesh->AddNode(node);
+        nodes.push_back(node);
+    }
+    system.Add(mesh);
+    system.Setup();
+
+    x.Reset(system.GetNcoords_x(), &system);
+    v.Reset(system.GetNcoords_v(), &system);
+    double T;
+    system.StateGather(x, v, T);
+}
+
+static void SetThroughput(benchmark::State& st, size_t bytes) {
+    st.SetBytesProcessed(st.iterations() * bytes);
+    st.counters["MB"] = bytes / 1e6;
+}
+
+// -----------------------------------------------------------------------------
+
+// Nodal positions and velocities written node by node (one virtual call per scalar)
+static void FEA_Archive_Nodes(benchmark::State& st) {
+    MeshState ms((int)st.range(0));
+    std::vector<char> buffer;
+    while (st.KeepRunning()) {
+        buffer.clear();
+        ChStreamOutBinaryVector stream(&buffer);
+        ChArchiveOutBinary archive(stream);
+        for (auto& node : ms.nodes) {
+            archive << CHNVP(node->GetPos(), "pos");
+            archive << CHNVP(node->GetPos_dt(), "vel");
+        }
+    }
+    SetThroughput(st, buffer.size());
+}
+
+// Nodal positions and velocities gathered in arrays of vectors (bulk path)
+static void FEA_Archive_NodeArrays(benchmark::State& st) {
+    MeshState ms((int)st.range(0));
+    std::vector<char> buffer;
+    std::vector<ChVector<>> pos;
+    std::vector<ChVector<>> vel;
+    while (st.KeepRunning()) {
+        pos.resize(ms.nodes.size());
+        vel.resize(ms.nodes.size());
+        for (size_t i = 0; i < ms.nodes.size(); i++) {
+            pos[i] = ms.nodes[i]->GetPos();
+            vel[i] = ms.nodes[i]->GetPos_dt();
+        }
+        buffer.clear();
+        ChStreamOutBinaryVector stream(&buffer);
+        ChArchiveOutBinary archive(stream);
+        archive << CHNVP(pos);
+        archive << CHNVP(vel);
+    }
+    SetThroughput(st, buffer.size());
+}
+
+// System state vectors (bulk path)
+static void FEA_Archive_StateOut(benchmark::State& st) {
+    MeshState ms((int)st.range(0));
+    std::vector<char> buffer;
+    while (st.KeepRunning()) {
+        buffer.clear();
+        ChStreamOutBinaryVector stream(&buffer);
+        ChArchiveOutBinary archive(stream);
+        archive << CHNVP(ms.x, "x");
+        archive << CHNVP(ms.v, "v");
+    }
+    SetThroughput(st, buffer.size());
+}
+
+static void FEA_Archive_StateIn(benchmark::State& st) {
+    MeshState ms((int)st.range(0));
+    std::vector<char> buffer;
+    {
+        ChStreamOutBinaryVector stream(&buffer);
+        ChArchiveOutBinary archive(stream);
+        archive << CHNVP(ms.x, "x");
+        archive << CHNVP(ms.v, "v");
+    }
+    while (st.KeepRunning()) {
+        ChStreamInBinaryVector stream(&buffer);
+        ChArchiveInBinary archive(stream);
+        archive >> CHNVP(ms.x, "x");
+        archive >> CHNVP(ms.v, "v");
+    }
+    SetThroughput(st, buffer.size());
+}
+
+// System state vectors written to file
+static void FEA_Archive_StateFile(benchmark::State& st) {
+    MeshState ms((int)st.range(0));
+    while (st.KeepRunning()) {
+        ChStreamOutBinaryFile stream("btest_FEA_archive.dat");
+        ChArchiveOutBinary archive(stream);
+        archive << CHNVP(ms.x, "x");
+        archive << CHNVP(ms.v, "v");
+    }
+    SetThroughput(st, (ms.x.GetRows() + ms.v.GetRows()) * sizeof(double));
+    std::remove("btest_FEA_archive.dat");
+}
+
+BENCHMARK(FEA_Archive_Nodes)->Unit(benchmark::kMillisecond)->Arg(10000)->Arg(1000000);
+BENCHMARK(FEA_Archive_NodeArrays)->Unit(benchmark::kMillisecond)->Arg(10000)->Arg(1000000);
+BENCHMARK(FEA_Archive_StateOut)->Unit(benchmark::kMillisecond)->Arg(10000)->Arg(1000000);
+BENCHMARK(FEA_Archive_StateIn)->Unit(benchmark::kMillisecond)->Arg(10000)->Arg(1000000);
+BENCHMARK(FEA_Archive_StateFile)->Unit(benchmark::kMillisecond)->Arg(10000)->Arg(1000000);
+
+#ifdef CHRONO_HAS_ZLIB
+
+// System state vectors written to a compressed file
+static void FEA_Archive_StateGzip(benchmark::State& st) {
+    MeshState ms((int)st.range(0));
+    while (st.KeepRunning()) {
+        ChStreamOutBinaryGzipFile stream("btest_FEA_archive.gz", 1);
+        ChArchiveOutBinary archive(stream);
+        archive << CHNVP(ms.x, "x");
+        archive << CHNVP(ms.v, "v");
+    }
+    SetThroughput(st, (ms.x.GetRows() + ms.v.GetRows()) * sizeof(double));
+    std::remove("btest_FEA_archive.gz");
+}
+
+BENCHMARK(FEA_Archive_StateGzip)->Unit(benchmark::kMillisecond)->Arg(10000)->Arg(1000000);
+
+#endif
+
+BENCHMARK_MAIN();
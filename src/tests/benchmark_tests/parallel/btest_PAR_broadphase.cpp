@@ -0,0 +1,161 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark test for the Chrono::Parallel broadphase.
+// A granular pile of spheres rests on a large ground plate; optionally, a few
+// particles are placed far away from the pile, as escaping particles would be.
+// The collision detection is timed with the uniform grid and with the hashed
+// grid broadphase, and the broadphase time of a settling pile is measured with
+// and without the pair cache.
+//
+// =============================================================================
+
+#include "benchmark/benchmark.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// =============================================================================
+
+class GranularPile {
+  public:
+    GranularPile(int num_per_side, bool outliers, BroadPhaseType broadphase);
+
+    /// Run the collision detection on the current configuration.
+    void Collide() { m_system.GetCollisionSystem()->Run(); }
+
+    ChSystemParallelNSC m_system;
+};
+
+GranularPile::GranularPile(int num_per_side, bool outliers, BroadPhaseType broadphase) {
+    m_system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    m_system.GetSettings()->solver.max_iteration_sliding = 10;
+    m_system.GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    m_system.ChangeSolverType(SolverType::APGD);
+    m_system.GetSettings()->collision.collision_envelope = 0.01;
+    m_system.GetSettings()->collision.bins_per_axis = vec3(20, 20, 20);
+    m_system.GetSettings()->collision.broadphase_algorithm = broadphase;
+
+    auto mat = std::make_shared<ChMaterialSurfaceNSC>();
+
+    std::shared_ptr<ChBody> ground(m_system.NewBody());
+    ground->SetMaterialSurface(mat);
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(ground.get(), ChVector<>(100, 100, 0.1), ChVector<>(0, 0, -0.1));
+    ground->GetCollisionModel()->BuildModel();
+    m_system.AddBody(ground);
+
+    // Pile of spheres, with a square base and a height of a quarter of its side
+    double radius = 0.1;
+    double spacing = 2.1 * radius;
+    for (int ix = 0; ix < num_per_side; ix++) {
+        for (int iy = 0; iy < num_per_side; iy++) {
+            for (int iz = 0; iz < num_per_side / 4; iz++) {
+                ChVector<> rnd(ChRandom() * 0.01, ChRandom() * 0.01, ChRandom() * 0.01);
+                std::shared_ptr<ChBody> ball(m_system.NewBody());
+                ball->SetMaterialSurface(mat);
+                ball->SetMass(1);
+                ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+                ball->SetPos(ChVector<>(spacing * ix, spacing * iy, spacing * iz + radius) + rnd);
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), radius);
+                ball->GetCollisionModel()->BuildModel();
+                m_system.AddBody(ball);
+            }
+        }
+    }
+
+    // Particles thrown far away from the pile
+    if (outliers) {
+        for (int i = 0; i < 4; i++) {
+            std::shared_ptr<ChBody> ball(m_system.NewBody());
+            ball->SetMaterialSurface(mat);
+            ball->SetMass(1);
+            ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+            ball->SetPos(ChVector<>(1000.0 * (i % 2), 1000.0 * (i / 2), 500.0 * (i + 1)));
+            ball->SetCollide(true);
+            ball->GetCollisionModel()->ClearModel();
+            utils::AddSphereGeometry(ball.get(), radius);
+            ball->GetCollisionModel()->BuildModel();
+            m_system.AddBody(ball);
+        }
+    }
+
+    // Settle the data structures of the parallel system
+    m_system.DoStepDynamics(1e-3);
+}
+
+// =============================================================================
+
+static void Broadphase(benchmark::State& st, bool outliers, BroadPhaseType broadphase) {
+    GranularPile pile((int)st.range(0), outliers, broadphase);
+    while (st.KeepRunning()) {
+        pile.Collide();
+    }
+    st.counters["bodies"] = (double)pile.m_system.Get_bodylist().size();
+    st.counters["pairs"] = (double)pile.m_system.data_manager->measures.collision.number_of_contacts_possible;
+    st.counters["bins"] = (double)pile.m_system.data_manager->measures.collision.number_of_bins_active;
+}
+
+static void Broadphase_Grid(benchmark::State& st) {
+    Broadphase(st, false, BroadPhaseType::BROADPHASE_GRID);
+}
+
+static void Broadphase_Hashed(benchmark::State& st) {
+    Broadphase(st, false, BroadPhaseType::BROADPHASE_HASHED);
+}
+
+static void Broadphase_GridOutliers(benchmark::State& st) {
+    Broadphase(st, true, BroadPhaseType::BROADPHASE_GRID);
+}
+
+static void Broadphase_HashedOutliers(benchmark::State& st) {
+    Broadphase(st, true, BroadPhaseType::BROADPHASE_HASHED);
+}
+
+// Simulate the pile as it settles, and report the average broadphase time per step.
+static void Settle(benchmark::State& st, bool pair_cache) {
+    GranularPile pile((int)st.range(0), false, BroadPhaseType::BROADPHASE_HASHED);
+    pile.m_system.GetSettings()->collision.use_pair_cache = pair_cache;
+    double broad_time = 0;
+    while (st.KeepRunning()) {
+        pile.m_system.DoStepDynamics(1e-3);
+        broad_time += pile.m_system.GetTimerCollisionBroad();
+    }
+    st.counters["broad_ms"] = 1e3 * broad_time / st.iterations();
+    st.counters["reuse_rate"] = pile.m_system.data_manager->measures.collision.pair_cache_reuse_rate;
+}
+
+static void Settle_Hashed(benchmark::State& st) {
+    Settle(st, false);
+}
+
+static void Settle_PairCache(benchmark::State& st) {
+    Settle(st, true);
+}
+
+BENCHMARK(Broadphase_Grid)->Unit(benchmark::kMillisecond)->Arg(40)->Arg(80);
+BENCHMARK(Broadphase_Hashed)->Unit(benchmark::kMillisecond)->Arg(40)->Arg(80);
+BENCHMARK(Broadphase_GridOutliers)->Unit(benchmark::kMillisecond)->Arg(40)->Arg(80);
+BENCHMARK(Broadphase_HashedOutliers)->Unit(benchmark::kMillisecond)->Arg(40)->Arg(80);
+BENCHMARK(Settle_Hashed)->Unit(benchmark::kMillisecond)->Arg(40);
+BENCHMARK(Settle_PairCache)->Unit(benchmark::kMillisecond)->Arg(40);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark test for the Chrono::Parallel analytical narrowphase.
+// A granular pile of spheres (optionally with a capsule every fourth particle)
+// rests on a ground plate. The collision detection is timed with the candidate
+// pairs processed one at a time and in batches.
+//
+// =============================================================================
+
+#include "benchmark/benchmark.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// =============================================================================
+
+class GranularPile {
+  public:
+    GranularPile(int num_per_side, bool capsules, bool batched);
+
+    /// Run the collision detection on the current configuration.
+    void Collide() { m_system.GetCollisionSystem()->Run(); }
+
+    ChSystemParallelNSC m_system;
+};
+
+GranularPile::GranularPile(int num_per_side, bool capsules, bool batched) {
+    m_system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    m_system.GetSettings()->solver.max_iteration_sliding = 10;
+    m_system.GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    m_system.ChangeSolverType(SolverType::APGD);
+    m_system.GetSettings()->collision.collision_envelope = 0.01;
+    m_system.GetSettings()->collision.bins_per_axis = vec3(20, 20, 20);
+    m_system.GetSettings()->collision.narrowphase_algorithm = NarrowPhaseType::NARROWPHASE_HYBRID_MPR;
+    m_system.GetSettings()->collision.use_batched_narrowphase = batched;
+
+    auto mat = std::make_shared<ChMaterialSurfaceNSC>();
+
+    std::shared_ptr<ChBody> ground(m_system.NewBody());
+    ground->SetMaterialSurface(mat);
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(ground.get(), ChVector<>(100, 100, 0.1), ChVector<>(0, 0, -0.1));
+    ground->GetCollisionModel()->BuildModel();
+    m_system.AddBody(ground);
+
+    // Pile of particles, touching each other, with a square base and a height of a quarter of its side
+    double radius = 0.1;
+    double spacing = 1.99 * radius;
+    int count = 0;
+    for (int ix = 0; ix < num_per_side; ix++) {
+        for (int iy = 0; iy < num_per_side; iy++) {
+            for (int iz = 0; iz < num_per_side / 4; iz++) {
+                ChVector<> rnd(ChRandom() * 0.001, ChRandom() * 0.001, ChRandom() * 0.001);
+                std::shared_ptr<ChBody> ball(m_system.NewBody());
+                ball->SetMaterialSurface(mat);
+                ball->SetMass(1);
+                ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+                ball->SetPos(ChVector<>(spacing * ix, spacing * iy, spacing * iz + radius) + rnd);
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                if (capsules && count++ % 4 == 0)
+                    utils::AddCapsuleGeometry(ball.get(), radius / 2, radius / 2);
+                else
+                    utils::AddSphereGeometry(ball.get(), radius);
+                ball->GetCollisionModel()->BuildModel();
+                m_system.AddBody(ball);
+            }
+        }
+    }
+
+    // Settle the data structures of the parallel system
+    m_system.DoStepDynamics(1e-3);
+}
+
+// =============================================================================
+
+static void Narrowphase(benchmark::State& st, bool capsules, bool batched) {
+    GranularPile pile((int)st.range(0), capsules, batched);
+    double narrow_time = 0;
+    while (st.KeepRunning()) {
+        pile.Collide();
+        narrow_time += pile.m_system.GetTimerCollisionNarrow();
+    }
+    st.counters["narrow_ms"] = 1e3 * narrow_time / st.iterations();
+    st.counters["contacts"] = (double)pile.m_system.data_manager->num_rigid_contacts;
+    st.counters["batched"] = (double)pile.m_system.data_manager->measures.collision.number_of_batched_pairs;
+}
+
+static void Narrowphase_Spheres(benchmark::State& st) {
+    Narrowphase(st, false, false);
+}
+
+static void Narrowphase_SpheresBatched(benchmark::State& st) {
+    Narrowphase(st, false, true);
+}
+
+static void Narrowphase_Mixed(benchmark::State& st) {
+    Narrowphase(st, true, false);
+}
+
+static void Narrowphase_MixedBatched(benchmark::State& st) {
+    Narrowphase(st, true, true);
+}
+
+BENCHMARK(Narrowphase_Spheres)->Unit(benchmark::kMillisecond)->Arg(40)->Arg(80);
+BENCHMARK(Narrowphase_SpheresBatched)->Unit(benchmark::kMillisecond)->Arg(40)->Arg(80);
+BENCHMARK(Narrowphase_Mixed)->Unit(benchmark::kMillisecond)->Arg(40)->Arg(80);
+BENCHMARK(Narrowphase_MixedBatched)->Unit(benchmark::kMillisecond)->Arg(40)->Arg(80);
+
+BENCHMARK_MAIN();
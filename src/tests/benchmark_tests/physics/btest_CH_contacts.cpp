@@ -0,0 +1,240 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark test for contact handling in the NSC contact container.
+// A large number of synthetic contacts (100k and more) between random pairs of
+// bodies is fed to the contact container, and the time for adding the contacts,
+// injecting them in the system descriptor, and loading the Cq'*L residual term
+// is measured separately. Each benchmark is run with the contact container
+// and, for comparison, with the legacy storage of contacts in a linked list.
+//
+// =============================================================================
+
+#include <list>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// =============================================================================
+
+// Legacy storage of NSC contacts, as in ChContactContainerNSC before contact pools: each contact is allocated
+// separately and kept in a std::list; contact objects are reused across collision passes through a list iterator.
+// Only contacts between two 6-dof contactables (with sliding friction) are supported.
+class ContactContainerNSC_list : public ChContactContainerNSC {
+  public:
+    typedef ChContactNSC<ChContactable_1vars<6>, ChContactable_1vars<6>> ContactType;
+
+    ContactContainerNSC_list() : n_added(0) { lastcontact = contactlist.begin(); }
+    ContactContainerNSC_list(const ContactContainerNSC_list& other) : ChContactContainerNSC(other), n_added(0) {
+        lastcontact = contactlist.begin();
+    }
+    ~ContactContainerNSC_list() { RemoveAllContacts(); }
+
+    virtual ContactContainerNSC_list* Clone() const override { return new ContactContainerNSC_list(*this); }
+
+    virtual int GetNcontacts() const override { return n_added; }
+    virtual int GetDOC_d() override { return 3 * n_added; }
+
+    virtual void RemoveAllContacts() override {
+        for (auto contact : contactlist)
+            delete contact;
+        contactlist.clear();
+        lastcontact = contactlist.begin();
+        n_added = 0;
+    }
+
+    virtual void BeginAddContact() override {
+        lastcontact = contactlist.begin();
+        n_added = 0;
+    }
+
+    virtual void AddContact(const ChCollisionInfo& cinfo) override {
+        auto objA = static_cast<ChContactable_1vars<6>*>(cinfo.modelA->GetContactable());
+        auto objB = static_cast<ChContactable_1vars<6>*>(cinfo.modelB->GetContactable());
+        if (lastcontact != contactlist.end()) {
+            // reuse old contacts
+            (*lastcontact)->Reset(objA, objB, cinfo);
+            lastcontact++;
+        } else {
+            // add new contact
+            contactlist.push_back(new ContactType(this, objA, objB, cinfo));
+            lastcontact = contactlist.end();
+        }
+        n_added++;
+    }
+
+    virtual void EndAddContact() override {
+        // remove contacts that are beyond last contact
+        while (lastcontact != contactlist.end()) {
+            delete (*lastcontact);
+            lastcontact = contactlist.erase(lastcontact);
+        }
+    }
+
+    virtual void IntLoadResidual_CqL(const unsigned int off_L,
+                                     ChVectorDynamic<>& R,
+                                     const ChVectorDynamic<>& L,
+                                     const double c) override {
+        unsigned int coffset = 0;
+        for (auto contact : contactlist) {
+            contact->ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
+            coffset += 3;
+        }
+    }
+
+    virtual void InjectConstraints(ChSystemDescriptor& mdescriptor) override {
+        for (auto contact : contactlist)
+            contact->InjectConstraints(mdescriptor);
+    }
+
+  private:
+    std::list<ContactType*> contactlist;
+    std::list<ContactType*>::iterator lastcontact;
+    int n_added;
+};
+
+// =============================================================================
+
+template <class Container>
+class ContactTestNSC {
+  public:
+    ContactTestNSC(int num_contacts);
+
+    /// Add all contacts to the contact container.
+    void AddContacts();
+
+    /// Prepare the system descriptor and the state vectors (requires contacts already added).
+    void Prepare();
+
+    ChSystemNSC m_system;
+    std::vector<ChCollisionInfo> m_cinfo;
+    ChVectorDynamic<> m_R;
+    ChVectorDynamic<> m_L;
+};
+
+template <class Container>
+ContactTestNSC<Container>::ContactTestNSC(int num_contacts) {
+    m_system.SetContactContainer(std::make_shared<Container>());
+
+    int num_bodies = 1000;
+
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    for (int i = 0; i < num_bodies; i++) {
+        auto body = std::make_shared<ChBodyEasySphere>(0.5, 1000, true, false);
+        body->SetPos(ChVector<>(ChRandom() * 100, ChRandom() * 100, ChRandom() * 100));
+        m_system.AddBody(body);
+        bodies.push_back(body);
+    }
+
+    m_cinfo.resize(num_contacts);
+    for (int i = 0; i < num_contacts; i++) {
+        int ia = (int)(ChRandom() * (num_bodies - 1));
+        int ib = (ia + 1 + (int)(ChRandom() * (num_bodies - 2))) % num_bodies;
+        ChVector<> normal = ChVector<>(ChRandom() - 0.5, ChRandom() - 0.5, ChRandom() - 0.5).GetNormalized();
+        m_cinfo[i].modelA = bodies[ia]->GetCollisionModel().get();
+        m_cinfo[i].modelB = bodies[ib]->GetCollisionModel().get();
+        m_cinfo[i].vpA = bodies[ia]->GetPos() + normal * 0.5;
+        m_cinfo[i].vpB = bodies[ib]->GetPos() - normal * 0.5;
+        m_cinfo[i].vN = normal;
+        m_cinfo[i].distance = -0.01;
+    }
+
+    m_system.Setup();
+    m_system.Update();
+}
+
+template <class Container>
+void ContactTestNSC<Container>::AddContacts() {
+    auto container = m_system.GetContactContainer();
+    container->BeginAddContact();
+    for (auto& cinfo : m_cinfo)
+        container->AddContact(cinfo);
+    container->EndAddContact();
+}
+
+template <class Container>
+void ContactTestNSC<Container>::Prepare() {
+    AddContacts();
+    m_system.Setup();
+    auto descriptor = m_system.GetSystemDescriptor();
+    descriptor->BeginInsertion();
+    m_system.InjectVariables(*descriptor);
+    m_system.InjectConstraints(*descriptor);
+    descriptor->EndInsertion();
+    m_R.Reset(m_system.GetNcoords_w());
+    m_L.Reset(m_system.GetNdoc_w());
+    for (int i = 0; i < m_L.GetRows(); i++)
+        m_L(i) = ChRandom();
+}
+
+// =============================================================================
+
+template <class Container>
+static void ContactsNSC_Add(benchmark::State& st) {
+    ContactTestNSC<Container> test((int)st.range(0));
+    test.AddContacts();  // hot start: fill the contact pools
+    while (st.KeepRunning()) {
+        test.AddContacts();
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+template <class Container>
+static void ContactsNSC_Inject(benchmark::State& st) {
+    ContactTestNSC<Container> test((int)st.range(0));
+    test.Prepare();
+    auto descriptor = test.m_system.GetSystemDescriptor();
+    auto container = test.m_system.GetContactContainer();
+    while (st.KeepRunning()) {
+        descriptor->BeginInsertion();
+        container->InjectConstraints(*descriptor);
+        descriptor->EndInsertion();
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+template <class Container>
+static void ContactsNSC_ResidualCqL(benchmark::State& st) {
+    ContactTestNSC<Container> test((int)st.range(0));
+    test.Prepare();
+    auto container = test.m_system.GetContactContainer();
+    while (st.KeepRunning()) {
+        container->IntLoadResidual_CqL(0, test.m_R, test.m_L, 1.0);
+    }
+    st.SetItemsProcessed(st.iterations() * st.range(0));
+}
+
+BENCHMARK_TEMPLATE(ContactsNSC_Add, ChContactContainerNSC)->Unit(benchmark::kMillisecond)->Arg(100000)->Arg(400000);
+BENCHMARK_TEMPLATE(ContactsNSC_Add, ContactContainerNSC_list)->Unit(benchmark::kMillisecond)->Arg(100000)->Arg(400000);
+BENCHMARK_TEMPLATE(ContactsNSC_Inject, ChContactContainerNSC)->Unit(benchmark::kMillisecond)->Arg(100000)->Arg(400000);
+BENCHMARK_TEMPLATE(ContactsNSC_Inject, ContactContainerNSC_list)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(100000)
+    ->Arg(400000);
+BENCHMARK_TEMPLATE(ContactsNSC_ResidualCqL, ChContactContainerNSC)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(100000)
+    ->Arg(400000);
+BENCHMARK_TEMPLATE(ContactsNSC_ResidualCqL, ContactContainerNSC_list)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(100000)
+    ->Arg(400000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark test for the startup time of a fleet of vehicles: construction of
+// 100 HMMWV vehicles (specified through JSON files), with mesh visualization,
+// with and without the asset cache.
+//
+// =============================================================================
+
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/powertrain/SimplePowertrain.h"
+#include "chrono_vehicle/utils/ChAssetCache.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/RigidTire.h"
+#include "chrono_vehicle/wheeled_vehicle/vehicle/WheeledVehicle.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// =============================================================================
+
+// A vehicle with its powertrain and tires
+struct Vehicle {
+    std::shared_ptr<WheeledVehicle> vehicle;
+    std::shared_ptr<SimplePowertrain> powertrain;
+    std::vector<std::shared_ptr<RigidTire>> tires;
+};
+
+static void CreateVehicle(Vehicle& v) {
+    v.vehicle = std::make_shared<WheeledVehicle>(vehicle::GetDataFile("hmmwv/vehicle/HMMWV_Vehicle.json"));
+    v.vehicle->Initialize(ChCoordsys<>(ChVector<>(0, 0, 1.6), QUNIT));
+    v.vehicle->SetChassisVisualizationType(VisualizationType::MESH);
+    v.vehicle->SetWheelVisualizationType(VisualizationType::MESH);
+
+    v.powertrain = std::make_shared<SimplePowertrain>(vehicle::GetDataFile("generic/powertrain/SimplePowertrain.json"));
+    v.powertrain->Initialize(v.vehicle->GetChassisBody(), v.vehicle->GetDriveshaft());
+
+    int num_wheels = 2 * v.vehicle->GetNumberAxles();
+    for (int i = 0; i < num_wheels; i++) {
+        auto tire = std::make_shared<RigidTire>(vehicle::GetDataFile("hmmwv/tire/HMMWV_RigidTire.json"));
+        tire->Initialize(v.vehicle->GetWheelBody(i), VehicleSide(i % 2));
+        tire->SetVisualizationType(VisualizationType::MESH);
+        v.tires.push_back(tire);
+    }
+}
+
+static void CreateFleet(benchmark::State& st, bool use_cache) {
+    int num_vehicles = (int)st.range(0);
+    ChAssetCache::SetEnabled(use_cache);
+    ChAssetCache::Clear();
+    while (st.KeepRunning()) {
+        std::vector<Vehicle> fleet(num_vehicles);
+        for (auto& v : fleet)
+            CreateVehicle(v);
+    }
+    st.SetItemsProcessed(st.iterations() * num_vehicles);
+    st.counters["loads"] = ChAssetCache::GetNumLoads();
+    st.counters["hits"] = ChAssetCache::GetNumHits();
+    ChAssetCache::SetEnabled(true);
+}
+
+static void HMMWV_Startup_NoCache(benchmark::State& st) {
+    CreateFleet(st, false);
+}
+
+static void HMMWV_Startup_Cache(benchmark::State& st) {
+    CreateFleet(st, true);
+}
+
+BENCHMARK(HMMWV_Startup_NoCache)->Unit(benchmark::kMillisecond)->Arg(100);
+BENCHMARK(HMMWV_Startup_Cache)->Unit(benchmark::kMillisecond)->Arg(100);
+
+BENCHMARK_MAIN();
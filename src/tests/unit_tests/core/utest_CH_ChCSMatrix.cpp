@@ -184,6 +184,48 @@ TEST(ChCSMatrixTest, compress) {
     ASSERT_TRUE(CompareMatrix(mat, matDYN));
 }
 
+TEST(ChCSMatrixTest, sparsity_pattern_hash) {
+    ChCSMatrix mat(3, 3, true, 6);
+    mat.SetSparsityPatternLock(true);
+    mat.SetElement(0, 0, 10.0);
+    mat.SetElement(0, 1, 0.1);
+    mat.SetElement(1, 1, 1.1);
+    mat.SetElement(2, 1, 2.1);
+    mat.SetElement(2, 2, 2.2);
+    size_t hash = mat.GetSparsityPatternHash();
+
+    // Same pattern, different values (sparsity pattern lock)
+    mat.Reset(3, 3);
+    mat.SetElement(2, 2, -1.0);
+    mat.SetElement(0, 0, -2.0);
+    mat.SetElement(2, 1, -3.0);
+    mat.SetElement(1, 1, -4.0);
+    mat.SetElement(0, 1, -5.0);
+    ASSERT_EQ(mat.GetSparsityPatternHash(), hash);
+
+    // Same pattern, built from scratch in a different order
+    ChCSMatrix mat2(3, 3, true);
+    mat2.SetElement(2, 2, 1.0);
+    mat2.SetElement(1, 1, 1.0);
+    mat2.SetElement(0, 1, 1.0);
+    mat2.SetElement(2, 1, 1.0);
+    mat2.SetElement(0, 0, 1.0);
+    ASSERT_EQ(mat2.GetSparsityPatternHash(), hash);
+
+    // One more non-zero
+    mat2.SetElement(1, 2, 1.0);
+    ASSERT_NE(mat2.GetSparsityPatternHash(), hash);
+
+    // Same index arrays, interpreted as column major
+    ChCSMatrix mat3(3, 3, false);
+    mat3.SetElement(0, 0, 1.0);
+    mat3.SetElement(1, 0, 1.0);
+    mat3.SetElement(1, 1, 1.0);
+    mat3.SetElement(1, 2, 1.0);
+    mat3.SetElement(2, 2, 1.0);
+    ASSERT_NE(mat3.GetSparsityPatternHash(), hash);
+}
+
 TEST(ChCSMatrixTest, column_major) {
     int n = 3;
 
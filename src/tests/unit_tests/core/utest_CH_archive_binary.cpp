@@ -0,0 +1,257 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the bulk array transfers of binary archives: arrays of numbers,
+// of ChVector and ChQuaternion objects, matrices and C arrays must survive a
+// round trip, and must be written with the same byte layout as the element by
+// element transfer (so that existing archives can still be read).
+//
+// =============================================================================
+
+#include <cstdio>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChQuaternion.h"
+#include "chrono/core/ChStream.h"
+#include "chrono/core/ChVector.h"
+#include "chrono/serialization/ChArchiveBinary.h"
+
+using namespace chrono;
+
+// Binary archives that transfer all arrays element by element (as before the bulk transfer was added).
+class ChArchiveOutBinaryElementwise : public ChArchiveOutBinary {
+  public:
+    ChArchiveOutBinaryElementwise(ChStreamOutBinary& mostream) : ChArchiveOutBinary(mostream) {}
+    virtual bool out_array_bulk(ChValue& bVal, const double* data, size_t msize) override { return false; }
+    virtual bool out_array_bulk(ChValue& bVal, const float* data, size_t msize) override { return false; }
+    virtual bool out_array_bulk(ChValue& bVal, const int* data, size_t msize) override { return false; }
+    virtual bool has_array_bulk() const override { return false; }
+};
+
+class ChArchiveInBinaryElementwise : public ChArchiveInBinary {
+  public:
+    ChArchiveInBinaryElementwise(ChStreamInBinary& mistream) : ChArchiveInBinary(mistream) {}
+    virtual bool in_array_bulk(const char* name, double* data, size_t msize) override { return false; }
+    virtual bool in_array_bulk(const char* name, float* data, size_t msize) override { return false; }
+    virtual bool in_array_bulk(const char* name, int* data, size_t msize) override { return false; }
+    virtual bool has_array_bulk() const override { return false; }
+};
+
+// Data set covering all the types that use the bulk transfer.
+struct ArchiveData {
+    std::vector<ChVector<>> vectors;
+    std::vector<ChQuaternion<>> quaternions;
+    std::vector<ChVector<float>> fvectors;
+    std::vector<ChVector<>> empty;
+    std::vector<double> doubles;
+    std::vector<float> floats;
+    std::vector<int> ints;
+    ChMatrixDynamic<> matrix;
+    double carray[5];
+    int iarray[3];
+    ChVector<> single;
+    std::vector<ChVector<>> vectors2;
+
+    void Fill() {
+        for (int i = 0; i < 10; i++) {
+            vectors.push_back(ChVector<>(i, 0.5 * i, -1.0 / (i + 1)));
+            doubles.push_back(1.0 / (i + 3));
+            floats.push_back(0.25f * i);
+            ints.push_back(-7 * i);
+        }
+        for (int i = 0; i < 7; i++) {
+            quaternions.push_back(ChQuaternion<>(1, 0.1 * i, 0.2 * i, -0.3 * i).GetNormalized());
+            fvectors.push_back(ChVector<float>(0.5f * i, 1.5f, -2.0f * i));
+        }
+        matrix.Reset(4, 3);
+        for (int i = 0; i < 12; i++)
+            matrix.ElementN(i) = 0.1 * i * i;
+        for (int i = 0; i < 5; i++)
+            carray[i] = 3.5 - i;
+        for (int i = 0; i < 3; i++)
+            iarray[i] = 100 + i;
+        single = ChVector<>(7, 8, 9);
+        vectors2.push_back(ChVector<>(-1, -2, -3));
+    }
+
+    void Write(ChArchiveOut& archive) {
+        archive << CHNVP(vectors);
+        archive << CHNVP(quaternions);
+        archive << CHNVP(fvectors);
+        archive << CHNVP(empty);
+        archive << CHNVP(doubles);
+        archive << CHNVP(floats);
+        archive << CHNVP(ints);
+        archive << CHNVP(matrix);
+        archive << CHNVP(carray);
+        archive << CHNVP(iarray);
+        archive << CHNVP(single);
+        archive << CHNVP(vectors2);
+    }
+
+    void Read(ChArchiveIn& archive) {
+        archive >> CHNVP(vectors);
+        archive >> CHNVP(quaternions);
+        archive >> CHNVP(fvectors);
+        archive >> CHNVP(empty);
+        archive >> CHNVP(doubles);
+        archive >> CHNVP(floats);
+        archive >> CHNVP(ints);
+        archive >> CHNVP(matrix);
+        archive >> CHNVP(carray);
+        archive >> CHNVP(iarray);
+        archive >> CHNVP(single);
+        archive >> CHNVP(vectors2);
+    }
+};
+
+template <typename T>
+static void CheckEqual(const std::vector<T>& a, const std::vector<T>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++)
+        ASSERT_TRUE(a[i] == b[i]);
+}
+
+static void CheckEqual(const ArchiveData& a, const ArchiveData& b) {
+    CheckEqual(a.vectors, b.vectors);
+    CheckEqual(a.quaternions, b.quaternions);
+    CheckEqual(a.fvectors, b.fvectors);
+    CheckEqual(a.empty, b.empty);
+    CheckEqual(a.doubles, b.doubles);
+    CheckEqual(a.floats, b.floats);
+    CheckEqual(a.ints, b.ints);
+    ASSERT_EQ(a.matrix.GetRows(), b.matrix.GetRows());
+    ASSERT_EQ(a.matrix.GetColumns(), b.matrix.GetColumns());
+    for (int i = 0; i < a.matrix.GetRows() * a.matrix.GetColumns(); i++)
+        ASSERT_EQ(a.matrix.ElementN(i), b.matrix.ElementN(i));
+    for (int i = 0; i < 5; i++)
+        ASSERT_EQ(a.carray[i], b.carray[i]);
+    for (int i = 0; i < 3; i++)
+        ASSERT_EQ(a.iarray[i], b.iarray[i]);
+    ASSERT_TRUE(a.single == b.single);
+    CheckEqual(a.vectors2, b.vectors2);
+}
+
+// Version settings of the archives: default (clustered class versions), no versions, one version per object.
+static void SetVersions(ChArchive& archive, int mode) {
+    archive.SetUseVersions(mode != 1);
+    archive.SetClusterClassVersions(mode != 2);
+}
+
+TEST(ChArchiveBinary, bulk_round_trip) {
+    ArchiveData data;
+    data.Fill();
+
+    for (int mode = 0; mode < 3; mode++) {
+        std::vector<char> buffer;
+        {
+            ChStreamOutBinaryVector stream(&buffer);
+            ChArchiveOutBinary archive(stream);
+            SetVersions(archive, mode);
+            data.Write(archive);
+        }
+
+        ArchiveData data_in;
+        ChStreamInBinaryVector stream(&buffer);
+        ChArchiveInBinary archive(stream);
+        SetVersions(archive, mode);
+        data_in.Read(archive);
+        CheckEqual(data, data_in);
+        ASSERT_TRUE(stream.End_of_stream());
+    }
+}
+
+TEST(ChArchiveBinary, bulk_layout) {
+    ArchiveData data;
+    data.Fill();
+
+    for (int mode = 0; mode < 3; mode++) {
+        std::vector<char> buffer_bulk;
+        {
+            ChStreamOutBinaryVector stream(&buffer_bulk);
+            ChArchiveOutBinary archive(stream);
+            SetVersions(archive, mode);
+            data.Write(archive);
+        }
+        std::vector<char> buffer_elem;
+        {
+            ChStreamOutBinaryVector stream(&buffer_elem);
+            ChArchiveOutBinaryElementwise archive(stream);
+            SetVersions(archive, mode);
+            data.Write(archive);
+        }
+
+        // Same bytes with and without the bulk transfer
+        ASSERT_TRUE(buffer_bulk == buffer_elem);
+
+        // Archives written element by element are read with the bulk transfer, and vice versa
+        {
+            ArchiveData data_in;
+            ChStreamInBinaryVector stream(&buffer_elem);
+            ChArchiveInBinary archive(stream);
+            SetVersions(archive, mode);
+            data_in.Read(archive);
+            CheckEqual(data, data_in);
+        }
+        {
+            ArchiveData data_in;
+            ChStreamInBinaryVector stream(&buffer_bulk);
+            ChArchiveInBinaryElementwise archive(stream);
+            SetVersions(archive, mode);
+            data_in.Read(archive);
+            CheckEqual(data, data_in);
+        }
+    }
+}
+
+#ifdef CHRONO_HAS_ZLIB
+
+TEST(ChArchiveBinary, gzip_round_trip) {
+    ArchiveData data;
+    data.Fill();
+
+    std::string filename = "utest_CH_archive_binary.dat.gz";
+    {
+        ChStreamOutBinaryGzipFile stream(filename.c_str());
+        ChArchiveOutBinary archive(stream);
+        data.Write(archive);
+    }
+    {
+        ArchiveData data_in;
+        ChStreamInBinaryGzipFile stream(filename.c_str());
+        ChArchiveInBinary archive(stream);
+        data_in.Read(archive);
+        CheckEqual(data, data_in);
+    }
+    std::remove(filename.c_str());
+
+    // Uncompressed files are read by the gzip stream too
+    filename = "utest_CH_archive_binary.dat";
+    {
+        ChStreamOutBinaryFile stream(filename.c_str());
+        ChArchiveOutBinary archive(stream);
+        data.Write(archive);
+    }
+    {
+        ArchiveData data_in;
+        ChStreamInBinaryGzipFile stream(filename.c_str());
+        ChArchiveInBinary archive(stream);
+        data_in.Read(archive);
+        CheckEqual(data, data_in);
+    }
+    std::remove(filename.c_str());
+}
+
+#endif
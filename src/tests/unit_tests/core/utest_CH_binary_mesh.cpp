@@ -0,0 +1,105 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the Chrono binary mesh format: a mesh written with
+// WriteBinaryMesh and loaded with LoadBinaryMesh must be identical to the
+// original, including the map of neighboring triangles.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+
+using namespace chrono;
+using namespace chrono::geometry;
+
+// A grid of nx x ny quads, split in two triangles each, with normals and UV coordinates.
+static void CreateGrid(ChTriangleMeshConnected& mesh, int nx, int ny) {
+    for (int iy = 0; iy <= ny; iy++) {
+        for (int ix = 0; ix <= nx; ix++) {
+            mesh.getCoordsVertices().push_back(ChVector<>(0.1 * ix, 0.2 * iy, 0.01 * ix * iy));
+            mesh.getCoordsNormals().push_back(ChVector<>(0, 0, 1));
+            mesh.getCoordsUV().push_back(ChVector<>(ix / (double)nx, iy / (double)ny, 0));
+        }
+    }
+    for (int iy = 0; iy < ny; iy++) {
+        for (int ix = 0; ix < nx; ix++) {
+            int v0 = iy * (nx + 1) + ix;
+            ChVector<int> t1(v0, v0 + 1, v0 + nx + 2);
+            ChVector<int> t2(v0, v0 + nx + 2, v0 + nx + 1);
+            mesh.getIndicesVertexes().push_back(t1);
+            mesh.getIndicesVertexes().push_back(t2);
+            mesh.getIndicesNormals().push_back(t1);
+            mesh.getIndicesNormals().push_back(t2);
+            mesh.getIndicesUV().push_back(t1);
+            mesh.getIndicesUV().push_back(t2);
+        }
+    }
+}
+
+template <typename T>
+static void CheckEqual(const std::vector<T>& a, const std::vector<T>& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++)
+        ASSERT_TRUE(a[i] == b[i]);
+}
+
+TEST(ChTriangleMeshConnected, binary_round_trip) {
+    const std::string filename = "utest_CH_binary_mesh.bin";
+
+    ChTriangleMeshConnected mesh;
+    CreateGrid(mesh, 7, 5);
+    std::vector<std::array<int, 4>> tri_map;
+    mesh.ComputeNeighbouringTriangleMap(tri_map);
+
+    ASSERT_TRUE(mesh.WriteBinaryMesh(filename, true));
+    ASSERT_TRUE(ChTriangleMeshConnected::IsBinaryMeshFile(filename));
+
+    ChTriangleMeshConnected loaded;
+    std::vector<std::array<int, 4>> loaded_tri_map;
+    ASSERT_TRUE(loaded.LoadBinaryMesh(filename, true, true, &loaded_tri_map));
+
+    CheckEqual(mesh.getCoordsVertices(), loaded.getCoordsVertices());
+    CheckEqual(mesh.getCoordsNormals(), loaded.getCoordsNormals());
+    CheckEqual(mesh.getCoordsUV(), loaded.getCoordsUV());
+    CheckEqual(mesh.getIndicesVertexes(), loaded.getIndicesVertexes());
+    CheckEqual(mesh.getIndicesNormals(), loaded.getIndicesNormals());
+    CheckEqual(mesh.getIndicesUV(), loaded.getIndicesUV());
+    CheckEqual(tri_map, loaded_tri_map);
+
+    // Normals and UV coordinates are optional
+    ChTriangleMeshConnected loaded_plain;
+    ASSERT_TRUE(loaded_plain.LoadBinaryMesh(filename, false, false));
+    CheckEqual(mesh.getCoordsVertices(), loaded_plain.getCoordsVertices());
+    CheckEqual(mesh.getIndicesVertexes(), loaded_plain.getIndicesVertexes());
+    ASSERT_TRUE(loaded_plain.getCoordsNormals().empty());
+    ASSERT_TRUE(loaded_plain.getIndicesUV().empty());
+
+    // Without the map of neighboring triangles in the file, none is returned
+    ASSERT_TRUE(mesh.WriteBinaryMesh(filename, false));
+    ASSERT_TRUE(loaded.LoadBinaryMesh(filename, true, true, &loaded_tri_map));
+    ASSERT_TRUE(loaded_tri_map.empty());
+    CheckEqual(mesh.getIndicesVertexes(), loaded.getIndicesVertexes());
+
+    // A truncated file is rejected
+    {
+        std::ofstream mf(filename, std::ios::binary | std::ios::trunc);
+        mf.write("CHMESH", 6);
+    }
+    ASSERT_FALSE(loaded.LoadBinaryMesh(filename));
+
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,236 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit tests for the native sparse LDL' factorization (ChSparseLDL)
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChSparseLDL.h"
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverSparseLDL.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+
+using namespace chrono;
+
+// Load the stiffness-like matrix of a 2D grid (5-point stencil), with a diagonal shift.
+static void SetGridElements(int nx, int ny, double shift, ChCSMatrix& A) {
+    for (int i = 0; i < nx; i++) {
+        for (int j = 0; j < ny; j++) {
+            int k = i * ny + j;
+            A.SetElement(k, k, 4 + shift);
+            if (i > 0)
+                A.SetElement(k, k - ny, -1);
+            if (i < nx - 1)
+                A.SetElement(k, k + ny, -1);
+            if (j > 0)
+                A.SetElement(k, k - 1, -1);
+            if (j < ny - 1)
+                A.SetElement(k, k + 1, -1);
+        }
+    }
+}
+
+static void GridMatrix(int nx, int ny, double shift, ChCSMatrix& A) {
+    int n = nx * ny;
+    A.Reset(n, n, 5 * n);
+    SetGridElements(nx, ny, shift, A);
+    A.Compress();
+}
+
+// Saddle-point matrix [K C'; C 0], with K the grid matrix and C a random set of independent constraints.
+static void SaddlePointMatrix(int nx, int ny, int nc, ChCSMatrix& A) {
+    int n = nx * ny;
+    A.Reset(n + nc, n + nc, 5 * n + 4 * nc);
+    SetGridElements(nx, ny, 0.1, A);
+    std::vector<int> dofs(n - 1);
+    std::iota(dofs.begin(), dofs.end(), 0);
+    std::shuffle(dofs.begin(), dofs.end(), std::mt19937(42));
+    for (int c = 0; c < nc; c++) {
+        int k = dofs[c];
+        A.SetElement(n + c, k, 1);
+        A.SetElement(k, n + c, 1);
+        A.SetElement(n + c, k + 1, -1);
+        A.SetElement(k + 1, n + c, -1);
+    }
+    A.Compress();
+}
+
+// Relative residual |A*x - b| / |b|.
+static double Residual(const ChCSMatrix& A, const ChMatrixDynamic<>& x, const ChMatrixDynamic<>& b) {
+    ChMatrixDynamic<> Ax(b.GetRows(), 1);
+    A.MatrMultiply(x, Ax);
+    Ax -= b;
+    return Ax.NormTwo() / b.NormTwo();
+}
+
+static void RandomVector(int n, ChMatrixDynamic<>& b) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    b.Reset(n, 1);
+    for (int i = 0; i < n; i++)
+        b(i) = dist(gen);
+}
+
+TEST(ChSparseLDLTest, positive_definite) {
+    ChCSMatrix A;
+    GridMatrix(30, 40, 0.0, A);
+    int n = A.GetNumRows();
+
+    ChSparseLDL ldl;
+    ASSERT_TRUE(ldl.Analyze(A));
+    ASSERT_TRUE(ldl.Factorize(A));
+    ASSERT_EQ(ldl.GetNumPerturbedPivots(), 0);
+
+    // The fill-reducing ordering must do much better than the banded natural ordering
+    ASSERT_LT(ldl.GetNNZ_L(), (size_t)(n * 30));
+
+    ChMatrixDynamic<> b;
+    ChMatrixDynamic<> x(n, 1);
+    RandomVector(n, b);
+    ldl.Solve(b, x);
+    ASSERT_LT(Residual(A, x, b), 1e-12);
+}
+
+TEST(ChSparseLDLTest, saddle_point) {
+    ChCSMatrix A;
+    SaddlePointMatrix(20, 20, 30, A);
+    int n = A.GetNumRows();
+
+    ChSparseLDL ldl;
+    ASSERT_TRUE(ldl.Analyze(A));
+    ASSERT_TRUE(ldl.Factorize(A));
+
+    ChMatrixDynamic<> b;
+    RandomVector(n, b);
+    ChMatrixDynamic<> x(b);
+    ldl.Solve(x, x);
+    ASSERT_LT(Residual(A, x, b), 1e-10);
+}
+
+TEST(ChSparseLDLTest, refactorization) {
+    ChCSMatrix A;
+    GridMatrix(25, 25, 0.0, A);
+    int n = A.GetNumRows();
+
+    ChSparseLDL ldl;
+    ASSERT_TRUE(ldl.Analyze(A));
+    ASSERT_TRUE(ldl.Factorize(A));
+
+    // Same sparsity pattern, different values: reuse the symbolic analysis
+    ChCSMatrix B;
+    GridMatrix(25, 25, 2.5, B);
+    ASSERT_EQ(A.GetSparsityPatternHash(), B.GetSparsityPatternHash());
+    ASSERT_TRUE(ldl.Factorize(B));
+
+    ChMatrixDynamic<> b;
+    ChMatrixDynamic<> x(n, 1);
+    RandomVector(n, b);
+    ldl.Solve(b, x);
+    ASSERT_LT(Residual(B, x, b), 1e-12);
+}
+
+TEST(ChSparseLDLTest, parallel) {
+    ChCSMatrix A;
+    SaddlePointMatrix(60, 60, 200, A);
+    int n = A.GetNumRows();
+
+    ChMatrixDynamic<> b;
+    RandomVector(n, b);
+
+    ChSparseLDL serial;
+    serial.SetParallel(false);
+    serial.Analyze(A);
+    serial.Factorize(A);
+    ChMatrixDynamic<> x_serial(n, 1);
+    serial.Solve(b, x_serial);
+
+    auto& scheduler = ChTaskScheduler::GetInstance();
+    int num_threads = scheduler.GetNumThreads();
+    scheduler.SetNumThreads(4);
+
+    ChSparseLDL parallel;
+    parallel.Analyze(A);
+    parallel.Factorize(A);
+    ChMatrixDynamic<> x_parallel(n, 1);
+    parallel.Solve(b, x_parallel);
+
+    scheduler.SetNumThreads(num_threads);
+
+    // The parallel factorization performs the same operations, in the same order, on each front
+    ASSERT_EQ(serial.GetPermutation(), parallel.GetPermutation());
+    for (int i = 0; i < n; i++)
+        ASSERT_EQ(x_serial(i), x_parallel(i));
+    ASSERT_LT(Residual(A, x_parallel, b), 1e-10);
+}
+
+TEST(ChSparseLDLTest, solver) {
+    // Chain of pendulums connected by revolute joints, integrated with HHT
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    int num_bodies = 20;
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    std::shared_ptr<ChBody> prev = ground;
+    for (int i = 0; i < num_bodies; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetMass(1);
+        body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        body->SetPos(ChVector<>(i + 1.0, 0, 0));
+        system.AddBody(body);
+        auto revolute = std::make_shared<ChLinkLockRevolute>();
+        revolute->Initialize(prev, body, ChCoordsys<>(ChVector<>(i, 0, 0), QUNIT));
+        system.AddLink(revolute);
+        bodies.push_back(body);
+        prev = body;
+    }
+
+    system.SetSolverType(ChSolver::Type::SPARSE_LDL);
+    auto solver = std::static_pointer_cast<ChSolverSparseLDL>(system.GetSolver());
+    ASSERT_EQ(solver->GetType(), ChSolver::Type::SPARSE_LDL);
+
+    system.SetTimestepperType(ChTimestepper::Type::HHT);
+    auto integrator = std::static_pointer_cast<ChTimestepperHHT>(system.GetTimestepper());
+    integrator->SetAlpha(-0.2);
+    integrator->SetMaxiters(20);
+    integrator->SetAbsTolerances(1e-8);
+
+    for (int i = 0; i < 100; i++)
+        system.DoStepDynamics(1e-3);
+
+    // The chain fell under gravity, preserving the length of the links
+    ASSERT_LT(bodies.back()->GetPos().y(), -1e-3);
+    ChVector<> joint(0, 0, 0);
+    for (auto& body : bodies) {
+        ASSERT_NEAR((body->GetPos() - joint).Length(), 1.0, 1e-6);
+        joint = body->GetPos();
+    }
+
+    // The sparsity pattern does not change: a single symbolic analysis
+    ASSERT_GT(solver->GetNumSetupCalls(), 1);
+    ASSERT_EQ(solver->GetNumAnalysisCalls(), 1);
+    ASSERT_EQ(solver->GetNumFactorizationCalls(), solver->GetNumSetupCalls());
+}
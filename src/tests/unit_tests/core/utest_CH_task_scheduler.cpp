@@ -0,0 +1,92 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the work-stealing task scheduler.
+//
+// =============================================================================
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/parallel/ChTaskScheduler.h"
+
+using namespace chrono;
+
+TEST(ChTaskScheduler, ParallelFor) {
+    ChTaskScheduler scheduler(4);
+    std::vector<int> visits(10000, 0);
+    scheduler.ParallelFor(0, (int)visits.size(), 0, [&](int from, int to) {
+        for (int i = from; i < to; i++)
+            visits[i]++;
+    });
+    for (auto v : visits)
+        ASSERT_EQ(v, 1);
+}
+
+TEST(ChTaskScheduler, ParallelForMaxThreads) {
+    ChTaskScheduler scheduler(4);
+    std::vector<int> visits(10000, 0);
+    std::atomic<int> running(0);
+    std::atomic<int> max_running(0);
+    scheduler.ParallelFor(0, (int)visits.size(), 10,
+                          [&](int from, int to) {
+                              int r = ++running;
+                              int m = max_running;
+                              while (r > m && !max_running.compare_exchange_weak(m, r)) {
+                              }
+                              for (int i = from; i < to; i++)
+                                  visits[i]++;
+                              std::this_thread::sleep_for(std::chrono::microseconds(10));
+                              running--;
+                          },
+                          2);
+    for (auto v : visits)
+        ASSERT_EQ(v, 1);
+    ASSERT_LE(max_running, 2);
+}
+
+TEST(ChTaskScheduler, ParallelReduce) {
+    ChTaskScheduler scheduler(4);
+    long long sum = scheduler.ParallelReduce(0, 100000, 0, 0LL,
+                                             [](int from, int to, long long init) {
+                                                 for (int i = from; i < to; i++)
+                                                     init += i;
+                                                 return init;
+                                             },
+                                             [](long long a, long long b) { return a + b; });
+    ASSERT_EQ(sum, 100000LL * 99999LL / 2);
+}
+
+TEST(ChTaskScheduler, NestedTaskGroups) {
+    ChTaskScheduler scheduler(3);
+    std::atomic<int> count(0);
+    ChTaskScheduler::TaskGroup outer(scheduler);
+    for (int i = 0; i < 8; i++) {
+        outer.Run([&]() {
+            scheduler.ParallelFor(0, 100, 1, [&](int from, int to) { count += to - from; });
+        });
+    }
+    outer.Wait();
+    ASSERT_EQ(count, 800);
+}
+
+TEST(ChTaskScheduler, Exception) {
+    ChTaskScheduler scheduler(2);
+    ChTaskScheduler::TaskGroup group(scheduler);
+    group.Run([]() { throw std::runtime_error("task failed"); });
+    ASSERT_THROW(group.Wait(), std::runtime_error);
+}
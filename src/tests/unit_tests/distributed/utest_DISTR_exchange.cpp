@@ -0,0 +1,124 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the non-blocking exchange between ranks: a row of spheres moves at
+// constant speed along the split axis, so that bodies are continuously shared,
+// handed over and dropped by the sub-domains. Every body must have exactly one
+// owner at each step and follow the analytical trajectory. The fraction of the
+// exchange time overlapped with computation is reported on the master rank.
+//
+// To be run on any number of MPI ranks (mpirun -np N utest_DISTR_exchange).
+//
+// =============================================================================
+
+#include <mpi.h>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChMaterialSurfaceSMC.h"
+
+#include "chrono_distributed/collision/ChCollisionModelDistributed.h"
+#include "chrono_distributed/comm/ChCommDistributed.h"
+#include "chrono_distributed/physics/ChSystemDistributed.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+double dt = 1e-3;
+int num_steps = 1000;
+int num_balls = 40;
+double radius = 0.1;
+double speed = 2.0;
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    ChSystemDistributed sys(MPI_COMM_WORLD, 0.5, 1000);
+    sys.Set_G_acc(ChVector<double>(0, 0, 0));
+    sys.GetDomain()->SetSplitAxis(0);
+    sys.GetDomain()->SetSimDomain(0, 20, -1, 1, -1, 1);
+
+    auto mat = std::make_shared<ChMaterialSurfaceSMC>();
+
+    // Balls spaced by twice their diameter, all moving in +x: no contacts
+    for (int i = 0; i < num_balls; i++) {
+        auto ball = std::make_shared<ChBody>(std::make_shared<ChCollisionModelDistributed>(), ChMaterialSurface::SMC);
+        ball->SetMaterialSurface(mat);
+        ball->SetMass(1);
+        ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+        ball->SetPos(ChVector<>(0.5 + 4 * radius * i, 0, 0));
+        ball->SetPos_dt(ChVector<>(speed, 0, 0));
+        ball->GetCollisionModel()->ClearModel();
+        ball->GetCollisionModel()->AddSphere(radius, ChVector<>(0, 0, 0));
+        ball->GetCollisionModel()->BuildModel();
+        ball->SetCollide(true);
+        sys.AddBody(ball);
+    }
+
+    bool passed = true;
+    sys.GetComm()->ResetExchangeStats();
+
+    for (int step = 0; step < num_steps; step++) {
+        sys.DoStepDynamics(dt);
+
+        // Each body must be owned by exactly one rank
+        int num_owned = 0;
+        for (uint i = 0; i < sys.data_manager->num_rigid_bodies; i++) {
+            int status = sys.ddm->comm_status[i];
+            if (status == distributed::OWNED || status == distributed::SHARED_UP || status == distributed::SHARED_DOWN)
+                num_owned++;
+        }
+        int num_owned_global = 0;
+        MPI_Allreduce(&num_owned, &num_owned_global, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        if (num_owned_global != num_balls) {
+            if (my_rank == 0)
+                printf("Step %d: %d owned bodies, expected %d\n", step, num_owned_global, num_balls);
+            passed = false;
+            break;
+        }
+    }
+
+    // Owned bodies must be where the constant-speed motion puts them
+    double time = sys.GetChTime();
+    for (uint i = 0; i < sys.data_manager->num_rigid_bodies; i++) {
+        int status = sys.ddm->comm_status[i];
+        if (status != distributed::OWNED && status != distributed::SHARED_UP && status != distributed::SHARED_DOWN)
+            continue;
+        auto body = sys.Get_bodylist()[i];
+        double x = 0.5 + 4 * radius * body->GetGid() + speed * time;
+        if (std::abs(body->GetPos().x() - x) > 1e-6) {
+            printf("Rank %d: body %u at x = %g, expected %g\n", my_rank, body->GetGid(), body->GetPos().x(), x);
+            passed = false;
+        }
+    }
+
+    int local_ok = passed ? 1 : 0;
+    int all_ok = 0;
+    MPI_Allreduce(&local_ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+    const ChCommDistributed::ExchangeStats& stats = sys.GetComm()->GetExchangeStats();
+    double ratio = sys.GetComm()->GetOverlapRatio();
+    double min_ratio = 0;
+    MPI_Reduce(&ratio, &min_ratio, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+    if (my_rank == 0) {
+        printf("Exchanges: %d  post: %g s  overlap: %g s  wait: %g s  process: %g s\n", stats.num_exchanges,
+               stats.post_time, stats.overlap_time, stats.wait_time, stats.process_time);
+        printf("Communication/compute overlap ratio (min over ranks): %g\n", min_ratio);
+    }
+
+    MPI_Finalize();
+    return all_ok ? 0 : 1;
+}
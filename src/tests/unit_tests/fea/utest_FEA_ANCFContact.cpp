@@ -170,14 +170,14 @@ class MyContactContainer : public ChContactContainerSMC {
     MyContactContainer() {}
     // Traverse the list contactlist_6_6
     bool isThereContacts(std::shared_ptr<ChElementBase> myShellANCF, bool print) {
-        auto iter = contactlist_333_333.begin();
         int num_contact = 0;
-        while (iter != contactlist_333_333.end()) {
-            ChContactable* objA = (*iter)->GetObjA();
-            ChContactable* objB = (*iter)->GetObjB();
-            ChVector<> p1 = (*iter)->GetContactP1();
-            ChVector<> p2 = (*iter)->GetContactP2();
-            double CD = (*iter)->GetContactDistance();
+        for (size_t i = 0; i < contactlist_333_333.size(); ++i) {
+            auto& contact = contactlist_333_333[i];
+            ChContactable* objA = contact.GetObjA();
+            ChContactable* objB = contact.GetObjB();
+            ChVector<> p1 = contact.GetContactP1();
+            ChVector<> p2 = contact.GetContactP2();
+            double CD = contact.GetContactDistance();
 
             if (print) {
                 printf("P1=[%f %f %f]\n", p1.x(), p1.y(), p1.z());
@@ -185,7 +185,6 @@ class MyContactContainer : public ChContactContainerSMC {
                 printf("Contact Distance=%f\n\n", CD);
             }
             num_contact++;
-            ++iter;
         }
         return num_contact > 0;
     }
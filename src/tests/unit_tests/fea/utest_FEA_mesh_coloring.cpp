@@ -0,0 +1,107 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the element coloring in ChMesh: the internal forces, the
+// automatic gravity loads and the M*v products of a grid of ANCF shell elements
+// are evaluated with 1 and with 4 threads; the results must be identical.
+//
+// =============================================================================
+
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono/fea/ChElementShellANCF.h"
+#include "chrono/fea/ChMesh.h"
+
+using namespace chrono;
+using namespace fea;
+
+static void Evaluate(std::shared_ptr<ChMesh> mesh, ChVectorDynamic<>& F, ChVectorDynamic<>& Mv) {
+    ChVectorDynamic<> w(mesh->GetDOF_w());
+    for (int i = 0; i < w.GetRows(); i++)
+        w(i) = 0.01 * i;
+
+    F.Reset(mesh->GetDOF_w());
+    mesh->IntLoadResidual_F(0, F, 1.0);
+    Mv.Reset(mesh->GetDOF_w());
+    mesh->IntLoadResidual_Mv(0, Mv, w, 1.0);
+}
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC my_system;
+    my_system.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    // Grid of 8x8 ANCF shell elements, with automatic gravity loads
+    const int numDiv_x = 8;
+    const int numDiv_y = 8;
+    const int N_x = numDiv_x + 1;
+    const double dx = 0.1;
+    const double dy = 0.1;
+
+    auto my_mesh = std::make_shared<ChMesh>();
+    for (int i = 0; i < N_x * (numDiv_y + 1); i++) {
+        auto node = std::make_shared<ChNodeFEAxyzD>(ChVector<>((i % N_x) * dx, (i / N_x) * dy, 0), ChVector<>(0, 0, 1));
+        node->SetMass(0);
+        if (i % N_x == 0)
+            node->SetFixed(true);
+        my_mesh->AddNode(node);
+    }
+
+    auto mat = std::make_shared<ChMaterialShellANCF>(500, 2.1e7, 0.3);
+    for (int i = 0; i < numDiv_x * numDiv_y; i++) {
+        int node0 = (i / numDiv_x) * N_x + i % numDiv_x;
+        auto element = std::make_shared<ChElementShellANCF>();
+        element->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node0)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node0 + 1)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node0 + 1 + N_x)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node0 + N_x)));
+        element->SetDimensions(dx, dy);
+        element->AddLayer(0.01, 0, mat);
+        element->SetAlphaDamp(0.0);
+        my_mesh->AddElement(element);
+    }
+    my_system.Add(my_mesh);
+    my_system.SetupInitial();
+    my_mesh->Setup();
+
+    // Elements in a structured quad grid can be split in 4 colors.
+    int num_colors = my_mesh->GetNelementColors();
+    if (num_colors != 4) {
+        std::cout << "Unexpected number of colors: " << num_colors << "\n";
+        return 1;
+    }
+
+    ChVectorDynamic<> F1, Mv1, F4, Mv4;
+    ChTaskScheduler::GetInstance().SetNumThreads(1);
+    Evaluate(my_mesh, F1, Mv1);
+    ChTaskScheduler::GetInstance().SetNumThreads(4);
+    Evaluate(my_mesh, F4, Mv4);
+
+    double gravity_z = 0;
+    for (int i = 0; i < F1.GetRows(); i++) {
+        if (F1(i) != F4(i) || Mv1(i) != Mv4(i)) {
+            std::cout << "Results differ at row " << i << "\n";
+            return 1;
+        }
+        if (i % 6 == 2)
+            gravity_z += F1(i);
+    }
+
+    // The free nodes carry (a part of) the weight of the shell.
+    if (gravity_z >= 0) {
+        std::cout << "Missing gravity loads\n";
+        return 1;
+    }
+
+    std::cout << "Unit test check succeeded\n";
+    return 0;
+}
@@ -0,0 +1,170 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test comparing the contacts found with the uniform grid
+// and with the hashed grid broadphase or the pair cache, for a granular pile in
+// a container on a large ground plate, with a few particles far away from the
+// pile.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+static void CreateModel(ChSystemParallelNSC* system) {
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+    system->GetSettings()->solver.max_iteration_sliding = 25;
+    system->GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    system->ChangeSolverType(SolverType::APGD);
+    system->GetSettings()->collision.collision_envelope = 0.01;
+    system->GetSettings()->collision.bins_per_axis = vec3(10, 10, 10);
+    system->GetSettings()->max_threads = 1;
+    system->GetSettings()->perform_thread_tuning = false;
+    CHOMPfunctions::SetNumThreads(1);
+
+    auto mat = std::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.5f);
+
+    // Container on a large ground plate (the plate goes to the second level of the hashed grid)
+    std::shared_ptr<ChBody> container(system->NewBody());
+    container->SetMaterialSurface(mat);
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    double hthick = 0.05;
+    container->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(container.get(), ChVector<>(20, 20, hthick), ChVector<>(0, 0, -hthick));
+    utils::AddBoxGeometry(container.get(), ChVector<>(hthick, 1, 1), ChVector<>(-1 - hthick, 0, 1));
+    utils::AddBoxGeometry(container.get(), ChVector<>(hthick, 1, 1), ChVector<>(1 + hthick, 0, 1));
+    utils::AddBoxGeometry(container.get(), ChVector<>(1, hthick, 1), ChVector<>(0, -1 - hthick, 1));
+    utils::AddBoxGeometry(container.get(), ChVector<>(1, hthick, 1), ChVector<>(0, 1 + hthick, 1));
+    container->GetCollisionModel()->BuildModel();
+    system->AddBody(container);
+
+    // Granular pile
+    double radius = 0.1;
+    srand(1);
+    for (int ix = -4; ix <= 4; ix++) {
+        for (int iy = -4; iy <= 4; iy++) {
+            for (int iz = 0; iz < 6; iz++) {
+                ChVector<> rnd(rand() % 1000 / 100000.0, rand() % 1000 / 100000.0, rand() % 1000 / 100000.0);
+                std::shared_ptr<ChBody> ball(system->NewBody());
+                ball->SetMaterialSurface(mat);
+                ball->SetMass(1);
+                ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+                ball->SetPos(ChVector<>(0.21 * ix, 0.21 * iy, 0.21 * iz + 0.15) + rnd);
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), radius);
+                ball->GetCollisionModel()->BuildModel();
+                system->AddBody(ball);
+            }
+        }
+    }
+
+    // Outliers: a pair of particles far away, within the collision envelope of each other, falling freely
+    for (int i = 0; i < 2; i++) {
+        std::shared_ptr<ChBody> ball(system->NewBody());
+        ball->SetMaterialSurface(mat);
+        ball->SetMass(1);
+        ball->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+        ball->SetPos(ChVector<>(1e4 + 0.205 * i, 0, 1e4));
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), radius);
+        ball->GetCollisionModel()->BuildModel();
+        system->AddBody(ball);
+    }
+}
+
+// Sync the positions and velocities of the rigid bodies
+static void Sync(ChSystemParallel* system_A, ChSystemParallel* system_B) {
+    for (int i = 0; i < system_A->Get_bodylist().size(); i++) {
+        system_B->Get_bodylist().at(i)->SetPos(system_A->Get_bodylist().at(i)->GetPos());
+        system_B->Get_bodylist().at(i)->SetPos_dt(system_A->Get_bodylist().at(i)->GetPos_dt());
+    }
+}
+
+// Sorted list of the pairs of bodies in contact.
+static std::vector<std::pair<int, int>> ContactPairs(ChSystemParallel* system) {
+    std::vector<std::pair<int, int>> pairs;
+    auto& bids = system->data_manager->host_data.bids_rigid_rigid;
+    for (int i = 0; i < (signed)system->data_manager->num_rigid_contacts; i++)
+        pairs.push_back(std::make_pair(std::min(bids[i].x, bids[i].y), std::max(bids[i].x, bids[i].y)));
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+// Simulate with the uniform grid, and check that the same contacts are found by the tested broadphase.
+static void CompareBroadphase(ChSystemParallelNSC& system_grid, ChSystemParallelNSC& system_test) {
+    for (int i = 0; i < 300; i++) {
+        Sync(&system_grid, &system_test);
+        system_grid.DoStepDynamics(1e-3);
+        system_test.DoStepDynamics(1e-3);
+
+        ASSERT_EQ(system_grid.data_manager->num_rigid_contacts, system_test.data_manager->num_rigid_contacts);
+        ASSERT_EQ(ContactPairs(&system_grid), ContactPairs(&system_test));
+    }
+
+    // The pile settled on the plate, and the outliers are still in contact
+    auto pairs = ContactPairs(&system_test);
+    int num_bodies = (int)system_test.Get_bodylist().size();
+    ASSERT_GT(system_test.data_manager->num_rigid_contacts, 9 * 9);
+    ASSERT_TRUE(std::binary_search(pairs.begin(), pairs.end(), std::make_pair(num_bodies - 2, num_bodies - 1)));
+}
+
+static void TestHashed(real cell_size) {
+    ChSystemParallelNSC system_grid;
+    ChSystemParallelNSC system_hashed;
+    CreateModel(&system_grid);
+    CreateModel(&system_hashed);
+    system_hashed.GetSettings()->collision.broadphase_algorithm = BroadPhaseType::BROADPHASE_HASHED;
+    system_hashed.GetSettings()->collision.hashed_cell_size = cell_size;
+
+    CompareBroadphase(system_grid, system_hashed);
+
+    // Only the ground plate is in the second level
+    ASSERT_EQ(system_hashed.data_manager->measures.collision.number_of_large_shapes, 1u);
+    ASSERT_GT(system_hashed.data_manager->measures.collision.hashed_large_cell_size, 40);
+}
+
+TEST(ChronoParallel, broadphase_hashed) {
+    TestHashed(0);
+}
+
+TEST(ChronoParallel, broadphase_hashed_fixed_cells) {
+    TestHashed(0.6);
+}
+
+TEST(ChronoParallel, broadphase_pair_cache) {
+    ChSystemParallelNSC system_grid;
+    ChSystemParallelNSC system_cached;
+    CreateModel(&system_grid);
+    CreateModel(&system_cached);
+    system_cached.GetSettings()->collision.use_pair_cache = true;
+
+    CompareBroadphase(system_grid, system_cached);
+
+    // The cached pairs are reused in most steps, while the pile falls and settles
+    const collision_measures& measures = system_cached.data_manager->measures.collision;
+    ASSERT_EQ(measures.pair_cache_reuses + measures.pair_cache_rebuilds, 300u);
+    ASSERT_GE(measures.pair_cache_rebuilds, 1u);
+    ASSERT_GT(measures.pair_cache_reuse_rate, 0.5);
+    ASSERT_GE(measures.number_of_cached_pairs, measures.number_of_contacts_possible);
+}
@@ -0,0 +1,138 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test comparing the contacts found by the analytical
+// narrowphase one pair at a time and in batches, for a mix of spheres, capsules,
+// and boxes falling in a container.
+//
+// =============================================================================
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+static void CreateModel(ChSystemParallelNSC* system, NarrowPhaseType narrowphase, bool batched) {
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+    system->GetSettings()->solver.max_iteration_sliding = 25;
+    system->GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    system->ChangeSolverType(SolverType::APGD);
+    system->GetSettings()->collision.collision_envelope = 0.01;
+    system->GetSettings()->collision.bins_per_axis = vec3(10, 10, 10);
+    system->GetSettings()->collision.narrowphase_algorithm = narrowphase;
+    system->GetSettings()->collision.use_batched_narrowphase = batched;
+    system->GetSettings()->max_threads = 1;
+    system->GetSettings()->perform_thread_tuning = false;
+    CHOMPfunctions::SetNumThreads(1);
+
+    auto mat = std::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.5f);
+
+    std::shared_ptr<ChBody> container(system->NewBody());
+    container->SetMaterialSurface(mat);
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    double hthick = 0.05;
+    container->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(container.get(), ChVector<>(1, 1, hthick), ChVector<>(0, 0, -hthick));
+    utils::AddBoxGeometry(container.get(), ChVector<>(hthick, 1, 1), ChVector<>(-1 - hthick, 0, 1));
+    utils::AddBoxGeometry(container.get(), ChVector<>(hthick, 1, 1), ChVector<>(1 + hthick, 0, 1));
+    utils::AddBoxGeometry(container.get(), ChVector<>(1, hthick, 1), ChVector<>(0, -1 - hthick, 1));
+    utils::AddBoxGeometry(container.get(), ChVector<>(1, hthick, 1), ChVector<>(0, 1 + hthick, 1));
+    container->GetCollisionModel()->BuildModel();
+    system->AddBody(container);
+
+    // Spheres, with a capsule every fifth body, tilted so that all capsule contacts are tested
+    srand(1);
+    int count = 0;
+    for (int ix = -3; ix <= 3; ix++) {
+        for (int iy = -3; iy <= 3; iy++) {
+            for (int iz = 0; iz < 4; iz++) {
+                ChVector<> rnd(rand() % 1000 / 100000.0, rand() % 1000 / 100000.0, rand() % 1000 / 100000.0);
+                std::shared_ptr<ChBody> body(system->NewBody());
+                body->SetMaterialSurface(mat);
+                body->SetMass(1);
+                body->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+                body->SetPos(ChVector<>(0.25 * ix, 0.25 * iy, 0.25 * iz + 0.15) + rnd);
+                body->SetRot(Q_from_AngAxis(0.3 * count, ChVector<>(1, 1, 0).GetNormalized()));
+                body->SetCollide(true);
+                body->GetCollisionModel()->ClearModel();
+                if (count++ % 5 == 0)
+                    utils::AddCapsuleGeometry(body.get(), 0.05, 0.05);
+                else
+                    utils::AddSphereGeometry(body.get(), 0.1);
+                body->GetCollisionModel()->BuildModel();
+                system->AddBody(body);
+            }
+        }
+    }
+}
+
+// Sync the positions, orientations, and velocities of the rigid bodies
+static void Sync(ChSystemParallel* system_A, ChSystemParallel* system_B) {
+    for (int i = 0; i < system_A->Get_bodylist().size(); i++) {
+        auto body_A = system_A->Get_bodylist().at(i);
+        auto body_B = system_B->Get_bodylist().at(i);
+        body_B->SetPos(body_A->GetPos());
+        body_B->SetRot(body_A->GetRot());
+        body_B->SetPos_dt(body_A->GetPos_dt());
+        body_B->SetWvel_par(body_A->GetWvel_par());
+    }
+}
+
+// Simulate without batches, and check that the same contacts are found with batches.
+static void CompareBatched(NarrowPhaseType narrowphase) {
+    ChSystemParallelNSC system_single;
+    ChSystemParallelNSC system_batched;
+    CreateModel(&system_single, narrowphase, false);
+    CreateModel(&system_batched, narrowphase, true);
+
+    double tolerance = 1e-6;
+
+    for (int i = 0; i < 300; i++) {
+        Sync(&system_single, &system_batched);
+        system_single.DoStepDynamics(1e-3);
+        system_batched.DoStepDynamics(1e-3);
+
+        // The contacts are stored in the same order, whether found in batches or not
+        auto& data_single = system_single.data_manager->host_data;
+        auto& data_batched = system_batched.data_manager->host_data;
+        ASSERT_EQ(system_single.data_manager->num_rigid_contacts, system_batched.data_manager->num_rigid_contacts);
+        for (int j = 0; j < (signed)system_single.data_manager->num_rigid_contacts; j++) {
+            ASSERT_EQ(data_single.bids_rigid_rigid[j].x, data_batched.bids_rigid_rigid[j].x);
+            ASSERT_EQ(data_single.bids_rigid_rigid[j].y, data_batched.bids_rigid_rigid[j].y);
+            Assert_near(data_single.norm_rigid_rigid[j], data_batched.norm_rigid_rigid[j], tolerance);
+            Assert_near(data_single.cpta_rigid_rigid[j], data_batched.cpta_rigid_rigid[j], tolerance);
+            Assert_near(data_single.cptb_rigid_rigid[j], data_batched.cptb_rigid_rigid[j], tolerance);
+            ASSERT_NEAR(data_single.dpth_rigid_rigid[j], data_batched.dpth_rigid_rigid[j], tolerance);
+            ASSERT_NEAR(data_single.erad_rigid_rigid[j], data_batched.erad_rigid_rigid[j], tolerance);
+        }
+    }
+
+    // Most candidate pairs were processed in batches
+    const collision_measures& measures = system_batched.data_manager->measures.collision;
+    ASSERT_GT(system_batched.data_manager->num_rigid_contacts, 7 * 7);
+    ASSERT_GT(measures.number_of_batched_pairs, measures.number_of_contacts_possible / 2);
+    ASSERT_EQ(system_single.data_manager->measures.collision.number_of_batched_pairs, 0u);
+}
+
+TEST(ChronoParallel, narrowphase_batched_R) {
+    CompareBatched(NarrowPhaseType::NARROWPHASE_R);
+}
+
+TEST(ChronoParallel, narrowphase_batched_hybrid) {
+    CompareBatched(NarrowPhaseType::NARROWPHASE_HYBRID_MPR);
+}
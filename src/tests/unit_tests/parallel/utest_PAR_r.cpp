@@ -672,5 +672,97 @@ TEST_P(Collision, roundedcyl_sphere) {
     delete shapeC;
 }
 
+// =============================================================================
+// Tests for the batched collision functions
+// =============================================================================
+
+// Compare the batched collision functions with the single-pair ones, on packs of random pairs.
+TEST_P(Collision, batched) {
+    real separation = sep ? 0.1 : 0.0;
+
+    srand(1);
+    auto uniform = [](real min, real max) { return min + (max - min) * (rand() % 10000) / real(10000); };
+
+    for (int type = 0; type < RBATCH_NONE; type++) {
+        int num_contacts = 0;
+
+        for (int pack = 0; pack < 100; pack++) {
+            RBatch batch;
+            real3 pos1[RBatch::width];
+            quaternion rot1[RBatch::width];
+            real3 dims1[RBatch::width];
+            real3 pos2[RBatch::width];
+            real radius2[RBatch::width];
+
+            for (int l = 0; l < RBatch::width; l++) {
+                pos1[l] = real3(uniform(-1, 1), uniform(-1, 1), uniform(-1, 1));
+                rot1[l] = Normalize(quaternion(uniform(-1, 1), uniform(-1, 1), uniform(-1, 1), uniform(-1, 1)));
+                dims1[l] = real3(uniform(0.05, 0.3), uniform(0.05, 0.3), uniform(0.05, 0.3));
+                pos2[l] = pos1[l] + real3(uniform(-0.6, 0.6), uniform(-0.6, 0.6), uniform(-0.6, 0.6));
+                radius2[l] = uniform(0.05, 0.2);
+
+                for (int k = 0; k < 3; k++) {
+                    batch.pos1[k][l] = pos1[l][k];
+                    batch.dims1[k][l] = dims1[l][k];
+                    batch.pos2[k][l] = pos2[l][k];
+                }
+                for (int k = 0; k < 4; k++) {
+                    batch.rot1[k][l] = rot1[l][k];
+                }
+                batch.radius2[l] = radius2[l];
+            }
+
+            switch (type) {
+                case RBATCH_SPHERE_SPHERE:
+                    sphere_sphere(batch, separation);
+                    break;
+                case RBATCH_BOX_SPHERE:
+                    box_sphere(batch, separation);
+                    break;
+                case RBATCH_CAPSULE_SPHERE:
+                    capsule_sphere(batch, separation);
+                    break;
+            }
+
+            for (int l = 0; l < RBatch::width; l++) {
+                real3 norm;
+                real3 pt1;
+                real3 pt2;
+                real depth;
+                real eff_rad;
+                bool contact = false;
+
+                switch (type) {
+                    case RBATCH_SPHERE_SPHERE:
+                        contact = sphere_sphere(pos1[l], dims1[l].x, pos2[l], radius2[l], separation, norm, depth, pt1,
+                                                pt2, eff_rad);
+                        break;
+                    case RBATCH_BOX_SPHERE:
+                        contact = box_sphere(pos1[l], rot1[l], dims1[l], pos2[l], radius2[l], separation, norm, depth,
+                                             pt1, pt2, eff_rad);
+                        break;
+                    case RBATCH_CAPSULE_SPHERE:
+                        contact = capsule_sphere(pos1[l], rot1[l], dims1[l].x, dims1[l].y, pos2[l], radius2[l],
+                                                 separation, norm, depth, pt1, pt2, eff_rad);
+                        break;
+                }
+
+                ASSERT_EQ(contact, batch.contact[l]);
+                if (!contact)
+                    continue;
+
+                num_contacts++;
+                Assert_near(norm, real3(batch.norm[0][l], batch.norm[1][l], batch.norm[2][l]), precision);
+                Assert_near(pt1, real3(batch.pt1[0][l], batch.pt1[1][l], batch.pt1[2][l]), precision);
+                Assert_near(pt2, real3(batch.pt2[0][l], batch.pt2[1][l], batch.pt2[2][l]), precision);
+                ASSERT_NEAR(depth, batch.depth[l], precision);
+                ASSERT_NEAR(eff_rad, batch.eff_radius[l], precision);
+            }
+        }
+
+        ASSERT_GT(num_contacts, 0);
+    }
+}
+
 INSTANTIATE_TEST_CASE_P(R, Collision, ::testing::Bool());
 
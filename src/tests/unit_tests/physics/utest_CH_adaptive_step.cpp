@@ -0,0 +1,202 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for adaptive time stepping with local error control in the implicit
+// timesteppers. A double pendulum is simulated with error control and compared
+// against a reference solution obtained with a small fixed step.
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+
+using namespace chrono;
+
+// A double pendulum, released from the horizontal position.
+static std::shared_ptr<ChBody> CreatePendulum(ChSystem& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    auto body1 = std::make_shared<ChBody>();
+    body1->SetPos(ChVector<>(1, 0, 0));
+    system.AddBody(body1);
+
+    auto body2 = std::make_shared<ChBody>();
+    body2->SetPos(ChVector<>(2, 0, 0));
+    system.AddBody(body2);
+
+    auto revolute1 = std::make_shared<ChLinkLockRevolute>();
+    revolute1->Initialize(ground, body1, ChCoordsys<>(ChVector<>(0, 0, 0), QUNIT));
+    system.AddLink(revolute1);
+
+    auto revolute2 = std::make_shared<ChLinkLockRevolute>();
+    revolute2->Initialize(body1, body2, ChCoordsys<>(ChVector<>(1, 0, 0), QUNIT));
+    system.AddLink(revolute2);
+
+    system.SetSolverType(ChSolver::Type::SPARSE_LDL);
+
+    return body2;
+}
+
+static void SetupHHT(ChSystem& system, bool error_control) {
+    system.SetTimestepperType(ChTimestepper::Type::HHT);
+    auto integrator = std::static_pointer_cast<ChTimestepperHHT>(system.GetTimestepper());
+    integrator->SetAlpha(-0.2);
+    integrator->SetMaxiters(20);
+    integrator->SetAbsTolerances(1e-10);
+    integrator->SetStepControl(false);
+    integrator->SetErrorControl(error_control);
+    integrator->SetErrorTolerances(1e-4, 1e-6);
+}
+
+// Position of the tip of the pendulum at time t_end, with a fixed step.
+static ChVector<> Reference(double t_end) {
+    ChSystemNSC system;
+    auto tip = CreatePendulum(system);
+    SetupHHT(system, false);
+    while (system.GetChTime() < t_end - 1e-10)
+        system.DoStepDynamics(2e-4);
+    return tip->GetPos();
+}
+
+TEST(ChAdaptiveStepTest, HHT) {
+    double t_end = 1.0;
+    ChVector<> ref = Reference(t_end);
+
+    ChSystemNSC system;
+    auto tip = CreatePendulum(system);
+    SetupHHT(system, true);
+    auto integrator = std::static_pointer_cast<ChTimestepperHHT>(system.GetTimestepper());
+    system.SetStepMin(1e-6);
+    system.SetStepMax(0.05);
+
+    // Frames at a fixed rate; the steps within each frame are chosen by the timestepper
+    for (int frame = 1; frame <= 20; frame++) {
+        ASSERT_TRUE(system.DoFrameDynamics(frame * 0.05));
+        ASSERT_NEAR(system.GetChTime(), frame * 0.05, 1e-12);
+    }
+
+    int accepted = integrator->GetNumAcceptedSteps();
+    int rejected = integrator->GetNumRejectedSteps();
+    ASSERT_LT(accepted, 1000);
+    ASSERT_GT(accepted, 20);
+    ASSERT_GT(rejected, 0);
+    ASSERT_LE(integrator->GetErrorEstimate(), 1.0);
+    ASSERT_GT(integrator->GetStepSize(), 1e-6);
+    ASSERT_LE(integrator->GetStepSize(), 0.05);
+    ASSERT_NEAR((tip->GetPos() - ref).Length(), 0.0, 1e-2);
+
+    integrator->ResetStepStatistics();
+    ASSERT_EQ(integrator->GetNumAcceptedSteps(), 0);
+    ASSERT_EQ(integrator->GetNumRejectedSteps(), 0);
+}
+
+TEST(ChAdaptiveStepTest, default_limits) {
+    // Without SetStepMin/SetStepMax, the timestepper keeps its own step size limits, so that the error control is
+    // not defeated by the default ChSystem minimum step
+    double t_end = 0.5;
+    ChVector<> ref = Reference(t_end);
+
+    ChSystemNSC system;
+    auto tip = CreatePendulum(system);
+    SetupHHT(system, true);
+    auto integrator = std::static_pointer_cast<ChTimestepperHHT>(system.GetTimestepper());
+
+    for (int i = 1; i <= 50; i++) {
+        system.DoStepDynamics(0.01);
+        ASSERT_LE(integrator->GetErrorEstimate(), 1.0);
+    }
+
+    ASSERT_EQ(integrator->GetStepSizeMin(), 1e-6);
+    ASSERT_GT(integrator->GetNumAcceptedSteps(), 50);
+    ASSERT_GT(integrator->GetNumRejectedSteps(), 0);
+    ASSERT_NEAR((tip->GetPos() - ref).Length(), 0.0, 1e-2);
+
+    // Explicitly set limits are forwarded to the timestepper
+    system.SetStepMax(0.005);
+    system.DoStepDynamics(0.01);
+    ASSERT_EQ(integrator->GetStepSizeMin(), 1e-6);
+    ASSERT_EQ(integrator->GetStepSizeMax(), 0.005);
+}
+
+// Fixed outer steps with error control: the timestepper takes internal steps to reach the end of each of them.
+static void TestFixedOuterSteps(ChTimestepper::Type type) {
+    double t_end = 0.5;
+    ChVector<> ref = Reference(t_end);
+
+    ChSystemNSC system;
+    auto tip = CreatePendulum(system);
+    system.SetTimestepperType(type);
+    auto integrator = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(system.GetTimestepper());
+    ASSERT_TRUE(integrator);
+    integrator->SetMaxiters(20);
+    integrator->SetAbsTolerances(1e-10);
+    integrator->SetErrorControl(true);
+    integrator->SetErrorTolerances(1e-3, 1e-5);
+    system.SetStepMin(1e-7);
+    system.SetStepMax(0.01);
+
+    for (int i = 1; i <= 50; i++) {
+        system.DoStepDynamics(0.01);
+        ASSERT_NEAR(system.GetChTime(), i * 0.01, 1e-12);
+    }
+
+    ASSERT_GE(integrator->GetNumAcceptedSteps(), 50);
+    ASSERT_LT(integrator->GetNumRejectedSteps(), integrator->GetNumAcceptedSteps() / 4);
+    ASSERT_NEAR((tip->GetPos() - ref).Length(), 0.0, 1e-2);
+
+    // Without error control, one step per call
+    integrator->SetErrorControl(false);
+    integrator->ResetStepStatistics();
+    system.DoStepDynamics(0.01);
+    ASSERT_EQ(integrator->GetNumAcceptedSteps(), 1);
+    ASSERT_EQ(integrator->GetNumRejectedSteps(), 0);
+}
+
+TEST(ChAdaptiveStepTest, EulerImplicit) {
+    TestFixedOuterSteps(ChTimestepper::Type::EULER_IMPLICIT);
+}
+
+TEST(ChAdaptiveStepTest, Trapezoidal) {
+    TestFixedOuterSteps(ChTimestepper::Type::TRAPEZOIDAL);
+}
+
+TEST(ChAdaptiveStepTest, tolerance) {
+    // Tighter tolerances require more steps and give a smaller error
+    double t_end = 0.5;
+    ChVector<> ref = Reference(t_end);
+
+    double errors[2];
+    int steps[2];
+    double tolerances[2] = {1e-3, 1e-5};
+    for (int k = 0; k < 2; k++) {
+        ChSystemNSC system;
+        auto tip = CreatePendulum(system);
+        SetupHHT(system, true);
+        auto integrator = std::static_pointer_cast<ChTimestepperHHT>(system.GetTimestepper());
+        integrator->SetErrorTolerances(tolerances[k], tolerances[k] * 1e-2);
+        system.SetStepMin(1e-6);
+        system.SetStepMax(0.05);
+        system.DoFrameDynamics(t_end);
+        errors[k] = (tip->GetPos() - ref).Length();
+        steps[k] = integrator->GetNumAcceptedSteps();
+    }
+
+    ASSERT_LT(errors[1], errors[0]);
+    ASSERT_GT(steps[1], steps[0]);
+}
@@ -0,0 +1,202 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the incremental update of the system descriptor: a model with joints
+// and contacts is simulated with incremental updates and with a full rebuild of
+// the descriptor at each step, while bodies, links, and loads are added,
+// disabled, and removed. The results must be identical.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChLoadContainer.h"
+#include "chrono/physics/ChLoadsBody.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverSparseLDL.h"
+
+using namespace chrono;
+
+// Physics item counting the injections in the system descriptor.
+class InjectionCounter : public ChPhysicsItem {
+  public:
+    virtual InjectionCounter* Clone() const override { return new InjectionCounter(*this); }
+    virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override { count++; }
+    int count = 0;
+};
+
+struct Model {
+    ChSystemNSC system;
+    std::shared_ptr<ChBody> ground;
+    std::vector<std::shared_ptr<ChLinkLockRevolute>> links;
+    std::shared_ptr<InjectionCounter> counter;
+};
+
+// Boxes falling on the ground, and a chain of pendulums.
+static void CreateModel(Model& model, bool incremental) {
+    ChSystemNSC& system = model.system;
+    system.SetIncrementalDescriptor(incremental);
+    system.SetMaxItersSolverSpeed(50);
+
+    model.ground = std::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true);
+    model.ground->SetPos(ChVector<>(0, -0.5, 0));
+    model.ground->SetBodyFixed(true);
+    system.AddBody(model.ground);
+
+    for (int i = 0; i < 4; i++) {
+        auto box = std::make_shared<ChBodyEasyBox>(0.5, 0.5, 0.5, 1000, true);
+        box->SetPos(ChVector<>(-3 + 1.5 * i, 0.3, 0));
+        system.AddBody(box);
+    }
+
+    std::shared_ptr<ChBody> prev = model.ground;
+    for (int i = 0; i < 6; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetPos(ChVector<>(0.5 * (i + 1), 3, 2));
+        system.AddBody(body);
+        auto revolute = std::make_shared<ChLinkLockRevolute>();
+        revolute->Initialize(prev, body, ChCoordsys<>(ChVector<>(0.5 * i, 3, 2), QUNIT));
+        system.AddLink(revolute);
+        model.links.push_back(revolute);
+        prev = body;
+    }
+
+    model.counter = std::make_shared<InjectionCounter>();
+    system.Add(model.counter);
+}
+
+static void Compare(Model& incremental, Model& full) {
+    auto& bodies1 = incremental.system.Get_bodylist();
+    auto& bodies2 = full.system.Get_bodylist();
+    ASSERT_EQ(bodies1.size(), bodies2.size());
+    for (size_t i = 0; i < bodies1.size(); i++) {
+        ASSERT_EQ(bodies1[i]->GetPos(), bodies2[i]->GetPos());
+        ASSERT_EQ(bodies1[i]->GetRot(), bodies2[i]->GetRot());
+    }
+
+    auto descriptor1 = incremental.system.GetSystemDescriptor();
+    auto descriptor2 = full.system.GetSystemDescriptor();
+    ASSERT_EQ(descriptor1->GetConstraintsList().size(), descriptor2->GetConstraintsList().size());
+    ASSERT_EQ(descriptor1->GetVariablesList().size(), descriptor2->GetVariablesList().size());
+    ASSERT_EQ(descriptor1->CountActiveConstraints(), descriptor2->CountActiveConstraints());
+    ASSERT_EQ(descriptor1->CountActiveVariables(), descriptor2->CountActiveVariables());
+}
+
+static void Step(Model& incremental, Model& full, int steps) {
+    for (int i = 0; i < steps; i++) {
+        incremental.system.DoStepDynamics(1e-3);
+        full.system.DoStepDynamics(1e-3);
+    }
+}
+
+TEST(ChSystemDescriptorTest, incremental) {
+    Model incremental;
+    CreateModel(incremental, true);
+    ASSERT_TRUE(incremental.system.GetIncrementalDescriptor());
+
+    Model full;
+    CreateModel(full, false);
+
+    // The boxes reach the ground
+    Step(incremental, full, 300);
+    ASSERT_GT(incremental.system.GetNcontacts(), 0);
+    Compare(incremental, full);
+
+    // Bodies and links are injected once, at the first step
+    ASSERT_EQ(incremental.counter->count, 1);
+    ASSERT_EQ(full.counter->count, 300);
+
+    // Add a body and a link
+    for (auto model : {&incremental, &full}) {
+        auto body = std::make_shared<ChBody>();
+        body->SetPos(ChVector<>(-1, 3, -2));
+        model->system.AddBody(body);
+        auto revolute = std::make_shared<ChLinkLockRevolute>();
+        revolute->Initialize(model->ground, body, ChCoordsys<>(ChVector<>(-2, 3, -2), QUNIT));
+        model->system.AddLink(revolute);
+        model->links.push_back(revolute);
+    }
+    Step(incremental, full, 100);
+    Compare(incremental, full);
+    ASSERT_EQ(incremental.counter->count, 2);
+
+    // Disable a link: its constraints are no longer injected
+    incremental.links[3]->SetDisabled(true);
+    full.links[3]->SetDisabled(true);
+    Step(incremental, full, 100);
+    Compare(incremental, full);
+    ASSERT_EQ(incremental.counter->count, 3);
+
+    // Remove a link and a box
+    for (auto model : {&incremental, &full}) {
+        model->system.RemoveLink(model->links.back());
+        model->system.RemoveBody(model->system.Get_bodylist()[1]);
+    }
+    Step(incremental, full, 100);
+    Compare(incremental, full);
+    ASSERT_EQ(incremental.counter->count, 4);
+}
+
+// A body hanging from the ground by a stiff bushing load, added to an existing load container after the first step.
+// The stiffness block of the load must be injected in the descriptor, as with a full rebuild.
+static std::shared_ptr<ChBody> CreateBushingModel(ChSystemNSC& system, std::shared_ptr<ChLoadContainer>& loads) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    system.SetSolverType(ChSolver::Type::SPARSE_LDL);
+    system.SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    auto body = std::make_shared<ChBody>();
+    body->SetMass(1);
+    body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+    body->SetPos(ChVector<>(0, 1, 0));
+    system.AddBody(body);
+
+    loads = std::make_shared<ChLoadContainer>();
+    system.Add(loads);
+
+    return body;
+}
+
+TEST(ChSystemDescriptorTest, stiff_load) {
+    ChSystemNSC system_incr;
+    ChSystemNSC system_full;
+    std::shared_ptr<ChLoadContainer> loads_incr;
+    std::shared_ptr<ChLoadContainer> loads_full;
+    auto body_incr = CreateBushingModel(system_incr, loads_incr);
+    auto body_full = CreateBushingModel(system_full, loads_full);
+    system_full.SetIncrementalDescriptor(false);
+
+    system_incr.DoStepDynamics(1e-3);
+    system_full.DoStepDynamics(1e-3);
+
+    loads_incr->Add(std::make_shared<ChLoadBodyBodyBushingSpherical>(
+        system_incr.Get_bodylist()[0], body_incr, ChFrame<>(ChVector<>(0, 1, 0)), ChVector<>(1e5), ChVector<>(1e2)));
+    loads_full->Add(std::make_shared<ChLoadBodyBodyBushingSpherical>(
+        system_full.Get_bodylist()[0], body_full, ChFrame<>(ChVector<>(0, 1, 0)), ChVector<>(1e5), ChVector<>(1e2)));
+
+    for (int i = 0; i < 200; i++) {
+        system_incr.DoStepDynamics(1e-3);
+        system_full.DoStepDynamics(1e-3);
+        ASSERT_EQ(body_incr->GetPos(), body_full->GetPos());
+    }
+    ASSERT_EQ(system_incr.GetSystemDescriptor()->GetKblocksList().size(), 1u);
+
+    // The body hangs from the bushing
+    ASSERT_NEAR(body_incr->GetPos().y(), 1 - 9.81 / 1e5, 1e-5);
+}
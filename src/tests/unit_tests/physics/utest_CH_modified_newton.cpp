@@ -0,0 +1,116 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the modified Newton (Jacobian reuse) policy of the implicit
+// timesteppers. A chain of pendulums is simulated with full Newton and with
+// modified Newton reusing the Newton matrix across steps; the results must agree,
+// with far fewer calls to the solver's Setup function.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverSparseLDL.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+
+using namespace chrono;
+
+struct Result {
+    std::vector<ChVector<>> pos;  // final body positions
+    int setups;                   // total number of solver setups
+    int saved;                    // total number of saved setups
+    int factorizations;           // total number of numeric factorizations
+};
+
+// Chain of pendulums connected by revolute joints, released from rest at 30 degrees from the vertical and simulated
+// for 0.2 s with a step of 1 ms.
+static Result SimulateChain(ChTimestepper::Type type, bool modified_newton) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    ChVector<> dir(std::sin(CH_C_PI / 6), -std::cos(CH_C_PI / 6), 0);
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    std::shared_ptr<ChBody> prev = ground;
+    for (int i = 0; i < 10; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetMass(1);
+        body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        body->SetPos((i + 1.0) * dir);
+        system.AddBody(body);
+        auto revolute = std::make_shared<ChLinkLockRevolute>();
+        revolute->Initialize(prev, body, ChCoordsys<>(dir * i, QUNIT));
+        system.AddLink(revolute);
+        bodies.push_back(body);
+        prev = body;
+    }
+
+    system.SetSolverType(ChSolver::Type::SPARSE_LDL);
+    auto solver = std::static_pointer_cast<ChSolverSparseLDL>(system.GetSolver());
+
+    system.SetTimestepperType(type);
+    auto integrator = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(system.GetTimestepper());
+    integrator->SetMaxiters(50);
+    integrator->SetAbsTolerances(1e-8);
+    integrator->SetModifiedNewton(modified_newton);
+    integrator->SetMatrixReuseAcrossSteps(modified_newton);
+    if (auto hht = std::dynamic_pointer_cast<ChTimestepperHHT>(integrator)) {
+        hht->SetStepControl(false);
+    }
+
+    Result result;
+    result.setups = 0;
+    for (int i = 0; i < 200; i++) {
+        system.DoStepDynamics(1e-3);
+        result.setups += integrator->GetNumSetupCalls();
+    }
+    result.saved = integrator->GetNumSetupsSaved();
+    result.factorizations = solver->GetNumFactorizationCalls();
+    for (auto& body : bodies)
+        result.pos.push_back(body->GetPos());
+
+    return result;
+}
+
+static void CompareNewton(ChTimestepper::Type type, double tol) {
+    Result full = SimulateChain(type, false);
+    Result modified = SimulateChain(type, true);
+
+    // Same solution, up to the Newton tolerances
+    for (size_t i = 0; i < full.pos.size(); i++)
+        ASSERT_NEAR((full.pos[i] - modified.pos[i]).Length(), 0.0, tol);
+
+    // Full Newton calls Setup at each iteration
+    ASSERT_EQ(full.saved, 0);
+    ASSERT_GE(full.setups, 200);
+
+    // Modified Newton reuses the matrix across iterations and steps
+    ASSERT_GT(modified.saved, 0);
+    ASSERT_LT(modified.setups, full.setups / 4);
+    ASSERT_LE(modified.factorizations, modified.setups);
+}
+
+TEST(ChModifiedNewtonTest, HHT) {
+    CompareNewton(ChTimestepper::Type::HHT, 1e-5);
+}
+
+TEST(ChModifiedNewtonTest, EulerImplicit) {
+    CompareNewton(ChTimestepper::Type::EULER_IMPLICIT, 1e-5);
+}
@@ -0,0 +1,190 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the parallel update mode of ChAssembly: a set of independent
+// pendulums and a set of drivelines (shafts connected by gears, springs,
+// clutches, planetary gears, and coupled to bodies) are simulated with serial
+// and parallel update and the results are compared.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChShaftsBody.h"
+#include "chrono/physics/ChShaftsClutch.h"
+#include "chrono/physics/ChShaftsGear.h"
+#include "chrono/physics/ChShaftsPlanetary.h"
+#include "chrono/physics/ChShaftsTorsionSpring.h"
+
+using namespace chrono;
+
+static void CreatePendulums(ChSystemNSC& system, int num_pendulums) {
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+    system.SetMaxItersSolverSpeed(100);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int i = 0; i < num_pendulums; i++) {
+        ChVector<> loc(2.0 * i, 0, 0);
+
+        auto pend = std::make_shared<ChBody>();
+        pend->SetMass(1 + 0.01 * i);
+        pend->SetInertiaXX(ChVector<>(0.04, 0.1, 0.1));
+        pend->SetPos(loc + ChVector<>(1, 0, 0));
+        system.AddBody(pend);
+
+        auto rev = std::make_shared<ChLinkLockRevolute>();
+        rev->Initialize(ground, pend, ChCoordsys<>(loc, Q_from_AngX(CH_C_PI_2)));
+        system.AddLink(rev);
+    }
+}
+
+// Each driveline drives a wheel body on a revolute joint. The shafts are added before the items that
+// connect them, so that the serial update also sees the current shaft states.
+static void CreateDrivelines(ChSystemNSC& system, int num_drivelines) {
+    system.Set_G_acc(ChVector<>(0, 0, 0));
+    system.SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+    system.SetMaxItersSolverSpeed(100);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int i = 0; i < num_drivelines; i++) {
+        ChVector<> loc(0, 2.0 * i, 0);
+
+        auto wheel = std::make_shared<ChBody>();
+        wheel->SetMass(2);
+        wheel->SetInertiaXX(ChVector<>(0.3, 0.5, 0.3));
+        wheel->SetPos(loc);
+        system.AddBody(wheel);
+
+        auto rev = std::make_shared<ChLinkLockRevolute>();
+        rev->Initialize(ground, wheel, ChCoordsys<>(loc, Q_from_AngX(CH_C_PI_2)));
+        system.AddLink(rev);
+
+        std::shared_ptr<ChShaft> shafts[4];
+        for (int j = 0; j < 4; j++) {
+            shafts[j] = std::make_shared<ChShaft>();
+            shafts[j]->SetInertia(0.5 + 0.1 * j);
+            system.Add(shafts[j]);
+        }
+        shafts[0]->SetAppliedTorque(10 + 0.5 * i);
+
+        auto gear = std::make_shared<ChShaftsGear>();
+        gear->Initialize(shafts[0], shafts[1]);
+        gear->SetTransmissionRatio(-2);
+        system.Add(gear);
+
+        auto spring = std::make_shared<ChShaftsTorsionSpring>();
+        spring->Initialize(shafts[1], shafts[2]);
+        spring->SetTorsionalStiffness(200);
+        spring->SetTorsionalDamping(5);
+        system.Add(spring);
+
+        auto planetary = std::make_shared<ChShaftsPlanetary>();
+        planetary->Initialize(shafts[3], shafts[1], shafts[2]);
+        planetary->SetTransmissionRatioOrdinary(-3);
+        system.Add(planetary);
+
+        auto clutch = std::make_shared<ChShaftsClutch>();
+        clutch->Initialize(shafts[2], shafts[0]);
+        clutch->SetTorqueLimit(4);
+        clutch->SetModulation(0.5);
+        system.Add(clutch);
+
+        auto shaft_body = std::make_shared<ChShaftsBody>();
+        shaft_body->Initialize(shafts[3], wheel, ChVector<>(0, 1, 0));
+        system.Add(shaft_body);
+    }
+}
+
+TEST(ChAssembly, ParallelUpdate) {
+    int num_pendulums = 64;
+
+    ChSystemNSC serial_system;
+    CreatePendulums(serial_system, num_pendulums);
+    serial_system.SetParallelUpdate(false);
+
+    ChSystemNSC parallel_system;
+    CreatePendulums(parallel_system, num_pendulums);
+    parallel_system.SetParallelThreadNumber(4);
+    parallel_system.SetParallelUpdate(true);
+
+    for (int step = 0; step < 200; step++) {
+        serial_system.DoStepDynamics(1e-3);
+        parallel_system.DoStepDynamics(1e-3);
+    }
+
+    auto& serial_bodies = serial_system.Get_bodylist();
+    auto& parallel_bodies = parallel_system.Get_bodylist();
+    ASSERT_EQ(serial_bodies.size(), parallel_bodies.size());
+
+    for (size_t i = 0; i < serial_bodies.size(); i++) {
+        ChVector<> pos1 = serial_bodies[i]->GetPos();
+        ChVector<> pos2 = parallel_bodies[i]->GetPos();
+        ASSERT_NEAR(pos1.x(), pos2.x(), 1e-12);
+        ASSERT_NEAR(pos1.y(), pos2.y(), 1e-12);
+        ASSERT_NEAR(pos1.z(), pos2.z(), 1e-12);
+    }
+}
+
+TEST(ChAssembly, ParallelUpdateDriveline) {
+    int num_drivelines = 16;
+
+    ChSystemNSC serial_system;
+    CreateDrivelines(serial_system, num_drivelines);
+    serial_system.SetParallelUpdate(false);
+
+    ChSystemNSC parallel_system;
+    CreateDrivelines(parallel_system, num_drivelines);
+    parallel_system.SetParallelThreadNumber(4);
+    parallel_system.SetParallelUpdate(true);
+
+    for (int step = 0; step < 200; step++) {
+        serial_system.DoStepDynamics(1e-3);
+        parallel_system.DoStepDynamics(1e-3);
+    }
+
+    auto& serial_items = serial_system.Get_otherphysicslist();
+    auto& parallel_items = parallel_system.Get_otherphysicslist();
+    ASSERT_EQ(serial_items.size(), parallel_items.size());
+
+    for (size_t i = 0; i < serial_items.size(); i++) {
+        auto shaft1 = std::dynamic_pointer_cast<ChShaft>(serial_items[i]);
+        auto shaft2 = std::dynamic_pointer_cast<ChShaft>(parallel_items[i]);
+        if (!shaft1)
+            continue;
+        ASSERT_TRUE(shaft2 != nullptr);
+        ASSERT_NEAR(shaft1->GetPos(), shaft2->GetPos(), 1e-12);
+        ASSERT_NEAR(shaft1->GetPos_dt(), shaft2->GetPos_dt(), 1e-12);
+    }
+
+    auto& serial_bodies = serial_system.Get_bodylist();
+    auto& parallel_bodies = parallel_system.Get_bodylist();
+    for (size_t i = 0; i < serial_bodies.size(); i++) {
+        if (serial_bodies[i]->GetBodyFixed())
+            continue;
+        ChVector<> w1 = serial_bodies[i]->GetWvel_loc();
+        ChVector<> w2 = parallel_bodies[i]->GetWvel_loc();
+        ASSERT_NEAR(w1.y(), w2.y(), 1e-12);
+        ASSERT_GT(std::abs(w1.y()), 0.0);
+    }
+}
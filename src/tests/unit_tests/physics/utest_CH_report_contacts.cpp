@@ -0,0 +1,93 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the multithreaded contact reporting of the Bullet collision system:
+// a pile of spheres is simulated with serial and parallel contact reporting and
+// the contacts (including their order) are compared.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+static void CreatePile(ChSystemNSC& system) {
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto ground = std::make_shared<ChBodyEasyBox>(20, 20, 1, 1000, true, false);
+    ground->SetPos(ChVector<>(0, 0, -0.5));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int ix = 0; ix < 8; ix++) {
+        for (int iy = 0; iy < 8; iy++) {
+            for (int iz = 0; iz < 4; iz++) {
+                auto ball = std::make_shared<ChBodyEasySphere>(0.5, 1000, true, false);
+                ball->SetPos(ChVector<>(0.99 * ix + 0.01 * iz, 0.99 * iy, 0.49 + 0.98 * iz));
+                system.AddBody(ball);
+            }
+        }
+    }
+}
+
+class ContactCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        points.push_back(pA);
+        points.push_back(pB);
+        return true;
+    }
+
+    std::vector<ChVector<>> points;
+};
+
+TEST(ChCollisionSystemBullet, ParallelReportContacts) {
+    ChSystemNSC serial_system;
+    CreatePile(serial_system);
+
+    ChSystemNSC parallel_system;
+    CreatePile(parallel_system);
+    auto collision_system = std::static_pointer_cast<ChCollisionSystemBullet>(parallel_system.GetCollisionSystem());
+    collision_system->SetNumThreads(4);
+
+    for (int step = 0; step < 50; step++) {
+        serial_system.DoStepDynamics(1e-3);
+        parallel_system.DoStepDynamics(1e-3);
+
+        ASSERT_EQ(serial_system.GetNcontacts(), parallel_system.GetNcontacts());
+
+        ContactCollector serial_contacts;
+        ContactCollector parallel_contacts;
+        serial_system.GetContactContainer()->ReportAllContacts(&serial_contacts);
+        parallel_system.GetContactContainer()->ReportAllContacts(&parallel_contacts);
+
+        ASSERT_EQ(serial_contacts.points.size(), parallel_contacts.points.size());
+        for (size_t i = 0; i < serial_contacts.points.size(); i++) {
+            ASSERT_EQ(serial_contacts.points[i], parallel_contacts.points[i]);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the assembled mode of the Schur complement product in the system
+// descriptor: a pile of spheres resting on the ground is simulated with the
+// APGD solver, using the matrix-free and the assembled products; the results
+// must match up to round-off errors.
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+
+static void CreatePile(ChSystemNSC& system, bool assembled) {
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(ChSolver::Type::APGD);
+    system.SetMaxItersSolverSpeed(100);
+    system.GetSystemDescriptor()->SetAssembledShurProduct(assembled);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(20, 20, 1, 1000, true, false);
+    ground->SetPos(ChVector<>(0, 0, -0.5));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int ix = 0; ix < 5; ix++) {
+        for (int iy = 0; iy < 5; iy++) {
+            for (int iz = 0; iz < 3; iz++) {
+                auto ball = std::make_shared<ChBodyEasySphere>(0.5, 1000, true, false);
+                ball->SetPos(ChVector<>(1.0 * ix, 1.0 * iy, 0.5 + 1.0 * iz));
+                system.AddBody(ball);
+            }
+        }
+    }
+}
+
+TEST(ChSystemDescriptor, AssembledShurProduct) {
+    ChSystemNSC default_system;
+    CreatePile(default_system, false);
+
+    ChSystemNSC assembled_system;
+    CreatePile(assembled_system, true);
+    ASSERT_TRUE(assembled_system.GetSystemDescriptor()->GetAssembledShurProduct());
+
+    for (int step = 0; step < 100; step++) {
+        default_system.DoStepDynamics(1e-3);
+        assembled_system.DoStepDynamics(1e-3);
+    }
+
+    ASSERT_GT(default_system.GetNcontacts(), 0);
+    ASSERT_EQ(default_system.GetNcontacts(), assembled_system.GetNcontacts());
+
+    auto& default_bodies = default_system.Get_bodylist();
+    auto& assembled_bodies = assembled_system.Get_bodylist();
+    for (size_t i = 0; i < default_bodies.size(); i++) {
+        ChVector<> diff = default_bodies[i]->GetPos() - assembled_bodies[i]->GetPos();
+        ASSERT_LT(diff.Length(), 1e-9);
+    }
+}
@@ -0,0 +1,206 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for system snapshots: a system is simulated past a snapshot, and the
+// snapshot is restored into an identically built system which is advanced over
+// the same interval. The final states of the two systems must be identical.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+
+using namespace chrono;
+
+// A pile of spheres and boxes on a fixed ground, with a pendulum swinging through it.
+static void CreatePile(ChSystem& system) {
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    auto ground = std::make_shared<ChBodyEasyBox>(20, 20, 1, 1000, true, false, system.GetContactMethod());
+    ground->SetPos(ChVector<>(0, 0, -0.5));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int ix = 0; ix < 4; ix++) {
+        for (int iy = 0; iy < 4; iy++) {
+            for (int iz = 0; iz < 3; iz++) {
+                ChVector<> pos(1.01 * ix + 0.02 * iz, 1.01 * iy, 0.5 + 1.1 * iz);
+                std::shared_ptr<ChBody> body;
+                if ((ix + iy + iz) % 2)
+                    body = std::make_shared<ChBodyEasySphere>(0.5, 1000, true, false, system.GetContactMethod());
+                else
+                    body = std::make_shared<ChBodyEasyBox>(0.9, 0.9, 0.9, 1000, true, false, system.GetContactMethod());
+                body->SetPos(pos);
+                system.AddBody(body);
+            }
+        }
+    }
+
+    auto bob = std::make_shared<ChBodyEasySphere>(0.4, 2000, true, false, system.GetContactMethod());
+    bob->SetPos(ChVector<>(-3, 1.5, 4));
+    system.AddBody(bob);
+
+    auto revolute = std::make_shared<ChLinkLockRevolute>();
+    revolute->Initialize(ground, bob, ChCoordsys<>(ChVector<>(1.5, 1.5, 4), Q_from_AngX(CH_C_PI_2)));
+    system.AddLink(revolute);
+}
+
+// A double pendulum (no contacts).
+static void CreatePendulum(ChSystem& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    auto body1 = std::make_shared<ChBody>();
+    body1->SetPos(ChVector<>(1, 0, 0));
+    system.AddBody(body1);
+
+    auto body2 = std::make_shared<ChBody>();
+    body2->SetPos(ChVector<>(2, 0, 0));
+    system.AddBody(body2);
+
+    auto revolute1 = std::make_shared<ChLinkLockRevolute>();
+    revolute1->Initialize(ground, body1, ChCoordsys<>(ChVector<>(0, 0, 0), QUNIT));
+    system.AddLink(revolute1);
+
+    auto revolute2 = std::make_shared<ChLinkLockRevolute>();
+    revolute2->Initialize(body1, body2, ChCoordsys<>(ChVector<>(1, 0, 0), QUNIT));
+    system.AddLink(revolute2);
+}
+
+static void SetHHT(ChSystem& system) {
+    system.SetTimestepperType(ChTimestepper::Type::HHT);
+    auto integrator = std::static_pointer_cast<ChTimestepperHHT>(system.GetTimestepper());
+    integrator->SetAlpha(-0.2);
+    integrator->SetMaxiters(20);
+    integrator->SetAbsTolerances(1e-6);
+}
+
+static void Advance(ChSystem& system, int num_steps, double step) {
+    for (int i = 0; i < num_steps; i++)
+        system.DoStepDynamics(step);
+}
+
+static void CompareStates(ChSystem& system1, ChSystem& system2) {
+    ASSERT_EQ(system1.GetChTime(), system2.GetChTime());
+    ASSERT_EQ(system1.GetStepcount(), system2.GetStepcount());
+    ASSERT_EQ(system1.GetNcontacts(), system2.GetNcontacts());
+
+    auto& bodies1 = system1.Get_bodylist();
+    auto& bodies2 = system2.Get_bodylist();
+    ASSERT_EQ(bodies1.size(), bodies2.size());
+    for (size_t i = 0; i < bodies1.size(); i++) {
+        ASSERT_EQ(bodies1[i]->GetPos(), bodies2[i]->GetPos());
+        ASSERT_EQ(bodies1[i]->GetRot(), bodies2[i]->GetRot());
+        ASSERT_EQ(bodies1[i]->GetPos_dt(), bodies2[i]->GetPos_dt());
+        ASSERT_EQ(bodies1[i]->GetWvel_loc(), bodies2[i]->GetWvel_loc());
+    }
+}
+
+// Simulate system1 up to the snapshot and past it, then restore the snapshot in system2 and
+// simulate it over the same interval.
+static void CheckRestart(ChSystem& system1, ChSystem& system2, int num_steps, double step) {
+    Advance(system1, num_steps, step);
+
+    std::vector<char> snapshot;
+    system1.WriteSnapshot(snapshot);
+
+    Advance(system1, num_steps, step);
+
+    ASSERT_TRUE(system2.ReadSnapshot(snapshot));
+    Advance(system2, num_steps, step);
+
+    CompareStates(system1, system2);
+}
+
+TEST(ChSystem, SnapshotNSC) {
+    ChSystemNSC system1;
+    ChSystemNSC system2;
+    CreatePile(system1);
+    CreatePile(system2);
+    system1.SetSolverWarmStarting(true);
+    system2.SetSolverWarmStarting(true);
+
+    CheckRestart(system1, system2, 500, 1e-3);
+}
+
+TEST(ChSystem, SnapshotSMC) {
+    ChSystemSMC system1;
+    ChSystemSMC system2;
+    CreatePile(system1);
+    CreatePile(system2);
+
+    CheckRestart(system1, system2, 500, 1e-4);
+}
+
+TEST(ChSystem, SnapshotHHT) {
+    ChSystemNSC system1;
+    ChSystemNSC system2;
+    CreatePendulum(system1);
+    CreatePendulum(system2);
+    SetHHT(system1);
+    SetHHT(system2);
+
+    CheckRestart(system1, system2, 200, 1e-2);
+}
+
+TEST(ChSystem, SnapshotMismatch) {
+    ChSystemNSC system1;
+    CreatePendulum(system1);
+    Advance(system1, 10, 1e-3);
+
+    std::vector<char> snapshot;
+    system1.WriteSnapshot(snapshot);
+
+    ChSystemNSC system2;
+    CreatePile(system2);
+    ASSERT_FALSE(system2.ReadSnapshot(snapshot));
+
+    snapshot.resize(snapshot.size() - 1);
+    ChSystemNSC system3;
+    CreatePendulum(system3);
+    ASSERT_FALSE(system3.ReadSnapshot(snapshot));
+}
+
+TEST(ChSystem, SnapshotContactMismatch) {
+    ChSystemNSC system1;
+    CreatePile(system1);
+    Advance(system1, 100, 1e-3);
+
+    std::vector<char> snapshot;
+    system1.WriteSnapshot(snapshot);
+
+    // Same state vectors, but a different set of collision models: the snapshot is rejected
+    // and the system is left untouched
+    ChSystemNSC system2;
+    CreatePile(system2);
+    system2.Get_bodylist()[1]->SetCollide(false);
+    Advance(system2, 10, 1e-3);
+    double time = system2.GetChTime();
+    std::vector<ChVector<>> positions;
+    for (auto& body : system2.Get_bodylist())
+        positions.push_back(body->GetPos());
+
+    ASSERT_FALSE(system2.ReadSnapshot(snapshot));
+    ASSERT_EQ(system2.GetChTime(), time);
+    for (size_t i = 0; i < positions.size(); i++)
+        ASSERT_EQ(system2.Get_bodylist()[i]->GetPos(), positions[i]);
+}
@@ -0,0 +1,73 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the graph-colored SOR solver: a pile of spheres resting on the
+// ground is simulated with the serial SOR solver and with the colored SOR
+// solver; the results must be close, and the coloring must be reused as long
+// as the contact topology does not change.
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverSORcolored.h"
+
+using namespace chrono;
+
+static void CreatePile(ChSystemNSC& system, ChSolver::Type solver_type) {
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(solver_type);
+    system.SetMaxItersSolverSpeed(100);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(20, 20, 1, 1000, true, false);
+    ground->SetPos(ChVector<>(0, 0, -0.5));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int ix = 0; ix < 5; ix++) {
+        for (int iy = 0; iy < 5; iy++) {
+            for (int iz = 0; iz < 3; iz++) {
+                auto ball = std::make_shared<ChBodyEasySphere>(0.5, 1000, true, false);
+                ball->SetPos(ChVector<>(1.0 * ix, 1.0 * iy, 0.5 + 1.0 * iz));
+                system.AddBody(ball);
+            }
+        }
+    }
+}
+
+TEST(ChSolverSORcolored, CompareSOR) {
+    ChSystemNSC serial_system;
+    CreatePile(serial_system, ChSolver::Type::SOR);
+
+    ChSystemNSC colored_system;
+    CreatePile(colored_system, ChSolver::Type::SOR_COLORED);
+
+    for (int step = 0; step < 100; step++) {
+        serial_system.DoStepDynamics(1e-3);
+        colored_system.DoStepDynamics(1e-3);
+    }
+
+    ASSERT_EQ(serial_system.GetNcontacts(), colored_system.GetNcontacts());
+
+    auto solver = std::static_pointer_cast<ChSolverSORcolored>(colored_system.GetSolver());
+    ASSERT_GT(solver->GetNumColors(), 1);
+    ASSERT_LT(solver->GetNumColorings(), 10);
+
+    auto& serial_bodies = serial_system.Get_bodylist();
+    auto& colored_bodies = colored_system.Get_bodylist();
+    for (size_t i = 0; i < serial_bodies.size(); i++) {
+        ChVector<> diff = serial_bodies[i]->GetPos() - colored_bodies[i]->GetPos();
+        ASSERT_LT(diff.Length(), 1e-3);
+    }
+}
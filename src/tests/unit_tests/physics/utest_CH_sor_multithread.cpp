@@ -0,0 +1,84 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the multithreaded SOR solver: a pile of spheres resting on the
+// ground is simulated with the serial SOR solver and with the multithreaded
+// SOR solver. With one thread the results must be identical; with several
+// threads they must be close.
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverSORmultithread.h"
+
+using namespace chrono;
+
+static void CreatePile(ChSystemNSC& system, ChSolver::Type solver_type, int num_threads) {
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(solver_type);
+    system.SetParallelThreadNumber(num_threads);
+    system.SetMaxItersSolverSpeed(100);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(20, 20, 1, 1000, true, false);
+    ground->SetPos(ChVector<>(0, 0, -0.5));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    for (int ix = 0; ix < 5; ix++) {
+        for (int iy = 0; iy < 5; iy++) {
+            for (int iz = 0; iz < 3; iz++) {
+                auto ball = std::make_shared<ChBodyEasySphere>(0.5, 1000, true, false);
+                ball->SetPos(ChVector<>(1.0 * ix, 1.0 * iy, 0.5 + 1.0 * iz));
+                system.AddBody(ball);
+            }
+        }
+    }
+}
+
+static void Compare(int num_threads, double tolerance) {
+    ChSystemNSC serial_system;
+    CreatePile(serial_system, ChSolver::Type::SOR, 1);
+
+    ChSystemNSC mt_system;
+    CreatePile(mt_system, ChSolver::Type::SOR_MULTITHREAD, num_threads);
+
+    auto solver = std::static_pointer_cast<ChSolverSORmultithread>(mt_system.GetSolver());
+    ASSERT_EQ(solver->GetNumberOfThreads(), num_threads);
+
+    for (int step = 0; step < 100; step++) {
+        serial_system.DoStepDynamics(1e-3);
+        mt_system.DoStepDynamics(1e-3);
+    }
+
+    ASSERT_EQ(serial_system.GetNcontacts(), mt_system.GetNcontacts());
+    ASSERT_GT(solver->GetTotalIterations(), 0);
+
+    auto& serial_bodies = serial_system.Get_bodylist();
+    auto& mt_bodies = mt_system.Get_bodylist();
+    for (size_t i = 0; i < serial_bodies.size(); i++) {
+        ChVector<> diff = serial_bodies[i]->GetPos() - mt_bodies[i]->GetPos();
+        ASSERT_LE(diff.Length(), tolerance);
+    }
+}
+
+TEST(ChSolverSORmultithread, OneThread) {
+    Compare(1, 0.0);
+}
+
+TEST(ChSolverSORmultithread, FourThreads) {
+    ChTaskScheduler::GetInstance().SetNumThreads(4);
+    Compare(4, 1e-3);
+}
@@ -0,0 +1,117 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for RigidTerrain mesh patches. A sphere rests on a flat mesh patch
+// with a sweep sphere radius. Both the height queries (answered by the 2.5D
+// grid index) and the collision detection see the mesh surface inflated by the
+// sweep sphere radius.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Flat square mesh [-2,2] x [-2,2] at z = 0, with 4 x 4 cells split in two triangles each.
+static void WriteFlatMesh(const std::string& filename) {
+    geometry::ChTriangleMeshConnected mesh;
+    int n = 4;
+    for (int iy = 0; iy <= n; iy++) {
+        for (int ix = 0; ix <= n; ix++)
+            mesh.getCoordsVertices().push_back(ChVector<>(-2.0 + ix, -2.0 + iy, 0));
+    }
+    for (int iy = 0; iy < n; iy++) {
+        for (int ix = 0; ix < n; ix++) {
+            int v0 = iy * (n + 1) + ix;
+            mesh.getIndicesVertexes().push_back(ChVector<int>(v0, v0 + 1, v0 + n + 2));
+            mesh.getIndicesVertexes().push_back(ChVector<int>(v0, v0 + n + 2, v0 + n + 1));
+        }
+    }
+    std::vector<geometry::ChTriangleMeshConnected> meshes(1, mesh);
+    geometry::ChTriangleMeshConnected::WriteWavefront(filename, meshes);
+}
+
+class ContactReporter : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        distances.push_back(distance);
+        return true;
+    }
+
+    std::vector<double> distances;
+};
+
+TEST(RigidTerrain, mesh_patch) {
+    const std::string filename = "utest_VEH_rigid_terrain.obj";
+    WriteFlatMesh(filename);
+
+    double sweep_radius = 0.05;
+    double radius = 0.2;
+    double penetration = 0.02;
+
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    collision::ChCollisionModel::SetDefaultSuggestedEnvelope(0.01);
+
+    RigidTerrain terrain(&system);
+    terrain.AddPatch(ChCoordsys<>(), filename, "ground", sweep_radius, false);
+    terrain.Initialize();
+
+    // The ball touches a single mesh triangle
+    auto ball = std::make_shared<ChBodyEasySphere>(radius, 1000, true, false);
+    ball->SetPos(ChVector<>(0.7, 0.3, radius - penetration));
+    system.AddBody(ball);
+
+    // Height queries report the surface inflated by the sweep sphere radius
+    ASSERT_NEAR(terrain.GetHeight(0.7, 0.3), sweep_radius, 1e-12);
+    ASSERT_NEAR(terrain.GetHeight(-1.7, 1.4), sweep_radius, 1e-12);
+    ASSERT_NEAR(terrain.GetNormal(0.7, 0.3).z(), 1.0, 1e-12);
+
+    std::vector<ChVector2<>> loc = {ChVector2<>(0.7, 0.3), ChVector2<>(1.5, -1.5), ChVector2<>(5, 5)};
+    std::vector<double> height;
+    std::vector<ChVector<>> normal;
+    std::vector<float> friction;
+    terrain.GetProperties(loc, height, normal, friction);
+    ASSERT_NEAR(height[0], sweep_radius, 1e-12);
+    ASSERT_NEAR(height[1], sweep_radius, 1e-12);
+    ASSERT_EQ(height[2], 0.0);  // outside the patch
+
+    // The collision detection also sees the surface inflated by the sweep sphere radius (not by the envelope),
+    // so the contact depth matches the penetration below the reported terrain height
+    system.ComputeCollisions();
+    ContactReporter reporter;
+    system.GetContactContainer()->ReportAllContacts(&reporter);
+    ASSERT_EQ(system.GetNcontacts(), 1);
+    ASSERT_EQ(reporter.distances.size(), 1u);
+    ASSERT_NEAR(reporter.distances[0], -(penetration + sweep_radius), 1e-4);
+    double bottom = ball->GetPos().z() - radius;
+    ASSERT_NEAR(reporter.distances[0], bottom - terrain.GetHeight(0.7, 0.3), 1e-4);
+
+    std::remove(filename.c_str());
+}